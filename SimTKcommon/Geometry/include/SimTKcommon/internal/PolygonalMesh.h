@@ -54,7 +54,10 @@ file (.stl) that is in ascii or binary format. You can also build meshes
 programmatically, and some static methods are provided here for generating some
 common shapes. If you don't know what kind of file you have, you can attempt to 
 read it with the loadFile() method which will examine the file extension to 
-determine the expected format.
+determine the expected format. For meshes that are loaded often, you can save
+them once with writeBinaryMeshFile(); loading the resulting file with
+loadBinaryMeshFile() involves no parsing and is much faster than reading any 
+of the text formats.
 
 The file formats above support having normals (and/or texture coordinates) 
 either at each vertex (.vtp) or per face/vertex (obj, stl). We assume this 
@@ -285,6 +288,7 @@ public:
         - <tt>.stl </tt>: 3D Systems Stereolithography file (ascii or binary)
         - <tt>.stla</tt>: ascii-only stl extension
         - <tt>.vtp </tt>: VTK PolyData file (we can only read the ascii version)
+        - <tt>.simtkmesh</tt>: binary mesh file written by writeBinaryMeshFile()
 
     @param[in]  pathname    The name of a mesh file with a recognized extension.
     **/
@@ -325,6 +329,23 @@ public:
     @param[in]  pathname    The name of a .stl or .stla file. **/
     void loadStlFile(const String& pathname);
 
+    /** Load a binary mesh file that was written by writeBinaryMeshFile(), 
+    replacing any vertices, faces, normals and texture coordinates already in
+    this mesh. The file is an image of the mesh's internal arrays so it is 
+    read in a single operation with no parsing. It must have been written 
+    on a machine with the same byte order and the same precision for Real as
+    this one. The suffix for these files is typically ".simtkmesh" but we 
+    don't check here.
+    @param[in]  pathname    The name of a binary mesh file. **/
+    void loadBinaryMeshFile(const String& pathname);
+
+    /** Write this mesh, including any normals and texture coordinates, to a 
+    binary file that can be read back with loadBinaryMeshFile(). The file is
+    compact and fast to read but is not portable between machines with 
+    different byte orders or precisions.
+    @param[in]  pathname    The name of the file to create or overwrite. **/
+    void writeBinaryMeshFile(const String& pathname) const;
+
    private:
     explicit PolygonalMesh(PolygonalMeshImpl* impl) : HandleBase(impl) {}
     void initializeHandleIfEmpty();
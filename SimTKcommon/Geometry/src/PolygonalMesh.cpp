@@ -27,10 +27,13 @@
 #include "SimTKcommon/internal/Pathname.h"
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 #include <string>
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <fstream>
 
 using namespace SimTK;
@@ -218,11 +221,13 @@ void PolygonalMesh::loadFile(const String& pathname) {
     if (lext==".obj") loadObjFile(pathname);
     else if (lext==".vtp") loadVtpFile(pathname);
     else if (lext==".stl"||lext==".stla") loadStlFile(pathname);
+    else if (lext==".simtkmesh") loadBinaryMeshFile(pathname);
     else {
         SimTK_ERRCHK1_ALWAYS(!"unrecognized extension",
             "PolygonalMesh::loadFile()",
             "Unrecognized file extension on mesh file '%s':\n"
-            "  expected .obj, .stl, .stla, or .vtp.", pathname.c_str());
+            "  expected .obj, .stl, .stla, .vtp, or .simtkmesh.", 
+            pathname.c_str());
     }
 }
 
@@ -625,7 +630,27 @@ void PolygonalMesh::enforceMeshConsistency() {
     }
 
 }
-    //------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+//                              READ WHOLE FILE
+//------------------------------------------------------------------------------
+// Binary formats are read with a single read of the whole file into memory,
+// then decoded from there; that is much faster than many small reads.
+namespace {
+void readWholeFile(const String& pathname, const char* methodName,
+                   std::string& contents) {
+    std::ifstream ifs(pathname, std::ios_base::binary | std::ios_base::ate);
+    SimTK_ERRCHK1_ALWAYS(ifs.good(), methodName,
+        "Can't open file '%s'", pathname.c_str());
+    const std::streamoff size = ifs.tellg();
+    contents.resize((std::size_t)size);
+    ifs.seekg(0);
+    if (size > 0) ifs.read(&contents[0], size);
+    SimTK_ERRCHK1_ALWAYS(ifs.good() && ifs.gcount()==size, methodName,
+        "Error while reading file '%s'.", pathname.c_str());
+}
+}
+
+//------------------------------------------------------------------------------
 //                              VERTEX MAP
 //------------------------------------------------------------------------------
 // This is a local utility class for use in weeding out duplicate vertices.
@@ -698,13 +723,45 @@ private:
         return ix;
     }
 
+    // Binary STL vertices are floats, and the copies of a vertex shared by 
+    // several faces are nearly always bit-for-bit identical. So we first 
+    // look for an exact match, which is a cheap hash lookup, and only search
+    // the tolerance-based map for vertices we haven't seen before.
+    int getVertex(const float* v, PolygonalMesh& mesh) {
+        ExactVertKey key;
+        std::memcpy(key.bits, v, sizeof(key.bits));
+        ExactVertMap::const_iterator p = m_exactVertMap.find(key);
+        if (p != m_exactVertMap.end())
+            return p->second;
+        const int ix = getVertex(Vec3((Real)v[0], (Real)v[1], (Real)v[2]), 
+                                 mesh);
+        m_exactVertMap.insert(std::make_pair(key,ix));
+        return ix;
+    }
+
     // The ascii/binary determination reads some lines; counts must restart.
     void resetLineCounts() {m_lineNo=m_sigLineNo=0;}
 
+    struct ExactVertKey {
+        bool operator==(const ExactVertKey& other) const 
+        {   return std::memcmp(bits, other.bits, sizeof(bits)) == 0; }
+        std::uint32_t bits[3];
+    };
+    struct ExactVertHash {
+        std::size_t operator()(const ExactVertKey& key) const {
+            std::uint64_t h = 14695981039346656037ULL; // FNV-1a
+            for (int i=0; i < 3; ++i) 
+                h = (h ^ key.bits[i]) * 1099511628211ULL;
+            return (std::size_t)h;
+        }
+    };
+    typedef std::unordered_map<ExactVertKey,int,ExactVertHash> ExactVertMap;
+
     const String&     m_pathname;
     const char* const m_pathcstr;
     const Real        m_vertexTol;
     VertMap           m_vertMap;
+    ExactVertMap      m_exactVertMap;
 
     std::ifstream     m_ifs;
     int               m_lineNo;         // current line in file
@@ -887,53 +944,41 @@ void STLFile::loadStlAsciiFile(PolygonalMesh& mesh) {
 //
 // TODO: the STL binary format is always little-endian, like an Intel chip.
 // The code here won't work properly on a big endian machine!
+//
+// The whole file is read at once and the fixed-size records are decoded from
+// memory; vertices are merged as described for getVertex(const float*).
 void STLFile::loadStlBinaryFile(PolygonalMesh& mesh) {
-    // This should never fail since the above succeeded, but we'll check.
-    m_ifs.open(m_pathname, std::ios_base::binary);
-    SimTK_ERRCHK1_ALWAYS(m_ifs.good(), "PolygonalMesh::loadStlFile()",
-        "Can't open file '%s'", m_pathcstr);
-
-    unsigned char header[80];
-    m_ifs.read((char*)header, 80);
-    SimTK_ERRCHK1_ALWAYS(m_ifs.good() && m_ifs.gcount()==80, 
+    std::string contents;
+    readWholeFile(m_pathname, "PolygonalMesh::loadStlFile()", contents);
+    SimTK_ERRCHK1_ALWAYS(contents.size() >= 84, 
         "PolygonalMesh::loadStlFile()", "Bad binary STL file '%s':\n"
-        "  couldn't read header.", m_pathcstr);
+        "  couldn't read header and triangle count.", m_pathcstr);
 
-    unsigned nFaces;
-    m_ifs.read((char*)&nFaces, sizeof(unsigned));
-    SimTK_ERRCHK1_ALWAYS(m_ifs.good() && m_ifs.gcount()==sizeof(unsigned), 
+    std::uint32_t nFaces;
+    std::memcpy(&nFaces, contents.data()+80, sizeof(nFaces));
+    const std::size_t recordSize = 12*sizeof(float) + sizeof(std::uint16_t);
+    SimTK_ERRCHK3_ALWAYS((contents.size()-84)/recordSize >= nFaces, 
         "PolygonalMesh::loadStlFile()", "Bad binary STL file '%s':\n"
-        "  couldn't read triangle count.", m_pathcstr);
+        "  expected %u triangles but there is only room for %u.", m_pathcstr,
+        (unsigned)nFaces, (unsigned)((contents.size()-84)/recordSize));
 
     Array_<int> vertices(3);
     Array_<int> normalIndices(3);
-    float vbuf[3];
-    unsigned short sbuf;
-    const unsigned vz = 3*sizeof(float);
-    for (unsigned fx=0; fx < nFaces; ++fx) {
-        m_ifs.read((char*)vbuf, vz); 
-        const UnitVec3 faceNormal((Real)vbuf[0], (Real)vbuf[1], (Real)vbuf[2]);
-        int normalIndex = mesh.addNormal(faceNormal);
+    float fbuf[12]; // normal and three vertices
+    const char* record = contents.data() + 84;
+    for (std::uint32_t fx=0; fx < nFaces; ++fx, record += recordSize) {
+        std::memcpy(fbuf, record, sizeof(fbuf));
+        const UnitVec3 faceNormal((Real)fbuf[0], (Real)fbuf[1], (Real)fbuf[2]);
+        const int normalIndex = mesh.addNormal(faceNormal);
         for (int vx=0; vx < 3; ++vx) {
-            m_ifs.read((char*)vbuf, vz);
-            SimTK_ERRCHK3_ALWAYS(m_ifs.good() && m_ifs.gcount()==vz, 
-                "PolygonalMesh::loadStlFile()", "Bad binary STL file '%s':\n"
-                "  couldn't read vertex %d for face %d.", m_pathcstr, vx, fx);
-            const Vec3 vertex((Real)vbuf[0], (Real)vbuf[1], (Real)vbuf[2]);
-            int vertIndex = getVertex(vertex, mesh);
-            vertices[vx] = vertIndex;
+            vertices[vx] = getVertex(&fbuf[3*(vx+1)], mesh);
             normalIndices[vx] = normalIndex;
         }
         mesh.addFaceWithNormals(vertices, normalIndices);
-        // Now read and toss the "attribute byte count".
-        m_ifs.read((char*)&sbuf,sizeof(short));
-        SimTK_ERRCHK2_ALWAYS(m_ifs.good() && m_ifs.gcount()==sizeof(short), 
-            "PolygonalMesh::loadStlFile()", "Bad binary STL file '%s':\n"
-            "  couldn't read attribute for face %d.", m_pathcstr, fx);
+        // The "attribute byte count" is ignored.
     }
 
     // We don't care if there is extra stuff in the file.
-    m_ifs.close();
 }
 
 // Return the next line from the formatted input stream, ignoring blank
@@ -974,6 +1019,154 @@ bool STLFile::getSignificantLine(bool eofOK) {
     return false;
 }
 
+//------------------------------------------------------------------------------
+//                            BINARY MESH FILE
+//------------------------------------------------------------------------------
+// This is the binary mesh format:
+//   char[8]    - "SimTKmsh"
+//   uint32     - 0x01020304, written in native byte order
+//   uint32     - format version, currently 1
+//   uint32     - sizeof(Real)
+//   uint32     - flags: 1 if normals and texture coordinates are at vertices,
+//                2 if the mesh has texture coordinates
+//   uint32[7]  - number of elements in each of the following arrays
+//   Vec3[]     - vertices
+//   int[]      - faceVertexIndex
+//   int[]      - faceVertexStart
+//   UnitVec3[] - normals
+//   int[]      - faceVertexNormalIndex
+//   Vec2[]     - textureCoordinates
+//   int[]      - faceVertexTextureIndex
+// That is, the arrays of PolygonalMeshImpl exactly as they are in memory.
+namespace {
+const char          BinaryMeshMagic[8] = {'S','i','m','T','K','m','s','h'};
+const std::uint32_t BinaryMeshByteOrder = 0x01020304;
+const std::uint32_t BinaryMeshVersion = 1;
+const int           BinaryMeshNumArrays = 7;
+
+static_assert(sizeof(Vec3)==3*sizeof(Real) && sizeof(UnitVec3)==3*sizeof(Real)
+              && sizeof(Vec2)==2*sizeof(Real), 
+              "Binary mesh files require tightly packed Vec types.");
+
+template <class T>
+void writeBinaryArray(std::ostream& o, const Array_<T>& a) {
+    if (!a.empty())
+        o.write(reinterpret_cast<const char*>(a.cbegin()), a.size()*sizeof(T));
+}
+
+// Copy n elements from the bytes at p into a, advancing p.
+template <class T>
+void readBinaryArray(const char*& p, std::uint32_t n, Array_<T>& a) {
+    a.resize(n);
+    if (n) std::memcpy(reinterpret_cast<char*>(a.begin()), p, n*sizeof(T));
+    p += n*sizeof(T);
+}
+
+// Return true if every entry of indices is a valid index into an array of
+// n elements.
+bool allIndicesInRange(const Array_<int>& indices, std::size_t n) {
+    for (int i : indices)
+        if (i < 0 || (std::size_t)i >= n)
+            return false;
+    return true;
+}
+}
+
+void PolygonalMesh::loadBinaryMeshFile(const String& pathname) {
+    const char* methodName = "PolygonalMesh::loadBinaryMeshFile()";
+    std::string contents;
+    readWholeFile(pathname, methodName, contents);
+
+    const std::size_t headerSize = 
+        sizeof(BinaryMeshMagic) + (4+BinaryMeshNumArrays)*sizeof(std::uint32_t);
+    SimTK_ERRCHK1_ALWAYS(contents.size() >= headerSize
+        && std::memcmp(contents.data(), BinaryMeshMagic, 
+                       sizeof(BinaryMeshMagic)) == 0, methodName,
+        "File '%s' is not a binary mesh file.", pathname.c_str());
+    std::uint32_t header[4+BinaryMeshNumArrays];
+    std::memcpy(header, contents.data()+sizeof(BinaryMeshMagic), 
+                sizeof(header));
+    SimTK_ERRCHK1_ALWAYS(header[0]==BinaryMeshByteOrder, methodName,
+        "Binary mesh file '%s' was written on a machine with a different"
+        " byte order.", pathname.c_str());
+    SimTK_ERRCHK2_ALWAYS(header[1]==BinaryMeshVersion, methodName,
+        "Binary mesh file '%s' has format version %u, which is not supported.",
+        pathname.c_str(), (unsigned)header[1]);
+    SimTK_ERRCHK3_ALWAYS(header[2]==sizeof(Real), methodName,
+        "Binary mesh file '%s' has %u-byte reals but we need %u-byte reals.",
+        pathname.c_str(), (unsigned)header[2], (unsigned)sizeof(Real));
+
+    const std::uint32_t* n = header+4;
+    const std::size_t elementSize[BinaryMeshNumArrays] = 
+    {   sizeof(Vec3), sizeof(int), sizeof(int), sizeof(UnitVec3), 
+        sizeof(int), sizeof(Vec2), sizeof(int) };
+    std::size_t expectedSize = headerSize;
+    for (int i=0; i < BinaryMeshNumArrays; ++i)
+        expectedSize += n[i]*elementSize[i];
+    SimTK_ERRCHK1_ALWAYS(contents.size()==expectedSize && n[2] >= 1, 
+        methodName, "Binary mesh file '%s' is truncated or corrupt.", 
+        pathname.c_str());
+
+    initializeHandleIfEmpty();
+    PolygonalMeshImpl& impl = updImpl();
+    const char* p = contents.data() + headerSize;
+    readBinaryArray(p, n[0], impl.vertices);
+    readBinaryArray(p, n[1], impl.faceVertexIndex);
+    readBinaryArray(p, n[2], impl.faceVertexStart);
+    readBinaryArray(p, n[3], impl.normals);
+    readBinaryArray(p, n[4], impl.faceVertexNormalIndex);
+    readBinaryArray(p, n[5], impl.textureCoordinates);
+    readBinaryArray(p, n[6], impl.faceVertexTextureIndex);
+    impl.meshDataAtVertices = (header[3] & 1) != 0;
+    impl.meshHasTextureCoordinates = (header[3] & 2) != 0;
+
+    // Everything else indexes into the arrays, so make sure it can't point
+    // outside them.
+    bool startsOK = impl.faceVertexStart.front() == 0
+        && impl.faceVertexStart.back() == (int)impl.faceVertexIndex.size();
+    for (unsigned f=1; startsOK && f < impl.faceVertexStart.size(); ++f)
+        startsOK = impl.faceVertexStart[f-1] <= impl.faceVertexStart[f];
+    SimTK_ERRCHK1_ALWAYS(startsOK
+        && allIndicesInRange(impl.faceVertexIndex, impl.vertices.size())
+        && allIndicesInRange(impl.faceVertexNormalIndex, impl.normals.size())
+        && allIndicesInRange(impl.faceVertexTextureIndex, 
+                             impl.textureCoordinates.size()),
+        methodName, "Binary mesh file '%s' is corrupt.", pathname.c_str());
+}
+
+void PolygonalMesh::writeBinaryMeshFile(const String& pathname) const {
+    const char* methodName = "PolygonalMesh::writeBinaryMeshFile()";
+    std::ofstream ofs(pathname, std::ios_base::binary);
+    SimTK_ERRCHK1_ALWAYS(ofs.good(), methodName,
+        "Can't open file '%s' for writing.", pathname.c_str());
+
+    const PolygonalMeshImpl empty;
+    const PolygonalMeshImpl& impl = isEmptyHandle() ? empty : getImpl();
+    const std::uint32_t header[4+BinaryMeshNumArrays] = {
+        BinaryMeshByteOrder, BinaryMeshVersion, (std::uint32_t)sizeof(Real),
+        std::uint32_t((impl.meshDataAtVertices ? 1 : 0) 
+                      | (impl.meshHasTextureCoordinates ? 2 : 0)),
+        (std::uint32_t)impl.vertices.size(),
+        (std::uint32_t)impl.faceVertexIndex.size(),
+        (std::uint32_t)impl.faceVertexStart.size(),
+        (std::uint32_t)impl.normals.size(),
+        (std::uint32_t)impl.faceVertexNormalIndex.size(),
+        (std::uint32_t)impl.textureCoordinates.size(),
+        (std::uint32_t)impl.faceVertexTextureIndex.size() };
+    ofs.write(BinaryMeshMagic, sizeof(BinaryMeshMagic));
+    ofs.write(reinterpret_cast<const char*>(header), sizeof(header));
+    writeBinaryArray(ofs, impl.vertices);
+    writeBinaryArray(ofs, impl.faceVertexIndex);
+    writeBinaryArray(ofs, impl.faceVertexStart);
+    writeBinaryArray(ofs, impl.normals);
+    writeBinaryArray(ofs, impl.faceVertexNormalIndex);
+    writeBinaryArray(ofs, impl.textureCoordinates);
+    writeBinaryArray(ofs, impl.faceVertexTextureIndex);
+    ofs.close();
+    SimTK_ERRCHK1_ALWAYS(!ofs.fail(), methodName,
+        "Error while writing file '%s'.", pathname.c_str());
+}
+
 //------------------------------------------------------------------------------
 //                            CREATE SPHERE MESH
 //------------------------------------------------------------------------------
@@ -163,9 +163,9 @@ public:
 
     // Default copy constructor, copy assignment, destructor are shallow.
 
-    // Use this to make this entry contain a *copy* of the source value.
-    // If the destination already has a value, the new value must be
-    // assignment compatible.
+    // Use this to make this entry contain a *copy* of the source value. The
+    // value is shared with the source until one of them is written; see
+    // updValue().
     DiscreteVarInfo& deepAssign(const DiscreteVarInfo& src) {
         *this = src; // copy assignment forgets dependents
         return *this;
@@ -179,20 +179,21 @@ public:
     const Stage& getAllocationStage()  const {return m_allocationStage;}
 
     // Exchange value pointers (should be from this dv's update cache entry).
-    void swapValue(Real updTime, ClonePtr<AbstractValue>& other) 
+    void swapValue(Real updTime, CloneOnWritePtr<AbstractValue>& other) 
     {   m_value.swap(other); m_timeLastUpdated=updTime; }
 
     const AbstractValue& getValue() const {assert(m_value); return *m_value;}
 
     // Whenever we hand out this variables value for write access we update
     // the value version, note the update time, and notify any dependents that
-    // they are now invalid with respect to this variable's value.
+    // they are now invalid with respect to this variable's value. If the value
+    // is still shared with a copied State, this is when we get our own copy.
     AbstractValue& updValue(const StateImpl& stateImpl, Real updTime) {
        assert(m_value); 
        ++m_valueVersion;
        m_timeLastUpdated=updTime; 
        m_dependents.notePrerequisiteChange(stateImpl);
-       return *m_value; 
+       return m_value.updRef(); 
     }
     ValueVersion getValueVersion() const {return m_valueVersion;}
     Real getTimeLastUpdated() const 
@@ -217,8 +218,9 @@ private:
     // themselves.
     ResetOnCopy<ListOfDependents>   m_dependents;
 
-    // These change at run time.
-    ClonePtr<AbstractValue>         m_value;
+    // These change at run time. The value is shared among copies of a State
+    // until one of them writes on it.
+    CloneOnWritePtr<AbstractValue>  m_value;
     ValueVersion                    m_valueVersion{1};
     Real                            m_timeLastUpdated{NaN};
 
@@ -331,7 +333,8 @@ public:
         m_dependents.notePrerequisiteChange(stateImpl);
     }
 
-    // Use this to make this entry contain a *copy* of the source value.
+    // Use this to make this entry contain a *copy* of the source value. As
+    // for discrete variables, the value is shared until written.
     CacheEntryInfo& deepAssign(const CacheEntryInfo& src) {
         *this = src; // copy assignment forgets dependents
         return *this;
@@ -358,10 +361,11 @@ public:
     // gets done often with no intent to modify, esp. by SBStateDigest.)
     // So be sure that the cache entry gets invalidated first either by an
     // explicit prerequisite change notification, or because the depends-on
-    // stage got invalidated.
+    // stage got invalidated. A value still shared with a copied State is
+    // cloned here.
     AbstractValue& updValue(const StateImpl& stateImpl) {
        assert(m_value); 
-       return *m_value; 
+       return m_value.updRef(); 
     }
     ValueVersion getValueVersion() const {return m_valueVersion;}
 
@@ -422,7 +426,7 @@ private:
     // prerequisites so we are up to date with respect to them. We'll change
     // the initial value to false in registerWithPrerequisites() if there
     // are some.
-    ClonePtr<AbstractValue>     m_value;
+    CloneOnWritePtr<AbstractValue> m_value;
     ValueVersion                m_valueVersion{1};
     StageVersion                m_dependsOnVersionWhenLastComputed{0};
     bool                        m_isUpToDateWithPrerequisites{true};
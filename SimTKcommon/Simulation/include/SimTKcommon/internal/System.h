@@ -281,6 +281,41 @@ requested stage or higher, nothing happens here. Otherwise, the state is
 realized one stage at a time until it reaches the requested stage. 
 @see realizeTopology(), realizeModel() **/
 void realize(const State& state, Stage stage = Stage::HighestRuntime) const;
+
+/** Realize each of a batch of \a states to the indicated \a stage. This is
+equivalent to calling realize() on each State in turn, but the States are
+divided among up to getNumberOfBatchThreads() threads, and the checks that
+each State belongs to this %System are done once for the whole batch before
+any realization begins. This is intended for ensemble or Monte Carlo studies
+in which the same %System is evaluated for many States that differ in their
+parameters or initial conditions.
+
+Each State's results are written only into that State's own cache, so the
+results are identical to those of serial realize() calls. However, all the
+States share this %System, so every force element, constraint, and measure
+in it must be safe to evaluate concurrently for different States; the
+built-in ones are, but Custom elements that modify their own data members
+during realization are not. Several threads may call realizeBatch() for the
+same %System at once; a batch that finds this %System's threads already busy
+is realized serially in its calling thread.
+
+If realizing any State throws an exception, the remaining States are still
+realized and then the first exception is rethrown here. The States need not
+be realized to the same stage on entry, but each must be realized through at
+least Stage::Model.
+@see realize(), setNumberOfBatchThreads() **/
+void realizeBatch(const Array_<State>& states, 
+                  Stage stage = Stage::HighestRuntime) const;
+
+/** Set the maximum number of threads used by realizeBatch(). The default is
+the number of processors on this machine. Set this to 1 to realize batches
+serially in the calling thread. When realizeBatch() is itself called from a
+thread that is part of some other parallel computation, the batch is always
+realized serially. **/
+void setNumberOfBatchThreads(int numThreads);
+/** Return the maximum number of threads used by realizeBatch().
+@see setNumberOfBatchThreads() **/
+int getNumberOfBatchThreads() const;
 /**@}**/
 
 
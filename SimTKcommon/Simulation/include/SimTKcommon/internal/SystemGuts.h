@@ -96,6 +96,8 @@ public:
     State&       updDefaultState();
 
     void realize(const State& s, Stage g = Stage::HighestRuntime) const;
+    void realizeBatch(const Array_<State>& states,
+                      Stage g = Stage::HighestRuntime) const;
 
     SubsystemIndex adoptSubsystem(Subsystem& child);
 
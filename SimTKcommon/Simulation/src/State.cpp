@@ -172,7 +172,8 @@ bool State::isConsistent(const SimTK::State& otherState) const {
 // The methods are templatized and expect the stacks to be in Arrays
 // of the same template. The template value must be a type that supports
 // three methods (the template analog to virtual functions):
-//      deepAssign()            a non-shallow assignment, i.e. clone the value
+//      deepAssign()            a non-shallow assignment; the value itself may
+//                              be shared until one of the copies writes it
 //      deepDestruct()          destroy any owned heap space
 //      getAllocationStage()    return the stage being worked on when this was 
 //                              allocated
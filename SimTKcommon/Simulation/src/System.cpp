@@ -40,7 +40,9 @@
 #include "SystemGutsRep.h"
 
 #include <cassert>
+#include <exception>
 #include <map>
+#include <mutex>
 #include <set>
 
 namespace SimTK {
@@ -169,6 +171,20 @@ void System::invalidateSystemTopologyCache() const
 const State& System::realizeTopology() const {return getSystemGuts().realizeTopology();}
 void System::realizeModel(State& s) const {getSystemGuts().realizeModel(s);}
 void System::realize(const State& s, Stage g) const {getSystemGuts().realize(s,g);}
+void System::realizeBatch(const Array_<State>& states, Stage g) const
+{   getSystemGuts().realizeBatch(states,g); }
+
+void System::setNumberOfBatchThreads(int numThreads) {
+    SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, "System",
+        "setNumberOfBatchThreads", "Illegal number of threads %d.", numThreads);
+    if (numThreads != getNumberOfBatchThreads()) {
+        updSystemGuts().updRep().numBatchThreads = numThreads;
+        updSystemGuts().updRep().batchExecutor.reset
+                                            (new ParallelExecutor(numThreads));
+    }
+}
+int System::getNumberOfBatchThreads() const
+{   return getSystemGuts().getRep().numBatchThreads; }
 void System::calcDecorativeGeometryAndAppend
    (const State& s, Stage g, Array_<DecorativeGeometry>& geom) const 
 {   getSystemGuts().calcDecorativeGeometryAndAppend(s,g,geom); }
@@ -791,6 +807,67 @@ void System::Guts::realize(const State& s, Stage g) const {
     }
 }
 
+//------------------------------------------------------------------------------
+//                              REALIZE BATCH
+//------------------------------------------------------------------------------
+namespace {
+// Realize one State of the batch per index. Any exception is caught so that
+// it can't escape from a worker thread; the first one is kept for rethrowing
+// once the whole batch is done.
+class RealizeBatchTask : public ParallelExecutor::Task {
+public:
+    RealizeBatchTask(const System::Guts& guts, const Array_<State>& states,
+                     Stage stage)
+    :   guts(guts), states(states), stage(stage) {}
+
+    void execute(int i) override {
+        try {
+            guts.realize(states[i], stage);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!firstError) firstError = std::current_exception();
+        }
+    }
+
+    void rethrowIfFailed() const
+    {   if (firstError) std::rethrow_exception(firstError); }
+
+private:
+    const System::Guts&  guts;
+    const Array_<State>& states;
+    const Stage          stage;
+    std::mutex           errorMutex;
+    std::exception_ptr   firstError;
+};
+}
+
+void System::Guts::realizeBatch(const Array_<State>& states, Stage g) const {
+    SimTK_STAGECHECK_TOPOLOGY_REALIZED_ALWAYS(systemTopologyHasBeenRealized(),
+        "System", getName(), "System::Guts::realizeBatch()");
+
+    // Do all the per-State checks up front so that a bad State is reported
+    // before any work is done, and so none of the threads need to throw.
+    const StageVersion topoVersion = getSystemTopologyCacheVersion();
+    for (const State& s : states) {
+        SimTK_STAGECHECK_TOPOLOGY_VERSION_ALWAYS(topoVersion, 
+            s.getSystemTopologyStageVersion(),
+            "System", getName(), "System::Guts::realizeBatch()");
+        SimTK_STAGECHECK_GE_ALWAYS(s.getSystemStage(), Stage::Model, 
+            "System::Guts::realizeBatch()");
+    }
+
+    const GutsRep& rep = getRep();
+    const int numStates = (int)states.size();
+    RealizeBatchTask task(*this, states, g);
+    if (rep.numBatchThreads < 2 || numStates < 2
+        || ParallelExecutor::isWorkerThread()) {
+        for (int i=0; i < numStates; ++i)
+            task.execute(i);
+    } else
+        rep.batchExecutor->execute(task, numStates);
+    task.rethrowIfFailed();
+}
+
 //------------------------------------------------------------------------------
 //                   CALC DECORATIVE GEOMETRY AND APPEND
 //------------------------------------------------------------------------------
@@ -37,6 +37,9 @@
 
 #include "SimTKcommon/internal/System.h"
 #include "SimTKcommon/internal/SystemGuts.h"
+#include "SimTKcommon/internal/ParallelExecutor.h"
+
+#include <atomic>
 
 namespace SimTK {
 
@@ -52,10 +55,13 @@ public:
         defaultUpDirection(YAxis), 
         useUniformBackground(false),
         hasTimeAdvancedEventsFlag(false),
+        numBatchThreads(ParallelExecutor::getNumProcessors()),
         systemTopologyRealized(false), 
         topologyCacheVersion(1) // not zero
 
     {
+        if (numBatchThreads < 1) numBatchThreads = 1;
+        batchExecutor.reset(new ParallelExecutor(numBatchThreads));
         resetAllCounters();
     }
 
@@ -73,6 +79,8 @@ public:
         defaultUpDirection(src.defaultUpDirection), 
         useUniformBackground(src.useUniformBackground),
         hasTimeAdvancedEventsFlag(src.hasTimeAdvancedEventsFlag),
+        numBatchThreads(src.numBatchThreads),
+        batchExecutor(new ParallelExecutor(src.numBatchThreads)),
         systemTopologyRealized(false),
         topologyCacheVersion(src.topologyCacheVersion)
     {
@@ -183,6 +191,14 @@ private:
     bool                useUniformBackground;   // visualization hint
 
     bool hasTimeAdvancedEventsFlag; //TODO: should be in State as a Model variable
+
+    // Used by realizeBatch(). The executor is replaced only when the number
+    // of threads changes, never by realizeBatch() itself, so concurrent
+    // realizeBatch() calls can share it. It is mutable only because 
+    // ParallelExecutor::execute() is non-const; that is safe to call from
+    // several threads. (Its threads start on first use.)
+    int                                 numBatchThreads;
+    mutable ClonePtr<ParallelExecutor>  batchExecutor;
        
     
     // TOPOLOGY STAGE CACHE //
@@ -200,7 +216,8 @@ private:
     mutable State           defaultState;
 
         // STATISTICS //
-    mutable int nRealizationsOfStage[Stage::NValid];
+    // Bumped concurrently by realizeBatch().
+    mutable std::atomic<int> nRealizationsOfStage[Stage::NValid];
     mutable int nRealizeCalls; // counts realizeTopology(), realizeModel(), realize()
 
     mutable int nPrescribeQCalls, nPrescribeUCalls;
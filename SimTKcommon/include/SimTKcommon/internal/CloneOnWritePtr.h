@@ -29,6 +29,7 @@
 #include <memory>
 #include <iosfwd>
 #include <cassert>
+#include <atomic>
 
 namespace SimTK {
 
@@ -50,7 +51,9 @@ return a writable pointer.
 
 This class is entirely inline and has no computational or space overhead
 beyond the cost of dealing with the reference count, except when a copy has
-to be made due to a write attempt.
+to be made due to a write attempt. The reference count is atomic, so
+containers that share an object may be used from different threads, provided
+that each container is used by only one thread at a time.
 
 @tparam T   The type of the contained object, which *must* have a `clone()` 
             method. May be an abstract or concrete type.
@@ -79,7 +82,7 @@ public:
     ownership of that object. The use count will be one unless the pointer
     was null in which case it will be zero. **/
     explicit CloneOnWritePtr(T* x) : CloneOnWritePtr()
-    {   if (x) {p=x; count=new long(1);} } 
+    {   if (x) {p=x; count=new std::atomic<long>(1);} } 
 
     /** Given a pointer to a read-only object, create a new heap-allocated 
     copy of that object via its `clone()` method and make this %CloneOnWritePtr
@@ -271,7 +274,7 @@ public:
     void reset(T* x) { // could throw when allocating count
         if (x != p) {
             reset();
-            if (x) {p=x; count=new long(1);}
+            if (x) {p=x; count=new std::atomic<long>(1);}
         }
     }
 
@@ -288,7 +291,7 @@ public:
     sharing the referenced object. There is never more than
     one holding an object for writing. If the pointer is null the use 
     count is zero. **/
-    long use_count() const noexcept {return count ? *count : 0;}
+    long use_count() const noexcept {return count ? count->load() : 0;}
 
     /** Is this the only user of the referenced object? Note that this means
     there is exactly one; if the managed pointer is null `unique()` returns 
@@ -327,8 +330,16 @@ public:
     unique() already then nothing happens. Note that you have to have write
     access to this container in order to detach it. **/
     void detach() { // can throw during clone()
-        if (use_count() > 1) 
-        {   decr(); p=p->clone(); count=new long(1); }
+        if (use_count() > 1) {
+            // Don't let go of the shared object until we have our own copy;
+            // another sharer in another thread may be detaching too and 
+            // could otherwise decide it was the last user and write on it
+            // while we're still cloning.
+            std::unique_ptr<T> copy(p->clone());
+            std::atomic<long>* newCount = new std::atomic<long>(1);
+            if (decr()==0) {delete p; delete count;} // others went away
+            p=copy.release(); count=newCount;
+        }
     }
     /**@}**/
      
@@ -361,8 +372,8 @@ template <class U> friend class CloneOnWritePtr;
     void init() noexcept {p=nullptr; count=nullptr;}
 
     // Can't use std::shared_ptr here due to lack of release() method.
-    T*      p;          // this may be null
-    long*   count;      // if p is null so is count
+    T*                  p;      // this may be null
+    std::atomic<long>*  count;  // if p is null so is count
 };    
 
 
@@ -56,10 +56,26 @@ class ParallelExecutorImpl;
  * any assumptions about what order they will occur in or which ones will
  * happen at the same time.
  * 
- * The threads are created in the ParallelExecutor's constructor and remain
- * active until it is deleted. This means that creating a ParallelExecutor is a
- * somewhat expensive operation, but it may then be used repeatedly for
- * executing various calculations.  By default, the number of threads is chosen
+ * The thread calling execute() takes part in the work, so at most
+ * maxThreads-1 additional worker threads are created. They are created the
+ * first time execute() is called and remain active until the ParallelExecutor
+ * is deleted. This means that the first execution is somewhat expensive, but
+ * the ParallelExecutor may then be used repeatedly for executing various
+ * calculations. The indices are divided into contiguous ranges, one per
+ * thread, and a thread that runs out of work steals half of the remaining
+ * range of another thread, so uneven workloads are balanced without any
+ * locking. Between calls, idle workers spin briefly before going to sleep so
+ * that a rapid series of small executions doesn't pay for waking them up each
+ * time.
+ *
+ * If execute() is called while the ParallelExecutor is already executing a
+ * Task (for example, from inside a Task it is running), the nested call runs
+ * the new Task serially on the calling thread rather than deadlocking. While
+ * the calling thread runs its share of a Task, isWorkerThread() returns true
+ * on that thread just as it does on the worker threads; code that checks it
+ * to avoid nested parallelism therefore behaves the same on every thread.
+ *
+ * By default, the number of threads is chosen
  * to be equal to the number of available processor cores.  You can optionally
  * specify a different number of threads to create.  For example, using more
  * threads than processors can sometimes lead to better processor
@@ -119,6 +135,12 @@ public:
     /**
      * Execute a parallel task.
      * 
+     * If the Task throws an exception on the thread that called execute(),
+     * execute() rethrows it once all the threads have finished, as it would
+     * if the Task had been run serially. Exceptions thrown on the worker
+     * threads have nowhere to go; they are reported on std::cerr and the
+     * indices that thread was working on are skipped.
+     *
      * @param task    the Task to execute
      * @param times   the number of times the Task should be executed
      */
@@ -130,8 +152,16 @@ public:
      */
     static int getNumProcessors();
     /**
-     * Determine whether the thread invoking this method is a worker thread
-     * created by ParallelExecutor.
+     * Determine whether the thread invoking this method is taking part in a
+     * parallel execution. This is always true on a worker thread created by
+     * ParallelExecutor. It is also true on the thread that called execute()
+     * while that thread runs its own share of a Task in parallel with the
+     * workers, and false again once execute() returns. When execute() runs
+     * a Task serially instead (a single-thread executor, or one that is
+     * already busy with another Task), it doesn't change the result on the
+     * calling thread. Code inside a Task can therefore check this to avoid
+     * starting a parallel computation of its own from any of the threads
+     * running it.
      */
     static bool isWorkerThread();
     /**
@@ -75,7 +75,9 @@ public:
     explicit ParallelWorkQueue(int queueSize, int numThreads = ParallelExecutor::getNumProcessors());
     /**
      * Add a Task to the queue.  If the queue is currently full, this method will block until space is freed up in
-     * the queue by the worker threads.  The queue assumes ownership of the Task object and deletes it once it has
+     * the queue by the worker threads.  The exception is when this is called from a Task running on one of this
+     * queue's own worker threads: a full queue then causes the new Task to be executed immediately on the calling
+     * thread, since blocking could deadlock.  The queue assumes ownership of the Task object and deletes it once it has
      * finished executing.
      *
      * @param task      the Task to add to the queue
@@ -33,9 +33,9 @@ using namespace std;
 
 namespace SimTK {
 
-static void threadBody(ThreadInfo& info);
-
-ParallelExecutorImpl::ParallelExecutorImpl() : finished(false) {
+ParallelExecutorImpl::ParallelExecutorImpl() 
+:   currentTask(nullptr), busy(false), finished(false), generation(0),
+    numUnfinished(0) {
 
     //By default, we use the total number of processors available of the
     //computer (including hyperthreads)
@@ -43,7 +43,9 @@ ParallelExecutorImpl::ParallelExecutorImpl() : finished(false) {
     if(numMaxThreads <= 0)
       numMaxThreads = 1;
 }
-ParallelExecutorImpl::ParallelExecutorImpl(int numThreads) : finished(false) {
+ParallelExecutorImpl::ParallelExecutorImpl(int numThreads) 
+:   currentTask(nullptr), busy(false), finished(false), generation(0),
+    numUnfinished(0) {
 
     // Set the maximum number of threads that we can use
     SimTK_APIARGCHECK_ALWAYS(numThreads > 0, "ParallelExecutorImpl",
@@ -52,28 +54,34 @@ ParallelExecutorImpl::ParallelExecutorImpl(int numThreads) : finished(false) {
 }
 ParallelExecutorImpl::~ParallelExecutorImpl() {
     
-    // Notify the threads that they should exit.
+    // Notify the threads that they should exit, then wait until they have.
     
-    std::unique_lock<std::mutex> lock(runMutex);
     finished = true;
-    for (int i = 0; i < (int) threads.size(); ++i)
-        threadInfo[i].running = true;
-    runCondition.notify_all();
-    lock.unlock();
-    
-    // Wait until all the threads have finished.
-    
+    ++generation;
+    workerWait.notifyAll();
     for (int i = 0; i < (int) threads.size(); ++i)
         threads[i].join();
 }
 ParallelExecutorImpl* ParallelExecutorImpl::clone() const {
     return new ParallelExecutorImpl(numMaxThreads);
 }
+void ParallelExecutorImpl::startThreads() {
+    // The calling thread always participates as slot 0, so we need one fewer
+    // worker than the number of threads we're allowed to use. We do not
+    // support numMaxThreads changing for a given instance of ParallelExecutor.
+    ranges.reset(new IndexRange[numMaxThreads]);
+    threads.resize(numMaxThreads-1);
+    for (int i = 1; i < numMaxThreads; ++i)
+        threads[i-1] = std::thread(&ParallelExecutorImpl::workerBody, this, i);
+}
 void ParallelExecutorImpl::execute(ParallelExecutor::Task& task, int times) {
-  if (numMaxThreads < 2) {
+  bool wasIdle = false;
+  if (numMaxThreads < 2 || !busy.compare_exchange_strong(wasIdle, true)) {
       //(1) NON-PARALLEL CASE:
       // Nothing is actually going to get done in parallel, so we might as well
-      // just execute the task directly and save the threading overhead.
+      // just execute the task directly and save the threading overhead. We
+      // also get here for a nested call made from within a Task that this
+      // executor is already running; the outer call has all the threads.
       task.initialize();
       for (int i = 0; i < times; ++i)
           task.execute(i);
@@ -83,40 +91,113 @@ void ParallelExecutorImpl::execute(ParallelExecutor::Task& task, int times) {
     
     //(2) PARALLEL CASE:
     // We launch the maximum number of threads and save them for later use
-    if(threads.size() < (size_t)numMaxThreads)
-    {
-      // We do not support numMaxThreads changing for a given instance of
-      // ParallelExecutor.
-      assert(threads.size() == 0);
-      threadInfo.reserve(numMaxThreads);
-      threads.resize(numMaxThreads);
-      for (int i = 0; i < numMaxThreads; ++i) {
-          threadInfo.emplace_back(i, this);
-          threads[i] = std::thread(threadBody, std::ref(threadInfo[i]));
-      }
-    }
-   
-    // Initialize fields to execute the new task.
-    std::unique_lock<std::mutex> lock(runMutex);
+    if (!ranges)
+        startThreads();
+
+    // Give each thread an equal contiguous share of the indices; threads
+    // that finish early will steal from the others.
+    const std::uint64_t n = times > 0 ? times : 0;
+    for (int i = 0; i < numMaxThreads; ++i)
+        ranges[i].bounds.store(pack(std::uint32_t(n*i/numMaxThreads),
+                                    std::uint32_t(n*(i+1)/numMaxThreads)),
+                               std::memory_order_relaxed);
     currentTask = &task;
-    currentTaskCount = times;
-    waitingThreadCount = 0;
-    for (int i = 0; i < (int)threadInfo.size(); ++i) {
-        threadInfo[i].running = true;
+    numUnfinished = numMaxThreads;
+
+    // Wake up the worker threads, do our share, and wait until they finish.
+    ++generation;
+    workerWait.notifyAll();
+
+    const bool callerWasWorker = isWorker;
+    std::exception_ptr callerError;
+    isWorker = true;
+    runTask(0, &callerError);
+    isWorker = callerWasWorker;
+
+    callerWait.wait([this] { return numUnfinished.load() == 0; });
+    currentTask = nullptr;
+    busy = false;
+
+    // An exception thrown by our own share goes back to our caller, just as
+    // it would have if the Task had been run serially.
+    if (callerError)
+        std::rethrow_exception(callerError);
+}
+
+// Take the next index from the front of our own range.
+bool ParallelExecutorImpl::takeIndex(int slot, int& index) {
+    std::atomic<std::uint64_t>& bounds = ranges[slot].bounds;
+    std::uint64_t r = bounds.load(std::memory_order_acquire);
+    while (beginOf(r) < endOf(r)) {
+        if (bounds.compare_exchange_weak(r, pack(beginOf(r)+1, endOf(r)),
+                                         std::memory_order_acq_rel)) {
+            index = (int)beginOf(r);
+            return true;
+        }
     }
+    return false;
+}
 
-    // Wake up the worker threads and wait until they finish.
-    runCondition.notify_all();
-    waitCondition.wait(lock,
-        [&] { return waitingThreadCount == (int)threads.size(); });
-    lock.unlock();
-}
-void ParallelExecutorImpl::incrementWaitingThreads() {
-    std::lock_guard<std::mutex> lock(runMutex);
-    getCurrentTask().finish();
-    waitingThreadCount++;
-    if (waitingThreadCount == (int)threads.size()) {
-        waitCondition.notify_one();
+// Our own range is empty; look for another thread with work left and move
+// the back half of its range into ours. Only the owner ever stores into an
+// empty range, and thieves only modify nonempty ones, so the plain store is
+// safe. Returns false if there was nothing left to steal.
+bool ParallelExecutorImpl::stealRange(int thief) {
+    for (int k = 1; k < numMaxThreads; ++k) {
+        std::atomic<std::uint64_t>& victim = 
+            ranges[(thief+k) % numMaxThreads].bounds;
+        std::uint64_t r = victim.load(std::memory_order_acquire);
+        while (beginOf(r) < endOf(r)) {
+            const std::uint32_t begin = beginOf(r), end = endOf(r);
+            const std::uint32_t split = end - (end-begin+1)/2;
+            if (victim.compare_exchange_weak(r, pack(begin, split),
+                                             std::memory_order_acq_rel)) {
+                ranges[thief].bounds.store(pack(split, end),
+                                           std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Execute the current task for all the indices we can get, then report that
+// this thread is done. If error is given, an exception thrown by the task is
+// saved there; otherwise it is reported on cerr.
+void ParallelExecutorImpl::runTask(int slot, std::exception_ptr* error) {
+    ParallelExecutor::Task& task = *currentTask;
+    try {
+        task.initialize();
+        int index;
+        do {
+            while (takeIndex(slot, index))
+                task.execute(index);
+        } while (stealRange(slot));
+    }
+    catch (...) {
+        if (error) *error = std::current_exception();
+        else reportException();
+    }
+    {
+        std::lock_guard<std::mutex> lock(finishMutex);
+        task.finish();
+    }
+    if (--numUnfinished == 0)
+        callerWait.notifyAll();
+}
+
+// Report an exception that escaped from a Task on a worker thread, which has
+// nobody to throw it to. Must be called from inside a catch block.
+void ParallelExecutorImpl::reportException() {
+    try {
+        throw;
+    }
+    catch (const std::exception& ex) {
+        std::cerr <<"The parallel task threw an unhandled exception:"<< std::endl;
+        std::cerr <<ex.what()<< std::endl;
+    }
+    catch (...) {
+        std::cerr <<"The parallel task threw an error."<< std::endl;
     }
 }
 
@@ -126,42 +207,18 @@ thread_local bool ParallelExecutorImpl::isWorker(false);
  * This function contains the code executed by the worker threads.
  */
 
-void threadBody(ThreadInfo& info) {
-    ParallelExecutorImpl::isWorker = true;
-    ParallelExecutorImpl& executor = *info.executor;
-    int threadCount = executor.getThreadCount();
-    while (!executor.isFinished()) {
+void ParallelExecutorImpl::workerBody(int slot) {
+    isWorker = true;
+    unsigned seen = 0;
+    while (true) {
         
         // Wait for a Task to come in.
         
-        std::unique_lock<std::mutex> lock(executor.getMutex());
-        executor.getCondition().wait(lock, [&] { return info.running; });
-        lock.unlock();
-        if (!executor.isFinished()) {
-            
-            // Execute the task for all the indices belonging to this thread.
-            
-            int count = executor.getCurrentTaskCount();
-            ParallelExecutor::Task& task = executor.getCurrentTask();
-            task.initialize();
-            int index = info.index;
-                        
-            try {
-                while (index < count) {
-                    task.execute(index);
-                    index += threadCount;
-                }
-            }
-            catch (const std::exception& ex) {
-                std::cerr <<"The parallel task threw an unhandled exception:"<< std::endl;
-                std::cerr <<ex.what()<< std::endl;
-            }
-            catch (...) {
-                std::cerr <<"The parallel task threw an error."<< std::endl;
-            }
-            info.running = false;
-            executor.incrementWaitingThreads();
-        }
+        workerWait.wait([&] { return generation.load() != seen; });
+        seen = generation.load();
+        if (finished)
+            return;
+        runTask(slot);
     }
 }
 
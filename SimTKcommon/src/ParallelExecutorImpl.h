@@ -26,31 +26,33 @@
 
 #include "SimTKcommon/internal/ParallelExecutor.h"
 #include "SimTKcommon/internal/Array.h"
+#include "SpinThenPark.h"
 
 #include <iostream>
 #include <thread>
 #include <mutex>
-#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <exception>
 
 namespace SimTK {
 
-class ParallelExecutorImpl;
-
-/**
- * This class stores per-thread information used while executing a task.
- */
-
-class ThreadInfo {
-public:
-    ThreadInfo(int index, ParallelExecutorImpl* executor) : index(index), executor(executor), running(false) {
-    }
-    const int index;
-    ParallelExecutorImpl* const executor;
-    bool running;
-};
-
 /**
  * This is the internal implementation class for ParallelExecutor.
+ *
+ * Each call to execute() divides the indices 0..times-1 into one contiguous
+ * range per participating thread. Every range is a lock-free deque of
+ * indices packed into a single atomic word: the owning thread takes indices
+ * from the front and a thread that has run out of work steals the back half
+ * of some other thread's range. The calling thread takes part as one of the
+ * maxThreads participants, so only maxThreads-1 worker threads are created.
+ *
+ * Idle workers spin briefly before parking (see SpinThenPark), so back-to-back
+ * calls at a high rate don't pay for a kernel wakeup each time. A call to
+ * execute() made while this executor is already running a Task (that is, a
+ * nested call from inside a Task, or a concurrent call from another thread)
+ * executes its Task serially in the calling thread.
  */
 
 class ParallelExecutorImpl : public PIMPLImplementation<ParallelExecutor, ParallelExecutorImpl> {
@@ -60,39 +62,41 @@ public:
     ~ParallelExecutorImpl();
     ParallelExecutorImpl* clone() const;
     void execute(ParallelExecutor::Task& task, int times);
-    int getThreadCount() {
-        return threads.size();
-    }
-    ParallelExecutor::Task& getCurrentTask() {
-        return *currentTask;
-    }
-    int getCurrentTaskCount() {
-        return currentTaskCount;
-    }
-    bool isFinished() {
-        return finished;
-    }
-    std::mutex& getMutex() {
-        return runMutex;
-    }
-    std::condition_variable& getCondition() {
-        return runCondition;
-    }
     int getMaxThreads() const{
       return numMaxThreads;
     }
-    void incrementWaitingThreads();
     static thread_local bool isWorker;
 private:
-    bool finished;
-    std::mutex runMutex;
-    std::condition_variable runCondition, waitCondition;
+    // A range of task indices [begin,end) packed into one atomic word so that
+    // owners and thieves can update it with a single compare-and-swap. Each
+    // range is on its own cache line to avoid false sharing.
+    struct alignas(64) IndexRange {
+        std::atomic<std::uint64_t> bounds{0};
+    };
+    static std::uint64_t pack(std::uint32_t begin, std::uint32_t end) {
+        return (std::uint64_t(end) << 32) | begin;
+    }
+    static std::uint32_t beginOf(std::uint64_t r) {return std::uint32_t(r);}
+    static std::uint32_t endOf(std::uint64_t r) {return std::uint32_t(r>>32);}
+
+    void startThreads();
+    void workerBody(int slot);
+    void runTask(int slot, std::exception_ptr* error = nullptr);
+    static void reportException();
+    bool takeIndex(int slot, int& index);
+    bool stealRange(int thief);
+
+    int numMaxThreads;
     Array_<std::thread> threads;
-    Array_<ThreadInfo> threadInfo;
+    std::unique_ptr<IndexRange[]> ranges;
+
     ParallelExecutor::Task* currentTask;
-    int currentTaskCount;
-    int waitingThreadCount;
-    int numMaxThreads;
+    std::atomic<bool> busy;
+    std::atomic<bool> finished;
+    std::atomic<unsigned> generation;
+    std::atomic<int> numUnfinished;
+    std::mutex finishMutex;
+    SpinThenPark workerWait, callerWait;
 };
 
 } // namespace SimTK
@@ -23,60 +23,37 @@
 
 #include "ParallelWorkQueueImpl.h"
 #include "SimTKcommon/internal/ParallelExecutor.h"
-#include <utility>
-#include <mutex>
-#include <condition_variable>
-
-using std::queue;
+#include <algorithm>
 
 namespace SimTK {
 
-static void threadBody(ParallelWorkQueueImpl& owner) {
-    queue<ParallelWorkQueue::Task*>& taskQueue = owner.updTaskQueue();
-    std::mutex& queueMutex = owner.getQueueMutex();
-    std::condition_variable& waitForTaskCondition = owner.getWaitCondition();
-    std::condition_variable& queueFullCondition = owner.getQueueFullCondition();
-    bool decrementTaskCount = false;
-    while (!owner.isFinished() || !taskQueue.empty()) {
-        std::unique_lock<std::mutex> lock(queueMutex);
-        if (decrementTaskCount) {
-            owner.markTaskCompleted();
-            decrementTaskCount = false;
-        }
-        waitForTaskCondition.wait(lock,
-                [&] { return !taskQueue.empty() || owner.isFinished(); });
-        ParallelWorkQueue::Task* task = NULL;
-        if (!taskQueue.empty()) {
-            task = taskQueue.front();
-            taskQueue.pop();
-        }
-        queueFullCondition.notify_one();
-        lock.unlock();
-        if (task != NULL) {
-            task->execute();
-            delete task;
-            decrementTaskCount = true;
-        }
-    }
-    if (decrementTaskCount) {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        owner.markTaskCompleted();
-    }
+// The queue whose worker is running on this thread, if any.
+static thread_local const ParallelWorkQueueImpl* currentQueue = nullptr;
+
+static std::size_t ringCapacity(int queueSize) {
+    std::size_t capacity = 1;
+    while (capacity < (std::size_t) std::max(queueSize, 1))
+        capacity *= 2;
+    return capacity;
 }
 
-ParallelWorkQueueImpl::ParallelWorkQueueImpl(int queueSize, int numThreads) : queueSize(queueSize), pendingTasks(0), finished(false) {
+ParallelWorkQueueImpl::ParallelWorkQueueImpl(int queueSize, int numThreads) 
+:   queueSize(queueSize), mask(ringCapacity(queueSize)-1),
+    cells(new Cell[mask+1]), enqueuePos(0), dequeuePos(0),
+    freeSlots(std::max(queueSize, 1)), pendingTasks(0), finished(false) {
+    for (std::size_t i = 0; i <= mask; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+        cells[i].task = nullptr;
+    }
     threads.resize(numThreads);
     for (int i = 0; i < numThreads; ++i)
-        threads[i] = std::thread(threadBody, std::ref(*this));
+        threads[i] = std::thread(&ParallelWorkQueueImpl::workerBody, this);
 }
 
 ParallelWorkQueueImpl::~ParallelWorkQueueImpl() {
-    // Wait for the theads to finish.
-
-    std::unique_lock<std::mutex> lock(queueMutex);
+    // The workers drain any remaining tasks before they exit.
     finished = true;
-    waitForTaskCondition.notify_all();
-    lock.unlock();
+    taskWait.notifyAll();
     for (int i = 0; i < (int) threads.size(); ++i)
         threads[i].join();
 }
@@ -85,45 +62,95 @@ ParallelWorkQueueImpl* ParallelWorkQueueImpl::clone() const {
     return new ParallelWorkQueueImpl(queueSize, threads.size());
 }
 
-void ParallelWorkQueueImpl::addTask(ParallelWorkQueue::Task* task) {
-    std::unique_lock<std::mutex> lock(queueMutex);
-    queueFullCondition.wait(lock,
-            [this] { return (int)taskQueue.size() < queueSize; });
-    taskQueue.push(task);
-    ++pendingTasks;
-    waitForTaskCondition.notify_one();
-    lock.unlock();
+bool ParallelWorkQueueImpl::tryReserveSlot() {
+    int free = freeSlots.load(std::memory_order_relaxed);
+    while (free > 0)
+        if (freeSlots.compare_exchange_weak(free, free-1))
+            return true;
+    return false;
 }
 
-void ParallelWorkQueueImpl::flush() {
-    std::unique_lock<std::mutex> lock(queueMutex);
-    queueFullCondition.wait(lock, [this] { return pendingTasks == 0; });
-    lock.unlock();
-}
-
-queue<ParallelWorkQueue::Task*>& ParallelWorkQueueImpl::updTaskQueue() {
-    return taskQueue;
+// The caller must have reserved a slot, so the ring can't be full and this
+// only waits for a consumer that is still in the middle of releasing a cell.
+void ParallelWorkQueueImpl::push(ParallelWorkQueue::Task* task) {
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells[pos & mask];
+        const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t dif = (std::ptrdiff_t) seq - (std::ptrdiff_t) pos;
+        if (dif == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos+1,
+                                                 std::memory_order_relaxed)) {
+                cell.task = task;
+                cell.sequence.store(pos+1, std::memory_order_release);
+                return;
+            }
+        }
+        else if (dif < 0) {
+            SpinThenPark::cpuRelax();
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+        else
+            pos = enqueuePos.load(std::memory_order_relaxed);
+    }
 }
 
-bool ParallelWorkQueueImpl::isFinished() const {
-    return finished;
+bool ParallelWorkQueueImpl::tryPop(ParallelWorkQueue::Task*& task) {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells[pos & mask];
+        const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t dif = (std::ptrdiff_t) seq - (std::ptrdiff_t)(pos+1);
+        if (dif == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos+1,
+                                                 std::memory_order_relaxed)) {
+                task = cell.task;
+                cell.sequence.store(pos+mask+1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (dif < 0)
+            return false; // empty
+        else
+            pos = dequeuePos.load(std::memory_order_relaxed);
+    }
 }
 
-std::mutex& ParallelWorkQueueImpl::getQueueMutex() {
-    return queueMutex;
+void ParallelWorkQueueImpl::runTask(ParallelWorkQueue::Task* task) {
+    task->execute();
+    delete task;
+    if (--pendingTasks == 0)
+        doneWait.notifyAll();
 }
 
-std::condition_variable& ParallelWorkQueueImpl::getWaitCondition() {
-    return waitForTaskCondition;
+void ParallelWorkQueueImpl::workerBody() {
+    currentQueue = this;
+    while (true) {
+        ParallelWorkQueue::Task* task = nullptr;
+        taskWait.wait([&] { return tryPop(task) || finished.load(); });
+        if (task == nullptr)
+            return; // finished and the queue is empty
+        ++freeSlots;
+        doneWait.notifyAll();
+        runTask(task);
+    }
 }
 
-std::condition_variable& ParallelWorkQueueImpl::getQueueFullCondition() {
-    return queueFullCondition;
+void ParallelWorkQueueImpl::addTask(ParallelWorkQueue::Task* task) {
+    ++pendingTasks;
+    if (!tryReserveSlot()) {
+        if (currentQueue == this) {
+            runTask(task);
+            return;
+        }
+        doneWait.wait([this] { return tryReserveSlot(); });
+    }
+    push(task);
+    taskWait.notifyOne();
 }
 
-void ParallelWorkQueueImpl::markTaskCompleted() {
-    --pendingTasks;
-    queueFullCondition.notify_one();
+void ParallelWorkQueueImpl::flush() {
+    doneWait.wait([this] { return pendingTasks.load() == 0; });
 }
 
 ParallelWorkQueue::ParallelWorkQueue(int queueSize, int numThreads) : HandleBase(new ParallelWorkQueueImpl(queueSize, numThreads)) {
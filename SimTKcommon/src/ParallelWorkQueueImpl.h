@@ -26,39 +26,59 @@
 
 #include "SimTKcommon/internal/ParallelWorkQueue.h"
 #include "SimTKcommon/internal/Array.h"
-#include <queue>
-#include <mutex>
-#include <condition_variable>
+#include "SpinThenPark.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
 
 namespace SimTK {
 
-class ParallelExecutor;
-
 /**
  * This is the internal implementation class for ParallelWorkQueue.
+ *
+ * Tasks are passed to the worker threads through a bounded lock-free ring
+ * buffer that supports multiple producers and multiple consumers. Each cell
+ * carries a sequence number that tells producers and consumers whether it is
+ * ready for them, so neither side ever takes a lock on the fast path. The ring
+ * capacity is rounded up to a power of two; the queueSize limit requested by
+ * the user is enforced separately by a count of free slots that producers
+ * reserve before pushing. Idle workers, blocked producers and flush() all wait
+ * with a SpinThenPark.
+ *
+ * If a task running on one of this queue's own worker threads calls addTask()
+ * while the queue is full, the new task is executed immediately on that thread
+ * instead of blocking, since blocking could deadlock when every worker is
+ * doing the same.
  */
 
 class ParallelWorkQueueImpl : public PIMPLImplementation<ParallelWorkQueue, ParallelWorkQueueImpl> {
 public:
-    class ExecutorTask;
     ParallelWorkQueueImpl(int queueSize, int numThreads);
     ~ParallelWorkQueueImpl();
     ParallelWorkQueueImpl* clone() const;
     void addTask(ParallelWorkQueue::Task* task);
     void flush();
-    std::queue<ParallelWorkQueue::Task*>& updTaskQueue();
-    bool isFinished() const;
-    std::mutex& getQueueMutex();
-    std::condition_variable& getWaitCondition();
-    std::condition_variable& getQueueFullCondition();
-    void markTaskCompleted();
 private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        ParallelWorkQueue::Task* task;
+    };
+    bool tryReserveSlot();
+    void push(ParallelWorkQueue::Task* task);
+    bool tryPop(ParallelWorkQueue::Task*& task);
+    void runTask(ParallelWorkQueue::Task* task);
+    void workerBody();
+
     const int queueSize;
-    int pendingTasks;
-    bool finished;
-    std::queue<ParallelWorkQueue::Task*> taskQueue;
-    std::mutex queueMutex;
-    std::condition_variable waitForTaskCondition, queueFullCondition;
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<std::size_t> enqueuePos;
+    alignas(64) std::atomic<std::size_t> dequeuePos;
+    alignas(64) std::atomic<int> freeSlots;
+    std::atomic<int> pendingTasks;
+    std::atomic<bool> finished;
+    SpinThenPark taskWait, doneWait;
     SimTK::Array_<std::thread> threads;
 };
 
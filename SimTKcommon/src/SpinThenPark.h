@@ -0,0 +1,118 @@
+#ifndef SimTK_SimTKCOMMON_SPIN_THEN_PARK_H_
+#define SimTK_SimTKCOMMON_SPIN_THEN_PARK_H_
+
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+#endif
+
+namespace SimTK {
+
+/**
+ * This is a waiting strategy shared by the thread pools. A thread waiting for
+ * a condition first spins briefly, re-checking the condition, so that it can
+ * react within a few hundred nanoseconds when work arrives at a high rate.
+ * If nothing happens it then yields for a while and finally parks on a
+ * condition variable so that idle threads don't burn a processor.
+ *
+ * The condition must be expressed entirely with atomic variables. Whoever
+ * makes the condition true must call notifyAll() afterwards; that is cheap
+ * when no thread is parked, since it checks an atomic counter before touching
+ * the mutex.
+ */
+class SpinThenPark {
+public:
+    SpinThenPark() : numParked(0) {}
+
+    /** Block until pred() returns true. **/
+    template <class Pred>
+    void wait(Pred pred) {
+        for (int i = 0; i < NumSpins; ++i) {
+            if (pred())
+                return;
+            if (i < NumPauses)
+                cpuRelax();
+            else
+                std::this_thread::yield();
+        }
+
+        // The parked count is incremented before pred() is checked under the
+        // lock, and the notifier changes the condition before reading the
+        // count. The fences here and in notifyAll()/notifyOne() keep either
+        // side's store from being reordered after its load, even when the
+        // condition itself was stored with release or relaxed ordering, so
+        // at least one of the two sides sees the other and a wakeup can't
+        // be lost.
+        std::unique_lock<std::mutex> lock(mutex);
+        numParked.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        condition.wait(lock, pred);
+        numParked.fetch_sub(1);
+    }
+
+    /** Wake all parked threads so they re-check their conditions. **/
+    void notifyAll() {
+        std::atomic_thread_fence(std::memory_order_seq_cst); // see wait()
+        if (numParked.load() == 0)
+            return;
+        // Taking the lock ensures that a waiter which has checked pred() but
+        // not yet gone to sleep will see the notification.
+        { std::lock_guard<std::mutex> lock(mutex); }
+        condition.notify_all();
+    }
+
+    /** Wake one parked thread, if there are any. Use this only when any one
+    of the waiting threads can make use of the change. **/
+    void notifyOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst); // see wait()
+        if (numParked.load() == 0)
+            return;
+        { std::lock_guard<std::mutex> lock(mutex); }
+        condition.notify_one();
+    }
+
+    static void cpuRelax() {
+    #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        _mm_pause();
+    #endif
+    }
+
+private:
+    static const int NumPauses = 1000;
+    static const int NumSpins  = 1100;
+
+    std::atomic<int>        numParked;
+    std::mutex              mutex;
+    std::condition_variable condition;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SimTKCOMMON_SPIN_THEN_PARK_H_
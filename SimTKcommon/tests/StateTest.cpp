@@ -28,6 +28,7 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
 #include <exception>
 #include <cmath>
 using std::cout;
@@ -352,6 +353,53 @@ void testCacheValidity() {
 
 }
 
+// Copying a State shares discrete variable and cache entry values with the
+// source until one of them writes on a value; after that the two States must
+// be completely independent.
+void testCopyOnWrite() {
+    const SubsystemIndex Sub0(0);
+    std::unique_ptr<State> src(new State());
+    State& s = *src;
+    s.setNumSubsystems(1);
+    const DiscreteVariableIndex dvx =
+        s.allocateDiscreteVariable(Sub0, Stage::Position, new Value<int>(31));
+    const CacheEntryIndex cx = s.allocateCacheEntry(Sub0,
+        Stage::Model, Stage::Infinity, new Value<Vector>(Vector(5, Real(2))));
+    advanceStage(s, Stage::Topology);
+    advanceStage(s, Stage::Model);
+    Value<Vector>::updDowncast(s.updCacheEntry(Sub0, cx)).upd()[0] = 7;
+    s.markCacheValueRealized(Sub0, cx);
+
+    State copy(s);
+    SimTK_TEST(copy.getSystemStage() == Stage::Model);
+    SimTK_TEST(&copy.getDiscreteVariable(Sub0, dvx) 
+               == &s.getDiscreteVariable(Sub0, dvx));
+    SimTK_TEST(&copy.getCacheEntry(Sub0, cx) == &s.getCacheEntry(Sub0, cx));
+
+    // Writing on the copy's variable leaves the source alone.
+    Value<int>::updDowncast(copy.updDiscreteVariable(Sub0, dvx)) = 12;
+    SimTK_TEST(Value<int>::downcast(s.getDiscreteVariable(Sub0, dvx)) == 31);
+    SimTK_TEST(Value<int>::downcast(copy.getDiscreteVariable(Sub0, dvx))==12);
+
+    // Writing on the source's cache entry leaves the copy alone.
+    Value<Vector>::updDowncast(s.updCacheEntry(Sub0, cx)).upd()[0] = -1;
+    const Vector& copyCache =
+        Value<Vector>::downcast(copy.getCacheEntry(Sub0, cx)).get();
+    SimTK_TEST(copyCache[0] == 7);
+    SimTK_TEST(Value<Vector>::downcast(s.getCacheEntry(Sub0, cx)).get()[0]
+               == -1);
+
+    // A copy of a copy stays good after the States it came from are gone.
+    State copy2 = copy;
+    copy = State();
+    src.reset();
+    SimTK_TEST(Value<int>::downcast(copy2.getDiscreteVariable(Sub0, dvx))==12);
+    SimTK_TEST(Value<Vector>::downcast(copy2.getCacheEntry(Sub0, cx)).get()[0]
+               == 7);
+    Value<int>::updDowncast(copy2.updDiscreteVariable(Sub0, dvx)) = 13;
+    SimTK_TEST(Value<int>::downcast(copy2.getDiscreteVariable(Sub0, dvx))==13);
+}
+
 void testMisc() {
     State s;
     s.setNumSubsystems(1);
@@ -537,5 +585,6 @@ int main() {
         SimTK_SUBTEST(testCacheValidity);
         SimTK_SUBTEST(testMisc);
         SimTK_SUBTEST(testConsistent);
+        SimTK_SUBTEST(testCopyOnWrite);
     SimTK_END_TEST();
 }
@@ -23,7 +23,11 @@
 
 #include "SimTKcommon.h"
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 #define ASSERT(cond) {SimTK_ASSERT_ALWAYS(cond, "Assertion failed");}
 
@@ -100,11 +104,137 @@ void testResizeThreads() {
         SimTK_TEST(executor.getMaxThreads() == x);
     }
 }
+// A Task that runs another Task on the same executor from inside execute().
+// The nested call must run serially rather than deadlock.
+class NestedTask : public ParallelExecutor::Task {
+public:
+    NestedTask(ParallelExecutor& executor, Array_<int>& flags, int numInner)
+    :   executor(executor), flags(flags), numInner(numInner) {}
+    void execute(int index) override {
+        InnerTask inner(flags, index*numInner);
+        executor.execute(inner, numInner);
+    }
+private:
+    class InnerTask : public ParallelExecutor::Task {
+    public:
+        InnerTask(Array_<int>& flags, int offset)
+        :   flags(flags), offset(offset) {}
+        void execute(int index) override {flags[offset+index]++;}
+    private:
+        Array_<int>& flags;
+        int offset;
+    };
+    ParallelExecutor& executor;
+    Array_<int>& flags;
+    int numInner;
+};
+
+void testNestedExecution() {
+    const int numOuter = 20, numInner = 50;
+    Array_<int> flags(numOuter*numInner, 0);
+    ParallelExecutor executor(4);
+    NestedTask task(executor, flags, numInner);
+    executor.execute(task, numOuter);
+    for (int j = 0; j < numOuter*numInner; ++j)
+        ASSERT(flags[j] == 1);
+}
+
+// Tasks whose cost varies a lot must still have every index executed exactly
+// once when idle threads steal work from busy ones.
+class UnevenTask : public ParallelExecutor::Task {
+public:
+    explicit UnevenTask(Array_<int>& flags) : flags(flags) {}
+    void execute(int index) override {
+        volatile double sum = 0;
+        const int work = (index % 7 == 0) ? 20000 : 10;
+        for (int i = 0; i < work; ++i)
+            sum = sum + std::sqrt(double(i));
+        flags[index]++;
+    }
+private:
+    Array_<int>& flags;
+};
+
+void testUnevenExecution() {
+    const int numFlags = 1000;
+    Array_<int> flags(numFlags);
+    ParallelExecutor executor(4);
+    for (int i = 0; i < 20; ++i) {
+        for (int j = 0; j < numFlags; ++j)
+            flags[j] = 0;
+        UnevenTask task(flags);
+        executor.execute(task, numFlags);
+        for (int j = 0; j < numFlags; ++j)
+            ASSERT(flags[j] == 1);
+    }
+}
+
+// Many tiny executions in a row, with pauses now and then long enough for
+// the workers to park, so that wakeups race with workers going to sleep. A
+// lost wakeup would hang here. Every thread running the Task, including the
+// one that called execute(), must report itself as a worker.
+class CountTask : public ParallelExecutor::Task {
+public:
+    explicit CountTask(std::atomic<int>& count) : count(count) {}
+    void execute(int) override {
+        ASSERT(ParallelExecutor::isWorkerThread());
+        ++count;
+    }
+private:
+    std::atomic<int>& count;
+};
+
+void testManySmallExecutions() {
+    ParallelExecutor executor(4);
+    std::atomic<int> count(0);
+    CountTask task(count);
+    const int numExecutions = 20000;
+    for (int i = 0; i < numExecutions; ++i) {
+        if (i % 2000 == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        executor.execute(task, 1 + i%4);
+    }
+    ASSERT(!ParallelExecutor::isWorkerThread());
+    ASSERT(count == 5*numExecutions/2);
+}
+
+// A Task that throws whenever it runs on the thread that called execute().
+// That exception must come back out of execute(), and the executor must
+// still work afterwards.
+class ThrowOnCallerTask : public ParallelExecutor::Task {
+public:
+    explicit ThrowOnCallerTask(std::thread::id caller) : caller(caller) {}
+    void execute(int) override {
+        if (std::this_thread::get_id() == caller)
+            throw std::runtime_error("caller share failed");
+    }
+private:
+    std::thread::id caller;
+};
+
+void testCallerException() {
+    ParallelExecutor executor(4);
+    ThrowOnCallerTask task(std::this_thread::get_id());
+    for (int i = 0; i < 10; ++i)
+        SimTK_TEST_MUST_THROW_EXC(executor.execute(task, 100),
+                                  std::runtime_error);
+    ASSERT(!ParallelExecutor::isWorkerThread());
+
+    std::atomic<int> count(0);
+    CountTask countTask(count);
+    executor.execute(countTask, 100);
+    ASSERT(count == 100);
+}
+
 int main() {
     SimTK_START_TEST("TestParallelExecutor");
         SimTK_SUBTEST(testParallelExecution);
         SimTK_SUBTEST(testSingleThreadedExecution);
         SimTK_SUBTEST(testResizeThreads);
+        SimTK_SUBTEST(testNestedExecution);
+        SimTK_SUBTEST(testUnevenExecution);
+        SimTK_SUBTEST(testManySmallExecutions);
+        SimTK_SUBTEST(testCallerException);
     SimTK_END_TEST();
     return 0;
 }
@@ -23,7 +23,9 @@
 
 #include "SimTKcommon.h"
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #define ASSERT(cond) {SimTK_ASSERT_ALWAYS(cond, "Assertion failed");}
 
@@ -56,9 +58,59 @@ void testParallelExecution() {
         ASSERT(flags[i] == (i < numFlags-10));
 }
 
+// A Task that adds more Tasks to the queue it is running on. With a tiny
+// queue this fills up, and the nested additions must not deadlock.
+class SpawnTask : public ParallelWorkQueue::Task {
+public:
+    SpawnTask(ParallelWorkQueue& queue, Array_<int>& flags, int first,
+              int numChildren)
+    :   queue(queue), flags(flags), first(first), numChildren(numChildren) {}
+    void execute() override {
+        for (int i = 0; i < numChildren; i++)
+            queue.addTask(new SetFlagTask(flags, first+i));
+    }
+private:
+    ParallelWorkQueue& queue;
+    Array_<int>& flags;
+    int first, numChildren;
+};
+
+void testNestedAddTask() {
+    const int numSpawners = 20, numChildren = 25;
+    Array_<int> flags(numSpawners*numChildren, false);
+    ParallelWorkQueue queue(2);
+    for (int i = 0; i < numSpawners; i++)
+        queue.addTask(new SpawnTask(queue, flags, i*numChildren, numChildren));
+    queue.flush();
+    for (int i = 0; i < numSpawners*numChildren; i++)
+        ASSERT(flags[i]);
+}
+
+// Many small batches, each flushed before the next is added, with pauses
+// now and then long enough for the workers to park. A lost wakeup would leave
+// a task in the queue with every worker asleep, and flush() would hang.
+void testManySmallBatches() {
+    const int numBatches = 5000, batchSize = 3;
+    Array_<int> flags(batchSize, false);
+    ParallelWorkQueue queue(8, 4);
+    for (int b = 0; b < numBatches; b++) {
+        if (b % 500 == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        for (int i = 0; i < batchSize; i++) {
+            flags[i] = false;
+            queue.addTask(new SetFlagTask(flags, i));
+        }
+        queue.flush();
+        for (int i = 0; i < batchSize; i++)
+            ASSERT(flags[i]);
+    }
+}
+
 int main() {
     try {
         testParallelExecution();
+        testNestedAddTask();
+        testManySmallBatches();
     } catch(const std::exception& e) {
         cout << "exception: " << e.what() << endl;
         return 1;
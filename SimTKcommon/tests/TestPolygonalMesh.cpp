@@ -23,8 +23,12 @@
 
 #include "SimTKcommon.h"
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <iterator>
+#include <string>
 #define ASSERT(cond) {SimTK_ASSERT_ALWAYS(cond, "Assertion failed");}
 
 using std::cout;
@@ -568,6 +572,130 @@ static void testLoadVtpNoNormalsNoTextureCoords() {
     ASSERT(!mesh.hasTextureCoordinates());
 }
 
+// Write a binary STL file containing the two triangles of a square, plus a 
+// third triangle whose shared vertices are off by much less than the merge
+// tolerance, then load it.
+static void testLoadBinaryStlFile() {
+    const float tri[3][4][3] = {
+        {{0,0,1}, {0,0,0}, {1,0,0}, {1,1,0}},
+        {{0,0,1}, {0,0,0}, {1,1,0}, {0,1,0}},
+        {{0,0,1}, {1,1e-9f,0}, {2,0,0}, {1,1,1e-9f}} };
+    {
+        std::ofstream ofs("square.stl", std::ios::binary);
+        const char header[80] = "solid but binary";
+        ofs.write(header, 80);
+        const std::uint32_t nFaces = 3;
+        ofs.write((const char*)&nFaces, sizeof(nFaces));
+        const std::uint16_t attribute = 0;
+        for (int f=0; f < 3; ++f) {
+            ofs.write((const char*)tri[f], sizeof(tri[f]));
+            ofs.write((const char*)&attribute, sizeof(attribute));
+        }
+    }
+
+    PolygonalMesh mesh;
+    mesh.loadFile("square.stl");
+    ASSERT(mesh.getNumFaces() == 3);
+    ASSERT(mesh.getNumVertices() == 5);
+    ASSERT(mesh.hasNormalsAtFaces());
+    ASSERT(mesh.getVertexPosition(mesh.getFaceVertex(1, 0)) == Vec3(0));
+    ASSERT(mesh.getFaceVertex(1, 1) == mesh.getFaceVertex(0, 2));
+    ASSERT(mesh.getFaceVertex(2, 0) == mesh.getFaceVertex(0, 1));
+    ASSERT(mesh.getFaceVertex(2, 2) == mesh.getFaceVertex(0, 2));
+    ASSERT(mesh.getVertexNormal(2, 1) == UnitVec3(ZAxis));
+
+    // A file with fewer triangles than its header claims is rejected.
+    {
+        std::ofstream ofs("truncated.stl", std::ios::binary);
+        const char header[80] = "binary";
+        ofs.write(header, 80);
+        const std::uint32_t nFaces = 3;
+        ofs.write((const char*)&nFaces, sizeof(nFaces));
+        ofs.write((const char*)tri[0], sizeof(tri[0]));
+    }
+    PolygonalMesh bad;
+    bool threw = false;
+    try {bad.loadStlFile("truncated.stl");} 
+    catch (const std::exception&) {threw = true;}
+    ASSERT(threw);
+}
+
+// Write a mesh with normals and texture coordinates to a binary mesh file 
+// and make sure it reads back exactly.
+static void testBinaryMeshFile() {
+    PolygonalMesh mesh = PolygonalMesh::createSphereMesh(1.5, 2);
+    PolygonalMesh withData;
+    for (int i=0; i < mesh.getNumVertices(); ++i) {
+        withData.addVertex(mesh.getVertexPosition(i));
+        withData.addNormal(UnitVec3(mesh.getVertexPosition(i)));
+        withData.addTextureCoordinate(Vec2(i, -i));
+    }
+    for (int f=0; f < mesh.getNumFaces(); ++f) {
+        Array_<int> v;
+        for (int k=0; k < mesh.getNumVerticesForFace(f); ++k)
+            v.push_back(mesh.getFaceVertex(f, k));
+        withData.addFaceWithNormals(v, v);
+        withData.addFaceTextureCoordinates(v);
+    }
+    withData.writeBinaryMeshFile("sphere.simtkmesh");
+
+    PolygonalMesh loaded;
+    loaded.addVertex(Vec3(9)); // should be replaced
+    loaded.loadFile("sphere.simtkmesh");
+    ASSERT(loaded.getNumVertices() == withData.getNumVertices());
+    ASSERT(loaded.getNumFaces() == withData.getNumFaces());
+    ASSERT(loaded.hasNormalsAtFaces() == withData.hasNormalsAtFaces());
+    ASSERT(loaded.hasTextureCoordinatesAtFaces() 
+           == withData.hasTextureCoordinatesAtFaces());
+    for (int i=0; i < loaded.getNumVertices(); ++i)
+        ASSERT(loaded.getVertexPosition(i) == withData.getVertexPosition(i));
+    for (int f=0; f < loaded.getNumFaces(); ++f) {
+        ASSERT(loaded.getNumVerticesForFace(f) 
+               == withData.getNumVerticesForFace(f));
+        for (int k=0; k < loaded.getNumVerticesForFace(f); ++k) {
+            ASSERT(loaded.getFaceVertex(f, k) == withData.getFaceVertex(f, k));
+            ASSERT(loaded.getVertexNormal(f, k) 
+                   == withData.getVertexNormal(f, k));
+            ASSERT(loaded.getVertexTextureCoordinate(f, k) 
+                   == withData.getVertexTextureCoordinate(f, k));
+        }
+    }
+
+    // An empty mesh round trips too.
+    PolygonalMesh().writeBinaryMeshFile("empty.simtkmesh");
+    loaded.loadBinaryMeshFile("empty.simtkmesh");
+    ASSERT(loaded.getNumVertices() == 0 && loaded.getNumFaces() == 0);
+
+    // Other files are rejected.
+    bool threw = false;
+    try {loaded.loadBinaryMeshFile("square.stl");} 
+    catch (const std::exception&) {threw = true;}
+    ASSERT(threw);
+
+    // So is a file whose faces use vertices it doesn't have. The first face
+    // vertex index follows the 52-byte header and the vertex positions.
+    PolygonalMesh triangle;
+    triangle.addVertex(Vec3(0)); 
+    triangle.addVertex(Vec3(1,0,0)); 
+    triangle.addVertex(Vec3(0,1,0));
+    Array_<int> v;
+    v.push_back(0); v.push_back(1); v.push_back(2);
+    triangle.addFace(v);
+    triangle.writeBinaryMeshFile("triangle.simtkmesh");
+    std::string bytes;
+    {   std::ifstream in("triangle.simtkmesh", std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), 
+                     std::istreambuf_iterator<char>()); }
+    const int badIndex = 3;
+    std::memcpy(&bytes[52 + 3*sizeof(Vec3)], &badIndex, sizeof(int));
+    {   std::ofstream out("badindex.simtkmesh", std::ios::binary);
+        out.write(bytes.data(), bytes.size()); }
+    threw = false;
+    try {loaded.loadBinaryMeshFile("badindex.simtkmesh");} 
+    catch (const std::exception&) {threw = true;}
+    ASSERT(threw);
+}
+
 int main() {
     try {
         testCreateMesh();
@@ -577,6 +705,8 @@ int main() {
         testLoadVtpFile();
         testLoadVtpFileNoNormals();
         testLoadVtpNoNormalsNoTextureCoords();
+        testLoadBinaryStlFile();
+        testBinaryMeshFile();
     } catch(const std::exception& e) {
         cout << "exception: " << e.what() << endl;
         return 1;
@@ -0,0 +1,83 @@
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace SimTK;
+
+/**
+ * This program measures the overhead of dispatching small jobs to the thread
+ * pools. For each thread count it reports the wall-clock time per call of
+ * ParallelExecutor::execute() with a trivial Task, which is dominated by
+ * waking the workers and waiting for them to finish, and the time per Task
+ * pushed through a ParallelWorkQueue followed by flush().
+ *
+ * Usage: ParallelExecutorLatency [maxThreads]
+ */
+
+class EmptyTask : public ParallelExecutor::Task {
+public:
+    void execute(int index) override {}
+};
+
+class EmptyQueueTask : public ParallelWorkQueue::Task {
+public:
+    void execute() override {}
+};
+
+static double timeExecute(int numThreads, int times) {
+    ParallelExecutor executor(numThreads);
+    EmptyTask task;
+    executor.execute(task, times); // start the threads
+    const int iterations = 20000;
+    const double start = realTime();
+    for (int i = 0; i < iterations; ++i)
+        executor.execute(task, times);
+    return (realTime() - start)*1e6/iterations;
+}
+
+static double timeWorkQueue(int numThreads) {
+    ParallelWorkQueue queue(64, numThreads);
+    const int numTasks = 200000;
+    const double start = realTime();
+    for (int i = 0; i < numTasks; ++i)
+        queue.addTask(new EmptyQueueTask());
+    queue.flush();
+    return (realTime() - start)*1e6/numTasks;
+}
+
+int main(int argc, char** argv) {
+    const int maxThreads = argc > 1 ? std::atoi(argv[1])
+                                    : ParallelExecutor::getNumProcessors();
+    std::printf("%8s %16s %16s %16s\n", "threads", "execute(1)",
+                "execute(1000)", "queue per task");
+    for (int n = 1; n <= maxThreads; n *= 2) {
+        std::printf("%8d %14.2fus %14.2fus %14.3fus\n", n,
+                    timeExecute(n, 1), timeExecute(n, 1000),
+                    timeWorkQueue(n));
+    }
+    return 0;
+}
@@ -36,6 +36,7 @@ individual contact shapes. **/
 
 #include <cassert>
 #include <functional>
+#include <vector>
 
 namespace SimTK {
 
@@ -712,6 +713,34 @@ void shootGeodesicInDirectionImplicitly(
     const std::function<void(const ContactGeometry::GeodesicKnotPoint&)>&
         geodesicKnotPointsSink) const;
 
+/** Same as above, but warm started from a previously computed geodesic that
+is expected to be similar to the new one, for example the geodesic shot from
+nearby initial conditions during the previous time step or solver iteration.
+Instead of searching for suitable step sizes, the integrator replays the steps
+between the knot points of the previous geodesic, scaled to the new
+\a finalArcLength. From the first replayed step that fails the accuracy
+requirement onward, the integrator controls the step size as usual, so the
+result is just as accurate as when shooting from scratch; it is only found
+with fewer steps when the two geodesics are alike.
+
+@param previousKnotArcLengths The arc lengths of the knot points of the
+previous geodesic, in increasing order and starting at zero, as reported in
+GeodesicKnotPoint::arcLength. If this is empty or the previous geodesic had
+zero length, no steps are replayed.
+
+See the method above for the other parameters. **/
+void shootGeodesicInDirectionImplicitly(
+    const Vec3& initialPointApprox,
+    const Vec3& initialTangentApprox,
+    Real finalArcLength,
+    Real initialIntegratorStepSize,
+    const std::vector<Real>& previousKnotArcLengths,
+    Real integratorAccuracy,
+    Real constraintTolerance,
+    int maxIterations,
+    const std::function<void(const ContactGeometry::GeodesicKnotPoint&)>&
+        geodesicKnotPointsSink) const;
+
 /** Given the current positions of two points P and Q moving on this surface, 
 and the previous geodesic curve G' connecting prior locations P' and Q' of
 those same two points, return the geodesic G between P and Q that is closest in
@@ -1384,11 +1413,24 @@ the TriangleMesh. Cost is 11 flops.
 @param uv      The point within the face, specified by its barycentric uv 
                coordinates. **/
 Vec3 findPoint(int face, const Vec2& uv) const;
-/** Calculate the location of a face's centroid, that is, the point uv=(1/3,1/3)
+/** Get the location of a face's centroid, that is, the point uv=(1/3,1/3)
 which is the average of the three vertex locations. This is a common special 
-case of findPoint() that can be calculated more quickly (7 flops).
+case of findPoint() that is calculated once when the mesh is created.
 @param face    The index of the face whose centroid is of interest. **/
 Vec3 findCentroid(int face) const;
+/** Get the outward normal vectors of all the faces, indexed by face. This 
+and the arrays returned by getFaceAreas() and getFaceCentroids() are 
+calculated when the mesh is created, with each quantity stored in its own 
+contiguous array. Code that works through many faces can use these to 
+stream through just the data it needs, rather than calling getFaceNormal(), 
+getFaceArea() or findCentroid() for each face. **/
+const Array_<UnitVec3>& getFaceNormals() const;
+/** Get the areas of all the faces, indexed by face. 
+@see getFaceNormals() **/
+const Array_<Real>& getFaceAreas() const;
+/** Get the centroids of all the faces, indexed by face. 
+@see getFaceNormals(), findCentroid() **/
+const Array_<Vec3>& getFaceCentroids() const;
 /** Calculate the normal vector at a point on the surface.
 @param face    The index of the face containing the point.
 @param uv      The point within the face, specified by its barycentric uv 
@@ -1461,6 +1503,77 @@ bool intersectsRay(const Vec3& origin, const UnitVec3& direction, Real& distance
 Box Tree. **/
 OBBTreeNode getOBBTreeNode() const;
 
+/** These are the ways the faces of an OBB tree node can be divided between 
+its two children when the tree is built. **/
+enum OBBTreeSplitRule {
+    /** Split at the median extent of the faces along a coordinate axis. This
+    is quick to build and is the default. **/
+    SplitAtMedian       = 0,
+    /** Choose the split that minimizes the surface area heuristic estimate of
+    query cost. This takes longer to build but gives faster queries for 
+    meshes whose triangles vary greatly in size or density. **/
+    SplitBySurfaceArea  = 1
+};
+
+/** Discard this mesh's OBB tree and build a new one using the given rule for
+splitting nodes. Any OBBTreeNode objects obtained earlier from this mesh are
+invalid afterwards. **/
+void rebuildOBBTree(OBBTreeSplitRule rule);
+/** Return the rule that was used to build this mesh's OBB tree. **/
+OBBTreeSplitRule getOBBTreeSplitRule() const;
+/** Return the total number of nodes in this mesh's OBB tree. The nodes are
+stored contiguously in depth-first order. **/
+int getNumOBBTreeNodes() const;
+
+/** The amount of heap memory, in bytes, used by each part of a TriangleMesh.
+This includes storage that has been allocated but not yet used. You can write
+one of these to a stream to get a readable report.
+@see calcMemoryUsage() **/
+struct MemoryUsage {
+    std::size_t vertices = 0; ///< Positions, normals and an edge for each.
+    std::size_t edges    = 0; ///< Vertices and faces of each edge.
+    std::size_t faces    = 0; ///< Vertices and edges of each face.
+    std::size_t faceData = 0; ///< Face normals, areas and centroids.
+    std::size_t obbTree  = 0; ///< OBB tree nodes and their triangle lists.
+    /** Return the total over all the parts. **/
+    std::size_t getTotal() const 
+    {   return vertices + edges + faces + faceData + obbTree; }
+};
+/** Calculate how much heap memory this mesh is using, part by part. **/
+MemoryUsage calcMemoryUsage() const;
+
+/** Write this mesh to a binary cache file, including everything that was
+calculated when it was created such as edges, normals and the OBB tree. 
+Reading the file back with readCacheFile() skips all of that work. The file is
+not portable between machines with different byte orders or precisions. 
+@see createCached() **/
+void writeCacheFile(const String& pathname) const;
+/** Read a mesh that was written by writeCacheFile(). The result is identical
+to the mesh that was written. An exception is thrown if the file can't be 
+read or was not written by a compatible version of this class. **/
+static TriangleMesh readCacheFile(const String& pathname);
+/** Create a TriangleMesh from a PolygonalMesh just as the constructor does,
+but keep a cache of built meshes in a directory so that a mesh only has to be
+built the first time it is seen. The cache file name is calculated from a hash
+of the vertex positions and faces of \a mesh together with the \a smooth and 
+\a rule settings; see getCacheFileName(). If that file is in 
+\a cacheDirectory it is read, otherwise the mesh is built and written there 
+for next time. A cache file that can't be read is rebuilt, and failure to 
+write one is ignored, so the cache directory can be cleared at any time.
+@param mesh            The PolygonalMesh from which to construct a triangle 
+                       mesh.
+@param cacheDirectory  An existing directory in which to keep cache files.
+@param smooth          As for the constructor.
+@param rule            The rule to use when building the OBB tree. **/
+static TriangleMesh createCached(const PolygonalMesh& mesh, 
+                                 const String& cacheDirectory,
+                                 bool smooth=false, 
+                                 OBBTreeSplitRule rule=SplitAtMedian);
+/** Return the name, without any directory, of the file that createCached() 
+would use for this PolygonalMesh and these settings. **/
+static String getCacheFileName(const PolygonalMesh& mesh, bool smooth=false,
+                               OBBTreeSplitRule rule=SplitAtMedian);
+
 /** Generate a PolygonalMesh from this TriangleMesh; useful mostly for debugging
 because you can create a DecorativeMesh from this and then look at it. **/
 PolygonalMesh createPolygonalMesh() const;
@@ -1479,10 +1592,24 @@ static TriangleMesh& updAs(ContactGeometry& geo)
 static ContactGeometryTypeId classTypeId();
 
 class Impl; /**< Internal use only. **/
+explicit TriangleMesh(Impl* impl); /**< Internal use only. **/
 const Impl& getImpl() const; /**< Internal use only. **/
 Impl& updImpl(); /**< Internal use only. **/
 };
 
+/** Write a TriangleMesh::MemoryUsage report, one line per part of the mesh
+followed by the total, in kilobytes. **/
+inline std::ostream& 
+operator<<(std::ostream& o, const ContactGeometry::TriangleMesh::MemoryUsage& m)
+{   const double kB = 1./1024;
+    return o << "vertices " << m.vertices*kB << " kB\n"
+             << "edges    " << m.edges*kB    << " kB\n"
+             << "faces    " << m.faces*kB    << " kB\n"
+             << "faceData " << m.faceData*kB << " kB\n"
+             << "obbTree  " << m.obbTree*kB  << " kB\n"
+             << "total    " << m.getTotal()*kB << " kB\n";
+}
+
 
 
 //==============================================================================
@@ -1491,7 +1618,9 @@ Impl& updImpl(); /**< Internal use only. **/
 /** This class represents a node in the Oriented Bounding Box Tree for a 
 TriangleMesh. Each node has an OrientedBoundingBox that fully encloses all 
 triangles contained within it or its  children. This is a binary tree: each 
-non-leaf node has two children. Triangles are stored only in the leaf nodes. **/
+non-leaf node has two children. Triangles are stored only in the leaf nodes. 
+An %OBBTreeNode is a lightweight reference to a node that is owned by the 
+mesh; it is invalidated if the mesh is destroyed or its tree is rebuilt. **/
 class SimTK_SIMMATH_EXPORT ContactGeometry::TriangleMesh::OBBTreeNode {
 public:
 OBBTreeNode(const OBBTreeNodeImpl& impl);
@@ -327,7 +327,7 @@ void processBox
    (const ContactGeometry::TriangleMesh&              mesh, 
     const ContactGeometry::TriangleMesh::OBBTreeNode& node, 
     const Vec3& center_M, Real radius2,   
-    std::set<int>& insideFaces) const ;
+    Array_<int>& candidateFaces) const ;
 };
 
 
@@ -355,14 +355,21 @@ bool trackContact
 
 private:
 void findIntersectingFaces
+   (const ContactGeometry::TriangleMesh&    mesh1, 
+    const ContactGeometry::TriangleMesh&    mesh2,
+    const Transform&                        X_M1M2, 
+    std::set<int>&                          insideFaces1, 
+    std::set<int>&                          insideFaces2) const; 
+
+void findCandidateFaces
    (const ContactGeometry::TriangleMesh&                mesh1, 
     const ContactGeometry::TriangleMesh&                mesh2,
     const ContactGeometry::TriangleMesh::OBBTreeNode&   node1, 
     const ContactGeometry::TriangleMesh::OBBTreeNode&   node2, 
     const OrientedBoundingBox&                          node2Bounds_M1,
     const Transform&                                    X_M1M2, 
-    std::set<int>&                                      insideFaces1, 
-    std::set<int>&                                      insideFaces2) const; 
+    Array_<int>&                                        candidates1, 
+    Array_<int>&                                        candidates2) const; 
 
 void findBuriedFaces
    (const ContactGeometry::TriangleMesh&    mesh,
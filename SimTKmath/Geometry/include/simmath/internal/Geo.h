@@ -62,6 +62,7 @@ template <class P> class Box_;
 template <class P> class AlignedBox_;
 template <class P> class OrientedBox_;
 template <class P> class Triangle_;
+template <class P> class TriangleBatch_;
 template <class P> class CubicHermiteCurve_;
 template <class P> class BicubicHermitePatch_;
 template <class P> class CubicBezierCurve_;
@@ -77,6 +78,7 @@ typedef Box_<Real>          Box;
 typedef AlignedBox_<Real>   AlignedBox;
 typedef OrientedBox_<Real>  OrientedBox;
 typedef Triangle_<Real>     Triangle;
+typedef TriangleBatch_<Real>       TriangleBatch;
 typedef CubicHermiteCurve_<Real>    CubicHermiteCurve;
 typedef BicubicHermitePatch_<Real>  BicubicHermitePatch;
 typedef CubicBezierCurve_<Real>     CubicBezierCurve;
@@ -132,18 +132,18 @@ RealP calcAreaSqr() const
 
 /** Given a location in space, find the point of this triangular face that
 is closest to that location. If the answer is not unique then one of the 
-equidistant points is returned. **/
-Vec3P findNearestPoint(const Vec3P& position, Vec2P& uv) const
-{SimTK_ASSERT_ALWAYS(!"implemented", 
-"Geo::Triangle_::findNearestPoint(): Not implemented yet.");
-return Vec3P();}
-
-/** Determine whether a given ray intersects this triangle. TODO: is a 
-perfect hit on the boundary an intersection? **/
-bool intersectsRay(const Vec3P& origin, const UnitVec3P& direction, 
-                   RealP& distance, Vec2P& uv) const
-{SimTK_ASSERT_ALWAYS(!"implemented", 
-"Geo::Triangle_::intersectsRay(): Not implemented yet."); return false;}
+equidistant points is returned. The location of the nearest point is also
+returned in \a uv, in the same form that findPoint() takes. **/
+SimTK_SIMMATH_EXPORT Vec3P findNearestPoint(const Vec3P& position, 
+                                            Vec2P& uv) const;
+
+/** Determine whether a given ray intersects this triangle, and if so return
+the distance along the ray to the hit and its location on the triangle, in the
+same form that findPoint() takes. A hit exactly on the boundary of the
+triangle counts, but a ray lying in the triangle's plane never hits. **/
+SimTK_SIMMATH_EXPORT bool intersectsRay(const Vec3P& origin, 
+                                        const UnitVec3P& direction, 
+                                        RealP& distance, Vec2P& uv) const;
 
 /** Determine yes/no whether this triangle overlaps another one. Note that
 exactly touching is not overlapping. **/
@@ -0,0 +1,151 @@
+#ifndef SimTK_SIMMATH_GEO_TRIANGLE_BATCH_H_
+#define SimTK_SIMMATH_GEO_TRIANGLE_BATCH_H_
+
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/** @file
+Defines batched operations on collections of triangles. **/
+
+#include "SimTKcommon.h"
+#include "simmath/internal/common.h"
+#include "simmath/internal/Geo.h"
+#include "simmath/internal/Geo_Triangle.h"
+
+namespace SimTK {
+
+//==============================================================================
+//                            GEO TRIANGLE BATCH
+//==============================================================================
+/** A collection of triangles stored in structure-of-arrays layout, that is,
+with each vertex coordinate kept in its own contiguous array, and a set of
+methods that test many of those triangles at once. Where the compiler targets
+a vector instruction set (SSE2 or AVX in double precision) the tests are done
+several triangles per instruction; otherwise the same code runs one triangle
+at a time. Either way the answers are the ones you would get by calling the
+corresponding Geo::Triangle_ method on each triangle in turn.
+
+Filling a batch is cheap once its storage has grown to the needed size, so
+the intended use is to keep a batch around, clear() it, add the candidate
+triangles found by some broad phase search, and then test them all with one
+call. **/
+template <class P>
+class Geo::TriangleBatch_ {
+typedef P               RealP;
+typedef Vec<2,P>        Vec2P;
+typedef Vec<3,P>        Vec3P;
+typedef UnitVec<P,1>    UnitVec3P;
+public:
+/** Construct an empty batch. **/
+TriangleBatch_() {}
+
+/** Return the number of triangles in this batch. **/
+int size() const {return (int)coords[0].size();}
+/** Remove all the triangles from this batch, keeping the allocated storage
+for reuse. **/
+void clear()
+{   for (int k=0; k < 9; ++k) coords[k].clear(); }
+/** Make sure there is room for at least \a capacity triangles without
+further heap allocation. **/
+void reserve(int capacity)
+{   for (int k=0; k < 9; ++k) coords[k].reserve(capacity); }
+
+/** Append a triangle given its vertices, in counterclockwise order. **/
+void addTriangle(const Vec3P& v0, const Vec3P& v1, const Vec3P& v2) {
+    const Vec3P* v[3] = {&v0, &v1, &v2};
+    for (int i=0; i < 3; ++i)
+        for (int j=0; j < 3; ++j)
+            coords[3*i+j].push_back((*v[i])[j]);
+}
+/** Append a triangle. **/
+void addTriangle(const Triangle_<P>& tri)
+{   addTriangle(tri[0], tri[1], tri[2]); }
+
+/** Return one of the triangles in this batch. **/
+Triangle_<P> getTriangle(int i) const {
+    SimTK_INDEXCHECK(i,size(),"Geo::TriangleBatch_::getTriangle()");
+    return Triangle_<P>(getVertex(i,0), getVertex(i,1), getVertex(i,2));
+}
+/** Return one vertex (0, 1, or 2) of one of the triangles in this batch. **/
+Vec3P getVertex(int i, int vx) const {
+    SimTK_INDEXCHECK(i,size(),"Geo::TriangleBatch_::getVertex()");
+    SimTK_INDEXCHECK(vx,3,"Geo::TriangleBatch_::getVertex()");
+    return Vec3P(coords[3*vx][i], coords[3*vx+1][i], coords[3*vx+2][i]);
+}
+/** Return the contiguous array of one coordinate (0, 1, or 2 for x, y, or z)
+of one vertex (0, 1, or 2) of all the triangles in this batch. **/
+const RealP* getCoordinates(int vx, int coord) const {
+    SimTK_INDEXCHECK(vx,3,"Geo::TriangleBatch_::getCoordinates()");
+    SimTK_INDEXCHECK(coord,3,"Geo::TriangleBatch_::getCoordinates()");
+    return coords[3*vx+coord].cbegin();
+}
+
+/** Test triangle i of this batch against triangle i of \a other, which must
+be the same size, for every i. The indices of the pairs that overlap, in the
+sense of Triangle_::overlapsTriangle(), are appended to \a overlapping in
+increasing order. Most pairs handed to this method by a bounding volume
+search don't overlap; those are rejected in bulk and only the rest are given
+the full scalar test.
+@return The number of overlapping pairs found. **/
+SimTK_SIMMATH_EXPORT int
+findOverlappingPairs(const TriangleBatch_<P>& other,
+                     Array_<int>& overlapping) const;
+
+/** Find the triangles in this batch whose nearest point to \a point, as
+given by Triangle_::findNearestPoint(), is strictly closer than the square
+root of \a distanceSqr. Their indices are appended to \a near in increasing
+order.
+@return The number of triangles found. **/
+SimTK_SIMMATH_EXPORT int
+findTrianglesNearPoint(const Vec3P& point, RealP distanceSqr,
+                       Array_<int>& near) const;
+
+/** Calculate the squared distance from \a point to the nearest point of
+each triangle in this batch, as given by Triangle_::findNearestPoint().
+@param[in]  point       The query point.
+@param[out] distanceSqr Resized to size() and filled with the results. **/
+SimTK_SIMMATH_EXPORT void
+calcDistanceSqrToPoint(const Vec3P& point, Array_<RealP>& distanceSqr) const;
+
+/** Find the first triangle in this batch hit by a ray, in the sense of
+Triangle_::intersectsRay(). If two triangles are hit at exactly the same
+distance, the one with the lower index is reported.
+@param[in]  origin      The start of the ray.
+@param[in]  direction   The direction of the ray.
+@param[out] distance    Distance along the ray to the hit; unchanged if none.
+@param[out] which       Index of the triangle hit; unchanged if none.
+@param[out] uv          Location of the hit on that triangle; unchanged if
+                        none.
+@return true if the ray hits any triangle in this batch. **/
+SimTK_SIMMATH_EXPORT bool
+findRayIntersection(const Vec3P& origin, const UnitVec3P& direction,
+                    RealP& distance, int& which, Vec2P& uv) const;
+
+private:
+// coords[3*v+c][i] is coordinate c of vertex v of triangle i.
+Array_<RealP>   coords[9];
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMMATH_GEO_TRIANGLE_BATCH_H_
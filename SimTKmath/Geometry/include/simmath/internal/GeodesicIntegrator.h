@@ -224,6 +224,16 @@ public:
     step reaches \a tStop, the returned time will be \e exactly tStop. **/
     void takeOneStep(Real tStop);
 
+    /** Attempt to advance time and state by a single step ending exactly at
+    \a t1, without adjusting the step size. If the step satisfies the accuracy
+    requirement and the constraints, it is taken just as takeOneStep() would
+    have taken it, and true is returned. Otherwise the step is rejected and
+    false is returned; only the counters and the next step size to try are
+    changed, so that a subsequent takeOneStep() starts out with a suitably
+    smaller step. This is useful for replaying the steps of a previous, similar
+    solution. **/
+    bool tryOneStep(Real t1);
+
     /** Return the current time. **/
     const Real& getTime() const {return m_t;}
     /** Return the complete current state as a Vec<N>. **/
@@ -367,6 +377,43 @@ GeodesicIntegrator<Eqn>::takeOneStep(Real tStop) {
     }
 }
 
+template <class Eqn> bool
+GeodesicIntegrator<Eqn>::tryOneStep(Real t1) {
+    const Real Safety = Real(0.9), MinShrink = Real(0.1), MaxGrow = Real(5);
+    const Real HysteresisLow =  Real(0.9), HysteresisHigh = Real(1.2);
+
+    const Real h = t1 - m_t; assert(h>0);
+    Vec<N> y1, y1err;
+
+    ++m_nStepsAttempted;
+    takeRKMStep(h, y1, y1err);
+    const Real errNorm = calcNormInf(y1err);
+    if (errNorm > m_accuracy) {
+        ++m_nErrtestFailures;
+        // Shrink step by (acc/err)^(1/4) for 4th order, as in takeOneStep().
+        const Real hNew = Safety * h * std::sqrt(std::sqrt(m_accuracy/errNorm));
+        m_hNext = clamp(MinShrink*h, hNew, HysteresisLow*h);
+        return false;
+    }
+    if (!m_eqn.projectIfNeeded(m_consTol, t1, y1)) {
+        ++m_nProjectionFailures;
+        m_hNext = MinShrink*h;
+        return false;
+    }
+
+    ++m_nStepsTaken;
+    if (m_nStepsTaken==1) m_hInit = h; // that was the initial step
+    m_t = t1; m_y = y1; m_hLast = h;
+    m_eqn.calcDerivs(m_t, m_y, m_ydot);
+
+    // Possibly grow step for next time.
+    Real hNew = errNorm == 0 ? MaxGrow*h
+        :  Safety * h * std::sqrt(std::sqrt(m_accuracy/errNorm));
+    if (hNew < HysteresisHigh*h) hNew = h; // don't bother
+    m_hNext = std::min(hNew, MaxGrow*h);
+    return true;
+}
+
 template <class Eqn> void
 GeodesicIntegrator<Eqn>::takeRKMStep(Real h, Vec<N>& y1, Vec<N>& y1err) const {
     const Real h2=h/2, h3=h/3, h6=h/6, h8=h/8;
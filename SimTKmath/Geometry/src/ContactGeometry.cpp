@@ -915,6 +915,31 @@ void ContactGeometry::shootGeodesicInDirectionImplicitly(
         initialTangentApprox,
         finalArcLength,
         initialIntegratorStepSize,
+        std::vector<Real>(),
+        integratorAccuracy,
+        constraintTolerance,
+        maxIterations,
+        geodesicKnotPointsSink);
+}
+
+void ContactGeometry::shootGeodesicInDirectionImplicitly(
+    const Vec3& initialPointApprox,
+    const Vec3& initialTangentApprox,
+    Real finalArcLength,
+    Real initialIntegratorStepSize,
+    const std::vector<Real>& previousKnotArcLengths,
+    Real integratorAccuracy,
+    Real constraintTolerance,
+    int maxIterations,
+    const std::function<void(const GeodesicKnotPoint&)>&
+        geodesicKnotPointsSink) const
+{
+    getImpl().shootGeodesicInDirectionImplicitly(
+        initialPointApprox,
+        initialTangentApprox,
+        finalArcLength,
+        initialIntegratorStepSize,
+        previousKnotArcLengths,
         integratorAccuracy,
         constraintTolerance,
         maxIterations,
@@ -926,6 +951,7 @@ void ContactGeometryImpl::shootGeodesicInDirectionImplicitly(
     const Vec3& initialTangentApprox,
     Real finalArcLength,
     Real initialIntegratorStepSize,
+    const std::vector<Real>& previousKnotArcLengths,
     Real integratorAccuracy,
     Real constraintTolerance,
     int maxIterations, // TODO not connected (needs to be exposed?)
@@ -960,6 +986,15 @@ void ContactGeometryImpl::shootGeodesicInDirectionImplicitly(
     const Vec<N>& y = integ.getY();
     const Real& s   = integ.getTime(); // arc length
 
+    // When warm starting, the steps of the previous geodesic are replayed,
+    // scaled to the new length, for as long as they are accepted.
+    const int numPreviousKnots = (int)previousKnotArcLengths.size();
+    const Real previousArcLength =
+        numPreviousKnots > 0 ? previousKnotArcLengths.back() : Real(0);
+    const Real replayScale =
+        previousArcLength > 0 ? finalArcLength / previousArcLength : Real(0);
+    int replayKnot = replayScale > 0 ? 1 : numPreviousKnots;
+
     // Simulate it, and record geodesic knot points after each step
     int stepcnt = 0;
 
@@ -978,7 +1013,24 @@ void ContactGeometryImpl::shootGeodesicInDirectionImplicitly(
             break;
         }
 
-        integ.takeOneStep(finalArcLength);
+        // Replay the next step of the previous geodesic, making sure that
+        // the last one ends exactly at finalArcLength. Once a step fails,
+        // continue with step size control.
+        bool replayed = false;
+        if (replayKnot < numPreviousKnots) {
+            const Real t1 = replayKnot == numPreviousKnots-1 ? finalArcLength
+                : std::min(replayScale*previousKnotArcLengths[replayKnot],
+                           finalArcLength);
+            if (t1 > s && integ.tryOneStep(t1)) {
+                replayed = true;
+                ++replayKnot;
+            } else {
+                replayKnot = numPreviousKnots;
+            }
+        }
+        if (!replayed) {
+            integ.takeOneStep(finalArcLength);
+        }
         ++stepcnt;
 
         SimTK_ERRCHK1_ALWAYS(
@@ -33,6 +33,7 @@
 #include "simmath/internal/ContactGeometry.h"
 
 #include <atomic>
+#include <cstdint>
 #include <limits>
 
 namespace SimTK {
@@ -180,11 +181,14 @@ public:
             "shootGeodesicInDirectionAnalytically");
     }
 
+    // See ContactGeometry::shootGeodesicInDirectionImplicitly(); an empty
+    // previousKnotArcLengths means that no steps are replayed.
     void shootGeodesicInDirectionImplicitly(
         const Vec3& initialPointApprox,
         const Vec3& initialTangentApprox,
         Real finalArcLength,
         Real initialIntegratorStepSize,
+        const std::vector<Real>& previousKnotArcLengths,
         Real integratorAccuracy,
         Real constraintTolerance,
         int maxIterations,
@@ -1154,23 +1158,63 @@ private:
 //==============================================================================
 //                            OBB TREE NODE IMPL
 //==============================================================================
+// One node of a TriangleMesh's OBB tree. The nodes of a tree are stored
+// contiguously in depth-first order (see OBBTreeImpl), so a non-leaf node's
+// first child is the node that immediately follows it and its second child is
+// found at a stored offset. The triangles of all the leaves are packed into
+// a single list owned by the tree, and each leaf refers to its own range.
 class OBBTreeNodeImpl {
 public:
-    OBBTreeNodeImpl() : child1(NULL), child2(NULL), numTriangles(0) {
-    }
-    OBBTreeNodeImpl(const OBBTreeNodeImpl& copy);
-    ~OBBTreeNodeImpl();
+    bool isLeaf() const {return secondChildOffset == 0;}
+    const OBBTreeNodeImpl& getFirstChild() const 
+    {   assert(!isLeaf()); return this[1]; }
+    const OBBTreeNodeImpl& getSecondChild() const 
+    {   assert(!isLeaf()); return this[secondChildOffset]; }
+
     OrientedBoundingBox bounds;
-    OBBTreeNodeImpl* child1;
-    OBBTreeNodeImpl* child2;
+    int secondChildOffset = 0; // 0 for a leaf
+    int numTriangles = 0;      // in this node and all its descendants
+    int firstTriangle = 0;     // leaf only; index into the packed list
+    // Leaf only; a non-owning view of this leaf's part of the packed list,
+    // needed by OBBTreeNode::getTriangles().
     Array_<int> triangles;
-    int numTriangles;
-    Vec3 findNearestPoint(const ContactGeometry::TriangleMesh::Impl& mesh, 
-                          const Vec3& position, Real cutoff2, Real& distance2, 
+};
+
+
+
+//==============================================================================
+//                              OBB TREE IMPL
+//==============================================================================
+// The OBB tree of a TriangleMesh, stored as a flat depth-first array of nodes
+// plus one packed list of leaf triangles. The root is node 0.
+class OBBTreeImpl {
+public:
+    OBBTreeImpl() = default;
+    OBBTreeImpl(const OBBTreeImpl& src) {copyFrom(src);}
+    OBBTreeImpl& operator=(const OBBTreeImpl& src) 
+    {   if (&src != this) copyFrom(src); return *this; }
+
+    const OBBTreeNodeImpl& getRoot() const {return nodes[0];}
+
+    // Point each leaf's triangle view at its part of the packed list. This
+    // must be done whenever the packed list has been (re)allocated.
+    void shareLeafTriangles();
+
+    Vec3 findNearestPoint(const ContactGeometry::TriangleMesh::Impl& mesh,
+                          const OBBTreeNodeImpl& node,
+                          const Vec3& position, Real cutoff2, Real& distance2,
                           int& face, Vec2& uv) const;
-    bool intersectsRay(const ContactGeometry::TriangleMesh::Impl& mesh, 
+    bool intersectsRay(const ContactGeometry::TriangleMesh::Impl& mesh,
+                       const OBBTreeNodeImpl& node,
                        const Vec3& origin, const UnitVec3& direction, 
                        Real& distance, int& face, Vec2& uv) const;
+
+    Array_<OBBTreeNodeImpl> nodes;      // depth-first order
+    Array_<int>             triangles;  // all leaves' triangles, packed
+    ContactGeometry::TriangleMesh::OBBTreeSplitRule splitRule = 
+        ContactGeometry::TriangleMesh::SplitAtMedian;
+private:
+    void copyFrom(const OBBTreeImpl& src);
 };
 
 
@@ -1209,6 +1253,10 @@ public:
     bool intersectsRay(const Vec3& origin, const UnitVec3& direction, 
                        Real& distance, int& face, Vec2& uv) const;
     void getBoundingSphere(Vec3& center, Real& radius) const override;
+    ContactGeometry::TriangleMesh::MemoryUsage calcMemoryUsage() const;
+    // The key identifies the contents of a cache file; see createCached().
+    void writeCacheFile(const String& pathname, std::uint64_t key) const;
+    static Impl* readCacheFile(const String& pathname, std::uint64_t& key);
 
     bool isSmooth() const override {return false;}
     bool isConvex() const override {return false;}
@@ -1221,22 +1269,33 @@ public:
         return id;
     }
 private:
+    Impl() : ContactGeometryImpl(), smooth(false) {} // for readCacheFile()
     void init(const Array_<Vec3>& vertexPositions, const Array_<int>& faceIndices);
-    void createObbTree(OBBTreeNodeImpl& node, const Array_<int>& faceIndices);
+    void createObbTree(ContactGeometry::TriangleMesh::OBBTreeSplitRule rule);
+    void createObbTreeNode(const Array_<int>& faceIndices);
     void splitObbAxis(const Array_<int>& parentIndices, 
                       Array_<int>& child1Indices, 
                       Array_<int>& child2Indices, int axis);
+    bool splitBySurfaceArea(const Array_<int>& parentIndices, 
+                            Array_<int>& child1Indices, 
+                            Array_<int>& child2Indices);
     void findBoundingSphere(Vec3* point[], int p, int b, 
                             Vec3& center, Real& radius);
     friend class ContactGeometry::TriangleMesh;
-    friend class OBBTreeNodeImpl;
+    friend class OBBTreeImpl;
 
     Array_<Edge>    edges;
     Array_<Face>    faces;
     Array_<Vertex>  vertices;
+    // Quantities derived from each face's vertices, calculated once in init().
+    // Each is kept in its own contiguous array, indexed like faces, so that
+    // loops over many faces stream through only the data they use.
+    Array_<UnitVec3> faceNormals;
+    Array_<Real>     faceAreas;
+    Array_<Vec3>     faceCentroids;
     Vec3            boundingSphereCenter;
     Real            boundingSphereRadius;
-    OBBTreeNodeImpl obb;
+    OBBTreeImpl     obb;
     bool            smooth;
 };
 
@@ -1264,9 +1323,7 @@ public:
 //==============================================================================
 class ContactGeometry::TriangleMesh::Impl::Face {
 public:
-    Face(int vert1, int vert2, int vert3, 
-         const Vec3& normal, Real area) 
-    :   normal(normal), area(area) {
+    Face(int vert1, int vert2, int vert3) {
         vertices[0] = vert1;
         vertices[1] = vert2;
         vertices[2] = vert3;
@@ -1274,8 +1331,6 @@ public:
     }
     int         vertices[3];
     int         edges[3];
-    UnitVec3    normal;
-    Real        area;
 };
 
 
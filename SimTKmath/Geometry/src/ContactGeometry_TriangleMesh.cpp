@@ -31,8 +31,12 @@
 #include "ContactGeometryImpl.h"
 
 #include <iostream>
+#include <fstream>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <set>
 
 using namespace SimTK;
@@ -55,6 +59,9 @@ ContactGeometry::TriangleMesh::TriangleMesh
    (const PolygonalMesh& mesh, bool smooth) 
 :   ContactGeometry(new TriangleMesh::Impl(mesh, smooth)) {}
 
+ContactGeometry::TriangleMesh::TriangleMesh(TriangleMesh::Impl* impl) 
+:   ContactGeometry(impl) {}
+
 /*static*/ ContactGeometryTypeId ContactGeometry::TriangleMesh::classTypeId() 
 {   return ContactGeometry::TriangleMesh::Impl::classTypeId(); }
 
@@ -102,12 +109,24 @@ int ContactGeometry::TriangleMesh::getEdgeVertex(int edge, int vertex) const {
 
 const UnitVec3& ContactGeometry::TriangleMesh::getFaceNormal(int face) const {
     assert(face >= 0 && face < getNumFaces());
-    return getImpl().faces[face].normal;
+    return getImpl().faceNormals[face];
 }
 
 Real ContactGeometry::TriangleMesh::getFaceArea(int face) const {
     assert(face >= 0 && face < getNumFaces());
-    return getImpl().faces[face].area;
+    return getImpl().faceAreas[face];
+}
+
+const Array_<UnitVec3>& ContactGeometry::TriangleMesh::getFaceNormals() const {
+    return getImpl().faceNormals;
+}
+
+const Array_<Real>& ContactGeometry::TriangleMesh::getFaceAreas() const {
+    return getImpl().faceAreas;
+}
+
+const Array_<Vec3>& ContactGeometry::TriangleMesh::getFaceCentroids() const {
+    return getImpl().faceCentroids;
 }
 
 void ContactGeometry::TriangleMesh::
@@ -185,7 +204,98 @@ bool ContactGeometry::TriangleMesh::intersectsRay
 
 ContactGeometry::TriangleMesh::OBBTreeNode 
 ContactGeometry::TriangleMesh::getOBBTreeNode() const {
-    return OBBTreeNode(getImpl().obb);
+    return OBBTreeNode(getImpl().obb.getRoot());
+}
+
+void ContactGeometry::TriangleMesh::rebuildOBBTree(OBBTreeSplitRule rule) {
+    updImpl().createObbTree(rule);
+}
+
+ContactGeometry::TriangleMesh::OBBTreeSplitRule 
+ContactGeometry::TriangleMesh::getOBBTreeSplitRule() const {
+    return getImpl().obb.splitRule;
+}
+
+int ContactGeometry::TriangleMesh::getNumOBBTreeNodes() const {
+    return getImpl().obb.nodes.size();
+}
+
+ContactGeometry::TriangleMesh::MemoryUsage 
+ContactGeometry::TriangleMesh::calcMemoryUsage() const {
+    return getImpl().calcMemoryUsage();
+}
+
+// A 64-bit FNV-1a hash of everything that affects the mesh createCached() 
+// would build, used to name and check cache files.
+static std::uint64_t calcCacheKey
+   (const PolygonalMesh& mesh, bool smooth, 
+    ContactGeometry::TriangleMesh::OBBTreeSplitRule rule) 
+{   std::uint64_t h = 14695981039346656037ULL;
+    const auto add = [&h](const void* data, std::size_t n) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < n; ++i)
+            h = (h ^ bytes[i]) * 1099511628211ULL;
+    };
+    const int settings[2] = {smooth ? 1 : 0, (int)rule};
+    add(settings, sizeof(settings));
+    for (int i = 0; i < mesh.getNumVertices(); ++i)
+        add(&mesh.getVertexPosition(i)[0], sizeof(Vec3));
+    for (int i = 0; i < mesh.getNumFaces(); ++i) {
+        const int n = mesh.getNumVerticesForFace(i);
+        add(&n, sizeof(n));
+        for (int j = 0; j < n; ++j) {
+            const int v = mesh.getFaceVertex(i, j);
+            add(&v, sizeof(v));
+        }
+    }
+    return h;
+}
+
+void ContactGeometry::TriangleMesh::writeCacheFile
+   (const String& pathname) const {
+    getImpl().writeCacheFile(pathname, 0);
+}
+
+/*static*/ ContactGeometry::TriangleMesh 
+ContactGeometry::TriangleMesh::readCacheFile(const String& pathname) {
+    std::uint64_t key;
+    return TriangleMesh(Impl::readCacheFile(pathname, key));
+}
+
+/*static*/ ContactGeometry::TriangleMesh 
+ContactGeometry::TriangleMesh::createCached
+   (const PolygonalMesh& mesh, const String& cacheDirectory, bool smooth, 
+    OBBTreeSplitRule rule) 
+{   const std::uint64_t key = calcCacheKey(mesh, smooth, rule);
+    const String pathname = 
+        Pathname::addDirectoryOffset(cacheDirectory, "") 
+        + getCacheFileName(mesh, smooth, rule);
+
+    if (Pathname::fileExists(pathname)) {
+        try {
+            std::uint64_t fileKey;
+            Impl* impl = Impl::readCacheFile(pathname, fileKey);
+            if (fileKey == key)
+                return TriangleMesh(impl);
+            delete impl;
+        } catch (const std::exception&) {} // unreadable; rebuild it
+    }
+
+    TriangleMesh built(mesh, smooth);
+    if (rule != built.getOBBTreeSplitRule())
+        built.rebuildOBBTree(rule);
+    try {
+        built.getImpl().writeCacheFile(pathname, key);
+    } catch (const std::exception&) {} // the cache is only an optimization
+    return built;
+}
+
+/*static*/ String ContactGeometry::TriangleMesh::getCacheFileName
+   (const PolygonalMesh& mesh, bool smooth, OBBTreeSplitRule rule) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%016llx.simtkmeshcache", 
+        (unsigned long long)calcCacheKey(mesh, smooth, rule));
+    return String(name);
 }
 
 PolygonalMesh ContactGeometry::TriangleMesh::createPolygonalMesh() const {
@@ -226,12 +336,9 @@ Vec3 ContactGeometry::TriangleMesh::Impl::findPoint
            +  (1-uv[0]-uv[1])* vertices[f.vertices[2]].pos;
 }
 
-// same as findPoint(face, (1/3,1/3)) but faster
+// same as findPoint(face, (1/3,1/3)) but faster; calculated in init()
 Vec3 ContactGeometry::TriangleMesh::Impl::findCentroid(int face) const {
-    const Face& f = faces[face];
-    return (  vertices[f.vertices[0]].pos
-            + vertices[f.vertices[1]].pos
-            + vertices[f.vertices[2]].pos) / 3;
+    return faceCentroids[face];
 }
 
 UnitVec3 ContactGeometry::TriangleMesh::Impl::findNormalAtPoint
@@ -241,7 +348,7 @@ UnitVec3 ContactGeometry::TriangleMesh::Impl::findNormalAtPoint
         return UnitVec3(            uv[0] * vertices[f.vertices[0]].normal
                         +           uv[1] * vertices[f.vertices[1]].normal
                         +  (1-uv[0]-uv[1])* vertices[f.vertices[2]].normal);
-    return f.normal;
+    return faceNormals[face];
 }
 
 Vec3 ContactGeometry::TriangleMesh::Impl::
@@ -257,9 +364,9 @@ Vec3 ContactGeometry::TriangleMesh::Impl::
 findNearestPoint(const Vec3& position, bool& inside, int& face, Vec2& uv) const 
 {
     Real distance2;
-    Vec3 nearestPoint = obb.findNearestPoint(*this, position, MostPositiveReal, distance2, face, uv);
+    Vec3 nearestPoint = obb.findNearestPoint(*this, obb.getRoot(), position, MostPositiveReal, distance2, face, uv);
     Vec3 delta = position-nearestPoint;
-    inside = (~delta*faces[face].normal < 0);
+    inside = (~delta*faceNormals[face] < 0);
     return nearestPoint;
 }
 
@@ -278,9 +385,10 @@ bool ContactGeometry::TriangleMesh::Impl::
 intersectsRay(const Vec3& origin, const UnitVec3& direction, Real& distance, 
               int& face, Vec2& uv) const {
     Real boundsDistance;
-    if (!obb.bounds.intersectsRay(origin, direction, boundsDistance))
+    if (!obb.getRoot().bounds.intersectsRay(origin, direction, boundsDistance))
         return false;
-    return obb.intersectsRay(*this, origin, direction, distance, face, uv);
+    return obb.intersectsRay(*this, obb.getRoot(), origin, direction, 
+                             distance, face, uv);
 }
 
 void ContactGeometry::TriangleMesh::Impl::
@@ -289,6 +397,225 @@ getBoundingSphere(Vec3& center, Real& radius) const {
     radius = boundingSphereRadius;
 }
 
+// Heap memory held by an Array_, including any unused capacity.
+template <class T>
+static std::size_t heapBytes(const Array_<T>& a) 
+{   return a.capacity()*sizeof(T); }
+
+ContactGeometry::TriangleMesh::MemoryUsage 
+ContactGeometry::TriangleMesh::Impl::calcMemoryUsage() const {
+    MemoryUsage usage;
+    usage.vertices = heapBytes(vertices);
+    usage.edges    = heapBytes(edges);
+    usage.faces    = heapBytes(faces);
+    usage.faceData =   heapBytes(faceNormals) + heapBytes(faceAreas) 
+                     + heapBytes(faceCentroids);
+    // The leaves' triangle lists are views into the tree's packed list.
+    usage.obbTree  = heapBytes(obb.nodes) + heapBytes(obb.triangles);
+    return usage;
+}
+
+// This is the format of a TriangleMesh cache file:
+//   char[8]    - "SimTKtmc"
+//   uint32[3]  - 0x01020304 in native byte order, format version, sizeof(Real)
+//   uint64     - key; see createCached()
+//   uint32[7]  - smooth, split rule, and the number of vertices, edges, faces,
+//                OBB tree nodes and OBB tree leaf triangles
+//   Real[4]    - bounding sphere center and radius
+//   then each vertex (position, normal, first edge), the edges, the faces,
+//   the face normals, areas and centroids, each OBB tree node (transform,
+//   size, second child offset, number of triangles, first triangle) and the
+//   packed leaf triangles, all exactly as they are in memory.
+namespace {
+const char          MeshCacheMagic[8] = {'S','i','m','T','K','t','m','c'};
+const std::uint32_t MeshCacheByteOrder = 0x01020304;
+const std::uint32_t MeshCacheVersion = 1;
+
+// Appends the bytes of objects to a buffer.
+class MeshCacheWriter {
+public:
+    template <class T> void put(const T& x) {put(&x, 1);}
+    template <class T> void put(const T* x, std::size_t n) 
+    {   bytes.append(reinterpret_cast<const char*>(x), n*sizeof(T)); }
+    std::string bytes;
+};
+
+// Copies objects out of a buffer, checking that there are enough bytes left.
+class MeshCacheReader {
+public:
+    MeshCacheReader(const std::string& bytes, const String& pathname) 
+    :   p(bytes.data()), end(bytes.data()+bytes.size()), pathname(pathname) {}
+    template <class T> void get(T& x) {get(&x, 1);}
+    template <class T> void get(T* x, std::size_t n) {
+        SimTK_ERRCHK1_ALWAYS((std::size_t)(end-p) >= n*sizeof(T),
+            "ContactGeometry::TriangleMesh::readCacheFile()",
+            "Mesh cache file '%s' is truncated.", pathname.c_str());
+        if (n) std::memcpy(reinterpret_cast<char*>(x), p, n*sizeof(T));
+        p += n*sizeof(T);
+    }
+    bool atEnd() const {return p == end;}
+private:
+    const char* p;
+    const char* end;
+    const String& pathname;
+};
+
+// Return true if i is a valid index into an array of n elements.
+bool isInRange(int i, std::uint32_t n) {return i >= 0 && (std::uint32_t)i < n;}
+}
+
+void ContactGeometry::TriangleMesh::Impl::
+writeCacheFile(const String& pathname, std::uint64_t key) const {
+    static_assert(sizeof(Edge) == 4*sizeof(int) && sizeof(Face) == 6*sizeof(int),
+                  "Mesh cache files require tightly packed edges and faces.");
+    MeshCacheWriter out;
+    out.put(MeshCacheMagic, sizeof(MeshCacheMagic));
+    const std::uint32_t header[3] = 
+    {   MeshCacheByteOrder, MeshCacheVersion, (std::uint32_t)sizeof(Real) };
+    out.put(header, 3);
+    out.put(key);
+    const std::uint32_t counts[7] = 
+    {   smooth ? 1u : 0u, (std::uint32_t)obb.splitRule, vertices.size(), 
+        edges.size(), faces.size(), obb.nodes.size(), obb.triangles.size() };
+    out.put(counts, 7);
+    out.put(boundingSphereCenter);
+    out.put(boundingSphereRadius);
+    for (const Vertex& v : vertices) {
+        out.put(v.pos);
+        out.put(v.normal);
+        out.put(v.firstEdge);
+    }
+    out.put(edges.cbegin(), edges.size());
+    out.put(faces.cbegin(), faces.size());
+    out.put(faceNormals.cbegin(), faceNormals.size());
+    out.put(faceAreas.cbegin(), faceAreas.size());
+    out.put(faceCentroids.cbegin(), faceCentroids.size());
+    for (const OBBTreeNodeImpl& node : obb.nodes) {
+        out.put(node.bounds.getTransform());
+        out.put(node.bounds.getSize());
+        out.put(node.secondChildOffset);
+        out.put(node.numTriangles);
+        out.put(node.firstTriangle);
+    }
+    out.put(obb.triangles.cbegin(), obb.triangles.size());
+
+    std::ofstream ofs(pathname, std::ios_base::binary);
+    SimTK_ERRCHK1_ALWAYS(ofs.good(), 
+        "ContactGeometry::TriangleMesh::writeCacheFile()",
+        "Can't open file '%s' for writing.", pathname.c_str());
+    ofs.write(out.bytes.data(), out.bytes.size());
+    ofs.close();
+    SimTK_ERRCHK1_ALWAYS(!ofs.fail(), 
+        "ContactGeometry::TriangleMesh::writeCacheFile()",
+        "Error while writing file '%s'.", pathname.c_str());
+}
+
+/*static*/ ContactGeometry::TriangleMesh::Impl* 
+ContactGeometry::TriangleMesh::Impl::
+readCacheFile(const String& pathname, std::uint64_t& key) {
+    const char* methodName = "ContactGeometry::TriangleMesh::readCacheFile()";
+    // Read the whole file at once, then decode it from memory.
+    std::string bytes;
+    {   std::ifstream ifs(pathname, std::ios_base::binary|std::ios_base::ate);
+        SimTK_ERRCHK1_ALWAYS(ifs.good(), methodName,
+            "Can't open file '%s'", pathname.c_str());
+        const std::streamoff size = ifs.tellg();
+        bytes.resize((std::size_t)size);
+        ifs.seekg(0);
+        if (size > 0) ifs.read(&bytes[0], size);
+        SimTK_ERRCHK1_ALWAYS(ifs.good() && ifs.gcount()==size, methodName,
+            "Error while reading file '%s'.", pathname.c_str());
+    }
+    MeshCacheReader in(bytes, pathname);
+
+    char magic[sizeof(MeshCacheMagic)];
+    std::uint32_t header[3];
+    in.get(magic, sizeof(magic));
+    in.get(header, 3);
+    SimTK_ERRCHK1_ALWAYS(
+           std::memcmp(magic, MeshCacheMagic, sizeof(magic)) == 0
+        && header[0] == MeshCacheByteOrder && header[1] == MeshCacheVersion
+        && header[2] == sizeof(Real), methodName,
+        "File '%s' is not a mesh cache file written by this version on a"
+        " compatible machine.", pathname.c_str());
+    in.get(key);
+
+    std::uint32_t counts[7];
+    in.get(counts, 7);
+    SimTK_ERRCHK1_ALWAYS(counts[1] == SplitAtMedian 
+        || counts[1] == SplitBySurfaceArea, methodName, 
+        "Mesh cache file '%s' is corrupt.", pathname.c_str());
+    std::unique_ptr<Impl> impl(new Impl());
+    impl->smooth = counts[0] != 0;
+    impl->obb.splitRule = OBBTreeSplitRule(counts[1]);
+    impl->vertices.resize(counts[2], Vertex(Vec3(0)));
+    impl->edges.resize(counts[3], Edge(-1, -1, -1, -1));
+    impl->faces.resize(counts[4], Face(-1, -1, -1));
+    impl->faceNormals.resize(counts[4]);
+    impl->faceAreas.resize(counts[4]);
+    impl->faceCentroids.resize(counts[4]);
+    impl->obb.nodes.resize(counts[5]);
+    impl->obb.triangles.resize(counts[6]);
+
+    in.get(impl->boundingSphereCenter);
+    in.get(impl->boundingSphereRadius);
+    for (Vertex& v : impl->vertices) {
+        in.get(v.pos);
+        in.get(v.normal);
+        in.get(v.firstEdge);
+    }
+    in.get(impl->edges.begin(), impl->edges.size());
+    in.get(impl->faces.begin(), impl->faces.size());
+    in.get(impl->faceNormals.begin(), impl->faceNormals.size());
+    in.get(impl->faceAreas.begin(), impl->faceAreas.size());
+    in.get(impl->faceCentroids.begin(), impl->faceCentroids.size());
+    for (int i = 0; i < (int)counts[5]; i++) {
+        OBBTreeNodeImpl& node = impl->obb.nodes[i];
+        Transform X;
+        Vec3 size;
+        in.get(X);
+        in.get(size);
+        node.bounds = OrientedBoundingBox(X, size);
+        in.get(node.secondChildOffset);
+        in.get(node.numTriangles);
+        in.get(node.firstTriangle);
+        // A non-leaf's first child is the next node, so its second child
+        // must come after that and still be in the tree. The subtraction
+        // keeps the triangle range check from overflowing.
+        SimTK_ERRCHK1_ALWAYS(
+               (node.isLeaf() || (node.secondChildOffset > 1 
+                    && isInRange(node.secondChildOffset, counts[5]-i)))
+            && isInRange(node.firstTriangle, counts[6]+1) 
+            && node.numTriangles >= 0
+            && node.numTriangles <= (int)counts[6] - node.firstTriangle,
+            methodName, "Mesh cache file '%s' is corrupt.", pathname.c_str());
+    }
+    in.get(impl->obb.triangles.begin(), impl->obb.triangles.size());
+    SimTK_ERRCHK1_ALWAYS(in.atEnd() && counts[5] > 0, methodName, 
+        "Mesh cache file '%s' is corrupt.", pathname.c_str());
+
+    // Queries follow these indices without checking them, so a damaged file
+    // must not be able to point them outside the arrays.
+    bool indicesOK = true;
+    for (const Vertex& v : impl->vertices)
+        indicesOK = indicesOK && (v.firstEdge == -1 
+                                  || isInRange(v.firstEdge, counts[3]));
+    for (const Edge& e : impl->edges)
+        for (int j = 0; j < 2; j++)
+            indicesOK = indicesOK && isInRange(e.vertices[j], counts[2])
+                                  && isInRange(e.faces[j], counts[4]);
+    for (const Face& f : impl->faces)
+        for (int j = 0; j < 3; j++)
+            indicesOK = indicesOK && isInRange(f.vertices[j], counts[2])
+                                  && isInRange(f.edges[j], counts[3]);
+    for (int t : impl->obb.triangles)
+        indicesOK = indicesOK && isInRange(t, counts[4]);
+    SimTK_ERRCHK1_ALWAYS(indicesOK, methodName, 
+        "Mesh cache file '%s' is corrupt.", pathname.c_str());
+    impl->obb.shareLeafTriangles();
+    return impl.release();
+}
+
 void ContactGeometry::TriangleMesh::Impl::
 createPolygonalMesh(PolygonalMesh& mesh) const {
     for (unsigned vx=0; vx < vertices.size(); ++vx)
@@ -363,7 +690,7 @@ ContactGeometry::TriangleMesh::Impl::Impl
         origin += vertices[faces[0].vertices[i]].pos;
     origin /= 3; // this is the face centroid
 
-    const UnitVec3 direction = -faces[0].normal;
+    const UnitVec3 direction = -faceNormals[0];
     // Calculate a ray origin that is guaranteed to be outside the
     // mesh. If the topology is right (face 0 normal points outward), we'll be
     // outside on the side containing face 0. If it is wrong, we'll be outside
@@ -373,7 +700,7 @@ ContactGeometry::TriangleMesh::Impl::Impl
     // face's normal will be pointing back at us. If it is wrong, the face 
     // normal will also be pointing inwards, in roughly the same direction as 
     // the ray.
-    origin -= max(obb.bounds.getSize())*direction;
+    origin -= max(obb.getRoot().bounds.getSize())*direction;
     Real distance;
     int face;
     Vec2 uv;
@@ -381,7 +708,7 @@ ContactGeometry::TriangleMesh::Impl::Impl
     assert(intersects);
     // Now dot the hit face normal with the ray direction; correct topology
     // will have them pointing in more-or-less opposite directions.
-    if (dot(faces[face].normal, direction) > 0) {
+    if (dot(faceNormals[face], direction) > 0) {
         // We need to invert the mesh topology.
         
         for (int i = 0; i < (int) faces.size(); i++) {
@@ -392,7 +719,7 @@ ContactGeometry::TriangleMesh::Impl::Impl
             temp = f.edges[1];
             f.edges[1] = f.edges[2];
             f.edges[2] = temp;
-            f.normal *= -1;
+            faceNormals[i] *= -1;
         }
         for (int i = 0; i < (int) vertices.size(); i++)
             vertices[i].normal *= -1;
@@ -405,6 +732,9 @@ void ContactGeometry::TriangleMesh::Impl::init
         "ContactGeometry::TriangleMesh::Impl", "TriangleMesh::Impl", 
         "The number of indices must be a multiple of 3.");
     int numFaces = faceIndices.size()/3;
+    faces.reserve(numFaces);
+    faceNormals.reserve(numFaces);
+    faceAreas.reserve(numFaces);
     
     // Create the vertices.
     
@@ -432,7 +762,9 @@ void ContactGeometry::TriangleMesh::Impl::init
         SimTK_APIARGCHECK1_ALWAYS(norm > 0, 
             "ContactGeometry::TriangleMesh::Impl", "TriangleMesh::Impl",
             "Face %d is degenerate.", i);
-        faces.push_back(Face(v1, v2, v3, cross, norm/2));
+        faces.push_back(Face(v1, v2, v3));
+        faceNormals.push_back(UnitVec3(cross));
+        faceAreas.push_back(norm/2);
         int edges[3][2] = {{v1, v2}, {v2, v3}, {v3, v1}};
         for (int j = 0; j < 3; j++) {
             SimTK_APIARGCHECK1_ALWAYS(edges[j][0] != edges[j][1], 
@@ -523,18 +855,25 @@ void ContactGeometry::TriangleMesh::Impl::init
         }
         for (int j = 0; j < 3; j++) {
             Real angle = std::acos(~edgeDir[j]*edgeDir[(j+2)%3]);
-            vertNorm[f.vertices[j]] += f.normal*angle;
+            vertNorm[f.vertices[j]] += faceNormals[i]*angle;
         }
     }
     for (int i = 0; i < (int) vertices.size(); i++)
         vertices[i].normal = UnitVec3(vertNorm[i]);
+
+    // Calculate the centroid of each face.
+
+    faceCentroids.resize(faces.size());
+    for (int i = 0; i < (int) faces.size(); i++) {
+        const Face& f = faces[i];
+        faceCentroids[i] = (  vertices[f.vertices[0]].pos
+                            + vertices[f.vertices[1]].pos
+                            + vertices[f.vertices[2]].pos) / 3;
+    }
     
     // Create the OBBTree.
     
-    Array_<int> allFaces(faces.size());
-    for (int i = 0; i < (int) allFaces.size(); i++)
-        allFaces[i] = i;
-    createObbTree(obb, allFaces);
+    createObbTree(SplitAtMedian);
     
     // Find the bounding sphere.
     Array_<const Vec3*> points(vertices.size());
@@ -546,8 +885,28 @@ void ContactGeometry::TriangleMesh::Impl::init
 }
 
 void ContactGeometry::TriangleMesh::Impl::createObbTree
-   (OBBTreeNodeImpl& node, const Array_<int>& faceIndices) 
-{   // Find all vertices in the node and build the OrientedBoundingBox.
+   (OBBTreeSplitRule rule) 
+{   obb.nodes.clear();
+    obb.triangles.clear();
+    obb.triangles.reserve(faces.size());
+    obb.splitRule = rule;
+    Array_<int> allFaces(faces.size());
+    for (int i = 0; i < (int) allFaces.size(); i++)
+        allFaces[i] = i;
+    createObbTreeNode(allFaces);
+    obb.shareLeafTriangles();
+}
+
+// Append a node for the given faces to the tree, followed by all of its
+// descendants in depth-first order.
+void ContactGeometry::TriangleMesh::Impl::createObbTreeNode
+   (const Array_<int>& faceIndices) 
+{   // Find all vertices in the node and build the OrientedBoundingBox. Note
+    // that we can't hold on to a reference to the node once we start adding
+    // its children since that may reallocate the node array.
+    const int nodeIndex = (int)obb.nodes.size();
+    obb.nodes.push_back(OBBTreeNodeImpl());
+    OBBTreeNodeImpl& node = obb.nodes.back();
     node.numTriangles = faceIndices.size();
     set<int> vertexIndices;
     for (int i = 0; i < (int) faceIndices.size(); i++) 
@@ -560,6 +919,17 @@ void ContactGeometry::TriangleMesh::Impl::createObbTree
         points[index++] = vertices[*iter].pos;
     node.bounds = OrientedBoundingBox(points);
     if (faceIndices.size() > 3) {
+        if (obb.splitRule == SplitBySurfaceArea) {
+            Array_<int> child1Indices, child2Indices;
+            if (splitBySurfaceArea(faceIndices, child1Indices, child2Indices)){
+                createObbTreeNode(child1Indices);
+                obb.nodes[nodeIndex].secondChildOffset = 
+                    (int)obb.nodes.size() - nodeIndex;
+                createObbTreeNode(child2Indices);
+                return;
+            }
+            // Otherwise fall back to the median split.
+        }
 
         // Order the axes by size.
 
@@ -607,12 +977,13 @@ void ContactGeometry::TriangleMesh::Impl::createObbTree
             splitObbAxis(faceIndices, child1Indices, child2Indices, 
                          axisOrder[i]);
             if (child1Indices.size() > 0 && child2Indices.size() > 0) {
-                // It was successfully split, so create the child nodes.
+                // It was successfully split, so create the child nodes. The
+                // first child comes right after this node.
 
-                node.child1 = new OBBTreeNodeImpl();
-                node.child2 = new OBBTreeNodeImpl();
-                createObbTree(*node.child1, child1Indices);
-                createObbTree(*node.child2, child2Indices);
+                createObbTreeNode(child1Indices);
+                obb.nodes[nodeIndex].secondChildOffset = 
+                    (int)obb.nodes.size() - nodeIndex;
+                createObbTreeNode(child2Indices);
                 return;
             }
         }
@@ -620,8 +991,9 @@ void ContactGeometry::TriangleMesh::Impl::createObbTree
     
     // This is a leaf node.
     
-    node.triangles.insert(node.triangles.begin(), faceIndices.begin(), 
-                          faceIndices.end());
+    node.firstTriangle = obb.triangles.size();
+    obb.triangles.insert(obb.triangles.end(), faceIndices.begin(), 
+                         faceIndices.end());
 }
 
 void ContactGeometry::TriangleMesh::Impl::splitObbAxis
@@ -659,6 +1031,119 @@ void ContactGeometry::TriangleMesh::Impl::splitObbAxis
     }
 }
 
+// Surface area of an axis-aligned box.
+static Real calcBoxArea(const Vec3& lo, const Vec3& hi) {
+    const Vec3 d = hi-lo;
+    return 2*(d[0]*d[1] + d[1]*d[2] + d[2]*d[0]);
+}
+
+bool ContactGeometry::TriangleMesh::Impl::splitBySurfaceArea
+   (const Array_<int>& parentIndices, Array_<int>& child1Indices, 
+    Array_<int>& child2Indices) 
+{   // The surface area heuristic estimates the cost of querying a node as
+    // proportional to the sum over its children of the child's surface area
+    // (how likely a query is to enter it) times its number of faces. We
+    // consider splitting planes perpendicular to each coordinate axis at the 
+    // boundaries between NumBins equal slices of the range of face centroids,
+    // and bound the faces in each slice with an axis-aligned box. A split is
+    // only worth making if it is cheaper than leaving all the faces in the
+    // parent's own box; if none is, return false and let the caller use the
+    // median split.
+    const int NumBins = 16;
+    const int n = parentIndices.size();
+    Array_<Vec3> centroids(n);
+    Vec3 lo(Infinity), hi(-Infinity);
+    Vec3 parentLo(Infinity), parentHi(-Infinity);
+    for (int i = 0; i < n; i++) {
+        centroids[i] = findCentroid(parentIndices[i]);
+        for (int k = 0; k < 3; k++) {
+            lo[k] = std::min(lo[k], centroids[i][k]);
+            hi[k] = std::max(hi[k], centroids[i][k]);
+        }
+        const int* v = faces[parentIndices[i]].vertices;
+        for (int j = 0; j < 3; j++)
+            for (int k = 0; k < 3; k++) {
+                parentLo[k] = std::min(parentLo[k], vertices[v[j]].pos[k]);
+                parentHi[k] = std::max(parentHi[k], vertices[v[j]].pos[k]);
+            }
+    }
+
+    Real bestCost = Infinity;
+    int bestAxis = -1, bestBin = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        const Real extent = hi[axis]-lo[axis];
+        if (!(extent > 0))
+            continue; // all centroids in one plane
+        const Real scale = NumBins/extent;
+
+        // Bound and count the faces in each slice.
+        Vec3 binLo[NumBins], binHi[NumBins];
+        int  binCount[NumBins];
+        for (int b = 0; b < NumBins; b++) {
+            binLo[b] = Vec3(Infinity); binHi[b] = Vec3(-Infinity); 
+            binCount[b] = 0;
+        }
+        for (int i = 0; i < n; i++) {
+            const int b = std::min(NumBins-1, 
+                                   int(scale*(centroids[i][axis]-lo[axis])));
+            const int* v = faces[parentIndices[i]].vertices;
+            for (int j = 0; j < 3; j++)
+                for (int k = 0; k < 3; k++) {
+                    binLo[b][k] = std::min(binLo[b][k], vertices[v[j]].pos[k]);
+                    binHi[b][k] = std::max(binHi[b][k], vertices[v[j]].pos[k]);
+                }
+            ++binCount[b];
+        }
+
+        // Sweep from the right to get the cost of each possible second child,
+        // then from the left to evaluate each split.
+        Real rightCost[NumBins];
+        Vec3 sweepLo(Infinity), sweepHi(-Infinity);
+        int sweepCount = 0;
+        for (int b = NumBins-1; b > 0; b--) {
+            for (int k = 0; k < 3; k++) {
+                sweepLo[k] = std::min(sweepLo[k], binLo[b][k]);
+                sweepHi[k] = std::max(sweepHi[k], binHi[b][k]);
+            }
+            sweepCount += binCount[b];
+            rightCost[b] = sweepCount ? sweepCount*calcBoxArea(sweepLo, sweepHi)
+                                      : Real(0);
+        }
+        sweepLo = Vec3(Infinity); sweepHi = Vec3(-Infinity);
+        sweepCount = 0;
+        for (int b = 0; b < NumBins-1; b++) {
+            for (int k = 0; k < 3; k++) {
+                sweepLo[k] = std::min(sweepLo[k], binLo[b][k]);
+                sweepHi[k] = std::max(sweepHi[k], binHi[b][k]);
+            }
+            sweepCount += binCount[b];
+            if (sweepCount == 0 || sweepCount == n)
+                continue; // one of the children would be empty
+            const Real cost = 
+                sweepCount*calcBoxArea(sweepLo, sweepHi) + rightCost[b+1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin  = b;
+            }
+        }
+    }
+    if (bestAxis < 0 || !(bestCost < n*calcBoxArea(parentLo, parentHi)))
+        return false;
+
+    // Faces in slices up through bestBin go to the first child.
+    const Real scale = NumBins/(hi[bestAxis]-lo[bestAxis]);
+    for (int i = 0; i < n; i++) {
+        const int b = std::min(NumBins-1, 
+                        int(scale*(centroids[i][bestAxis]-lo[bestAxis])));
+        if (b <= bestBin)
+            child1Indices.push_back(parentIndices[i]);
+        else
+            child2Indices.push_back(parentIndices[i]);
+    }
+    return true;
+}
+
 Vec3 ContactGeometry::TriangleMesh::Impl::findNearestPointToFace
    (const Vec3& position, int face, Vec2& uv) const {
     // Calculate the distance between a point in space and a face of the mesh.
@@ -768,36 +1253,43 @@ Vec3 ContactGeometry::TriangleMesh::Impl::findNearestPointToFace
 
 
 //==============================================================================
-//                            OBB TREE NODE IMPL
+//                              OBB TREE IMPL
 //==============================================================================
 
-OBBTreeNodeImpl::OBBTreeNodeImpl(const OBBTreeNodeImpl& copy) 
-:   bounds(copy.bounds), triangles(copy.triangles), 
-    numTriangles(copy.numTriangles) {
-    if (copy.child1 == NULL) {
-        child1 = NULL;
-        child2 = NULL;
-    }
-    else {
-        child1 = new OBBTreeNodeImpl(*copy.child1);
-        child2 = new OBBTreeNodeImpl(*copy.child2);
+void OBBTreeImpl::copyFrom(const OBBTreeImpl& src) {
+    // Copy the nodes member by member; copying the leaves' views of the 
+    // packed triangle list would give each leaf its own copy of its triangles.
+    nodes.clear();
+    nodes.resize(src.nodes.size());
+    for (int i = 0; i < (int) nodes.size(); i++) {
+        const OBBTreeNodeImpl& srcNode = src.nodes[i];
+        OBBTreeNodeImpl& node = nodes[i];
+        node.bounds            = srcNode.bounds;
+        node.secondChildOffset = srcNode.secondChildOffset;
+        node.numTriangles      = srcNode.numTriangles;
+        node.firstTriangle     = srcNode.firstTriangle;
     }
+    triangles = src.triangles;
+    splitRule = src.splitRule;
+    shareLeafTriangles();
 }
 
-OBBTreeNodeImpl::~OBBTreeNodeImpl() {
-    if (child1 != NULL)
-        delete child1;
-    if (child2 != NULL)
-        delete child2;
+void OBBTreeImpl::shareLeafTriangles() {
+    for (OBBTreeNodeImpl& node : nodes)
+        if (node.isLeaf())
+            node.triangles.shareData(triangles.data() + node.firstTriangle,
+                                     node.numTriangles);
 }
 
-Vec3 OBBTreeNodeImpl::findNearestPoint
+Vec3 OBBTreeImpl::findNearestPoint
    (const ContactGeometry::TriangleMesh::Impl& mesh, 
-    const Vec3& position, Real cutoff2, 
+    const OBBTreeNodeImpl& node, const Vec3& position, Real cutoff2, 
     Real& distance2, int& face, Vec2& uv) const 
 {
     Real tol = 100*Eps;
-    if (child1 != NULL) {
+    if (!node.isLeaf()) {
+        const OBBTreeNodeImpl& child1 = node.getFirstChild();
+        const OBBTreeNodeImpl& child2 = node.getSecondChild();
         // Recursively check the child nodes.
         
         Real child1distance2 = MostPositiveReal, 
@@ -806,29 +1298,29 @@ Vec3 OBBTreeNodeImpl::findNearestPoint
         Vec2 child1uv, child2uv;
         Vec3 child1point, child2point;
         Real child1BoundsDist2 = 
-            (child1->bounds.findNearestPoint(position)-position).normSqr();
+            (child1.bounds.findNearestPoint(position)-position).normSqr();
         Real child2BoundsDist2 = 
-            (child2->bounds.findNearestPoint(position)-position).normSqr();
+            (child2.bounds.findNearestPoint(position)-position).normSqr();
         if (child1BoundsDist2 < child2BoundsDist2) {
             if (child1BoundsDist2 < cutoff2) {
-                child1point = child1->findNearestPoint(mesh, position, cutoff2, child1distance2, child1face, child1uv);
+                child1point = findNearestPoint(mesh, child1, position, cutoff2, child1distance2, child1face, child1uv);
                 if (child2BoundsDist2 < child1distance2 && child2BoundsDist2 < cutoff2)
-                    child2point = child2->findNearestPoint(mesh, position, cutoff2, child2distance2, child2face, child2uv);
+                    child2point = findNearestPoint(mesh, child2, position, cutoff2, child2distance2, child2face, child2uv);
             }
         }
         else {
             if (child2BoundsDist2 < cutoff2) {
-                child2point = child2->findNearestPoint(mesh, position, cutoff2, child2distance2, child2face, child2uv);
+                child2point = findNearestPoint(mesh, child2, position, cutoff2, child2distance2, child2face, child2uv);
                 if (child1BoundsDist2 < child2distance2 && child1BoundsDist2 < cutoff2)
-                    child1point = child1->findNearestPoint(mesh, position, cutoff2, child1distance2, child1face, child1uv);
+                    child1point = findNearestPoint(mesh, child1, position, cutoff2, child1distance2, child1face, child1uv);
             }
         }
         if (   child1distance2 <= child2distance2*(1+tol) 
             && child2distance2 <= child1distance2*(1+tol)) {
             // Decide based on angle which one to use.
             
-            if (  std::abs(~(child1point-position)*mesh.faces[child1face].normal) 
-                > std::abs(~(child2point-position)*mesh.faces[child2face].normal))
+            if (  std::abs(~(child1point-position)*mesh.faceNormals[child1face]) 
+                > std::abs(~(child2point-position)*mesh.faceNormals[child2face]))
                 child2distance2 = MostPositiveReal;
             else
                 child1distance2 = MostPositiveReal;
@@ -848,15 +1340,16 @@ Vec3 OBBTreeNodeImpl::findNearestPoint
     }    
     // This is a leaf node, so check each triangle for its distance to the point.
     
+    const int* triangles = this->triangles.data() + node.firstTriangle;
     distance2 = MostPositiveReal;
     Vec3 nearestPoint;
-    for (int i = 0; i < (int) triangles.size(); i++) {
+    for (int i = 0; i < node.numTriangles; i++) {
         Vec2 triangleUV;
         Vec3 p = mesh.findNearestPointToFace(position, triangles[i], triangleUV);
         Vec3 offset = p-position;
         // TODO: volatile to work around compiler bug
         volatile Real d2 = offset.normSqr(); 
-        if (d2 < distance2 || (d2 < distance2*(1+tol) && std::abs(~offset*mesh.faces[triangles[i]].normal) > std::abs(~offset*mesh.faces[face].normal))) {
+        if (d2 < distance2 || (d2 < distance2*(1+tol) && std::abs(~offset*mesh.faceNormals[triangles[i]]) > std::abs(~offset*mesh.faceNormals[face]))) {
             nearestPoint = p;
             distance2 = d2;
             face = triangles[i];
@@ -866,38 +1359,41 @@ Vec3 OBBTreeNodeImpl::findNearestPoint
     return nearestPoint;
 }
 
-bool OBBTreeNodeImpl::
+bool OBBTreeImpl::
 intersectsRay(const ContactGeometry::TriangleMesh::Impl& mesh,
+              const OBBTreeNodeImpl& node,
               const Vec3& origin, const UnitVec3& direction, Real& distance, 
               int& face, Vec2& uv) const {
-    if (child1 != NULL) {
+    if (!node.isLeaf()) {
         // Recursively check the child nodes.
         
+        const OBBTreeNodeImpl& child1 = node.getFirstChild();
+        const OBBTreeNodeImpl& child2 = node.getSecondChild();
         Real child1distance, child2distance;
         int child1face, child2face;
         Vec2 child1uv, child2uv;
-        bool child1intersects = child1->bounds.intersectsRay(origin, direction, child1distance);
-        bool child2intersects = child2->bounds.intersectsRay(origin, direction, child2distance);
+        bool child1intersects = child1.bounds.intersectsRay(origin, direction, child1distance);
+        bool child2intersects = child2.bounds.intersectsRay(origin, direction, child2distance);
         if (child1intersects) {
             if (child2intersects) {
                 // The ray intersects both child nodes.  First check the closer one.
                 
                 if (child1distance < child2distance) {
-                    child1intersects = child1->intersectsRay(mesh, origin,  direction, child1distance, child1face, child1uv);
+                    child1intersects = intersectsRay(mesh, child1, origin,  direction, child1distance, child1face, child1uv);
                     if (!child1intersects || child2distance < child1distance)
-                        child2intersects = child2->intersectsRay(mesh, origin,  direction, child2distance, child2face, child2uv);
+                        child2intersects = intersectsRay(mesh, child2, origin,  direction, child2distance, child2face, child2uv);
                 }
                 else {
-                    child2intersects = child2->intersectsRay(mesh, origin,  direction, child2distance, child2face, child2uv);
+                    child2intersects = intersectsRay(mesh, child2, origin,  direction, child2distance, child2face, child2uv);
                     if (!child2intersects || child1distance < child2distance)
-                        child1intersects = child1->intersectsRay(mesh, origin,  direction, child1distance, child1face, child1uv);
+                        child1intersects = intersectsRay(mesh, child1, origin,  direction, child1distance, child1face, child1uv);
                 }
             }
             else
-                child1intersects = child1->intersectsRay(mesh, origin,  direction, child1distance, child1face, child1uv);
+                child1intersects = intersectsRay(mesh, child1, origin,  direction, child1distance, child1face, child1uv);
         }
         else if (child2intersects)
-            child2intersects = child2->intersectsRay(mesh, origin,  direction, child2distance, child2face, child2uv);
+            child2intersects = intersectsRay(mesh, child2, origin,  direction, child2distance, child2face, child2uv);
         
         // If either one had an intersection, return the closer one.
         
@@ -919,9 +1415,10 @@ intersectsRay(const ContactGeometry::TriangleMesh::Impl& mesh,
     // This is a leaf node, so check each triangle for an intersection with the 
     // ray.
     
+    const int* triangles = this->triangles.data() + node.firstTriangle;
     bool foundIntersection = false;
-    for (int i = 0; i < (int) triangles.size(); i++) {
-        const UnitVec3& faceNormal = mesh.faces[triangles[i]].normal;
+    for (int i = 0; i < node.numTriangles; i++) {
+        const UnitVec3& faceNormal = mesh.faceNormals[triangles[i]];
         Real vd = ~faceNormal*direction;
         if (vd == 0.0)
             continue; // The ray is parallel to the plane.
@@ -1002,26 +1499,26 @@ ContactGeometry::TriangleMesh::OBBTreeNode::getBounds() const {
 }
 
 bool ContactGeometry::TriangleMesh::OBBTreeNode::isLeafNode() const {
-    return (impl->child1 == NULL);
+    return impl->isLeaf();
 }
 
 const ContactGeometry::TriangleMesh::OBBTreeNode 
 ContactGeometry::TriangleMesh::OBBTreeNode::getFirstChildNode() const {
-    SimTK_ASSERT_ALWAYS(impl->child1, 
+    SimTK_ASSERT_ALWAYS(!impl->isLeaf(), 
         "Called getFirstChildNode() on a leaf node");
-    return OBBTreeNode(*impl->child1);
+    return OBBTreeNode(impl->getFirstChild());
 }
 
 const ContactGeometry::TriangleMesh::OBBTreeNode 
 ContactGeometry::TriangleMesh::OBBTreeNode::getSecondChildNode() const {
-    SimTK_ASSERT_ALWAYS(impl->child2, 
-        "Called getFirstChildNode() on a leaf node");
-    return OBBTreeNode(*impl->child2);
+    SimTK_ASSERT_ALWAYS(!impl->isLeaf(), 
+        "Called getSecondChildNode() on a leaf node");
+    return OBBTreeNode(impl->getSecondChild());
 }
 
 const Array_<int>& ContactGeometry::TriangleMesh::OBBTreeNode::
 getTriangles() const {
-    SimTK_ASSERT_ALWAYS(impl->child2 == NULL, 
+    SimTK_ASSERT_ALWAYS(impl->isLeaf(), 
         "Called getTriangles() on a non-leaf node");
     return impl->triangles;
 }
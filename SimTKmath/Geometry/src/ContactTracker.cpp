@@ -933,9 +933,22 @@ bool ContactTracker::SphereTriangleMesh::trackContact
 
     // Want the sphere center measured and expressed in the mesh frame.
     const Vec3 p_MC = (~X_SM).p();
+    const Real radius2 = square(sphere.getRadius());
+    Array_<int> candidateFaces;
+    processBox(mesh, mesh.getOBBTreeNode(), p_MC, radius2, candidateFaces);
+
+    // Now measure the distance to all the candidate faces at once.
+    Geo::TriangleBatch faces;
+    faces.reserve(candidateFaces.size());
+    for (int face : candidateFaces)
+        faces.addTriangle(mesh.getVertexPosition(mesh.getFaceVertex(face, 0)),
+                          mesh.getVertexPosition(mesh.getFaceVertex(face, 1)),
+                          mesh.getVertexPosition(mesh.getFaceVertex(face, 2)));
+    Array_<int> nearFaces;
+    faces.findTrianglesNearPoint(p_MC, radius2, nearFaces);
     std::set<int> insideFaces;
-    processBox(mesh, mesh.getOBBTreeNode(), p_MC, square(sphere.getRadius()), 
-               insideFaces);
+    for (int i : nearFaces)
+        insideFaces.insert(candidateFaces[i]);
     
     if (insideFaces.empty()) {
         currentStatus.clear(); // not touching
@@ -950,13 +963,13 @@ bool ContactTracker::SphereTriangleMesh::trackContact
 }
 
 // Check a single OBB and its contents (recursively) against the sphere
-// whose center location in M and radius squared is given, appending any 
-// penetrating faces to the insideFaces list.
+// whose center location in M and radius squared is given, appending the faces
+// of any penetrating leaf boxes to the candidateFaces list.
 void ContactTracker::SphereTriangleMesh::processBox
    (const ContactGeometry::TriangleMesh&              mesh, 
     const ContactGeometry::TriangleMesh::OBBTreeNode& node, 
     const Vec3& center_M, Real radius2, 
-    std::set<int>& insideFaces) const 
+    Array_<int>& candidateFaces) const 
 {   // First check against the node's bounding box.
 
     const Vec3 nearest_M = node.getBounds().findNearestPoint(center_M);
@@ -966,21 +979,17 @@ void ContactTracker::SphereTriangleMesh::processBox
     // Bounding box is penetrating. If it's not a leaf node, check its children.
     if (!node.isLeafNode()) {
         processBox(mesh, node.getFirstChildNode(), center_M, radius2,
-                   insideFaces);
+                   candidateFaces);
         processBox(mesh, node.getSecondChildNode(), center_M, radius2,
-                   insideFaces);
+                   candidateFaces);
         return;
     }
     
-    // This is a leaf node that may be penetrating; check the triangles.
+    // This is a leaf node that may be penetrating; its triangles will be
+    // checked later along with all the others.
     const Array_<int>& triangles = node.getTriangles();
-    for (unsigned i = 0; i < triangles.size(); i++) {
-        Vec2 uv;
-        Vec3 nearest_M = mesh.findNearestPointToFace
-                                    (center_M, triangles[i], uv);
-        if ((nearest_M-center_M).normSqr() < radius2)
-            insideFaces.insert(triangles[i]);
-    }
+    candidateFaces.insert(candidateFaces.end(), triangles.begin(), 
+                          triangles.end());
 }
 
 
@@ -1017,15 +1026,9 @@ bool ContactTracker::TriangleMeshTriangleMesh::trackContact
     const Transform X_M1M2 = ~X_GM1*X_GM2; 
     std::set<int> insideFaces1, insideFaces2;
 
-    // Get M2's bounding box in M1's frame.
-    const OrientedBoundingBox 
-        mesh2Bounds_M1 = X_M1M2*mesh2.getOBBTreeNode().getBounds();
-
     // Find the faces that are actually intersecting faces on the other
     // surface (this doesn't yet include faces that may be completely buried).
-    findIntersectingFaces(mesh1, mesh2, 
-                          mesh1.getOBBTreeNode(), mesh2.getOBBTreeNode(), 
-                          mesh2Bounds_M1, X_M1M2, insideFaces1, insideFaces2);
+    findIntersectingFaces(mesh1, mesh2, X_M1M2, insideFaces1, insideFaces2);
     
     // It should never be the case that one set of faces is empty and the
     // other isn't, however it is conceivable that roundoff error could cause
@@ -1050,14 +1053,54 @@ bool ContactTracker::TriangleMeshTriangleMesh::trackContact
 
 void ContactTracker::TriangleMeshTriangleMesh::
 findIntersectingFaces
+   (const ContactGeometry::TriangleMesh&    mesh1, 
+    const ContactGeometry::TriangleMesh&    mesh2,
+    const Transform&                        X_M1M2, 
+    std::set<int>&                          insideFaces1, 
+    std::set<int>&                          insideFaces2) const 
+{   // Get M2's bounding box in M1's frame.
+    const OrientedBoundingBox 
+        mesh2Bounds_M1 = X_M1M2*mesh2.getOBBTreeNode().getBounds();
+
+    // Collect the pairs of faces whose leaf boxes overlap.
+    Array_<int> candidates1, candidates2;
+    findCandidateFaces(mesh1, mesh2, 
+                       mesh1.getOBBTreeNode(), mesh2.getOBBTreeNode(), 
+                       mesh2Bounds_M1, X_M1M2, candidates1, candidates2);
+
+    // Then test them all at once, with mesh2's faces in M1.
+    const int nPairs = candidates1.size();
+    Geo::TriangleBatch faces1, faces2;
+    faces1.reserve(nPairs); faces2.reserve(nPairs);
+    for (int i = 0; i < nPairs; i++) {
+        const int face1 = candidates1[i], face2 = candidates2[i];
+        Vec3 b[3], a[3];
+        for (int k = 0; k < 3; k++) {
+            b[k] = mesh1.getVertexPosition(mesh1.getFaceVertex(face1, k));
+            a[k] = X_M1M2*mesh2.getVertexPosition(mesh2.getFaceVertex(face2, k));
+        }
+        faces1.addTriangle(b[0], b[1], b[2]);
+        faces2.addTriangle(a[0], a[1], a[2]);
+    }
+    Array_<int> overlapping;
+    faces2.findOverlappingPairs(faces1, overlapping);
+    for (int i : overlapping) {
+        // The triangles intersect.
+        insideFaces1.insert(candidates1[i]);
+        insideFaces2.insert(candidates2[i]);
+    }
+}
+
+void ContactTracker::TriangleMeshTriangleMesh::
+findCandidateFaces
    (const ContactGeometry::TriangleMesh&                mesh1, 
     const ContactGeometry::TriangleMesh&                mesh2,
     const ContactGeometry::TriangleMesh::OBBTreeNode&   node1, 
     const ContactGeometry::TriangleMesh::OBBTreeNode&   node2, 
     const OrientedBoundingBox&                          node2Bounds_M1,
     const Transform&                                    X_M1M2, 
-    std::set<int>&                                      triangles1, 
-    std::set<int>&                                      triangles2) const 
+    Array_<int>&                                        triangles1, 
+    Array_<int>&                                        triangles2) const 
 {   // See if the bounding boxes intersect.
     
     if (!node1.getBounds().intersectsBox(node2Bounds_M1))
@@ -1071,14 +1114,14 @@ findIntersectingFaces
                 X_M1M2*node2.getFirstChildNode().getBounds();
             const OrientedBoundingBox secondChildBounds = 
                 X_M1M2*node2.getSecondChildNode().getBounds();
-            findIntersectingFaces(mesh1, mesh2, node1.getFirstChildNode(), node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2);
-            findIntersectingFaces(mesh1, mesh2, node1.getFirstChildNode(), node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2);
-            findIntersectingFaces(mesh1, mesh2, node1.getSecondChildNode(), node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2);
-            findIntersectingFaces(mesh1, mesh2, node1.getSecondChildNode(), node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2);
+            findCandidateFaces(mesh1, mesh2, node1.getFirstChildNode(), node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2);
+            findCandidateFaces(mesh1, mesh2, node1.getFirstChildNode(), node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2);
+            findCandidateFaces(mesh1, mesh2, node1.getSecondChildNode(), node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2);
+            findCandidateFaces(mesh1, mesh2, node1.getSecondChildNode(), node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2);
         }
         else {
-            findIntersectingFaces(mesh1, mesh2, node1.getFirstChildNode(), node2, node2Bounds_M1, X_M1M2, triangles1, triangles2);
-            findIntersectingFaces(mesh1, mesh2, node1.getSecondChildNode(), node2, node2Bounds_M1, X_M1M2, triangles1, triangles2);
+            findCandidateFaces(mesh1, mesh2, node1.getFirstChildNode(), node2, node2Bounds_M1, X_M1M2, triangles1, triangles2);
+            findCandidateFaces(mesh1, mesh2, node1.getSecondChildNode(), node2, node2Bounds_M1, X_M1M2, triangles1, triangles2);
         }
         return;
     }
@@ -1087,32 +1130,20 @@ findIntersectingFaces
             X_M1M2*node2.getFirstChildNode().getBounds();
         const OrientedBoundingBox secondChildBounds = 
             X_M1M2*node2.getSecondChildNode().getBounds();
-        findIntersectingFaces(mesh1, mesh2, node1, node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2);
-        findIntersectingFaces(mesh1, mesh2, node1, node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2);
+        findCandidateFaces(mesh1, mesh2, node1, node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2);
+        findCandidateFaces(mesh1, mesh2, node1, node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2);
         return;
     }
     
-    // These are both leaf nodes, so check triangles for intersections.
+    // These are both leaf nodes, so every pair of their triangles is a
+    // candidate.
     
     const Array_<int>& node1triangles = node1.getTriangles();
     const Array_<int>& node2triangles = node2.getTriangles();
     for (unsigned i = 0; i < node2triangles.size(); i++) {
-        const int face2 = node2triangles[i];
-        Vec3 a1 = X_M1M2*mesh2.getVertexPosition(mesh2.getFaceVertex(face2, 0));
-        Vec3 a2 = X_M1M2*mesh2.getVertexPosition(mesh2.getFaceVertex(face2, 1));
-        Vec3 a3 = X_M1M2*mesh2.getVertexPosition(mesh2.getFaceVertex(face2, 2));
-        const Geo::Triangle A(a1,a2,a3);
         for (unsigned j = 0; j < node1triangles.size(); j++) {
-            const int face1 = node1triangles[j];
-            const Vec3& b1 = mesh1.getVertexPosition(mesh1.getFaceVertex(face1, 0));
-            const Vec3& b2 = mesh1.getVertexPosition(mesh1.getFaceVertex(face1, 1));
-            const Vec3& b3 = mesh1.getVertexPosition(mesh1.getFaceVertex(face1, 2));
-            const Geo::Triangle B(b1,b2,b3);
-            if (A.overlapsTriangle(B)) 
-            {   // The triangles intersect.
-                triangles1.insert(face1);
-                triangles2.insert(face2);
-            }
+            triangles1.push_back(node1triangles[j]);
+            triangles2.push_back(node2triangles[i]);
         }
     }
 }
@@ -56,6 +56,117 @@ overlapsTriangle(const Triangle_<P>& other) const {
         &other.v[0][0], &other.v[1][0], &other.v[2][0]);
 }
 
+template <class P> 
+Vec<3,P> Geo::Triangle_<P>::
+findNearestPoint(const Vec3P& position, Vec2P& uv) const {
+    // This algorithm is based on a description by David Eberly found at 
+    // http://www.geometrictools.com/Documentation/DistancePoint3Triangle3.pdf.
+    // It is the same as ContactGeometry::TriangleMesh::findNearestPointToFace()
+    // and is repeated lane by lane in Geo_TriangleBatch.cpp; keep them in
+    // step.
+    const Vec3P e0 = v[1]-v[0];
+    const Vec3P e1 = v[2]-v[0];
+    const Vec3P delta = v[0]-position;
+    const RealP a = e0.normSqr();
+    const RealP b = ~e0*e1;
+    const RealP c = e1.normSqr();
+    const RealP d = ~e0*delta;
+    const RealP e = ~e1*delta;
+    const RealP det = a*c-b*b;
+    RealP s = b*e-c*d;
+    RealP t = b*d-a*e;
+    if (s+t <= det) {
+        if (s < 0) {
+            if (t < 0) { // region 4
+                if (d < 0) {
+                    s = (-d >= a ? 1 : -d/a);
+                    t = 0;
+                } else {
+                    s = 0;
+                    t = (e >= 0 ? 0 : (-e >= c ? 1 : -e/c));
+                }
+            } else { // region 3
+                s = 0;
+                t = (e >= 0 ? 0 : (-e >= c ? 1 : -e/c));
+            }
+        } else if (t < 0) { // region 5
+            s = (d >= 0 ? 0 : (-d >= a ? 1 : -d/a));
+            t = 0;
+        } else { // region 0
+            const RealP invDet = RealP(1)/det;
+            s *= invDet;
+            t *= invDet;
+        }
+    } else {
+        if (s < 0) { // region 2
+            const RealP temp0 = b+d;
+            const RealP temp1 = c+e;
+            if (temp1 > temp0) {
+                const RealP numer = temp1-temp0;
+                const RealP denom = a-2*b+c;
+                s = (numer >= denom ? 1 : numer/denom);
+                t = 1-s;
+            } else {
+                s = 0;
+                t = (temp1 <= 0 ? 1 : (e >= 0 ? 0 : -e/c));
+            }
+        } else if (t < 0) { // region 6
+            const RealP temp0 = b+e;
+            const RealP temp1 = a+d;
+            if (temp1 > temp0) {
+                const RealP numer = temp1-temp0;
+                const RealP denom = a-2*b+c;
+                t = (numer >= denom ? 1 : numer/denom);
+                s = 1-t;
+            } else {
+                s = (temp1 <= 0 ? 1 : (e >= 0 ? 0 : -d/a));
+                t = 0;
+            }
+        } else { // region 1
+            const RealP numer = c+e-b-d;
+            if (numer <= 0)
+                s = 0;
+            else {
+                const RealP denom = a-2*b+c;
+                s = (numer >= denom ? 1 : numer/denom);
+            }
+            t = 1-s;
+        }
+    }
+    uv = Vec2P(1-s-t, s);
+    return v[0] + s*e0 + t*e1;
+}
+
+// This is the Moller-Trumbore algorithm. It is repeated lane by lane in 
+// Geo_TriangleBatch.cpp; keep them in step.
+template <class P> 
+bool Geo::Triangle_<P>::
+intersectsRay(const Vec3P& origin, const UnitVec3P& direction, 
+              RealP& distance, Vec2P& uv) const {
+    const Vec3P& d = direction.asVec3();
+    const Vec3P e1 = v[1]-v[0];
+    const Vec3P e2 = v[2]-v[0];
+    const Vec3P pvec = d % e2;
+    const RealP det = ~e1*pvec;
+    if (det == 0)
+        return false; // the ray is parallel to the plane
+    const RealP ooDet = 1/det;
+    const Vec3P tvec = origin-v[0];
+    const RealP u = (~tvec*pvec)*ooDet;
+    if (u < 0 || u > 1)
+        return false;
+    const Vec3P qvec = tvec % e1;
+    const RealP w = (~d*qvec)*ooDet;
+    if (w < 0 || u+w > 1)
+        return false;
+    const RealP t = (~e2*qvec)*ooDet;
+    if (t < 0)
+        return false; // the triangle is behind the ray
+    distance = t;
+    uv = Vec2P(1-u-w, u);
+    return true;
+}
+
 template <class P> 
 bool Geo::Triangle_<P>::
 intersectsTriangle(const Triangle_<P>& other, LineSeg_<P>& seg,
@@ -0,0 +1,481 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/** @file
+Non-inline methods from the Geo::TriangleBatch class. **/
+
+#include "SimTKcommon.h"
+#include "simmath/internal/common.h"
+#include "simmath/internal/Geo.h"
+#include "simmath/internal/Geo_Triangle.h"
+#include "simmath/internal/Geo_TriangleBatch.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define SimTK_GEO_BATCH_AVX
+#elif defined(__SSE2__) || defined(_M_X64) \
+      || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SimTK_GEO_BATCH_SSE2
+#endif
+
+namespace SimTK {
+
+//==============================================================================
+//                                  LANES
+//==============================================================================
+// The kernels below are written once, as templates over a "lanes" type that
+// says how many triangles are processed at a time and supplies the operations
+// on a lane Value and on a lane comparison Mask. Arithmetic and comparisons
+// use the ordinary operators; the rest are static members:
+//   load(p)         lanes from consecutive memory at p (need not be aligned)
+//   store(p, a)     lanes to consecutive memory at p
+//   set(x)          x in every lane
+//   select(m, a, b) a where m is set, otherwise b
+//   bits(m)         bit j set if lane j of m is set
+// The kernels do the same floating point operations in the same order as the
+// scalar Geo::Triangle_ methods, so any lanes type gives the same answers.
+
+namespace {
+
+// One lane. This is the fallback when there is no vector instruction set, and
+// is also used for the leftover triangles at the end of a batch.
+template <class P>
+struct Lanes1 {
+    static const int Width = 1;
+    typedef P       Value;
+    typedef bool    Mask;
+    static Value load(const P* p)                  {return *p;}
+    static void  store(P* p, Value a)              {*p = a;}
+    static Value set(P x)                          {return x;}
+    static Value select(Mask m, Value a, Value b)  {return m ? a : b;}
+    static int   bits(Mask m)                      {return m ? 1 : 0;}
+};
+
+// The widest lanes available for precision P.
+template <class P> struct WideLanes {typedef Lanes1<P> Type;};
+
+#if defined(SimTK_GEO_BATCH_AVX)
+
+// Four doubles at a time.
+struct LanesAVX {
+    static const int Width = 4;
+    struct Value {__m256d v;};
+    struct Mask  {__m256d m;};
+    static Value load(const double* p)      {Value r={_mm256_loadu_pd(p)};
+                                             return r;}
+    static void  store(double* p, Value a)  {_mm256_storeu_pd(p, a.v);}
+    static Value set(double x)              {Value r={_mm256_set1_pd(x)};
+                                             return r;}
+    static Value select(Mask m, Value a, Value b)
+    {   Value r={_mm256_blendv_pd(b.v, a.v, m.m)}; return r; }
+    static int   bits(Mask m)               {return _mm256_movemask_pd(m.m);}
+};
+
+typedef LanesAVX::Value VAVX;
+typedef LanesAVX::Mask  MAVX;
+inline VAVX operator+(VAVX a, VAVX b)
+{   VAVX r={_mm256_add_pd(a.v,b.v)}; return r; }
+inline VAVX operator-(VAVX a, VAVX b)
+{   VAVX r={_mm256_sub_pd(a.v,b.v)}; return r; }
+inline VAVX operator*(VAVX a, VAVX b)
+{   VAVX r={_mm256_mul_pd(a.v,b.v)}; return r; }
+inline VAVX operator/(VAVX a, VAVX b)
+{   VAVX r={_mm256_div_pd(a.v,b.v)}; return r; }
+inline VAVX operator-(VAVX a)
+{   VAVX r={_mm256_xor_pd(a.v,_mm256_set1_pd(-0.0))}; return r; }
+inline MAVX operator<(VAVX a, VAVX b)
+{   MAVX r={_mm256_cmp_pd(a.v,b.v,_CMP_LT_OQ)}; return r; }
+inline MAVX operator<=(VAVX a, VAVX b)
+{   MAVX r={_mm256_cmp_pd(a.v,b.v,_CMP_LE_OQ)}; return r; }
+inline MAVX operator>(VAVX a, VAVX b)
+{   MAVX r={_mm256_cmp_pd(a.v,b.v,_CMP_GT_OQ)}; return r; }
+inline MAVX operator>=(VAVX a, VAVX b)
+{   MAVX r={_mm256_cmp_pd(a.v,b.v,_CMP_GE_OQ)}; return r; }
+inline MAVX operator!=(VAVX a, VAVX b)
+{   MAVX r={_mm256_cmp_pd(a.v,b.v,_CMP_NEQ_UQ)}; return r; }
+inline MAVX operator&(MAVX a, MAVX b)
+{   MAVX r={_mm256_and_pd(a.m,b.m)}; return r; }
+inline MAVX operator|(MAVX a, MAVX b)
+{   MAVX r={_mm256_or_pd(a.m,b.m)}; return r; }
+inline MAVX operator!(MAVX a)
+{   MAVX r={_mm256_xor_pd(a.m,_mm256_castsi256_pd(_mm256_set1_epi64x(-1)))};
+    return r; }
+
+template <> struct WideLanes<double> {typedef LanesAVX Type;};
+
+#elif defined(SimTK_GEO_BATCH_SSE2)
+
+// Two doubles at a time.
+struct LanesSSE2 {
+    static const int Width = 2;
+    struct Value {__m128d v;};
+    struct Mask  {__m128d m;};
+    static Value load(const double* p)      {Value r={_mm_loadu_pd(p)};
+                                             return r;}
+    static void  store(double* p, Value a)  {_mm_storeu_pd(p, a.v);}
+    static Value set(double x)              {Value r={_mm_set1_pd(x)};
+                                             return r;}
+    static Value select(Mask m, Value a, Value b)
+    {   Value r={_mm_or_pd(_mm_and_pd(m.m,a.v), _mm_andnot_pd(m.m,b.v))};
+        return r; }
+    static int   bits(Mask m)               {return _mm_movemask_pd(m.m);}
+};
+
+typedef LanesSSE2::Value VSSE;
+typedef LanesSSE2::Mask  MSSE;
+inline VSSE operator+(VSSE a, VSSE b)
+{   VSSE r={_mm_add_pd(a.v,b.v)}; return r; }
+inline VSSE operator-(VSSE a, VSSE b)
+{   VSSE r={_mm_sub_pd(a.v,b.v)}; return r; }
+inline VSSE operator*(VSSE a, VSSE b)
+{   VSSE r={_mm_mul_pd(a.v,b.v)}; return r; }
+inline VSSE operator/(VSSE a, VSSE b)
+{   VSSE r={_mm_div_pd(a.v,b.v)}; return r; }
+inline VSSE operator-(VSSE a)
+{   VSSE r={_mm_xor_pd(a.v,_mm_set1_pd(-0.0))}; return r; }
+inline MSSE operator<(VSSE a, VSSE b)
+{   MSSE r={_mm_cmplt_pd(a.v,b.v)}; return r; }
+inline MSSE operator<=(VSSE a, VSSE b)
+{   MSSE r={_mm_cmple_pd(a.v,b.v)}; return r; }
+inline MSSE operator>(VSSE a, VSSE b)
+{   MSSE r={_mm_cmpgt_pd(a.v,b.v)}; return r; }
+inline MSSE operator>=(VSSE a, VSSE b)
+{   MSSE r={_mm_cmpge_pd(a.v,b.v)}; return r; }
+inline MSSE operator!=(VSSE a, VSSE b)
+{   MSSE r={_mm_cmpneq_pd(a.v,b.v)}; return r; }
+inline MSSE operator&(MSSE a, MSSE b)
+{   MSSE r={_mm_and_pd(a.m,b.m)}; return r; }
+inline MSSE operator|(MSSE a, MSSE b)
+{   MSSE r={_mm_or_pd(a.m,b.m)}; return r; }
+inline MSSE operator!(MSSE a)
+{   MSSE r={_mm_xor_pd(a.m,_mm_castsi128_pd(_mm_set1_epi32(-1)))}; return r; }
+
+template <> struct WideLanes<double> {typedef LanesSSE2 Type;};
+
+#endif
+
+//==============================================================================
+//                                 KERNELS
+//==============================================================================
+// Each triangle is given as its nine vertex coordinates v[3*vx+coord].
+
+template <class V> inline void
+sub3(V d[3], const V a[3], const V b[3])
+{   d[0]=a[0]-b[0]; d[1]=a[1]-b[1]; d[2]=a[2]-b[2]; }
+
+template <class V> inline void
+cross3(V d[3], const V a[3], const V b[3]) {
+    d[0]=a[1]*b[2]-a[2]*b[1];
+    d[1]=a[2]*b[0]-a[0]*b[2];
+    d[2]=a[0]*b[1]-a[1]*b[0];
+}
+
+template <class V> inline V
+dot3(const V a[3], const V b[3])
+{   return a[0]*b[0]+a[1]*b[1]+a[2]*b[2]; }
+
+// Load the nine vertex coordinates of the triangles starting at index i.
+template <class L, class P> inline void
+loadTriangles(const Geo::TriangleBatch_<P>& batch, int i,
+              typename L::Value v[9]) {
+    for (int vx=0; vx < 3; ++vx)
+        for (int c=0; c < 3; ++c)
+            v[3*vx+c] = L::load(batch.getCoordinates(vx,c) + i);
+}
+
+// Return false for a pair of triangles that can't overlap because the
+// vertices of one lie strictly on one side of the plane of the other. These
+// are the first two tests in tri_tri_overlap_test_3d() in Geo_Triangle.cpp,
+// for which triangle 1 (p1,q1,r1) is "this" triangle and triangle 2 is
+// "other", and must be kept consistent with that.
+template <class L> typename L::Mask
+mayOverlap(const typename L::Value t1[9], const typename L::Value t2[9]) {
+    typedef typename L::Value V;
+    const V zero = L::set(0);
+    const V *p1=t1, *q1=t1+3, *r1=t1+6;
+    const V *p2=t2, *q2=t2+3, *r2=t2+6;
+    V v1[3], v2[3], N1[3], N2[3];
+
+    sub3(v1,p2,r2); sub3(v2,q2,r2); cross3(N2,v1,v2);
+    sub3(v1,p1,r2); const V dp1 = dot3(v1,N2);
+    sub3(v1,q1,r2); const V dq1 = dot3(v1,N2);
+    sub3(v1,r1,r2); const V dr1 = dot3(v1,N2);
+
+    sub3(v1,q1,p1); sub3(v2,r1,p1); cross3(N1,v1,v2);
+    sub3(v1,p2,r1); const V dp2 = dot3(v1,N1);
+    sub3(v1,q2,r1); const V dq2 = dot3(v1,N1);
+    sub3(v1,r2,r1); const V dr2 = dot3(v1,N1);
+
+    return !(   ((dp1*dq1 > zero) & (dp1*dr1 > zero))
+              | ((dp2*dq2 > zero) & (dp2*dr2 > zero)));
+}
+
+// Return the squared distance from point x to the nearest point of a
+// triangle. This is Triangle_::findNearestPoint() (and
+// TriangleMesh::findNearestPointToFace()) with each of the seven regions
+// computed for every lane and the right one selected at the end.
+template <class L> typename L::Value
+calcDistanceSqr(const typename L::Value x[3], const typename L::Value v[9]) {
+    typedef typename L::Value V;
+    typedef typename L::Mask  M;
+    const V zero = L::set(0), one = L::set(1), two = L::set(2);
+
+    V e0[3], e1[3], delta[3];
+    sub3(e0, v+3, v); sub3(e1, v+6, v); sub3(delta, v, x);
+    const V a = dot3(e0,e0), b = dot3(e0,e1), c = dot3(e1,e1);
+    const V d = dot3(e0,delta), e = dot3(e1,delta);
+    const V det = a*c-b*b;
+    const V s0 = b*e-c*d, t0 = b*d-a*e;
+    const M inside = s0+t0 <= det, sneg = s0 < zero, tneg = t0 < zero;
+
+    const V negD = -d, negE = -e;
+    const V clampD = L::select(negD >= a, one, negD/a);
+    const V clampE = L::select(negE >= c, one, negE/c);
+    const V edgeE  = L::select(e >= zero, zero, clampE);
+    const V denom  = a-two*b+c;
+
+    // Region 4; region 3 is (0, edgeE).
+    const M dneg = d < zero;
+    const V s4 = L::select(dneg, clampD, zero);
+    const V t4 = L::select(dneg, zero, edgeE);
+    // Region 5; t is 0.
+    const V s5 = L::select(d >= zero, zero, clampD);
+    // Region 0.
+    const V invDet = one/det;
+    const V sIn0 = s0*invDet, tIn0 = t0*invDet;
+    // Region 2.
+    const V temp0a = b+d, temp1a = c+e;
+    const V numer2 = temp1a-temp0a;
+    const V clamp2 = L::select(numer2 >= denom, one, numer2/denom);
+    const M above2 = temp1a > temp0a;
+    const V s2 = L::select(above2, clamp2, zero);
+    const V t2 = L::select(above2, one-clamp2,
+                     L::select(temp1a <= zero, one,
+                         L::select(e >= zero, zero, negE/c)));
+    // Region 6.
+    const V temp0b = b+e, temp1b = a+d;
+    const V numer6 = temp1b-temp0b;
+    const V clamp6 = L::select(numer6 >= denom, one, numer6/denom);
+    const M above6 = temp1b > temp0b;
+    const V t6 = L::select(above6, clamp6, zero);
+    const V s6 = L::select(above6, one-clamp6,
+                     L::select(temp1b <= zero, one,
+                         L::select(e >= zero, zero, negD/a)));
+    // Region 1.
+    const V numer1 = c+e-b-d;
+    const V s1 = L::select(numer1 <= zero, zero,
+                     L::select(numer1 >= denom, one, numer1/denom));
+    const V t1 = one-s1;
+
+    const V sIn  = L::select(sneg, L::select(tneg, s4, zero),
+                                   L::select(tneg, s5, sIn0));
+    const V tIn  = L::select(sneg, L::select(tneg, t4, edgeE),
+                                   L::select(tneg, zero, tIn0));
+    const V sOut = L::select(sneg, s2, L::select(tneg, s6, s1));
+    const V tOut = L::select(sneg, t2, L::select(tneg, t6, t1));
+    const V s = L::select(inside, sIn, sOut);
+    const V t = L::select(inside, tIn, tOut);
+
+    V offset[3];
+    for (int k=0; k < 3; ++k)
+        offset[k] = v[k] + s*e0[k] + t*e1[k] - x[k];
+    return dot3(offset,offset);
+}
+
+// Intersect a ray with a triangle, returning a mask of the lanes that hit and
+// the distance and (u,w) location of the hit, where the hit point is
+// v0 + u*(v1-v0) + w*(v2-v0). This is Triangle_::intersectsRay().
+template <class L> typename L::Mask
+intersectRay(const typename L::Value origin[3],
+             const typename L::Value direction[3],
+             const typename L::Value v[9],
+             typename L::Value& dist, typename L::Value& u,
+             typename L::Value& w) {
+    typedef typename L::Value V;
+    const V zero = L::set(0), one = L::set(1);
+    V e1[3], e2[3], pvec[3], tvec[3], qvec[3];
+    sub3(e1, v+3, v); sub3(e2, v+6, v);
+    cross3(pvec, direction, e2);
+    const V det = dot3(e1,pvec);
+    const V ooDet = one/det;
+    sub3(tvec, origin, v);
+    u = dot3(tvec,pvec)*ooDet;
+    cross3(qvec, tvec, e1);
+    w = dot3(direction,qvec)*ooDet;
+    dist = dot3(e2,qvec)*ooDet;
+    return (det != zero) & (u >= zero) & (u <= one) & (w >= zero)
+           & (u+w <= one) & (dist >= zero);
+}
+
+//==============================================================================
+//                                 DRIVERS
+//==============================================================================
+// Each of these processes triangles [begin,end) of a batch, L::Width at a
+// time; end-begin must be a multiple of L::Width.
+
+template <class L, class P> void
+findOverlappingPairsInRange(const Geo::TriangleBatch_<P>& batch1,
+                            const Geo::TriangleBatch_<P>& batch2,
+                            int begin, int end, Array_<int>& overlapping) {
+    typename L::Value t1[9], t2[9];
+    for (int i=begin; i < end; i += L::Width) {
+        loadTriangles<L>(batch1, i, t1);
+        loadTriangles<L>(batch2, i, t2);
+        int bits = L::bits(mayOverlap<L>(t1, t2));
+        // The survivors get the full test.
+        for (int j=i; bits; ++j, bits >>= 1)
+            if ((bits & 1) && batch1.getTriangle(j)
+                                    .overlapsTriangle(batch2.getTriangle(j)))
+                overlapping.push_back(j);
+    }
+}
+
+template <class L, class P> void
+calcDistanceSqrInRange(const Geo::TriangleBatch_<P>& batch,
+                       const Vec<3,P>& point, int begin, int end,
+                       P* distanceSqr) {
+    typedef typename L::Value V;
+    const V x[3] = {L::set(point[0]), L::set(point[1]), L::set(point[2])};
+    V v[9];
+    for (int i=begin; i < end; i += L::Width) {
+        loadTriangles<L>(batch, i, v);
+        L::store(distanceSqr+i, calcDistanceSqr<L>(x, v));
+    }
+}
+
+template <class L, class P> void
+findTrianglesNearPointInRange(const Geo::TriangleBatch_<P>& batch,
+                              const Vec<3,P>& point, P distanceSqr,
+                              int begin, int end, Array_<int>& near) {
+    typedef typename L::Value V;
+    const V x[3] = {L::set(point[0]), L::set(point[1]), L::set(point[2])};
+    const V limit = L::set(distanceSqr);
+    V v[9];
+    for (int i=begin; i < end; i += L::Width) {
+        loadTriangles<L>(batch, i, v);
+        int bits = L::bits(calcDistanceSqr<L>(x, v) < limit);
+        for (int j=i; bits; ++j, bits >>= 1)
+            if (bits & 1)
+                near.push_back(j);
+    }
+}
+
+// Update distance, which, and (u,w) if a triangle in the range is hit closer
+// than distance.
+template <class L, class P> void
+findRayIntersectionInRange(const Geo::TriangleBatch_<P>& batch,
+                           const Vec<3,P>& origin, const Vec<3,P>& direction,
+                           int begin, int end,
+                           P& distance, int& which, P& u, P& w) {
+    typedef typename L::Value V;
+    const V o[3] = {L::set(origin[0]), L::set(origin[1]), L::set(origin[2])};
+    const V d[3] = {L::set(direction[0]), L::set(direction[1]),
+                    L::set(direction[2])};
+    V v[9], dist, uLanes, wLanes;
+    P distOut[L::Width], uOut[L::Width], wOut[L::Width];
+    for (int i=begin; i < end; i += L::Width) {
+        loadTriangles<L>(batch, i, v);
+        int bits = L::bits(intersectRay<L>(o, d, v, dist, uLanes, wLanes));
+        if (!bits) continue;
+        L::store(distOut, dist); L::store(uOut, uLanes); L::store(wOut, wLanes);
+        for (int j=0; bits; ++j, bits >>= 1)
+            if ((bits & 1) && distOut[j] < distance) {
+                distance = distOut[j]; which = i+j;
+                u = uOut[j]; w = wOut[j];
+            }
+    }
+}
+
+} // anonymous namespace
+
+
+
+//==============================================================================
+//                          GEO :: TRIANGLE BATCH
+//==============================================================================
+// Each method runs the wide lanes over as much of the batch as they fit,
+// then one lane at a time over the rest.
+
+template <class P> int Geo::TriangleBatch_<P>::
+findOverlappingPairs(const TriangleBatch_<P>& other,
+                     Array_<int>& overlapping) const {
+    SimTK_APIARGCHECK2_ALWAYS(other.size() == size(), "Geo::TriangleBatch_",
+        "findOverlappingPairs", "The other batch has %d triangles but this one "
+        "has %d; they must be the same size.", other.size(), size());
+    typedef typename WideLanes<P>::Type Wide;
+    const int n = size(), nWide = n - n % Wide::Width;
+    const int nBefore = (int)overlapping.size();
+    findOverlappingPairsInRange<Wide>(*this, other, 0, nWide, overlapping);
+    findOverlappingPairsInRange<Lanes1<P> >(*this, other, nWide, n,
+                                            overlapping);
+    return (int)overlapping.size() - nBefore;
+}
+
+template <class P> int Geo::TriangleBatch_<P>::
+findTrianglesNearPoint(const Vec3P& point, RealP distanceSqr,
+                       Array_<int>& near) const {
+    typedef typename WideLanes<P>::Type Wide;
+    const int n = size(), nWide = n - n % Wide::Width;
+    const int nBefore = (int)near.size();
+    findTrianglesNearPointInRange<Wide>(*this, point, distanceSqr, 0, nWide,
+                                        near);
+    findTrianglesNearPointInRange<Lanes1<P> >(*this, point, distanceSqr,
+                                              nWide, n, near);
+    return (int)near.size() - nBefore;
+}
+
+template <class P> void Geo::TriangleBatch_<P>::
+calcDistanceSqrToPoint(const Vec3P& point, Array_<RealP>& distanceSqr) const {
+    typedef typename WideLanes<P>::Type Wide;
+    const int n = size(), nWide = n - n % Wide::Width;
+    distanceSqr.resize(n);
+    calcDistanceSqrInRange<Wide>(*this, point, 0, nWide, distanceSqr.begin());
+    calcDistanceSqrInRange<Lanes1<P> >(*this, point, nWide, n,
+                                       distanceSqr.begin());
+}
+
+template <class P> bool Geo::TriangleBatch_<P>::
+findRayIntersection(const Vec3P& origin, const UnitVec3P& direction,
+                    RealP& distance, int& which, Vec2P& uv) const {
+    typedef typename WideLanes<P>::Type Wide;
+    const int n = size(), nWide = n - n % Wide::Width;
+    RealP bestDistance = NTraits<P>::getInfinity(), u = 0, w = 0;
+    int best = -1;
+    findRayIntersectionInRange<Wide>(*this, origin, direction.asVec3(),
+        0, nWide, bestDistance, best, u, w);
+    findRayIntersectionInRange<Lanes1<P> >(*this, origin, direction.asVec3(),
+        nWide, n, bestDistance, best, u, w);
+    if (best < 0)
+        return false;
+    distance = bestDistance;
+    which = best;
+    uv = Vec2P(1-u-w, u);
+    return true;
+}
+
+// Explicit instantiations for float and double.
+template class Geo::TriangleBatch_<float>;
+template class Geo::TriangleBatch_<double>;
+
+} // namespace SimTK
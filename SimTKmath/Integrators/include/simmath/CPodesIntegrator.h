@@ -73,6 +73,138 @@ public:
      * again with a larger value will fail.
      */
     void setOrderLimit(int order);
+
+    /**
+     * The ways in which the linear systems that arise in the Newton iteration of an implicit method
+     * can be solved. These have no effect when using functional iteration.
+     */
+    enum LinearSolver {
+        /**
+         * Form the full ny X ny Jacobian of ydot by finite differences, which takes ny derivative
+         * evaluations, and factor it with dense LU at a cost of O(ny^3). This is the default and is
+         * the best choice for small systems.
+         */
+        DenseLinearSolver,
+        /**
+         * Form and factor a banded Jacobian with the half-bandwidths given to setJacobianBandwidth(). This
+         * takes only upper+lower+1 derivative evaluations and O(ny*lower*(upper+lower)) time. Note that y is
+         * ordered q, u, z so any coupling between a q and its u lies nq entries off the diagonal; this
+         * is most useful when most of the state is in z variables that are coupled only to their 
+         * neighbors.
+         */
+        BandLinearSolver,
+        /**
+         * Solve with matrix-free GMRES, calculating Jacobian-vector products by finite differences, and
+         * a block diagonal preconditioner over the generalized speeds u and auxiliary variables z. The 
+         * preconditioner approximates the Newton matrix eliminated onto (u,z) using qdot=N*u, that is, 
+         * I - gamma*dwdot/dw - gamma^2*dudot/dq*N with w=(u,z). For a multibody system dudot/du and 
+         * dudot/dq are the mass matrix inverse times the force partials. Only the diagonal blocks of 
+         * size setPreconditionerBlockSize() are formed, taking two derivative evaluations per column of 
+         * a block, and they are reused until CPODES decides that the Jacobian is out of date. This is 
+         * the best choice for large systems.
+         */
+        KrylovLinearSolver
+    };
+    /**
+     * Select how the linear systems in the Newton iteration are solved. The change takes effect the
+     * next time the integrator is initialized.
+     */
+    void setLinearSolver(LinearSolver solver);
+    /**
+     * Get the method being used to solve the Newton iteration's linear systems.
+     */
+    LinearSolver getLinearSolver() const;
+    /**
+     * Set the upper and lower half-bandwidths of the Jacobian for use with BandLinearSolver. Entries
+     * outside the band are ignored, which slows convergence of the Newton iteration if they are 
+     * significant. You must call this before initializing an integrator that uses BandLinearSolver.
+     */
+    void setJacobianBandwidth(int upper, int lower);
+    /**
+     * Set the maximum dimension of the Krylov subspace used by KrylovLinearSolver. The default is 5.
+     */
+    void setKrylovSubspaceDimension(int maxl);
+    /**
+     * Set the size of the diagonal blocks of the preconditioner used by KrylovLinearSolver. Larger
+     * blocks capture more of the coupling between neighboring mobilities, at a cost of two derivative 
+     * evaluations per block column each time the preconditioner is rebuilt. The default is 6.
+     */
+    void setPreconditionerBlockSize(int blockSize);
+    /**
+     * Get the number of times a Jacobian (or, for KrylovLinearSolver, the preconditioner's Jacobian 
+     * blocks) has been calculated.
+     */
+    int getNumJacobianEvaluations() const;
+    /**
+     * Get the total number of linear iterations performed by KrylovLinearSolver. This is zero for
+     * the direct solvers.
+     */
+    int getNumLinearSolverIterations() const;
+
+    /**
+     * An object that calculates the Jacobian dydot/dy for DenseLinearSolver or BandLinearSolver
+     * in place of finite differencing. Derive from this to supply an analytic or semi-analytic
+     * Jacobian for your System, for example one assembled from SimbodyMatterSubsystem operators
+     * and the partial derivatives of your force elements.
+     */
+    class JacobianProvider {
+    public:
+        virtual ~JacobianProvider() {}
+        /**
+         * Calculate J = dydot/dy at the given State, which has been realized through
+         * Stage::Acceleration. J has already been sized ny X ny, and still holds whatever this
+         * method left in it last time. Throw an exception if J can't be calculated; the integrator
+         * will then retry with a smaller step.
+         */
+        virtual void calcJacobian(const System& system, const State& state, Matrix& J) const = 0;
+    };
+    /**
+     * The ways the direct linear solvers can calculate the Jacobian by finite differences when no
+     * JacobianProvider has been set.
+     */
+    enum JacobianMethod {
+        /**
+         * Let CPODES perturb each element of y in turn, setting the whole state and realizing it
+         * from Stage::Time for every column. This is the default.
+         */
+        FullDifferenceQuotient,
+        /**
+         * Perturb the q's the same way, but perturb each u or z in a copy of the state that has
+         * already been realized through Stage::Velocity, so that only the stages invalidated by
+         * that variable are recalculated. For a multibody system the position kinematics and mass
+         * properties are then calculated once per Jacobian rather than once per column. With
+         * BandLinearSolver, columns too far apart to share a row of the band are perturbed
+         * together, so a Jacobian takes only upper+lower+1 evaluations.
+         */
+        StageAwareDifferenceQuotient
+    };
+    /**
+     * Select how the Jacobian is calculated when no JacobianProvider has been set. The change takes
+     * effect the next time the integrator is initialized.
+     */
+    void setJacobianMethod(JacobianMethod method);
+    /**
+     * Get the way the Jacobian is calculated when no JacobianProvider has been set.
+     */
+    JacobianMethod getJacobianMethod() const;
+    /**
+     * Supply an object to calculate the Jacobian for the direct linear solvers. The integrator takes
+     * over ownership of the provider; pass null to go back to the method chosen by setJacobianMethod().
+     * The change takes effect the next time the integrator is initialized.
+     */
+    void setJacobianProvider(JacobianProvider* provider);
+    /**
+     * Set the maximum number of steps for which a Jacobian (or, for KrylovLinearSolver, the
+     * preconditioner's Jacobian blocks) is reused. CPODES calculates a new one sooner if the Newton
+     * iteration fails to converge or the step size changes too much. The default is 50. Larger values
+     * save Jacobian evaluations on problems whose Jacobian changes slowly.
+     */
+    void setMaxStepsBetweenJacobians(int steps);
+    /**
+     * Get the number of times the Newton matrix was rebuilt from a saved Jacobian (or saved 
+     * preconditioner blocks) rather than from a new one. Each of these is a Jacobian evaluation saved.
+     */
+    int getNumJacobianReuses() const;
 };
 
 } // namespace SimTK
@@ -0,0 +1,56 @@
+#ifndef SimTK_SIMMATH_DORMAND_PRINCE_INTEGRATOR_H_
+#define SimTK_SIMMATH_DORMAND_PRINCE_INTEGRATOR_H_
+
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simmath/internal/common.h"
+#include "simmath/Integrator.h"
+
+namespace SimTK {
+
+/**
+ * This is an Integrator based on the Dormand-Prince 5(4) Runge-Kutta pair
+ * (DOPRI5). It is an error controlled, fifth order explicit integrator.
+ *
+ * The last stage of each step is evaluated at the end of the step, so when
+ * the step needs no constraint projection it serves as the first stage of the
+ * next step and a step costs six evaluations rather than seven. The stages
+ * also provide a fourth order continuous extension at no extra cost. That is
+ * used for interpolated reports, calcInterpolatedY(), and for locating event
+ * triggers within a step, rather than the third order Hermite interpolation
+ * used by the other Runge-Kutta integrators. See Hairer, Norsett & Wanner,
+ * Solving Ordinary Differential Equations I, 2nd rev. ed., sec. II.6.
+ */
+
+class DormandPrinceIntegratorRep;
+
+class SimTK_SIMMATH_EXPORT DormandPrinceIntegrator : public Integrator {
+public:
+    explicit DormandPrinceIntegrator(const System& sys);
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMMATH_DORMAND_PRINCE_INTEGRATOR_H_
@@ -175,6 +175,31 @@ public:
     /// Get a non-const reference to the advanced state.
     State& updAdvancedState();
 
+    /// Return the earliest time for which calcInterpolatedY() can be used.
+    /// This is the start of the most recent internal step; the latest such
+    /// time is getAdvancedTime(). The two are the same right after
+    /// initialization or an event.
+    Real getInterpolationStartTime() const;
+
+    /// Calculate the continuous state variables y=(q,u,z) at time \a t using
+    /// the same interpolant the integrator uses to produce the interpolated
+    /// states returned by getState(). Here, though, only y is calculated: no
+    /// State is copied or realized, and y is not projected onto the
+    /// constraint manifold nor are prescribed q's and u's set. That makes
+    /// this a cheap way to sample the trajectory much more often than the
+    /// integrator steps; for example, use setReturnEveryInternalStep() and
+    /// after each step sample all the times that fall within it. If you need
+    /// more than y at some sample, copy y into a State of your own and realize
+    /// that. \a t must be in the range getInterpolationStartTime() to
+    /// getAdvancedTime(). \a y is resized only if it isn't already the right
+    /// size, so reusing it allocates no memory.
+    void calcInterpolatedY(Real t, Vector& y) const;
+
+    /// Calculate y(t) as above for each of the given \a times, placing
+    /// y(times[j]) in column j of the ny X times.size() Matrix \a Y, which is
+    /// resized if necessary.
+    void calcInterpolatedY(const Vector& times, Matrix& Y) const;
+
     /// Get the accuracy which is being used for error control.  Usually this is the same value that was
     /// specified to setAccuracy().
     Real getAccuracyInUse() const;
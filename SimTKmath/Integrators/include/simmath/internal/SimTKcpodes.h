@@ -69,7 +69,30 @@ public:
     virtual void errorHandler(int error_code, const char* module,
                               const char* function, char* msg) const;
 
-    //TODO: Jacobian functions
+    // These are used only with an iterative linear solver, and only if
+    // CPodes::spilsSetPreconditioner() was called. The preconditioner P 
+    // should approximate the Newton matrix I-gamma*J, where J=df/dy.
+    // precondSetup() is called when CPodes wants a new preconditioner.
+    // If jacIsCurrent is true the caller believes that Jacobian data saved
+    // from an earlier call may be reused with the new gamma; set 
+    // jacWasUpdated to say whether you recomputed it anyway. 
+    // precondSolve() solves P*z=r (lr is 1 for a left and 2 for a right 
+    // preconditioner solve); delta is a tolerance for iterative 
+    // preconditioners.
+    virtual int  precondSetup(Real t, const Vector& y, const Vector& fy,
+                              bool jacIsCurrent, bool& jacWasUpdated,
+                              Real gamma) const;
+    virtual int  precondSolve(Real t, const Vector& y, const Vector& fy,
+                              const Vector& r, Vector& z, 
+                              Real gamma, Real delta, int lr) const;
+
+    // This is used only with a direct linear solver, and only if
+    // CPodes::dlsSetJacobian() was called. Fill in J=df/dy at (t,y), where
+    // fy=f(t,y); J has already been sized ny X ny and still holds whatever
+    // was left in it by the previous call. With a band linear solver only the
+    // entries within the band are used.
+    virtual int  jacobian(Real t, const Vector& y, const Vector& fy,
+                          Matrix& J) const;
 };
 
 
@@ -111,6 +134,23 @@ static void errorHandler_static(const CPodesSystem& sys,
                                 const char* function, char* msg)
   { sys.errorHandler(error_code,module,function,msg); }
 
+static int precondSetup_static(const CPodesSystem& sys,
+                               Real t, const Vector& y, const Vector& fy,
+                               bool jacIsCurrent, bool& jacWasUpdated,
+                               Real gamma)
+  { return sys.precondSetup(t,y,fy,jacIsCurrent,jacWasUpdated,gamma); }
+
+static int precondSolve_static(const CPodesSystem& sys,
+                               Real t, const Vector& y, const Vector& fy,
+                               const Vector& r, Vector& z,
+                               Real gamma, Real delta, int lr)
+  { return sys.precondSolve(t,y,fy,r,z,gamma,delta,lr); }
+
+static int jacobian_static(const CPodesSystem& sys,
+                           Real t, const Vector& y, const Vector& fy,
+                           Matrix& J)
+  { return sys.jacobian(t,y,fy,J); }
+
 /**
  * This is a straightforward translation of the Sundials CPODES C 
  * interface into C++. The class CPodes represents a single instance
@@ -177,6 +217,14 @@ public:
         OneStepTstop
     };
 
+    enum PreconditionType {
+        UnspecifiedPreconditionType=0,
+        NoPreconditioning,
+        LeftPreconditioning,
+        RightPreconditioning,
+        BothPreconditioning
+    };
+
     explicit CPodes
        (ODEType                      ode=UnspecifiedODEType, 
         LinearMultistepMethod        lmm=UnspecifiedLinearMultistepMethod, 
@@ -247,6 +295,22 @@ public:
     // method from CPodesSystem.
     int setEwtFn();
 
+    // This tells CPodes to make use of the user's precondSetup() and
+    // precondSolve() methods from CPodesSystem. Call it after spgmr().
+    int spilsSetPreconditioner();
+    // Saved preconditioner Jacobian data is reused for at most this many
+    // steps (default 50). Call it after spgmr().
+    int spilsSetMaxStepsBetweenPrec(int msbpre);
+
+    // This tells CPodes to make use of the user's jacobian() method from
+    // CPodesSystem rather than difference quotients. Call it after 
+    // lapackDense() or lapackBand().
+    int dlsSetJacobian();
+    // A saved Jacobian is reused for at most this many steps (default 50),
+    // or until the Newton iteration fails to converge. Call it after 
+    // lapackDense() or lapackBand().
+    int dlsSetMaxStepsBetweenJac(int msbj);
+
     // TODO: these routines should enable methods that are defined
     // in the CPodesSystem, but a proper interface to the Jacobian
     // routines hasn't been implemented yet.
@@ -338,10 +402,21 @@ public:
     int dlsProjGetNumJacEvals(int* njPevals);
     int dlsProjGetNumFctEvals(int* ncevalsLS);
 
+    int spilsGetNumPrecEvals(int* npevals);
+    int spilsGetNumPrecSolves(int* npsolves);
+    int spilsGetNumLinIters(int* nliters);
+    int spilsGetNumConvFails(int* nlcfails);
+    int spilsGetNumFctEvals(int* nfevalsLS);
+
     int lapackDense(int N);
     int lapackBand(int N, int mupper, int mlower);
     int lapackDenseProj(int Nc, int Ny, ProjectionFactorizationType);
 
+    // Use matrix-free GMRES for the Newton iteration's linear systems, with
+    // Jacobian-vector products calculated by finite differences. maxl is 
+    // the maximum Krylov subspace dimension; 0 means use the default (5).
+    int spgmr(PreconditionType, int maxl);
+
 private:
     // This is how we get the client-side virtual functions to
     // be callable from library-side code while maintaining binary
@@ -366,6 +441,17 @@ private:
     typedef void (*ErrorHandlerFunc)(const CPodesSystem&, 
                                      int error_code, const char* module, 
                                      const char* function, char* msg);
+    typedef int (*PrecondSetupFunc)(const CPodesSystem&,
+                                    Real t, const Vector& y, const Vector& fy,
+                                    bool jacIsCurrent, bool& jacWasUpdated,
+                                    Real gamma);
+    typedef int (*PrecondSolveFunc)(const CPodesSystem&,
+                                    Real t, const Vector& y, const Vector& fy,
+                                    const Vector& r, Vector& z,
+                                    Real gamma, Real delta, int lr);
+    typedef int (*JacobianFunc)    (const CPodesSystem&,
+                                    Real t, const Vector& y, const Vector& fy,
+                                    Matrix& J);
 
     // Note that these routines do not tell CPodes to use the supplied
     // functions. They merely provide the client-side addresses of functions
@@ -383,6 +469,9 @@ private:
     void registerRootFunc(RootFunc);
     void registerWeightFunc(WeightFunc);
     void registerErrorHandlerFunc(ErrorHandlerFunc);
+    void registerPrecondSetupFunc(PrecondSetupFunc);
+    void registerPrecondSolveFunc(PrecondSolveFunc);
+    void registerJacobianFunc(JacobianFunc);
 
 
     // This is the library-side part of the CPodes constructor. This must
@@ -401,6 +490,9 @@ private:
         registerRootFunc(root_static);
         registerWeightFunc(weight_static);
         registerErrorHandlerFunc(errorHandler_static);
+        registerPrecondSetupFunc(precondSetup_static);
+        registerPrecondSolveFunc(precondSolve_static);
+        registerJacobianFunc(jacobian_static);
     }
 
     // FOR INTERNAL USE ONLY
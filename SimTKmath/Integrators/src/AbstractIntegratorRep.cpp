@@ -59,20 +59,15 @@ void AbstractIntegratorRep::methodInitialize(const State& state) {
 //==============================================================================
 // Create an interpolated state at time t, which is between tPrev and tCurrent.
 // If we haven't yet delivered an interpolated state in this interval, we have
-// to initialize its discrete part from the advanced state.
+// to initialize its discrete part from the advanced state. The continuous
+// part comes from the method's calcInterpolatedY().
 void AbstractIntegratorRep::createInterpolatedState(Real t) {
     const System& system   = getSystem();
     const State&  advanced = getAdvancedState();
     State&        interp   = updInterpolatedState();
     interp = advanced; // pick up discrete stuff.
 
-    // Hermite interpolation requires state derivatives so we must realize
-    // end-of-step derivatives if they haven't already been realized.
-    realizeStateDerivatives(advanced);
-
-    interpolateOrder3(getPreviousTime(),  getPreviousY(),  getPreviousYDot(),
-                      advanced.getTime(), advanced.getY(), advanced.getYDot(),
-                      t, interp.updY());
+    calcInterpolatedY(t, interp.updY());
     interp.updTime() = t;
 
     if (userProjectInterpolatedStates == 0) {
@@ -90,6 +85,29 @@ void AbstractIntegratorRep::createInterpolatedState(Real t) {
 }
 
 
+//==============================================================================
+//                           CALC INTERPOLATED Y
+//==============================================================================
+// The default implementation uses third order Hermite interpolation between
+// the saved start of the step and the advanced state.
+void AbstractIntegratorRep::calcInterpolatedY(Real t, Vector& y) const {
+    const State& advanced = getAdvancedState();
+    if (t == advanced.getTime()) { // includes the case tPrev==tAdvanced
+        y = advanced.getY();
+        return;
+    }
+
+    // Hermite interpolation requires state derivatives so we must realize
+    // end-of-step derivatives if they haven't already been realized.
+    realizeStateDerivatives(advanced);
+
+    interpolateOrder3(getPreviousTime(),  getPreviousY(),  getPreviousYDot(),
+                      advanced.getTime(), advanced.getY(), advanced.getYDot(),
+                      t, y);
+}
+
+
+
 //==============================================================================
 //                  BACK UP ADVANCED STATE BY INTERPOLATION
 //==============================================================================
@@ -100,16 +118,13 @@ void AbstractIntegratorRep::createInterpolatedState(Real t) {
 void AbstractIntegratorRep::backUpAdvancedStateByInterpolation(Real t) {
     const System& system   = getSystem();
     State& advanced = updAdvancedState();
-    Vector yinterp, dummy;
+    Vector yinterp;
 
     assert(getPreviousTime() <= t && t <= advanced.getTime());
 
-    // Hermite interpolation requires state derivatives so we must realize
-    // end-of-step derivatives if they haven't already been realized.
-    realizeStateDerivatives(advanced);
-    interpolateOrder3(getPreviousTime(),  getPreviousY(),  getPreviousYDot(),
-                      advanced.getTime(), advanced.getY(), advanced.getYDot(),
-                      t, yinterp);
+    // Use the same interpolant as for reporting so that the state we back
+    // up to is the one that was seen during event localization.
+    calcInterpolatedY(t, yinterp);
     advanced.updY() = yinterp;
     advanced.updTime() = t;
 
@@ -65,6 +65,11 @@ public:
     int getNumIterations() const override;
     void resetMethodStatistics() override;
     const char* getMethodName() const override;
+    /**
+     * Calculate y(t) for t between the previous and advanced times. The
+     * default implementation uses third order Hermite spline interpolation.
+     */
+    void calcInterpolatedY(Real t, Vector& y) const override;
     int getMethodMinOrder() const override;
     int getMethodMaxOrder() const override;
     bool methodHasErrorControl() const override;
@@ -141,8 +146,9 @@ protected:
                                 bool hWasArtificiallyLimited);
     /**
      * Create an interpolated state at time t, which is between the previous 
-     * and advanced times. The default implementation uses third order 
-     * Hermite spline interpolation.
+     * and advanced times. The default implementation copies the advanced
+     * state, fills in its continuous variables with calcInterpolatedY(), and
+     * then realizes or projects it as requested.
      */
     virtual void createInterpolatedState(Real t);
     /**
@@ -150,7 +156,7 @@ protected:
      * forgetting about the rest of the interval. This is necessary, for 
      * example, after we have localized an event trigger to an interval 
      * tLow:tHigh where tHigh < tAdvanced.  The default implementation uses 
-     * third order Hermite spline interpolation.
+     * calcInterpolatedY() and then projects the result.
      */
     virtual void backUpAdvancedStateByInterpolation(Real t);
     int statsStepsTaken, statsStepsAttempted, statsErrorTestFailures, statsConvergenceTestFailures;
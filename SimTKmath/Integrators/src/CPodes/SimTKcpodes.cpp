@@ -31,7 +31,9 @@
 #include "cpodes/cpodes.h"
 #include "cpodes/cpodes_dense.h"
 #include "cpodes/cpodes_lapack_exports.h"
+#include "cpodes/cpodes_spgmr.h"
 
+#include <algorithm>
 #include <limits>
 
 namespace SimTK {
@@ -39,13 +41,15 @@ namespace SimTK {
 class CPodesRep {
 public:
     CPodesRep()
-      : useImplicitODEFunction(false), cpode_mem(0), sysp(0), myHandle(0) 
+      : useImplicitODEFunction(false), useBandLinearSolver(false), 
+        cpode_mem(0), sysp(0), myHandle(0) 
     { 
         zeroFunctionPointers();
     }
 
     CPodesRep(int ode_type, int lmm_type, int nls_type)
-      : useImplicitODEFunction(ode_type == CP_IMPL), cpode_mem(0), sysp(0), myHandle(0)
+      : useImplicitODEFunction(ode_type == CP_IMPL), useBandLinearSolver(false),
+        cpode_mem(0), sysp(0), myHandle(0)
     {
         cpode_mem = CPodeCreate(ode_type, lmm_type, nls_type);
     }
@@ -66,6 +70,9 @@ public:
     CPodes::RootFunc            rootFunc;
     CPodes::WeightFunc          weightFunc;
     CPodes::ErrorHandlerFunc    errorHandlerFunc;
+    CPodes::PrecondSetupFunc    precondSetupFunc;
+    CPodes::PrecondSolveFunc    precondSolveFunc;
+    CPodes::JacobianFunc        jacobianFunc;
 
     void zeroFunctionPointers() {
         explicitODEFunc  = 0;
@@ -76,6 +83,18 @@ public:
         rootFunc         = 0;
         weightFunc       = 0;
         errorHandlerFunc = 0;
+        precondSetupFunc = 0;
+        precondSolveFunc = 0;
+        jacobianFunc     = 0;
+    }
+
+    // The full Jacobian the user fills in for the Jacobian wrappers. It is 
+    // kept so that it need not be reallocated every time CPODES asks for a
+    // Jacobian.
+    Matrix& updJacobianWorkspace(int N) const {
+        if (jacobianWorkspace.nrow() != N || jacobianWorkspace.ncol() != N)
+            jacobianWorkspace.resize(N, N);
+        return jacobianWorkspace;
     }
 
     void setMyHandle(CPodes& cp) {myHandle = &cp;}
@@ -83,8 +102,10 @@ public:
     void clearMyHandle() {myHandle=0;}
 private:
     bool  useImplicitODEFunction;
+    bool  useBandLinearSolver; // selects which Jacobian wrapper to use
     void* cpode_mem;
     const CPodesSystem* sysp;
+    mutable Matrix jacobianWorkspace;
 
     friend class CPodes;
     CPodes* myHandle;   // The owner handle of this Rep.
@@ -183,6 +204,78 @@ static void errorHandlerWrapper(int error_code,
     return rep.errorHandlerFunc(rep.getCPodesSystem(), error_code,module,function,msg);
 }
 
+static int precondSetupWrapper(realtype t, N_Vector nv_y, N_Vector nv_fy,
+                               booleantype jok, booleantype* jcurPtr,
+                               realtype gamma, void* P_data,
+                               N_Vector, N_Vector, N_Vector)
+{
+    const Vector& y    = N_Vector_SimTK::getVector(nv_y);
+    const Vector& fy   = N_Vector_SimTK::getVector(nv_fy);
+    const CPodesRep& rep = *reinterpret_cast<const CPodesRep*>(P_data);
+    bool jacWasUpdated = false;
+    const int flag = rep.precondSetupFunc(rep.getCPodesSystem(), t, y, fy,
+                                          jok != FALSE, jacWasUpdated, gamma);
+    *jcurPtr = jacWasUpdated ? TRUE : FALSE;
+    return flag;
+}
+
+static int precondSolveWrapper(realtype t, N_Vector nv_y, N_Vector nv_fy,
+                               N_Vector nv_r, N_Vector nv_z,
+                               realtype gamma, realtype delta,
+                               int lr, void* P_data, N_Vector)
+{
+    const Vector& y    = N_Vector_SimTK::getVector(nv_y);
+    const Vector& fy   = N_Vector_SimTK::getVector(nv_fy);
+    const Vector& r    = N_Vector_SimTK::getVector(nv_r);
+    Vector&       z    = N_Vector_SimTK::updVector(nv_z);
+    const CPodesRep& rep = *reinterpret_cast<const CPodesRep*>(P_data);
+    return rep.precondSolveFunc(rep.getCPodesSystem(), t, y, fy, r, z,
+                                gamma, delta, lr);
+}
+
+// Both the dense and band Jacobian functions get the full Jacobian from the
+// user and copy the part that CPODES wants into its column-major storage.
+// The full Jacobian is kept in the CPodesRep between calls, so the user may
+// find it still holding the previous Jacobian.
+static int denseJacobianWrapper(int N, realtype t, N_Vector nv_y, 
+                                N_Vector nv_fy, DlsMat Jac, void* jac_data,
+                                N_Vector, N_Vector, N_Vector)
+{
+    const Vector& y    = N_Vector_SimTK::getVector(nv_y);
+    const Vector& fy   = N_Vector_SimTK::getVector(nv_fy);
+    const CPodesRep& rep = *reinterpret_cast<const CPodesRep*>(jac_data);
+    Matrix& J = rep.updJacobianWorkspace(N);
+    const int flag = rep.jacobianFunc(rep.getCPodesSystem(), t, y, fy, J);
+    if (flag != CPodes::Success)
+        return flag;
+    for (int j=0; j < N; ++j) {
+        realtype* col = DENSE_COL(Jac,j);
+        for (int i=0; i < N; ++i)
+            col[i] = J(i,j);
+    }
+    return flag;
+}
+
+static int bandJacobianWrapper(int N, int mupper, int mlower, realtype t,
+                               N_Vector nv_y, N_Vector nv_fy, DlsMat Jac, 
+                               void* jac_data, N_Vector, N_Vector, N_Vector)
+{
+    const Vector& y    = N_Vector_SimTK::getVector(nv_y);
+    const Vector& fy   = N_Vector_SimTK::getVector(nv_fy);
+    const CPodesRep& rep = *reinterpret_cast<const CPodesRep*>(jac_data);
+    Matrix& J = rep.updJacobianWorkspace(N);
+    const int flag = rep.jacobianFunc(rep.getCPodesSystem(), t, y, fy, J);
+    if (flag != CPodes::Success)
+        return flag;
+    for (int j=0; j < N; ++j) {
+        realtype* col = BAND_COL(Jac,j);
+        const int ilo = std::max(0, j-mupper), ihi = std::min(N-1, j+mlower);
+        for (int i=ilo; i <= ihi; ++i)
+            BAND_COL_ELEM(col,i,j) = J(i,j);
+    }
+    return flag;
+}
+
 ////////////////////////////////////////
 // CLASS SimTK::CPodes IMPLEMENTATION //
 ////////////////////////////////////////
@@ -258,6 +351,16 @@ static int mapStepMode(CPodes::StepMode mode) {
     }
 }
 
+static int mapPreconditionType(CPodes::PreconditionType type) {
+    switch(type) {
+    case CPodes::NoPreconditioning:    return PREC_NONE;
+    case CPodes::LeftPreconditioning:  return PREC_LEFT;
+    case CPodes::RightPreconditioning: return PREC_RIGHT;
+    case CPodes::BothPreconditioning:  return PREC_BOTH;
+    default: return std::numeric_limits<int>::min();
+    }
+}
+
 // The actual constructor is defined on the client side but
 // calls this library-side routine to do most of the work. (Registration of
 // user functions has to be done on the client side.)
@@ -356,6 +459,14 @@ int CPodes::setErrFile(FILE* errfp) {
 int CPodes::setEwtFn() {
     return CPodeSetEwtFn(updRep().cpode_mem, weightWrapper, (void*)rep);
 }
+int CPodes::spilsSetMaxStepsBetweenPrec(int msbpre) {
+    return CPSpilsSetMaxStepsBetweenPrec(updRep().cpode_mem,(long)msbpre);
+}
+int CPodes::spilsSetPreconditioner() {
+    return CPSpilsSetPreconditioner(updRep().cpode_mem, 
+                                    (void*)precondSetupWrapper, 
+                                    (void*)precondSolveWrapper, (void*)rep);
+}
 int CPodes::setMaxOrd(int maxord) {
     return CPodeSetMaxOrd(updRep().cpode_mem,maxord);
 }
@@ -630,6 +741,14 @@ char* CPodes::getReturnFlagName(int flag) {
 int CPodes::dlsSetJacFn(void* jac, void* jac_data) {
     return CPDlsSetJacFn(updRep().cpode_mem,jac,jac_data);
 }
+int CPodes::dlsSetJacobian() {
+    void* jac = getRep().useBandLinearSolver ? (void*)bandJacobianWrapper
+                                             : (void*)denseJacobianWrapper;
+    return CPDlsSetJacFn(updRep().cpode_mem, jac, (void*)rep);
+}
+int CPodes::dlsSetMaxStepsBetweenJac(int msbj) {
+    return CPDlsSetMaxStepsBetweenJac(updRep().cpode_mem,(long)msbj);
+}
 int CPodes::dlsGetWorkSpace(int* lenrwLS, int* leniwLS) {
     long llenrwLS, lleniwLS;
     int stat = CPDlsGetWorkSpace(updRep().cpode_mem,&llenrwLS,&lleniwLS);
@@ -671,9 +790,11 @@ int CPodes::dlsProjGetNumFctEvals(int* ncevalsLS) {
 }
 
 int CPodes::lapackDense(int N) {
+    updRep().useBandLinearSolver = false;
     return CPLapackDense(updRep().cpode_mem,N);
 }
 int CPodes::lapackBand(int N, int mupper, int mlower) {
+    updRep().useBandLinearSolver = true;
     return CPLapackBand(updRep().cpode_mem,N,mupper,mlower);
 }
 int CPodes::lapackDenseProj(int Nc, int Ny, ProjectionFactorizationType fact_type) {
@@ -681,6 +802,40 @@ int CPodes::lapackDenseProj(int Nc, int Ny, ProjectionFactorizationType fact_typ
         mapProjectionFactorizationType(fact_type));
 }
 
+int CPodes::spgmr(PreconditionType pretype, int maxl) {
+    return CPSpgmr(updRep().cpode_mem, mapPreconditionType(pretype), maxl);
+}
+int CPodes::spilsGetNumPrecEvals(int* npevals) {
+    long lnpevals;
+    int stat = CPSpilsGetNumPrecEvals(updRep().cpode_mem,&lnpevals);
+    *npevals = (int)lnpevals;
+    return stat;
+}
+int CPodes::spilsGetNumPrecSolves(int* npsolves) {
+    long lnpsolves;
+    int stat = CPSpilsGetNumPrecSolves(updRep().cpode_mem,&lnpsolves);
+    *npsolves = (int)lnpsolves;
+    return stat;
+}
+int CPodes::spilsGetNumLinIters(int* nliters) {
+    long lnliters;
+    int stat = CPSpilsGetNumLinIters(updRep().cpode_mem,&lnliters);
+    *nliters = (int)lnliters;
+    return stat;
+}
+int CPodes::spilsGetNumConvFails(int* nlcfails) {
+    long lnlcfails;
+    int stat = CPSpilsGetNumConvFails(updRep().cpode_mem,&lnlcfails);
+    *nlcfails = (int)lnlcfails;
+    return stat;
+}
+int CPodes::spilsGetNumFctEvals(int* nfevalsLS) {
+    long lnfevalsLS;
+    int stat = CPSpilsGetNumFctEvals(updRep().cpode_mem,&lnfevalsLS);
+    *nfevalsLS = (int)lnfevalsLS;
+    return stat;
+}
+
 
 
 // Client-side function registration
@@ -708,6 +863,15 @@ void CPodes::registerWeightFunc(CPodes::WeightFunc f) {
 void CPodes::registerErrorHandlerFunc(CPodes::ErrorHandlerFunc f) {
     updRep().errorHandlerFunc = f;
 }
+void CPodes::registerPrecondSetupFunc(CPodes::PrecondSetupFunc f) {
+    updRep().precondSetupFunc = f;
+}
+void CPodes::registerPrecondSolveFunc(CPodes::PrecondSolveFunc f) {
+    updRep().precondSolveFunc = f;
+}
+void CPodes::registerJacobianFunc(CPodes::JacobianFunc f) {
+    updRep().jacobianFunc = f;
+}
 
 /////////////////////////////////
 // CPodesSystem IMPLEMENTATION //
@@ -756,6 +920,20 @@ int CPodesSystem::weight(const Vector&, Vector&) const {
 void CPodesSystem::errorHandler(int, const char*, const char*, char*) const {
     SimTK_THROW2(Exception::UnimplementedVirtualMethod, "CPodesSystem", "errorHandler"); 
 }
+int CPodesSystem::precondSetup(Real, const Vector&, const Vector&, bool, 
+                               bool&, Real) const {
+    SimTK_THROW2(Exception::UnimplementedVirtualMethod, "CPodesSystem", "precondSetup"); 
+    return std::numeric_limits<int>::min();
+}
+int CPodesSystem::precondSolve(Real, const Vector&, const Vector&, 
+                               const Vector&, Vector&, Real, Real, int) const {
+    SimTK_THROW2(Exception::UnimplementedVirtualMethod, "CPodesSystem", "precondSolve"); 
+    return std::numeric_limits<int>::min();
+}
+int CPodesSystem::jacobian(Real, const Vector&, const Vector&, Matrix&) const {
+    SimTK_THROW2(Exception::UnimplementedVirtualMethod, "CPodesSystem", "jacobian"); 
+    return std::numeric_limits<int>::min();
+}
 
 } // namespace SimTK
 
@@ -377,10 +377,18 @@ typedef int (*CPDlsDenseProjJacFn)(int Nc, int Ny,
  *    CPDIRECT_SUCCESS   if successful
  *    CPDIRECT_MEM_NULL  if the CPODES memory was NULL
  *    CPDIRECT_LMEM_NULL if the linear solver memory was NULL
+ *
+ * CPDlsSetMaxStepsBetweenJac specifies the maximum number of steps
+ * for which a saved Jacobian is reused (explicit ODE only). A new 
+ * Jacobian is evaluated sooner if the Newton iteration fails to 
+ * converge or gamma changes too much. The default is CPD_MSBJ = 50.
+ * Its return value is CPDIRECT_SUCCESS, CPDIRECT_MEM_NULL, 
+ * CPDIRECT_LMEM_NULL, or CPDIRECT_ILL_INPUT if msbj <= 0.
  * -----------------------------------------------------------------
  */
 
 SUNDIALS_EXPORT int CPDlsSetJacFn(void *cvode_mem, void *jac, void *jac_data);
+SUNDIALS_EXPORT int CPDlsSetMaxStepsBetweenJac(void *cpode_mem, long int msbj);
 
 /*
  * -----------------------------------------------------------------
@@ -299,6 +299,11 @@ typedef int (*CPSpilsJacTimesVecImplFn)(realtype t, realtype gm,
  *                from the value previously set.
  *                An input value <= 0, gives the default value.
  *
+ * CPSpilsSetMaxStepsBetweenPrec specifies the maximum number of
+ *                steps for which saved preconditioner Jacobian data
+ *                may be reused (explicit ODE only). It must be
+ *                positive. Default value is 50.
+ *
  * CPSpilsSetDelt specifies the factor by which the tolerance on
  *                the nonlinear iteration is multiplied to get a
  *                tolerance on the linear iteration.
@@ -327,6 +332,7 @@ typedef int (*CPSpilsJacTimesVecImplFn)(realtype t, realtype gm,
 SUNDIALS_EXPORT int CPSpilsSetPrecType(void *cpode_mem, int pretype);
 SUNDIALS_EXPORT int CPSpilsSetGSType(void *cpode_mem, int gstype);
 SUNDIALS_EXPORT int CPSpilsSetMaxl(void *cpode_mem, int maxl);
+SUNDIALS_EXPORT int CPSpilsSetMaxStepsBetweenPrec(void *cpode_mem, long int msbpre);
 SUNDIALS_EXPORT int CPSpilsSetDelt(void *cpode_mem, realtype delt);
 SUNDIALS_EXPORT int CPSpilsSetPreconditioner(void *cpode_mem, void *pset, void *psolve, void *P_data);
 SUNDIALS_EXPORT int CPSpilsSetJacTimesVecFn(void *cpode_mem, void *jtimes, void *jac_data);
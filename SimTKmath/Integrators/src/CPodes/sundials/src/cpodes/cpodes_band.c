@@ -84,6 +84,7 @@ static void cpBandFree(CPodeMem cp_mem);
 #define pivots         (cpdls_mem->d_pivots)
 #define savedJ         (cpdls_mem->d_savedJ)
 #define nstlj          (cpdls_mem->d_nstlj)
+#define msbj           (cpdls_mem->d_msbj)
 #define nje            (cpdls_mem->d_nje)
 #define nfeDQ          (cpdls_mem->d_nfeDQ)
 #define J_data         (cpdls_mem->d_J_data)
@@ -162,6 +163,9 @@ int CPBand(void *cpode_mem, int N, int mupper, int mlower)
   jacI = NULL;
   J_data = NULL;
 
+  /* Set default maximum number of steps between Jacobian evaluations */
+  msbj = CPD_MSBJ;
+
   last_flag = CPDIRECT_SUCCESS;
   lsetup_exists = TRUE;
   
@@ -287,7 +291,7 @@ static int cpBandSetup(CPodeMem cp_mem, int convfail,
 
     /* Use nst, gamma/gammap, and convfail to set J eval. flag jok */
     dgamma = ABS((gamma/gammap) - ONE);
-    jbad = (nst == 0) || (nst > nstlj + CPD_MSBJ) ||
+    jbad = (nst == 0) || (nst > nstlj + msbj) ||
       ((convfail == CP_FAIL_BAD_J) && (dgamma < CPD_DGMAX)) ||
       (convfail == CP_FAIL_OTHER);
     jok = !jbad;
@@ -118,6 +118,7 @@ static void cpdSCcomputeKD(CPodeMem cp_mem, N_Vector d);
 #define savedJ         (cpdls_mem->d_savedJ)
 #define pivots         (cpdls_mem->d_pivots)
 #define nstlj          (cpdls_mem->d_nstlj)
+#define msbj           (cpdls_mem->d_msbj)
 #define nje            (cpdls_mem->d_nje)
 #define nfeDQ          (cpdls_mem->d_nfeDQ)
 #define J_data         (cpdls_mem->d_J_data)
@@ -210,6 +211,9 @@ int CPDense(void *cpode_mem, int N)
   jacI = NULL;
   J_data = NULL;
 
+  /* Set default maximum number of steps between Jacobian evaluations */
+  msbj = CPD_MSBJ;
+
   last_flag = CPDIRECT_SUCCESS;
   lsetup_exists = TRUE;
 
@@ -482,7 +486,7 @@ static int cpDenseSetup(CPodeMem cp_mem, int convfail,
 
     /* Use nst, gamma/gammap, and convfail to set J eval. flag jok */
     dgamma = ABS((gamma/gammap) - ONE);
-    jbad = (nst == 0) || (nst > nstlj + CPD_MSBJ) ||
+    jbad = (nst == 0) || (nst > nstlj + msbj) ||
       ((convfail == CP_FAIL_BAD_J) && (dgamma < CPD_DGMAX)) ||
       (convfail == CP_FAIL_OTHER);
     jok = !jbad;
@@ -78,6 +78,7 @@
 #define savedJ         (cpdls_mem->d_savedJ)
 #define pivots         (cpdls_mem->d_pivots)
 #define nstlj          (cpdls_mem->d_nstlj)
+#define msbj           (cpdls_mem->d_msbj)
 #define nje            (cpdls_mem->d_nje)
 #define nfeDQ          (cpdls_mem->d_nfeDQ)
 #define J_data         (cpdls_mem->d_J_data)
@@ -138,6 +139,38 @@ int CPDlsSetJacFn(void *cpode_mem, void *jac, void *jac_data)
   return(CPDIRECT_SUCCESS);
 }
 
+/*
+ * CPDlsSetMaxStepsBetweenJac specifies the maximum number of steps
+ * between Jacobian evaluations.
+ */
+int CPDlsSetMaxStepsBetweenJac(void *cpode_mem, long int msbjValue)
+{
+  CPodeMem cp_mem;
+  CPDlsMem cpdls_mem;
+
+  /* Return immediately if cpode_mem is NULL */
+  if (cpode_mem == NULL) {
+    cpProcessError(NULL, CPDIRECT_MEM_NULL, "CPDIRECT", "CPDlsSetMaxStepsBetweenJac", MSGD_CPMEM_NULL);
+    return(CPDIRECT_MEM_NULL);
+  }
+  cp_mem = (CPodeMem) cpode_mem;
+
+  if (lmem == NULL) {
+    cpProcessError(cp_mem, CPDIRECT_LMEM_NULL, "CPDIRECT", "CPDlsSetMaxStepsBetweenJac", MSGD_LMEM_NULL);
+    return(CPDIRECT_LMEM_NULL);
+  }
+  cpdls_mem = (CPDlsMem) lmem;
+
+  if (msbjValue <= 0) {
+    cpProcessError(cp_mem, CPDIRECT_ILL_INPUT, "CPDIRECT", "CPDlsSetMaxStepsBetweenJac", MSGD_BAD_MSBJ);
+    return(CPDIRECT_ILL_INPUT);
+  }
+
+  msbj = msbjValue;
+
+  return(CPDIRECT_SUCCESS);
+}
+
 /*
  * CPDlsGetWorkSpace returns the length of workspace allocated for the
  * CPDIRECT linear solver.
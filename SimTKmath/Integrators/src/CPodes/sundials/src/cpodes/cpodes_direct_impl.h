@@ -27,7 +27,7 @@ extern "C" {
  * -----------------------------------------------------------------
  * CPDIRECT solver constants
  * -----------------------------------------------------------------
- * CPD_MSBJ   maximum number of steps between Jacobian evaluations
+ * CPD_MSBJ   default maximum number of steps between Jacobian evaluations
  * CPD_DGMAX  maximum change in gamma between Jacobian evaluations
  * -----------------------------------------------------------------
  */
@@ -68,6 +68,8 @@ typedef struct {
   
   long int  d_nstlj;      /* nstlj = nst at last Jacobian eval.           */
 
+  long int  d_msbj;       /* max. no. of steps between Jacobian evals.    */
+
   long int d_nje;         /* nje = no. of calls to jac                    */
 
   long int d_nfeDQ;       /* no. of calls to f due to DQ Jacobian approx. */
@@ -163,6 +165,7 @@ int cpDlsDenseProjDQJac(int Nc, int Ny, realtype t,
 #define MSGD_MEM_FAIL "A memory request failed."
 #define MSGD_LMEM_NULL "Linear solver memory is NULL."
 #define MSGD_JACFUNC_FAILED "The Jacobian routine failed in an unrecoverable manner."
+#define MSGD_BAD_MSBJ "msbj must be positive."
 
 #define MSGD_BAD_FACT "fact_type has an illegal value."
 
@@ -147,6 +147,7 @@ static void cplSCcomputeKD(CPodeMem cp_mem, N_Vector d);
 #define savedJ         (cpdls_mem->d_savedJ)
 #define pivots         (cpdls_mem->d_pivots)
 #define nstlj          (cpdls_mem->d_nstlj)
+#define msbj           (cpdls_mem->d_msbj)
 #define nje            (cpdls_mem->d_nje)
 #define nfeDQ          (cpdls_mem->d_nfeDQ)
 #define J_data         (cpdls_mem->d_J_data)
@@ -242,6 +243,9 @@ int CPLapackDense(void *cpode_mem, int N)
   djacI = NULL;
   J_data = NULL;
 
+  /* Set default maximum number of steps between Jacobian evaluations */
+  msbj = CPD_MSBJ;
+
   last_flag = CPDIRECT_SUCCESS;
   lsetup_exists = TRUE;
 
@@ -350,6 +354,9 @@ int CPLapackBand(void *cpode_mem, int N, int mupper, int mlower)
   bjacI = NULL;
   J_data = NULL;
 
+  /* Set default maximum number of steps between Jacobian evaluations */
+  msbj = CPD_MSBJ;
+
   last_flag = CPDIRECT_SUCCESS;
   lsetup_exists = TRUE;
   
@@ -367,8 +374,10 @@ int CPLapackBand(void *cpode_mem, int N, int mupper, int mlower)
     return(CPDIRECT_ILL_INPUT);
   }
 
-  /* Set extended upper half-bandwidth for M (required for pivoting) */
-  smu = MIN(N-1, mu + ml);
+  /* Set extended upper half-bandwidth for M (required for pivoting).
+     Unlike the internal band solver, dgbtrf requires the leading 
+     dimension to be at least 2*ml+mu+1 even if that exceeds N. */
+  smu = mu + ml;
 
   /* Allocate memory for M, savedJ, and pivot arrays */
   M = NULL;
@@ -692,7 +701,7 @@ static int cpLapackDenseSetup(CPodeMem cp_mem, int convfail,
 
     /* Use nst, gamma/gammap, and convfail to set J eval. flag jok */
     dgamma = ABS((gamma/gammap) - ONE);
-    jbad = (nst == 0) || (nst > nstlj + CPD_MSBJ) ||
+    jbad = (nst == 0) || (nst > nstlj + msbj) ||
       ((convfail == CP_FAIL_BAD_J) && (dgamma < CPD_DGMAX)) ||
       (convfail == CP_FAIL_OTHER);
     jok = !jbad;
@@ -866,7 +875,7 @@ static int cpLapackBandSetup(CPodeMem cp_mem, int convfail,
 
     /* Use nst, gamma/gammap, and convfail to set J eval. flag jok */
     dgamma = ABS((gamma/gammap) - ONE);
-    jbad = (nst == 0) || (nst > nstlj + CPD_MSBJ) ||
+    jbad = (nst == 0) || (nst > nstlj + msbj) ||
       ((convfail == CP_FAIL_BAD_J) && (dgamma < CPD_DGMAX)) ||
       (convfail == CP_FAIL_OTHER);
     jok = !jbad;
@@ -162,6 +162,7 @@ int CPSpgmr(void *cpode_mem, int pretype, int maxl)
   cpspils_mem->s_jtvE       = NULL;
   cpspils_mem->s_jtvI       = NULL;
   cpspils_mem->s_P_data     = NULL;
+  cpspils_mem->s_msbpre    = CPSPILS_MSBPRE;
   cpspils_mem->s_j_data     = NULL;
 
   cpspils_mem->s_last_flag  = CPSPILS_SUCCESS;
@@ -331,7 +332,7 @@ static int cpSpgmrSetup(CPodeMem cp_mem, int convfail,
 
     /* Use nst, gamma/gammap, and convfail to set J eval. flag jok */
     dgamma = ABS((gamma/gammap) - ONE);
-    jbad = (nst == 0) || (nst > nstlpre + CPSPILS_MSBPRE) ||
+    jbad = (nst == 0) || (nst > nstlpre + cpspils_mem->s_msbpre) ||
       ((convfail == CP_FAIL_BAD_J) && (dgamma < CPSPILS_DGMAX)) ||
       (convfail == CP_FAIL_OTHER);
     *jcurPtr = jbad;
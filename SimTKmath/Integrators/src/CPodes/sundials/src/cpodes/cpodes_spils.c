@@ -181,6 +181,40 @@ int CPSpilsSetMaxl(void *cpode_mem, int maxl)
   return(CPSPILS_SUCCESS);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * CPSpilsSetMaxStepsBetweenPrec
+ * -----------------------------------------------------------------
+ */
+
+int CPSpilsSetMaxStepsBetweenPrec(void *cpode_mem, long int msbpre)
+{
+  CPodeMem cp_mem;
+  CPSpilsMem cpspils_mem;
+
+  /* Return immediately if cpode_mem is NULL */
+  if (cpode_mem == NULL) {
+    cpProcessError(NULL, CPSPILS_MEM_NULL, "CPSPILS", "CPSpilsSetMaxStepsBetweenPrec", MSGS_CPMEM_NULL);
+    return(CPSPILS_MEM_NULL);
+  }
+  cp_mem = (CPodeMem) cpode_mem;
+
+  if (lmem == NULL) {
+    cpProcessError(NULL, CPSPILS_LMEM_NULL, "CPSPILS", "CPSpilsSetMaxStepsBetweenPrec", MSGS_LMEM_NULL);
+    return(CPSPILS_LMEM_NULL);
+  }
+  cpspils_mem = (CPSpilsMem) lmem;
+
+  if (msbpre <= 0) {
+    cpProcessError(cp_mem, CPSPILS_ILL_INPUT, "CPSPILS", "CPSpilsSetMaxStepsBetweenPrec", MSGS_BAD_MSBPRE);
+    return(CPSPILS_ILL_INPUT);
+  }
+
+  cpspils_mem->s_msbpre = msbpre;
+
+  return(CPSPILS_SUCCESS);
+}
+
 
 /*
  * -----------------------------------------------------------------
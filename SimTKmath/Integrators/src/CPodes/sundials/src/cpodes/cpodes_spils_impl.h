@@ -47,7 +47,7 @@ extern "C" {
  * CPSPILS_MAXL   : default value for the maximum Krylov
  *                  dimension
  *
- * CPSPILS_MSBPRE : maximum number of steps between
+ * CPSPILS_MSBPRE : default maximum number of steps between
  *                  preconditioner evaluations
  *
  * CPSPILS_DGMAX  : maximum change in gamma between
@@ -86,6 +86,8 @@ typedef struct {
   int  s_maxl;          /* maxl = maximum dimension of the Krylov space */
 
   long int s_nstlpre;   /* value of nst at the last pset call           */
+  long int s_msbpre;    /* max. no. of steps between pset calls with    */
+                        /* jok = FALSE                                  */
   long int s_npe;       /* npe = total number of pset calls             */
   long int s_nli;       /* nli = total number of linear iterations      */
   long int s_nps;       /* nps = total number of psolve calls           */
@@ -152,6 +154,7 @@ int cpSpilsDQjtvImpl(realtype t, realtype gm,
 #define MSGS_LMEM_NULL   "Linear solver memory is NULL."
 #define MSGS_BAD_GSTYPE  "Illegal value for gstype. Legal values are MODIFIED_GS and CLASSICAL_GS."
 #define MSGS_BAD_DELT    "delt < 0 illegal."
+#define MSGS_BAD_MSBPRE  "msbpre must be positive."
 
 #define MSGS_PSET_FAILED "The preconditioner setup routine failed in an unrecoverable manner."
 #define MSGS_PSOLVE_FAILED "The preconditioner solve routine failed in an unrecoverable manner."
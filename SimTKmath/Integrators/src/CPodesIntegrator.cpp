@@ -51,6 +51,71 @@ void CPodesIntegrator::setOrderLimit(int order) {
     cprep.setOrderLimit(order);
 }
 
+void CPodesIntegrator::setLinearSolver(LinearSolver solver) {
+    CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
+    cprep.setLinearSolver(solver);
+}
+
+CPodesIntegrator::LinearSolver CPodesIntegrator::getLinearSolver() const {
+    const CPodesIntegratorRep& cprep = 
+        dynamic_cast<const CPodesIntegratorRep&>(*rep);
+    return cprep.getLinearSolver();
+}
+
+void CPodesIntegrator::setJacobianBandwidth(int upper, int lower) {
+    CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
+    cprep.setJacobianBandwidth(upper, lower);
+}
+
+void CPodesIntegrator::setKrylovSubspaceDimension(int maxl) {
+    CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
+    cprep.setKrylovSubspaceDimension(maxl);
+}
+
+void CPodesIntegrator::setPreconditionerBlockSize(int blockSize) {
+    CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
+    cprep.setPreconditionerBlockSize(blockSize);
+}
+
+int CPodesIntegrator::getNumJacobianEvaluations() const {
+    const CPodesIntegratorRep& cprep = 
+        dynamic_cast<const CPodesIntegratorRep&>(*rep);
+    return cprep.getNumJacobianEvaluations();
+}
+
+int CPodesIntegrator::getNumLinearSolverIterations() const {
+    const CPodesIntegratorRep& cprep = 
+        dynamic_cast<const CPodesIntegratorRep&>(*rep);
+    return cprep.getNumLinearSolverIterations();
+}
+
+void CPodesIntegrator::setJacobianMethod(JacobianMethod method) {
+    CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
+    cprep.setJacobianMethod(method);
+}
+
+CPodesIntegrator::JacobianMethod CPodesIntegrator::getJacobianMethod() const {
+    const CPodesIntegratorRep& cprep = 
+        dynamic_cast<const CPodesIntegratorRep&>(*rep);
+    return cprep.getJacobianMethod();
+}
+
+void CPodesIntegrator::setJacobianProvider(JacobianProvider* provider) {
+    CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
+    cprep.setJacobianProvider(provider);
+}
+
+void CPodesIntegrator::setMaxStepsBetweenJacobians(int steps) {
+    CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
+    cprep.setMaxStepsBetweenJacobians(steps);
+}
+
+int CPodesIntegrator::getNumJacobianReuses() const {
+    const CPodesIntegratorRep& cprep = 
+        dynamic_cast<const CPodesIntegratorRep&>(*rep);
+    return cprep.getNumJacobianReuses();
+}
+
 
 
 //------------------------------------------------------------------------------
@@ -124,6 +189,27 @@ public:
         gout = integ.getAdvancedState().getEventTriggers();
         return CPodes::Success;
     }
+
+    // Block diagonal preconditioner for the Krylov linear solver.
+    int precondSetup(Real t, const Vector& y, const Vector& fy,
+                     bool jacIsCurrent, bool& jacWasUpdated, 
+                     Real gamma) const override {
+        return integ.setUpPreconditioner(t, y, fy, jacIsCurrent, 
+                                         jacWasUpdated, gamma);
+    }
+
+    int precondSolve(Real t, const Vector& y, const Vector& fy,
+                     const Vector& r, Vector& z, 
+                     Real gamma, Real delta, int lr) const override {
+        return integ.solvePreconditioner(r, z, gamma);
+    }
+
+    // Jacobian for the direct linear solvers, used only if the integrator
+    // was asked for something other than CPODES' difference quotients.
+    int jacobian(Real t, const Vector& y, const Vector& fy, 
+                 Matrix& J) const override {
+        return integ.calcJacobian(t, y, fy, J);
+    }
 private:
     CPodesIntegratorRep& integ;
     const System& system;
@@ -137,6 +223,12 @@ void CPodesIntegratorRep::init
     cps = new CPodesSystemImpl(*this, getSystem());
     initialized = false;
     useCpodesProjection = false;
+    linearSolver = CPodesIntegrator::DenseLinearSolver;
+    bandUpper = bandLower = -1;
+    krylovDimension = 0; // use CPODES default
+    precondBlockSize = 6;
+    jacobianMethod = CPodesIntegrator::FullDifferenceQuotient;
+    maxStepsBetweenJacobians = 50; // CPODES default
 }
 
 CPodesIntegratorRep::CPodesIntegratorRep
@@ -189,7 +281,31 @@ void CPodesIntegratorRep::methodInitialize(const State& state) {
         printf("init() returned %d\n", retval);
         SimTK_THROW1(Integrator::InitializationFailed, "init() failed");
     }
-    cpodes->lapackDense(ny);
+    precondC.clear(); precondBN.clear(); precondLU.clear();
+    switch (linearSolver) {
+    case CPodesIntegrator::DenseLinearSolver:
+        cpodes->lapackDense(ny);
+        break;
+    case CPodesIntegrator::BandLinearSolver:
+        SimTK_ERRCHK_ALWAYS(bandUpper >= 0 && bandLower >= 0,
+            "CPodesIntegrator::initialize()",
+            "The Jacobian bandwidth must be set with setJacobianBandwidth()"
+            " before initializing an integrator that uses BandLinearSolver.");
+        cpodes->lapackBand(ny, std::min(bandUpper, std::max(ny-1, 0)), 
+                               std::min(bandLower, std::max(ny-1, 0)));
+        break;
+    case CPodesIntegrator::KrylovLinearSolver:
+        cpodes->spgmr(CPodes::LeftPreconditioning, krylovDimension);
+        cpodes->spilsSetPreconditioner();
+        cpodes->spilsSetMaxStepsBetweenPrec(maxStepsBetweenJacobians);
+        break;
+    }
+    if (linearSolver != CPodesIntegrator::KrylovLinearSolver) {
+        if (jacobianProvider || 
+            jacobianMethod == CPodesIntegrator::StageAwareDifferenceQuotient)
+            cpodes->dlsSetJacobian();
+        cpodes->dlsSetMaxStepsBetweenJac(maxStepsBetweenJacobians);
+    }
     cpodes->setNonlinConvCoef(Real(0.01)); // TODO (default is 0.1)
     if (useCpodesProjection) {
         const int nqerr = state.getNQErr(), nuerr = state.getNUErr();
@@ -268,9 +384,7 @@ void CPodesIntegratorRep::createInterpolatedState(Real t) {
     const State& advanced = getAdvancedState();
     State&       interp   = updInterpolatedState();
     interp = advanced; // pick up discrete stuff.
-    Vector yout(advanced.getY().size());
-    cpodes->getDky(t, 0, yout);
-    interp.updY() = yout;
+    calcInterpolatedY(t, interp.updY());
     interp.updTime() = t;
 
     if (userProjectInterpolatedStates == 0) {
@@ -287,6 +401,26 @@ void CPodesIntegratorRep::createInterpolatedState(Real t) {
     realizeAndProjectKinematicsWithThrow(interp, ProjectOptions::LocalOnly);
 }
 
+// CPodes keeps its own interpolating polynomial, which is valid over its last
+// internal step.
+void CPodesIntegratorRep::calcInterpolatedY(Real t, Vector& y) const {
+    if (t == getAdvancedTime()) {
+        y = getAdvancedState().getY();
+        return;
+    }
+    y.resize(getAdvancedState().getNY());
+    cpodes->getDky(t, 0, y);
+}
+
+Real CPodesIntegratorRep::getInterpolationStartTime() const {
+    if (!initialized)
+        return getAdvancedTime();
+    Real tcur, hlast;
+    cpodes->getCurrentTime(&tcur);
+    cpodes->getLastStep(&hlast);
+    return std::min(tcur - hlast, getAdvancedTime());
+}
+
 // Take a step. See AbstractIntegratorRep::stepTo() for how this is supposed
 // to behave. We have to go through some contortions to squeeze CPodes into
 // that mold.
@@ -398,11 +532,21 @@ stepTo(Real reportTime, Real scheduledEventTime) {
             Vector yout(getAdvancedState().getY().size());
             Vector ypout(getAdvancedState().getY().size()); // ignored
             int oldSteps=0, oldTestFailures=0, oldNonlinIterations=0, 
-                oldNonlinConvFailures=0;
+                oldNonlinConvFailures=0, oldJacEvals=0, oldLinIterations=0,
+                oldLinSetups=0;
             cpodes->getNumSteps(&oldSteps);
+            cpodes->getNumLinSolvSetups(&oldLinSetups);
             cpodes->getNumErrTestFails(&oldTestFailures);
             cpodes->getNumNonlinSolvIters(&oldNonlinIterations);
             cpodes->getNumNonlinSolvConvFails(&oldNonlinConvFailures);
+            if (linearSolver == CPodesIntegrator::KrylovLinearSolver)
+                cpodes->spilsGetNumLinIters(&oldLinIterations);
+            else
+                cpodes->dlsGetNumJacEvals(&oldJacEvals);
+            // The linear solver zeroes its counters when CPODES initializes
+            // it at the start of the first step after (re)initialization.
+            if (oldSteps == 0)
+                oldJacEvals = oldLinIterations = 0;
 
             //---------------------step------------------------
             res = cpodes->step(tMax, &tret, yout, ypout, mode);
@@ -423,11 +567,25 @@ stepTo(Real reportTime, Real scheduledEventTime) {
             }
 
             int newSteps=0, newTestFailures=0, newNonlinIterations=0, 
-                newNonlinConvFailures=0;
+                newNonlinConvFailures=0, newJacEvals=0, newLinIterations=0,
+                newLinSetups=0;
             cpodes->getNumSteps(&newSteps);
+            cpodes->getNumLinSolvSetups(&newLinSetups);
             cpodes->getNumErrTestFails(&newTestFailures);
             cpodes->getNumNonlinSolvIters(&newNonlinIterations);
             cpodes->getNumNonlinSolvConvFails(&newNonlinConvFailures);
+            // The preconditioner counts its own Jacobian evaluations and 
+            // reuses. A direct solver setup that didn't evaluate the 
+            // Jacobian reused the saved one.
+            if (linearSolver == CPodesIntegrator::KrylovLinearSolver)
+                cpodes->spilsGetNumLinIters(&newLinIterations);
+            else {
+                cpodes->dlsGetNumJacEvals(&newJacEvals);
+                statsJacobianReuses += (newLinSetups-oldLinSetups)
+                                       - (newJacEvals-oldJacEvals);
+            }
+            statsJacobianEvaluations += newJacEvals-oldJacEvals;
+            statsLinearIterations += newLinIterations-oldLinIterations;
             statsStepsTaken += newSteps-oldSteps;
             statsErrorTestFailures += newTestFailures-oldTestFailures;
             // Project stats were already updated in project() above.
@@ -629,6 +787,9 @@ void CPodesIntegratorRep::resetMethodStatistics() {
     statsErrorTestFailures = 0;
     statsConvergenceTestFailures = 0;
     statsIterations = 0;
+    statsJacobianEvaluations = 0;
+    statsLinearIterations = 0;
+    statsJacobianReuses = 0;
 }
 
 const char* CPodesIntegratorRep::getMethodName() const {
@@ -658,4 +819,275 @@ void CPodesIntegratorRep::setOrderLimit(int order) {
     cpodes->setMaxOrd(order);
 }
 
+void CPodesIntegratorRep::
+setLinearSolver(CPodesIntegrator::LinearSolver solver) {
+    linearSolver = solver;
+}
+
+void CPodesIntegratorRep::setJacobianBandwidth(int upper, int lower) {
+    SimTK_APIARGCHECK2_ALWAYS(upper >= 0 && lower >= 0, "CPodesIntegrator", 
+        "setJacobianBandwidth",
+        "The half-bandwidths must be nonnegative but were %d and %d.",
+        upper, lower);
+    bandUpper = upper;
+    bandLower = lower;
+}
+
+void CPodesIntegratorRep::setKrylovSubspaceDimension(int maxl) {
+    SimTK_APIARGCHECK1_ALWAYS(maxl >= 0, "CPodesIntegrator", 
+        "setKrylovSubspaceDimension",
+        "The subspace dimension must be nonnegative but was %d.", maxl);
+    krylovDimension = maxl;
+}
+
+void CPodesIntegratorRep::setPreconditionerBlockSize(int blockSize) {
+    SimTK_APIARGCHECK1_ALWAYS(blockSize >= 1, "CPodesIntegrator", 
+        "setPreconditionerBlockSize",
+        "The block size must be at least 1 but was %d.", blockSize);
+    precondBlockSize = blockSize;
+}
+
+int CPodesIntegratorRep::getNumJacobianEvaluations() const {
+    assert(initialized);
+    return statsJacobianEvaluations;
+}
+
+int CPodesIntegratorRep::getNumLinearSolverIterations() const {
+    assert(initialized);
+    return statsLinearIterations;
+}
+
+void CPodesIntegratorRep::
+setJacobianMethod(CPodesIntegrator::JacobianMethod method) {
+    jacobianMethod = method;
+}
+
+void CPodesIntegratorRep::
+setJacobianProvider(CPodesIntegrator::JacobianProvider* provider) {
+    jacobianProvider.reset(provider);
+}
+
+void CPodesIntegratorRep::setMaxStepsBetweenJacobians(int steps) {
+    SimTK_APIARGCHECK1_ALWAYS(steps >= 1, "CPodesIntegrator", 
+        "setMaxStepsBetweenJacobians",
+        "The number of steps must be at least 1 but was %d.", steps);
+    maxStepsBetweenJacobians = steps;
+}
+
+int CPodesIntegratorRep::getNumJacobianReuses() const {
+    assert(initialized);
+    return statsJacobianReuses;
+}
+
+
+
+//------------------------------------------------------------------------------
+//                                 JACOBIAN
+//------------------------------------------------------------------------------
+// Called by CPODES through CPodesSystemImpl::jacobian() when either a 
+// JacobianProvider was set or StageAwareDifferenceQuotient was selected.
+// CPODES' own difference quotients set and realize the whole state for every
+// column of J. A u or z perturbation doesn't change anything computed at
+// Position stage though, so here we realize the advanced state through
+// Velocity stage and perturb its u's and z's in place, restoring each 
+// afterwards. (A copy of that state would have to be realized again.) Only
+// the q columns need a full realization.
+
+int CPodesIntegratorRep::calcJacobian
+   (Real t, const Vector& y, const Vector& fy, Matrix& J)
+{
+    const System& system = getSystem();
+    const int ny = y.size();
+    try {
+        if (jacobianProvider) {
+            setAdvancedStateAndRealizeDerivatives(t, y);
+            jacobianProvider->calcJacobian(system, getAdvancedState(), J);
+            return J.nrow()==ny && J.ncol()==ny ? CPodes::Success 
+                                                : CPodes::UnrecoverableError;
+        }
+
+        // The band solver uses only the entries at most mu above and ml below
+        // the diagonal, so columns more than ml+mu apart never share a row
+        // it needs and can be perturbed together: group g holds columns g,
+        // g+width, g+2*width, ... The dense solver needs every entry, so
+        // each of its groups is a single column. A group whose first column
+        // is a q needs a full realization; the others perturb only u's and
+        // z's.
+        const bool banded = 
+            linearSolver == CPodesIntegrator::BandLinearSolver;
+        const int mu = banded ? std::min(bandUpper, ny-1) : ny-1;
+        const int ml = banded ? std::min(bandLower, ny-1) : ny-1;
+        const int width = std::min(ml+mu+1, ny);
+        const int nq = getAdvancedState().getNQ();
+
+        const Real sqrtEps = std::sqrt(Eps);
+        Vector sigma(ny);
+        for (int j=0; j < ny; ++j)
+            sigma[j] = sqrtEps * std::max(std::abs(y[j]), Real(1));
+        // Fill in the columns of group g given ydot with all of them 
+        // perturbed.
+        auto storeGroup = [&](int g, const Vector& ydot) {
+            for (int j=g; j < ny; j += width) {
+                const int ilo = std::max(0, j-mu), ihi = std::min(ny-1, j+ml);
+                for (int i=ilo; i <= ihi; ++i)
+                    J(i,j) = (ydot[i] - fy[i]) / sigma[j];
+            }
+        };
+
+        Vector yp(y);
+        for (int g=0; g < std::min(nq, width); ++g) {
+            for (int j=g; j < ny; j += width)
+                yp[j] = y[j] + sigma[j];
+            setAdvancedStateAndRealizeDerivatives(t, yp);
+            storeGroup(g, getAdvancedState().getYDot());
+            for (int j=g; j < ny; j += width)
+                yp[j] = y[j];
+        }
+        if (nq >= width)
+            return CPodes::Success;
+
+        setAdvancedStateAndRealizeKinematics(t, y);
+        State& s = updAdvancedState();
+        const int nu = s.getNU();
+        const Vector u0 = s.getU(), z0 = s.getZ();
+        for (int g=nq; g < width; ++g) {
+            for (int j=g; j < ny; j += width) {
+                if (j < nq+nu) s.updU()[j-nq] = u0[j-nq] + sigma[j];
+                else s.updZ()[j-nq-nu] = z0[j-nq-nu] + sigma[j];
+            }
+            system.prescribeU(s); // a prescribed u can't be perturbed
+            realizeStateDerivatives(s);
+            storeGroup(g, s.getYDot());
+            for (int j=g; j < ny; j += width) {
+                if (j < nq+nu) s.updU()[j-nq] = u0[j-nq];
+                else s.updZ()[j-nq-nu] = z0[j-nq-nu];
+            }
+        }
+    }
+    catch(...) { return CPodes::RecoverableError; } // assume recoverable
+    return CPodes::Success;
+}
+
+
+
+//------------------------------------------------------------------------------
+//                         BLOCK DIAGONAL PRECONDITIONER
+//------------------------------------------------------------------------------
+// CPODES wants to solve (I - gamma J) x = r with J = dydot/dy. With y=(q,w),
+// w=(u,z), and qdot=N*u, and neglecting the dependence of N on q, this is
+//      [    I         -gamma N     ] [xq]   [rq]
+//      [ -gamma B   I - gamma C    ] [xw] = [rw]
+// with B=dwdot/dq and C=dwdot/dw. Eliminating xq gives
+//      (I - gamma C - gamma^2 B N) xw = rw + gamma B rq
+//                                  xq = rq + gamma N xu.
+// We approximate C and B*N by their diagonal blocks, found by perturbing
+// the same column of every block at once, and approximate B rq by 
+// (B N) pinv(N) rq. Each block then needs one evaluation for C and, if it 
+// has any u's, one more for B*N. The blocks don't depend on gamma so are
+// saved and refactored when CPODES says the Jacobian is still good.
+
+int CPodesIntegratorRep::setUpPreconditioner
+   (Real t, const Vector& y, const Vector& fy, bool jacIsCurrent, 
+    bool& jacWasUpdated, Real gamma) 
+{
+    const State& advanced = getAdvancedState();
+    const int nq = advanced.getNQ(), nu = advanced.getNU(), 
+              nw = nu + advanced.getNZ();
+    const int bs = std::min(precondBlockSize, std::max(nw, 1));
+    const int nBlocks = (nw + bs - 1) / bs;
+
+    jacWasUpdated = false;
+    try {
+        if (!jacIsCurrent || (int)precondC.size() != nBlocks) {
+            setAdvancedStateAndRealizeKinematics(t, y);
+            precondState = getAdvancedState();
+
+            precondC.resize(nBlocks); precondBN.resize(nBlocks);
+            for (int b=0; b < nBlocks; ++b) {
+                const int n = std::min(bs, nw - b*bs);
+                precondC[b].resize(n,n);  precondC[b] = 0;
+                precondBN[b].resize(n,n); precondBN[b] = 0;
+            }
+
+            const Real sqrtEps = std::sqrt(Eps);
+            Vector yp(y.size()), sigma(nw), du(nu), dq(nq);
+            for (int g=0; g < bs; ++g) {
+                // Perturb the g'th entry of every block of w.
+                yp = y; du = 0;
+                bool anyU = false;
+                for (int j=g; j < nw; j += bs) {
+                    sigma[j] = sqrtEps * std::max(std::abs(y[nq+j]), Real(1));
+                    yp[nq+j] += sigma[j];
+                    if (j < nu) { du[j] = sigma[j]; anyU = true; }
+                }
+                setAdvancedStateAndRealizeDerivatives(t, yp);
+                const Vector& ydotC = getAdvancedState().getYDot();
+                for (int j=g; j < nw; j += bs) {
+                    const int b = j/bs, n = precondC[b].nrow();
+                    for (int i=0; i < n; ++i)
+                        precondC[b](i,g) = 
+                            (ydotC[nq+b*bs+i] - fy[nq+b*bs+i]) / sigma[j];
+                }
+
+                // Perturb q by N times the u part of the same perturbation.
+                if (!anyU) continue;
+                getSystem().multiplyByN(precondState, du, dq);
+                yp = y; yp(0,nq) += dq;
+                setAdvancedStateAndRealizeDerivatives(t, yp);
+                const Vector& ydotBN = getAdvancedState().getYDot();
+                for (int j=g; j < nu; j += bs) {
+                    const int b = j/bs, n = precondBN[b].nrow();
+                    for (int i=0; i < n; ++i)
+                        precondBN[b](i,g) = 
+                            (ydotBN[nq+b*bs+i] - fy[nq+b*bs+i]) / sigma[j];
+                }
+            }
+            ++statsJacobianEvaluations;
+            jacWasUpdated = true;
+        } else
+            ++statsJacobianReuses;
+
+        precondLU.resize(nBlocks);
+        Matrix P;
+        for (int b=0; b < nBlocks; ++b) {
+            P = (-gamma)*precondC[b] - (gamma*gamma)*precondBN[b];
+            P.diag() += 1;
+            precondLU[b].factor(P);
+        }
+    }
+    catch(...) { return CPodes::RecoverableError; } // assume recoverable
+    return CPodes::Success;
+}
+
+int CPodesIntegratorRep::solvePreconditioner
+   (const Vector& r, Vector& z, Real gamma) const
+{
+    const int nq = precondState.getNQ(), nu = precondState.getNU(),
+              nw = nu + precondState.getNZ();
+    z.resize(r.size());
+    if (nw == 0) { z = r; return CPodes::Success; }
+    const int bs = precondC[0].nrow();
+
+    try {
+        // wq = pinv(N) rq, extended with zeros for the z's.
+        Vector wq(nw, Real(0)), uq(nu);
+        getSystem().multiplyByNPInv(precondState, r(0,nq), uq);
+        wq(0,nu) = uq;
+
+        Vector rhs, xb;
+        for (int b=0; b < (int)precondLU.size(); ++b) {
+            const int n = precondC[b].nrow();
+            rhs = r(nq+b*bs, n) + gamma*(precondBN[b]*wq(b*bs, n));
+            precondLU[b].solve(rhs, xb);
+            z(nq+b*bs, n) = xb;
+        }
+
+        Vector dq(nq);
+        getSystem().multiplyByN(precondState, z(nq,nu), dq);
+        z(0,nq) = r(0,nq) + gamma*dq;
+    }
+    catch(...) { return CPodes::RecoverableError; } // assume recoverable
+    return CPodes::Success;
+}
+
 
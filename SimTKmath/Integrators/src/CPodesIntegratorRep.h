@@ -27,10 +27,14 @@
 #include "SimTKcommon.h"
 #include "simmath/internal/common.h"
 #include "simmath/Integrator.h"
+#include "simmath/CPodesIntegrator.h"
+#include "simmath/LinearAlgebra.h"
 #include "simmath/internal/SimTKcpodes.h"
 
 #include "IntegratorRep.h"
 
+#include <memory>
+
 
 namespace SimTK {
 
@@ -56,6 +60,8 @@ public:
     int getNumIterations() const override;
     void resetMethodStatistics() override;
     void createInterpolatedState(Real t);
+    void calcInterpolatedY(Real t, Vector& y) const override;
+    Real getInterpolationStartTime() const override;
     void initializeIntegrationParameters();
     void reconstructForNewModel();
     const char* getMethodName() const override;
@@ -64,6 +70,20 @@ public:
     bool methodHasErrorControl() const override;
     void setUseCPodesProjection();
     void setOrderLimit(int order);
+    void setLinearSolver(CPodesIntegrator::LinearSolver solver);
+    CPodesIntegrator::LinearSolver getLinearSolver() const 
+    {   return linearSolver; }
+    void setJacobianBandwidth(int upper, int lower);
+    void setKrylovSubspaceDimension(int maxl);
+    void setPreconditionerBlockSize(int blockSize);
+    int getNumJacobianEvaluations() const;
+    int getNumLinearSolverIterations() const;
+    void setJacobianMethod(CPodesIntegrator::JacobianMethod method);
+    CPodesIntegrator::JacobianMethod getJacobianMethod() const 
+    {   return jacobianMethod; }
+    void setJacobianProvider(CPodesIntegrator::JacobianProvider* provider);
+    void setMaxStepsBetweenJacobians(int steps);
+    int getNumJacobianReuses() const;
     class CPodesSystemImpl;
     friend class CPodesSystemImpl;
 private:
@@ -72,10 +92,35 @@ private:
     bool initialized, useCpodesProjection;
     int statsStepsTaken, statsErrorTestFailures, statsConvergenceTestFailures;
     int statsIterations;
+    int statsJacobianEvaluations, statsLinearIterations, statsJacobianReuses;
     int pendingReturnCode;
     Real previousStartTime, previousTimeReturned;
     Vector savedY;
     CPodes::LinearMultistepMethod method;
+
+    CPodesIntegrator::LinearSolver linearSolver;
+    int bandUpper, bandLower, krylovDimension, precondBlockSize;
+
+    // How the direct linear solvers get their Jacobian, and how long CPODES
+    // may keep reusing one.
+    CPodesIntegrator::JacobianMethod                    jacobianMethod;
+    std::unique_ptr<CPodesIntegrator::JacobianProvider> jacobianProvider;
+    int   maxStepsBetweenJacobians;
+    int calcJacobian(Real t, const Vector& y, const Vector& fy, Matrix& J);
+
+    // The block diagonal preconditioner used with KrylovLinearSolver. The
+    // blocks partition w=(u,z); precondC holds the diagonal blocks of 
+    // dwdot/dw and precondBN those of dwdot/dq*N, both calculated at 
+    // precondState, and precondLU the factored blocks of the preconditioner
+    // for the most recent gamma.
+    State            precondState;
+    Array_<Matrix>   precondC, precondBN;
+    Array_<FactorLU> precondLU;
+    int setUpPreconditioner(Real t, const Vector& y, const Vector& fy,
+                            bool jacIsCurrent, bool& jacWasUpdated, 
+                            Real gamma);
+    int solvePreconditioner(const Vector& r, Vector& z, Real gamma) const;
+
     void init(CPodes::LinearMultistepMethod method, CPodes::NonlinearSystemIterationType iterationType);
 };
 
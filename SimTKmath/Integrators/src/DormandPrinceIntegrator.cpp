@@ -0,0 +1,218 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/** @file
+ * This is the private (library side) implementation of the 
+ * DormandPrinceIntegrator and DormandPrinceIntegratorRep classes.
+ */
+
+#include "SimTKcommon.h"
+#include "simmath/Integrator.h"
+#include "simmath/DormandPrinceIntegrator.h"
+
+#include "IntegratorRep.h"
+#include "DormandPrinceIntegratorRep.h"
+
+using namespace SimTK;
+
+//------------------------------------------------------------------------------
+//                       DORMAND PRINCE INTEGRATOR
+//------------------------------------------------------------------------------
+
+DormandPrinceIntegrator::DormandPrinceIntegrator(const System& sys) 
+{
+    rep = new DormandPrinceIntegratorRep(this, sys);
+}
+
+
+//------------------------------------------------------------------------------
+//                     DORMAND PRINCE INTEGRATOR REP
+//------------------------------------------------------------------------------
+
+// Coefficients of DOPRI5 from Hairer, Norsett & Wanner, Solving ODEs I, 
+// 2nd rev. ed., Table II.5.2, and the dense output coefficients of their
+// DOPRI5 code (contd5). Our f0..f6 are their k1..k7.
+namespace {
+const Real C2  = Real(1.0/5.0);
+const Real C3  = Real(3.0/10.0);
+const Real C4  = Real(4.0/5.0);
+const Real C5  = Real(8.0/9.0);
+
+const Real A21 = Real(1.0/5.0);
+const Real A31 = Real(3.0/40.0),        A32 = Real(9.0/40.0);
+const Real A41 = Real(44.0/45.0),       A42 = Real(-56.0/15.0),
+           A43 = Real(32.0/9.0);
+const Real A51 = Real(19372.0/6561.0),  A52 = Real(-25360.0/2187.0),
+           A53 = Real(64448.0/6561.0),  A54 = Real(-212.0/729.0);
+const Real A61 = Real(9017.0/3168.0),   A62 = Real(-355.0/33.0),
+           A63 = Real(46732.0/5247.0),  A64 = Real(49.0/176.0),
+           A65 = Real(-5103.0/18656.0);
+
+// Fifth order solution weights; the first-same-as-last property is that 
+// these are also the coefficients of the seventh stage.
+const Real B1  = Real(35.0/384.0),      B3  = Real(500.0/1113.0),
+           B4  = Real(125.0/192.0),     B5  = Real(-2187.0/6784.0),
+           B6  = Real(11.0/84.0);
+
+// Difference between the fifth and fourth order weights.
+const Real E1  = Real(71.0/57600.0),    E3  = Real(-71.0/16695.0),
+           E4  = Real(71.0/1920.0),     E5  = Real(-17253.0/339200.0),
+           E6  = Real(22.0/525.0),      E7  = Real(-1.0/40.0);
+
+const Real D1  = Real(-12715105075.0/11282082432.0),
+           D3  = Real(87487479700.0/32700410799.0),
+           D4  = Real(-10690763975.0/1880347072.0),
+           D5  = Real(701980252875.0/199316789632.0),
+           D6  = Real(-1453857185.0/822651844.0),
+           D7  = Real(69997945.0/29380423.0);
+}
+
+DormandPrinceIntegratorRep::DormandPrinceIntegratorRep
+   (Integrator* handle, const System& sys) 
+:   AbstractIntegratorRep(handle, sys, 5, 5, "DormandPrince",  true),
+    stepT0(NaN), stepT1(NaN) {}
+
+// This is the seven stage, fifth order Dormand-Prince method with an 
+// embedded fourth order error estimate. We call the initial state (t0,y0) 
+// and want (t0+h,y1). We are given the initial derivative f0=f(t0,y0), which
+// is usually left over from the last stage of the previous step: that stage
+// is the derivative at y1, so if the caller doesn't have to project y1 onto
+// the constraint manifold the advanced state is still realized through
+// Acceleration stage and the next step gets its f0 for free.
+//
+// The stage derivatives are kept after the step so that calcInterpolatedY()
+// can evaluate the continuous extension.
+bool DormandPrinceIntegratorRep::attemptODEStep
+   (Real t1, Vector& y1err, int& errOrder, int& numIterations)
+{
+    const Real t0 = getPreviousTime();
+    assert(t1 > t0);
+
+    statsStepsAttempted++;
+    errOrder = 4;
+    const Vector& y0 = getPreviousY();
+    const Vector& f0 = getPreviousYDot();
+    const int ny = y0.size();
+    if (ytmp[0].size() != ny)
+        for (int i=0; i<NTemps; ++i)
+            ytmp[i].resize(ny);
+    Vector& f1 = ytmp[0]; // rename temps
+    Vector& f2 = ytmp[1];
+    Vector& f3 = ytmp[2];
+    Vector& f4 = ytmp[3];
+    Vector& f5 = ytmp[4];
+    Vector& f6 = ytmp[5];
+    Vector& ys = ytmp[6];
+
+    const Real h = t1-t0;
+    stepT0 = t0; stepT1 = t1;
+
+    for (int i=0; i<ny; ++i)
+        ys[i] = y0[i] + h*(A21*f0[i]);
+    setAdvancedStateAndRealizeDerivatives(t0 + h*C2, ys);
+    f1 = getAdvancedState().getYDot();
+
+    for (int i=0; i<ny; ++i)
+        ys[i] = y0[i] + h*(A31*f0[i] + A32*f1[i]);
+    setAdvancedStateAndRealizeDerivatives(t0 + h*C3, ys);
+    f2 = getAdvancedState().getYDot();
+
+    for (int i=0; i<ny; ++i)
+        ys[i] = y0[i] + h*(A41*f0[i] + A42*f1[i] + A43*f2[i]);
+    setAdvancedStateAndRealizeDerivatives(t0 + h*C4, ys);
+    f3 = getAdvancedState().getYDot();
+
+    for (int i=0; i<ny; ++i)
+        ys[i] = y0[i] + h*(A51*f0[i] + A52*f1[i] + A53*f2[i] + A54*f3[i]);
+    setAdvancedStateAndRealizeDerivatives(t0 + h*C5, ys);
+    f4 = getAdvancedState().getYDot();
+
+    for (int i=0; i<ny; ++i)
+        ys[i] = y0[i] + h*(A61*f0[i] + A62*f1[i] + A63*f2[i] + A64*f3[i]
+                           + A65*f4[i]);
+    setAdvancedStateAndRealizeDerivatives(t1, ys);
+    f5 = getAdvancedState().getYDot();
+
+    // Final value, y1=y(t0+h)+O(h^6). Unlike the other Runge-Kutta methods
+    // we do evaluate derivatives here since the error estimate and the 
+    // continuous extension need them.
+    for (int i=0; i<ny; ++i)
+        ys[i] = y0[i] + h*(B1*f0[i] + B3*f2[i] + B4*f3[i] + B5*f4[i]
+                           + B6*f5[i]);
+    setAdvancedStateAndRealizeDerivatives(t1, ys);
+    f6 = getAdvancedState().getYDot();
+
+    // The embedded fourth order solution differs from y1 by this, which is
+    // O(h^5).
+    for (int i=0; i<ny; ++i)
+        y1err[i] = h*(E1*f0[i] + E3*f2[i] + E4*f3[i] + E5*f4[i] + E6*f5[i]
+                      + E7*f6[i]);
+
+    return true;
+}
+
+// The continuous extension is the fourth order polynomial given by Hairer, 
+// et al. for DOPRI5. With theta=(t-t0)/h, theta1=1-theta, and dy=y1-y0,
+//     y(t) = y0 + theta*(dy + theta1*(c3 + theta*(c4 + theta1*c5)))
+// where c3 = h f0 - dy, c4 = dy - h f6 - c3, and c5 = h*sum(Dj*fj).
+// It uses the unprojected y1 from the step, so it can differ from the 
+// advanced state at t1 by the size of the projection; we return the advanced
+// state itself there. If the stages don't belong to the current interval,
+// for example right after initialization or an event handler, we fall back 
+// to Hermite interpolation.
+void DormandPrinceIntegratorRep::calcInterpolatedY(Real t, Vector& y) const {
+    const State& advanced = getAdvancedState();
+    if (t == advanced.getTime()) {
+        y = advanced.getY();
+        return;
+    }
+
+    const Vector& y0 = getPreviousY();
+    const int ny = y0.size();
+    if (getPreviousTime() != stepT0 || ytmp[0].size() != ny
+        || !(stepT0 <= t && t <= stepT1)) 
+    {
+        AbstractIntegratorRep::calcInterpolatedY(t, y);
+        return;
+    }
+
+    const Vector& f0 = getPreviousYDot();
+    const Vector& f2 = ytmp[1];
+    const Vector& f3 = ytmp[2];
+    const Vector& f4 = ytmp[3];
+    const Vector& f5 = ytmp[4];
+    const Vector& f6 = ytmp[5];
+    const Vector& y1 = ytmp[6];
+
+    const Real h = stepT1 - stepT0;
+    const Real theta = (t - stepT0)/h, theta1 = 1 - theta;
+    y.resize(ny);
+    for (int i=0; i<ny; ++i) {
+        const Real dy = y1[i] - y0[i];
+        const Real c3 = h*f0[i] - dy;
+        const Real c4 = dy - h*f6[i] - c3;
+        const Real c5 = h*(D1*f0[i] + D3*f2[i] + D4*f3[i] + D5*f4[i] 
+                           + D6*f5[i] + D7*f6[i]);
+        y[i] = y0[i] + theta*(dy + theta1*(c3 + theta*(c4 + theta1*c5)));
+    }
+}
@@ -55,34 +55,17 @@ ExplicitEulerIntegratorRep::ExplicitEulerIntegratorRep
 
 
 //==============================================================================
-//                         CREATE INTERPOLATED STATE
+//                           CALC INTERPOLATED Y
 //==============================================================================
-// Create an interpolated state at time t, which is between tPrev and tCurrent.
-// If we haven't yet delivered an interpolated state in this interval, we have
-// to initialize its discrete part from the advanced state.
-void ExplicitEulerIntegratorRep::createInterpolatedState(Real t) {
-    const System& system   = getSystem();
-    const State&  advanced = getAdvancedState();
-    State&        interp   = updInterpolatedState();
-    interp = advanced; // pick up discrete stuff.
-    const Real weight1 = (getAdvancedTime()-t) /
-                         (getAdvancedTime()-getPreviousTime());
-    const Real weight2 = 1-weight1;
-    interp.updY() = weight1*getPreviousY()+weight2*getAdvancedState().getY();
-    interp.updTime() = t;
-
-    if (userProjectInterpolatedStates == 0) {
-        system.realize(interp, Stage::Time);
-        system.prescribeQ(interp);
-        system.realize(interp, Stage::Position);
-        system.prescribeU(interp);
-        system.realize(interp, Stage::Velocity);
+// Interpolate y(t) linearly between tPrev and tCurrent.
+void ExplicitEulerIntegratorRep::
+calcInterpolatedY(Real t, Vector& y) const {
+    if (t == getAdvancedTime()) { // includes the case tPrev==tAdvanced
+        y = getAdvancedState().getY();
         return;
     }
-
-    // We may need to project onto constraint manifold. Allow project()
-    // to throw an exception if it fails since there is no way to recover here.
-    realizeAndProjectKinematicsWithThrow(interp, ProjectOptions::LocalOnly);
+    interpolateOrder1(getPreviousTime(), getPreviousY(),
+                      getAdvancedTime(), getAdvancedState().getY(), t, y);
 }
 
 
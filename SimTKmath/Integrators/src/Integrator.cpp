@@ -167,6 +167,34 @@ State& Integrator::updAdvancedState() {
     return updRep().updAdvancedState();
 }
 
+Real Integrator::getInterpolationStartTime() const {
+    return getRep().getInterpolationStartTime();
+}
+
+void Integrator::calcInterpolatedY(Real t, Vector& y) const {
+    const Real t0 = getRep().getInterpolationStartTime();
+    const Real t1 = getRep().getAdvancedTime();
+    SimTK_APIARGCHECK3_ALWAYS(t0 <= t && t <= t1, "Integrator",
+        "calcInterpolatedY", "Time %g is outside the most recent step %g:%g.",
+        t, t0, t1);
+    getRep().calcInterpolatedY(t, y);
+}
+
+void Integrator::calcInterpolatedY(const Vector& times, Matrix& Y) const {
+    const Real t0 = getRep().getInterpolationStartTime();
+    const Real t1 = getRep().getAdvancedTime();
+    Y.resize(getRep().getAdvancedState().getNY(), times.size());
+    Vector y(Y.nrow()); // reused for every sample
+    for (int j=0; j < times.size(); ++j) {
+        SimTK_APIARGCHECK4_ALWAYS(t0 <= times[j] && times[j] <= t1, 
+            "Integrator", "calcInterpolatedY", 
+            "Time %g (times[%d]) is outside the most recent step %g:%g.",
+            times[j], j, t0, t1);
+        getRep().calcInterpolatedY(times[j], y);
+        Y(j) = y;
+    }
+}
+
 
 Real Integrator::getAccuracyInUse() const {
     return getRep().getAccuracyInUse();
@@ -438,6 +466,9 @@ void IntegratorRep::reinitialize(Stage stage, bool shouldTerminate) {
     if (stage < Stage::Report) {
         startOfContinuousInterval = true;
         setUseInterpolatedState(false);
+        // The trajectory may be discontinuous here, so there is nothing to
+        // interpolate from until the next step has been taken.
+        tPrev = getAdvancedTime();
     }
     if (shouldTerminate) {
         setStepCommunicationStatus(FinalTimeHasBeenReturned);
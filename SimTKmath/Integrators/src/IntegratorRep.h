@@ -278,6 +278,19 @@ public:
     virtual void resetMethodStatistics() {
     }
 
+    // Dense output. Calculate just the continuous variables y(t) from the
+    // integration method's interpolant for the most recently completed step,
+    // for getInterpolationStartTime() <= t <= getAdvancedTime(). This is what
+    // createInterpolatedState() uses, but here no State is copied, realized or
+    // projected. y is resized only if it is the wrong size, so repeated calls
+    // don't allocate.
+    virtual void calcInterpolatedY(Real t, Vector& y) const = 0;
+
+    // The earliest time for which calcInterpolatedY() works. For methods that
+    // interpolate using the saved values from the start of the step, that's
+    // the previous time.
+    virtual Real getInterpolationStartTime() const {return tPrev;}
+
     // Cubic Hermite interpolation. See Hairer, et al. Solving ODEs I, 2nd rev.
     // ed., pg 190. Given (t0,y0,y0'),(t1,y1,y1') with y0 and y1 at least 3rd 
     // order accurate, we can obtain a 3rd order accurate interpolation yt for
@@ -309,7 +322,28 @@ public:
         const Real cy1 = d*d*(3-2*d), cy0 = 1-cy1;
         const Real hdd1 = h*d*(d-1), cf1=hdd1*d, cf0=cf1-hdd1;
 
-        yt = cy0*y0 + cy1*y1 + cf0*f0 + cf1*f1; // + O(h^4)
+        // Element by element so that no temporaries are needed; yt is only
+        // reallocated if it is the wrong size.
+        const int n = y0.size();
+        yt.resize(n);
+        for (int i=0; i < n; ++i)
+            yt[i] = cy0*y0[i] + cy1*y1[i] + cf0*f0[i] + cf1*f1[i]; // + O(h^4)
+    }
+
+    // Linear interpolation between (t0,y0) and (t1,y1) for the first-order
+    // methods, with the same conventions as interpolateOrder3().
+    static void interpolateOrder1
+       (const Real& t0, const Vector& y0, const Real& t1, const Vector& y1,
+        const Real& t, Vector& yt) {
+        assert(t0 < t1);
+        assert(t0 <= t && t <= t1);
+        assert(y1.size()==y0.size());
+
+        const Real w1 = (t-t0)/(t1-t0), w0 = 1-w1;
+        const int n = y0.size();
+        yt.resize(n);
+        for (int i=0; i < n; ++i)
+            yt[i] = w0*y0[i] + w1*y1[i];
     }
 
     // We have bracketed a zero crossing for some function f(t)
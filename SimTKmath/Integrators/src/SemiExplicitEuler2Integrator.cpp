@@ -48,11 +48,9 @@ SemiExplicitEuler2IntegratorRep::SemiExplicitEuler2IntegratorRep
 }
 
 //==============================================================================
-//                         CREATE INTERPOLATED STATE
+//                           CALC INTERPOLATED Y
 //==============================================================================
-// Create an interpolated state at time t, which is between tPrev and tCurrent.
-// If we haven't yet delivered an interpolated state in this interval, we have
-// to initialize its discrete part from the advanced state.
+// Interpolate y(t) linearly between tPrev and tCurrent.
 //
 // TODO: Note that this is a first-order interpolation across the *whole* step, 
 // even though this integrator takes two smaller first-order substeps. It would
@@ -61,29 +59,14 @@ SemiExplicitEuler2IntegratorRep::SemiExplicitEuler2IntegratorRep
 // the underlying steps. Alternately, the midpoint value could be used to
 // perform a second-order interpolation here; I'm not sure whether that would
 // be better.
-void SemiExplicitEuler2IntegratorRep::createInterpolatedState(Real t) {
-    const System& system   = getSystem();
-    const State&  advanced = getAdvancedState();
-    State&        interp   = updInterpolatedState();
-    interp = advanced; // pick up discrete stuff.
-    const Real weight1 = (getAdvancedTime()-t) /
-                         (getAdvancedTime()-getPreviousTime());
-    const Real weight2 = 1-weight1;
-    interp.updY() = weight1*getPreviousY()+weight2*getAdvancedState().getY();
-    interp.updTime() = t;
-
-    if (userProjectInterpolatedStates == 0) {
-        system.realize(interp, Stage::Time);
-        system.prescribeQ(interp);
-        system.realize(interp, Stage::Position);
-        system.prescribeU(interp);
-        system.realize(interp, Stage::Velocity);
+void SemiExplicitEuler2IntegratorRep::
+calcInterpolatedY(Real t, Vector& y) const {
+    if (t == getAdvancedTime()) { // includes the case tPrev==tAdvanced
+        y = getAdvancedState().getY();
         return;
     }
-
-    // We may need to project onto constraint manifold. Allow project()
-    // to throw an exception if it fails since there is no way to recover here.
-    realizeAndProjectKinematicsWithThrow(interp, ProjectOptions::LocalOnly);
+    interpolateOrder1(getPreviousTime(), getPreviousY(),
+                      getAdvancedTime(), getAdvancedState().getY(), t, y);
 }
 
 
@@ -31,10 +31,10 @@ namespace SimTK {
 class SemiExplicitEulerIntegratorRep : public AbstractIntegratorRep {
 public:
     SemiExplicitEulerIntegratorRep(Integrator* handle, const System& sys);
+    void calcInterpolatedY(Real t, Vector& y) const override;
 protected:
     bool attemptDAEStep
        (Real t1, Vector& yErrEst, int& errOrder, int& numIterations) override;
-    void createInterpolatedState(Real t) override;
     void backUpAdvancedStateByInterpolation(Real t) override;
 };
 
@@ -32,6 +32,7 @@
 #include "simmath/internal/Geo_LineSeg.h"
 #include "simmath/internal/Geo_Box.h"
 #include "simmath/internal/Geo_Triangle.h"
+#include "simmath/internal/Geo_TriangleBatch.h"
 #include "simmath/internal/Geo_CubicHermiteCurve.h"
 #include "simmath/internal/Geo_BicubicHermitePatch.h"
 #include "simmath/internal/Geo_CubicBezierCurve.h"
@@ -56,6 +57,7 @@
 #include "simmath/CPodesIntegrator.h"
 #include "simmath/RungeKuttaMersonIntegrator.h"
 #include "simmath/RungeKuttaFeldbergIntegrator.h"
+#include "simmath/DormandPrinceIntegrator.h"
 #include "simmath/RungeKutta3Integrator.h"
 #include "simmath/RungeKutta2Integrator.h"
 #include "simmath/ExplicitEulerIntegrator.h"
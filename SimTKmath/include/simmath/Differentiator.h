@@ -73,6 +73,19 @@ namespace SimTK {
  * Then the derivative, gradient element, or Jacobian column is computed 
  * as df/dy=[f(x+h)-f(x)]/h (1st order) or df/dy=[f(x+h)-f(x-h)]/(2h) 
  * (2nd order).
+ *
+ * @par Parallel evaluation
+ *
+ * The gradient elements or Jacobian columns are independent of one another,
+ * so they can be calculated concurrently. If you call setNumberOfThreads()
+ * with a number greater than one, the columns are split into that many 
+ * contiguous chunks which are evaluated on separate threads. Each chunk needs
+ * a function it can call without interfering with the others: either the
+ * function has been declared thread safe with Function::setIsThreadSafe(),
+ * in which case it is shared by all the chunks, or its clone() method returns
+ * a private copy for each additional chunk. If neither is the case, the
+ * columns are evaluated serially as usual. The results are identical to the
+ * serial results regardless of the number of threads used.
  */
 class SimTK_SIMMATH_EXPORT Differentiator {
 public:
@@ -107,6 +120,12 @@ public:
     Differentiator& setDefaultMethod(Method);
     Method          getDefaultMethod() const;
 
+    // Gradient elements and Jacobian columns can be evaluated concurrently on
+    // up to this many threads; the default is 1 (serial). See "Parallel 
+    // evaluation" above for what is required of the function.
+    Differentiator& setNumberOfThreads(int);
+    int             getNumberOfThreads() const;
+
     // These are the real routines, which are efficient and flexible
     // but somewhat messy to use.
     void calcDerivative(Real y0, Real fy0, Real& dfdy, 
@@ -160,6 +179,12 @@ public:
     int  getNumParameters() const;
     Real getEstimatedAccuracy() const; // approx. "roundoff" in f calculation
 
+    // Declare that f() may be called concurrently from several threads, so
+    // a Differentiator using more than one thread can share this function
+    // rather than cloning it. The default is false.
+    Function& setIsThreadSafe(bool);
+    bool      isThreadSafe() const;
+
     // Statistics (mutable)
     void resetAllStatistics();
     int getNumCalls()    const; // # evaluations of this function since reset
@@ -209,9 +234,17 @@ class SimTK_SIMMATH_EXPORT Differentiator::GradientFunction : public Differentia
 public:
     virtual int f(const Vector& y, Real& fy) const=0;
 
+    // Return a new heap-allocated copy of this function whose f() can be
+    // called concurrently with the original's, or null if that isn't 
+    // possible (the default). A Differentiator that is using several threads
+    // calls this once per additional thread and deletes the copies when it
+    // is done with them.
+    virtual GradientFunction* clone() const {return nullptr;}
+
+    virtual ~GradientFunction() { }
+
 protected:
     explicit GradientFunction(int ny=-1, Real acc=-1);
-    virtual ~GradientFunction() { }
 
 private:
     // suppress copy constructor and copy assignment
@@ -228,9 +261,13 @@ class SimTK_SIMMATH_EXPORT Differentiator::JacobianFunction : public Differentia
 public:
     virtual int f(const Vector& y, Vector& fy) const=0;
 
+    // See GradientFunction::clone().
+    virtual JacobianFunction* clone() const {return nullptr;}
+
+    virtual ~JacobianFunction() { }
+
 protected:
     explicit JacobianFunction(int nf=-1, int ny=-1, Real acc=-1); 
-    virtual ~JacobianFunction() { }
 
 private:
     // suppress copy constructor and copy assignment
@@ -29,7 +29,11 @@
 #include "SimTKcommon.h"
 #include "simmath/Differentiator.h"
 
+#include <algorithm>
 #include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace SimTK {
 
@@ -133,6 +137,22 @@ public:
     void calcJacobian(const JacobianFunctionRep&, Differentiator::Method, 
                       const Vector& y0, const Vector& fy0, Matrix& dfdy) const;
 
+    // Supply a function for each chunk of columns to be evaluated 
+    // concurrently; see the implementation. Returns false if the columns
+    // should be evaluated serially instead.
+    template <class F>
+    bool getChunkFunctions(const F& func, bool funcIsThreadSafe,
+                           std::vector<std::unique_ptr<F>>& clones,
+                           std::vector<const F*>& funcs) const;
+
+    // Evaluate column chunks concurrently; evalChunk(chunk,begin,end) 
+    // evaluates columns [begin,end). Returns the number of calls made to the
+    // user function as counted in nCallsInChunk, after rethrowing the first
+    // exception if any chunk failed.
+    int executeChunks(int nChunks, 
+                      const std::function<void(int,int,int)>& evalChunk,
+                      Array_<int>& nCallsInChunk) const;
+
     const Real& getAccFac(int order) const {
         if (order==1) return AccFac1;
         if (order==2) return AccFac2;
@@ -162,6 +182,11 @@ private:
     // This is set on construction, but can be changed.
     Differentiator::Method defaultMethod;
 
+    // Maximum number of threads used for evaluating columns. The executor 
+    // is created when first needed.
+    int numThreads;
+    mutable std::unique_ptr<ParallelExecutor> executor;
+
     // These are pre-calculated accuracy factors for 1st order and
     // 2nd order step size estimates, derived from EstimatedAccuracy
     // upon construction.
@@ -173,6 +198,9 @@ private:
     mutable Vector ytmp;           // [NParameters]
     mutable Vector fyptmp, fymtmp; // [NFunctions]
 
+    // The same, one per column chunk when evaluating in parallel.
+    mutable Array_<Vector> chunkYtmp, chunkFyptmp, chunkFymtmp;
+
     // suppress
     DifferentiatorRep(const DifferentiatorRep&);
     DifferentiatorRep& operator=(const DifferentiatorRep&);
@@ -186,7 +214,7 @@ class Differentiator::Function::FunctionRep {
     friend class Differentiator::Function;
 public:
     FunctionRep(int nf, int np, Real acc)
-      : nFunc(nf), nParam(np), estimatedAccuracy(acc)
+      : nFunc(nf), nParam(np), estimatedAccuracy(acc), threadSafe(false)
     {
         if (estimatedAccuracy < 0) // use default
             estimatedAccuracy = SignificantReal; // ~1e-14 in double
@@ -217,10 +245,19 @@ public:
         return estimatedAccuracy;
     }
 
+    bool isThreadSafe() const {return threadSafe;}
+
     void resetAllStatistics() {
         nCalls = nFailures = 0;
     }
 
+    // Record calls that were made without going through call(), as when the
+    // calls were made concurrently.
+    void recordCalls(int calls, int failures) const {
+        nCalls    += calls;
+        nFailures += failures;
+    }
+
 protected:
     // Stats
     mutable int nCalls;
@@ -229,7 +266,7 @@ protected:
 private:
     int  nFunc, nParam;
     Real estimatedAccuracy;
-
+    bool threadSafe;
 };
 
 class ScalarFunctionRep : public Differentiator::Function::FunctionRep {
@@ -343,9 +380,18 @@ public:
         nCalls++;
         nFailures++; // assume failure unless proven otherwise
 
+        invoke(gf, y, fy);
+
+        --nFailures;
+    }
+
+    // Evaluate func, which may be a clone of gf, without touching the 
+    // statistics so that this can be used from several threads at once.
+    static void invoke(const Differentiator::GradientFunction& func,
+                       const Vector& y, Real& fy) {
         int status;
         try 
-          { status = gf.f(y,fy); } 
+          { status = func.f(y,fy); } 
         catch (const std::exception& e)
           { SimTK_THROW1(Differentiator::UserFunctionThrewAnException, e.what()); }
         catch (...)
@@ -354,8 +400,6 @@ public:
 
         if (status != 0)
             SimTK_THROW1(Differentiator::UserFunctionReturnedNonzeroStatus, status);
-
-        --nFailures;
     }
 
     const Differentiator::GradientFunction&       gf;
@@ -413,9 +457,18 @@ public:
         nCalls++;
         nFailures++; // assume failure unless proven otherwise
 
+        invoke(jf, y, fy);
+
+        nFailures--;
+    }
+
+    // Evaluate func, which may be a clone of jf, without touching the 
+    // statistics so that this can be used from several threads at once.
+    static void invoke(const Differentiator::JacobianFunction& func,
+                       const Vector& y, Vector& fy) {
         int status;
         try 
-          { status = jf.f(y,fy); } 
+          { status = func.f(y,fy); } 
         catch (const std::exception& e)
           { SimTK_THROW1(Differentiator::UserFunctionThrewAnException, e.what()); }
         catch (...)
@@ -424,8 +477,6 @@ public:
 
         if (status != 0)
             SimTK_THROW1(Differentiator::UserFunctionReturnedNonzeroStatus, status);
-
-        nFailures--;
     }
 
     const Differentiator::JacobianFunction&       jf;
@@ -451,6 +502,21 @@ Differentiator::Method Differentiator::getDefaultMethod() const {
     return rep->defaultMethod;
 }
 
+Differentiator& Differentiator::setNumberOfThreads(int numThreads) {
+    SimTK_APIARGCHECK1_ALWAYS(numThreads>=1, "Differentiator", "setNumberOfThreads",
+        "The number of threads was %d but must be >= 1", numThreads);
+
+    if (numThreads != rep->numThreads) {
+        rep->numThreads = numThreads;
+        rep->executor.reset(); // recreated with the new size when needed
+    }
+    return *this;
+}
+
+int Differentiator::getNumberOfThreads() const {
+    return rep->numThreads;
+}
+
 void Differentiator::calcDerivative
    (Real y0, Real fy0, Real& dfdy, Differentiator::Method m) const 
 {
@@ -647,6 +713,15 @@ Real Differentiator::Function::getEstimatedAccuracy() const {
     return rep->estimatedAccuracy;
 }
 
+Differentiator::Function& 
+Differentiator::Function::setIsThreadSafe(bool threadSafe) {
+    rep->threadSafe = threadSafe;
+    return *this;
+}
+bool Differentiator::Function::isThreadSafe() const {
+    return rep->threadSafe;
+}
+
 void Differentiator::Function::resetAllStatistics(){
     rep->resetAllStatistics();
 }
@@ -686,6 +761,7 @@ Differentiator::DifferentiatorRep::DifferentiatorRep
     NFunctions(fr.getNumFunctions()), 
     EstimatedAccuracy(fr.getEstimatedAccuracy()),
     defaultMethod(getMethodOrThrow(defMthd, DefaultDefaultMethod, "Differentiator")),
+    numThreads(1),
     AccFac1(std::sqrt(EstimatedAccuracy)),
     AccFac2(std::pow(EstimatedAccuracy, OneThird))
 {
@@ -736,9 +812,41 @@ void Differentiator::DifferentiatorRep::calcGradient
 
     gradf.resize(NParameters);
 
-    ytmp = y0;
     const int order = Differentiator::getMethodOrder(method);
 
+    std::vector<std::unique_ptr<Differentiator::GradientFunction>> clones;
+    std::vector<const Differentiator::GradientFunction*> funcs;
+    if (getChunkFunctions(f.gf, f.isThreadSafe(), clones, funcs)) {
+        const int nChunks = (int)funcs.size();
+        chunkYtmp.resize(nChunks);
+        Array_<int> nCallsInChunk(nChunks, 0);
+        const int nCalls = executeChunks(nChunks, 
+            [&](int chunk, int begin, int end) {
+                const Differentiator::GradientFunction& func = *funcs[chunk];
+                Vector& y = chunkYtmp[chunk];
+                y = y0;
+                for (int i=begin; i < end; ++i) {
+                    const Real hEst = getAccFac(order)*std::max(std::abs(y0[i]), YMin);
+                    const Real h = cleanUpH(hEst, y0[i]);
+                    Real fyplus, fyminus;
+                    y[i] = y0[i]+h; 
+                    ++nCallsInChunk[chunk]; GradientFunctionRep::invoke(func, y, fyplus);
+                    if (order==1) {
+                        gradf[i] = (fyplus-fy0)/h;
+                    } else {
+                        y[i] = y0[i]-h; 
+                        ++nCallsInChunk[chunk]; GradientFunctionRep::invoke(func, y, fyminus);
+                        gradf[i] = (fyplus-fyminus)/(2*h);
+                    }
+                    y[i] = y0[i]; // restore
+                }
+            }, nCallsInChunk);
+        nCallsToUserFunction += nCalls;
+        f.recordCalls(nCalls, 0);
+        return;
+    }
+
+    ytmp = y0;
     for (int i=0; i < f.getNumParameters(); ++i) {
         const Real hEst = getAccFac(order)*std::max(std::abs(y0[i]), YMin);
         const Real h = cleanUpH(hEst, y0[i]);
@@ -772,6 +880,43 @@ void Differentiator::DifferentiatorRep::calcJacobian
 
     const int order = Differentiator::getMethodOrder(method);
 
+    std::vector<std::unique_ptr<Differentiator::JacobianFunction>> clones;
+    std::vector<const Differentiator::JacobianFunction*> funcs;
+    if (getChunkFunctions(f.jf, f.isThreadSafe(), clones, funcs)) {
+        const int nChunks = (int)funcs.size();
+        chunkYtmp.resize(nChunks);
+        chunkFyptmp.resize(nChunks);
+        chunkFymtmp.resize(nChunks);
+        Array_<int> nCallsInChunk(nChunks, 0);
+        const int nCalls = executeChunks(nChunks, 
+            [&](int chunk, int begin, int end) {
+                const Differentiator::JacobianFunction& func = *funcs[chunk];
+                Vector& y   = chunkYtmp[chunk];
+                Vector& fyp = chunkFyptmp[chunk];
+                Vector& fym = chunkFymtmp[chunk];
+                y = y0;
+                fyp.resize(NFunctions);
+                fym.resize(NFunctions);
+                for (int i=begin; i < end; ++i) {
+                    const Real hEst = getAccFac(order)*std::max(std::abs(y0[i]), YMin);
+                    const Real h = cleanUpH(hEst, y0[i]);
+                    y[i] = y0[i]+h; 
+                    ++nCallsInChunk[chunk]; JacobianFunctionRep::invoke(func, y, fyp);
+                    if (order==1) {
+                        dfdy(i) = (fyp-fy0)/h;
+                    } else {
+                        y[i] = y0[i]-h; 
+                        ++nCallsInChunk[chunk]; JacobianFunctionRep::invoke(func, y, fym);
+                        dfdy(i) = (fyp-fym)/(2*h);
+                    }
+                    y[i] = y0[i]; // restore
+                }
+            }, nCallsInChunk);
+        nCallsToUserFunction += nCalls;
+        f.recordCalls(nCalls, 0);
+        return;
+    }
+
     ytmp = y0;
     for (int i=0; i < NParameters; ++i) {
         const Real hEst = getAccFac(order)*std::max(std::abs(y0[i]), YMin);
@@ -789,6 +934,87 @@ void Differentiator::DifferentiatorRep::calcJacobian
     }
 }
 
-} // namespace SimTK
+// Each chunk of columns needs a function that can be evaluated without 
+// interfering with the other chunks. The first chunk uses the original 
+// function; the others share it too if it has been declared thread safe, and
+// otherwise each get a clone. If the function can't be cloned, or there is 
+// nothing to gain, return false so the caller evaluates the columns serially.
+// That includes the case where we're already running on a worker thread of
+// some other ParallelExecutor.
+template <class F>
+bool Differentiator::DifferentiatorRep::getChunkFunctions
+   (const F& func, bool funcIsThreadSafe, 
+    std::vector<std::unique_ptr<F>>& clones, 
+    std::vector<const F*>& funcs) const
+{
+    const int nChunks = std::min(numThreads, NParameters);
+    if (nChunks < 2 || ParallelExecutor::isWorkerThread())
+        return false;
+
+    funcs.assign(nChunks, &func);
+    if (!funcIsThreadSafe) {
+        for (int chunk=1; chunk < nChunks; ++chunk) {
+            clones.emplace_back(func.clone());
+            if (!clones.back())
+                return false;
+            funcs[chunk] = clones.back().get();
+        }
+    }
+    return true;
+}
 
+namespace {
+// Columns [0,n) are split into nChunks contiguous chunks as evenly as 
+// possible; each task evaluates one chunk. An exception can't be allowed to
+// escape from a worker thread, so it is saved and rethrown later.
+class ColumnChunkTask : public ParallelExecutor::Task {
+public:
+    ColumnChunkTask(int n, int nChunks, 
+                    const std::function<void(int,int,int)>& evalChunk)
+    :   n(n), nChunks(nChunks), evalChunk(evalChunk), errors(nChunks) {}
 
+    void execute(int chunk) override {
+        const int begin = (int)((long long)chunk*n/nChunks);
+        const int end   = (int)((long long)(chunk+1)*n/nChunks);
+        try 
+          { evalChunk(chunk, begin, end); }
+        catch (...)
+          { errors[chunk] = std::current_exception(); }
+    }
+
+    // Rethrow the exception from the lowest-numbered chunk that failed, so 
+    // that the same one is reported regardless of thread timing.
+    void rethrowFirstError() const {
+        for (const std::exception_ptr& error : errors)
+            if (error) std::rethrow_exception(error);
+    }
+private:
+    const int n, nChunks;
+    const std::function<void(int,int,int)>& evalChunk;
+    Array_<std::exception_ptr> errors;
+};
+}
+
+int Differentiator::DifferentiatorRep::executeChunks
+   (int nChunks, const std::function<void(int,int,int)>& evalChunk,
+    Array_<int>& nCallsInChunk) const 
+{
+    if (!executor)
+        executor.reset(new ParallelExecutor(numThreads));
+
+    ColumnChunkTask task(NParameters, nChunks, evalChunk);
+    executor->execute(task, nChunks);
+
+    int nCalls = 0;
+    for (int chunk=0; chunk < nChunks; ++chunk)
+        nCalls += nCallsInChunk[chunk];
+    try
+      { task.rethrowFirstError(); }
+    catch (...)
+      { nCallsToUserFunction += nCalls;
+        frep.recordCalls(nCalls, 1);
+        throw; }
+    return nCalls;
+}
+
+} // namespace SimTK
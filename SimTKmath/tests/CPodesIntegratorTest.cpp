@@ -24,6 +24,26 @@
 #include "IntegratorTestFramework.h"
 #include "simmath/CPodesIntegrator.h"
 
+// A JacobianProvider that just takes difference quotients of its own, and
+// counts how often it is called.
+class DifferenceQuotientJacobian : public CPodesIntegrator::JacobianProvider {
+public:
+    void calcJacobian(const System& system, const State& state, 
+                      Matrix& J) const override {
+        ++numCalls;
+        State perturbed = state;
+        for (int j=0; j < state.getNY(); ++j) {
+            const Real sigma = 1e-7 * std::max(std::abs(state.getY()[j]), 1.);
+            perturbed.updY() = state.getY();
+            perturbed.updY()[j] += sigma;
+            system.realize(perturbed, Stage::Acceleration);
+            J(j) = (perturbed.getYDot() - state.getYDot()) / sigma;
+        }
+    }
+    static int numCalls;
+};
+int DifferenceQuotientJacobian::numCalls = 0;
+
 int main () {
   try {
     PendulumSystem sys;
@@ -71,6 +91,65 @@ int main () {
         CPodesIntegrator projInteg(sys, CPodes::BDF);
         projInteg.setUseCPodesProjection();
         testIntegrator(projInteg, sys);
+        
+        // Try the banded and Krylov linear solvers. The pendulum is tiny so 
+        // the band covers the whole iteration matrix.
+        
+        CPodesIntegrator bandInteg(sys, CPodes::BDF);
+        bandInteg.setLinearSolver(CPodesIntegrator::BandLinearSolver);
+        bandInteg.setJacobianBandwidth(3, 3);
+        testIntegrator(bandInteg, sys);
+        ASSERT(bandInteg.getNumJacobianEvaluations() > 0);
+        ASSERT(bandInteg.getNumLinearSolverIterations() == 0);
+        
+        CPodesIntegrator krylovInteg(sys, CPodes::BDF);
+        krylovInteg.setLinearSolver(CPodesIntegrator::KrylovLinearSolver);
+        testIntegrator(krylovInteg, sys);
+        ASSERT(krylovInteg.getNumJacobianEvaluations() > 0);
+        ASSERT(krylovInteg.getNumLinearSolverIterations() > 0);
+        
+        // Jacobians from stage-aware difference quotients and from a 
+        // user-supplied provider, reused for fewer steps than the default.
+        
+        CPodesIntegrator stageInteg(sys, CPodes::BDF);
+        stageInteg.setJacobianMethod
+           (CPodesIntegrator::StageAwareDifferenceQuotient);
+        stageInteg.setMaxStepsBetweenJacobians(20);
+        testIntegrator(stageInteg, sys);
+        ASSERT(stageInteg.getNumJacobianEvaluations() > 0);
+        ASSERT(stageInteg.getNumJacobianReuses() > 0);
+        
+        // With a band narrower than the system, the stage-aware quotients
+        // perturb columns that don't share a band row together.
+        
+        CPodesIntegrator stageBandInteg(sys, CPodes::BDF);
+        stageBandInteg.setJacobianMethod
+           (CPodesIntegrator::StageAwareDifferenceQuotient);
+        stageBandInteg.setLinearSolver(CPodesIntegrator::BandLinearSolver);
+        stageBandInteg.setJacobianBandwidth(1, 1);
+        testIntegrator(stageBandInteg, sys);
+        ASSERT(stageBandInteg.getNumJacobianEvaluations() > 0);
+        
+        CPodesIntegrator providerInteg(sys, CPodes::BDF);
+        providerInteg.setJacobianProvider(new DifferenceQuotientJacobian());
+        DifferenceQuotientJacobian::numCalls = 0;
+        testIntegrator(providerInteg, sys);
+        ASSERT(DifferenceQuotientJacobian::numCalls > 0);
+        ASSERT(providerInteg.getNumJacobianEvaluations() 
+               <= DifferenceQuotientJacobian::numCalls);
+        
+        // A band solver without a bandwidth can't be initialized.
+        
+        CPodesIntegrator noBandInteg(sys, CPodes::BDF);
+        noBandInteg.setLinearSolver(CPodesIntegrator::BandLinearSolver);
+        bool threw = false;
+        try {
+            noBandInteg.initialize(sys.getDefaultState());
+        }
+        catch (const std::exception&) {
+            threw = true;
+        }
+        ASSERT(threw);
     }
     cout << "Done" << endl;
     return 0;
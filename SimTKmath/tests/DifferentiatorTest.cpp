@@ -33,6 +33,7 @@
 
 #include <cstdio>
 #include <iostream>
+#include <stdexcept>
 
 using SimTK::Real;
 using SimTK::Vector;
@@ -191,6 +192,115 @@ static void doSinOmegaExample() {
 };
 
 
+// A vector function of many parameters in which each function depends on 
+// its neighboring parameters, for testing concurrent evaluation of Jacobian
+// columns. It can optionally be cloned.
+class CoupledFunc : public Differentiator::JacobianFunction {
+public:
+    CoupledFunc(int n, bool canClone) 
+        : Differentiator::JacobianFunction(n,n), canClone(canClone) { }
+
+    int f(const Vector& y, Vector& fy) const override {
+        const int n = y.size();
+        for (int i=0; i < n; ++i)
+            fy[i] = std::sin(y[i])*y[(i+1)%n] + y[i]*y[i]*y[(i+n-1)%n];
+        return 0;
+    }
+
+    CoupledFunc* clone() const override {
+        return canClone ? new CoupledFunc(getNumParameters(), true) : nullptr;
+    }
+private:
+    bool canClone;
+};
+
+// A scalar function of many parameters which throws if the last parameter
+// exceeds a limit; it is declared thread safe rather than cloned.
+class LimitedObjectiveFunc : public Differentiator::GradientFunction {
+public:
+    LimitedObjectiveFunc(int n, Real limit) 
+        : Differentiator::GradientFunction(n), limit(limit) 
+    {   setIsThreadSafe(true); }
+
+    int f(const Vector& y, Real& fy) const override {
+        if (y[y.size()-1] > limit)
+            throw std::runtime_error("parameter out of range");
+        fy = 0;
+        for (int i=0; i < y.size(); ++i)
+            fy += std::cos(y[i])*(i+1);
+        return 0;
+    }
+private:
+    Real limit;
+};
+
+static bool isIdentical(const Matrix& a, const Matrix& b) {
+    if (a.nrow() != b.nrow() || a.ncol() != b.ncol())
+        return false;
+    for (int j=0; j < a.ncol(); ++j)
+        for (int i=0; i < a.nrow(); ++i)
+            if (a(i,j) != b(i,j)) return false;
+    return true;
+}
+
+// Jacobians and gradients calculated on several threads must be exactly the
+// same as the serial ones, with the same statistics.
+static void testParallelDerivatives() {
+    const int n = 37; // doesn't divide evenly among the threads
+    Vector y0(n);
+    for (int i=0; i < n; ++i) y0[i] = 0.1*(i+1);
+
+    CoupledFunc cloneable(n, true), notCloneable(n, false);
+    Differentiator serial(cloneable), parallel(cloneable), 
+                   fallback(notCloneable);
+    SimTK_ASSERT_ALWAYS(parallel.getNumberOfThreads() == 1,
+        "Differentiator should be serial by default.");
+    parallel.setNumberOfThreads(4);
+    fallback.setNumberOfThreads(4);
+
+    for (Differentiator::Method m : {Differentiator::ForwardDifference,
+                                     Differentiator::CentralDifference}) {
+        const Matrix J = serial.calcJacobian(y0, m);
+        SimTK_ASSERT_ALWAYS(isIdentical(parallel.calcJacobian(y0, m), J),
+            "Jacobian calculated with cloned functions differs from serial.");
+        SimTK_ASSERT_ALWAYS(isIdentical(fallback.calcJacobian(y0, m), J),
+            "Jacobian calculated with an uncloneable function differs.");
+    }
+    SimTK_ASSERT_ALWAYS(parallel.getNumCallsToUserFunction() 
+                        == serial.getNumCallsToUserFunction(),
+        "Parallel Jacobians should make the same number of function calls.");
+    SimTK_ASSERT_ALWAYS(cloneable.getNumCalls() 
+                        == 2*serial.getNumCallsToUserFunction(),
+        "Calls made through clones should be counted by the function.");
+
+    cloneable.setIsThreadSafe(true); // now shared rather than cloned
+    SimTK_ASSERT_ALWAYS(isIdentical(parallel.calcJacobian(y0),
+                                    serial.calcJacobian(y0)),
+        "Jacobian calculated with a shared function differs from serial.");
+
+    LimitedObjectiveFunc objective(n, 2*y0[n-1]);
+    Differentiator serialGrad(objective), parallelGrad(objective);
+    parallelGrad.setNumberOfThreads(3);
+    SimTK_ASSERT_ALWAYS((parallelGrad.calcGradient(y0)
+                         - serialGrad.calcGradient(y0)).normInf() == 0,
+        "Gradient calculated on several threads differs from serial.");
+
+    // An exception thrown on a worker thread must reach the caller.
+    Vector yBad = y0; yBad[n-1] = 2*y0[n-1];
+    bool threw = false;
+    try {parallelGrad.calcGradient(yBad, Differentiator::CentralDifference);}
+    catch (const std::exception&) {threw = true;}
+    SimTK_ASSERT_ALWAYS(threw && parallelGrad.getNumDifferentiationFailures()==1,
+        "Exception from a user function on a worker thread was lost.");
+
+    threw = false;
+    try {parallel.setNumberOfThreads(0);}
+    catch (const std::exception&) {threw = true;}
+    SimTK_ASSERT_ALWAYS(threw, "Zero threads should have been rejected.");
+
+    cout << "Parallel derivatives OK." << endl;
+}
+
 static Real mysin(Real x) {
     return std::sin(x);
 }
@@ -284,6 +394,8 @@ int main() {
     cout << std::setprecision(16);
     cout << "1 err=" << (yp2-(yp+dfdy*2*delta_y)).norm() << endl;
     cout << "2 err=" << (yp2-(yp+dfdy2*2*delta_y)).norm() << endl;
+
+    testParallelDerivatives();
   }
   catch (const std::exception& e) {
     std::cout << e.what() << std::endl;
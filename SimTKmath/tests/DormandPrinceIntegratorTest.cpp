@@ -0,0 +1,108 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "IntegratorTestFramework.h"
+#include "simmath/DormandPrinceIntegrator.h"
+
+// Sample the continuous extension at many times within each step and compare
+// against a much more accurate solution evaluated at the same times.
+void testContinuousExtension() {
+    PendulumSystem sys;
+    sys.realizeTopology();
+    const Real qi[] = {1,0}; // (x,y)=(1,0)
+    const Real ui[] = {0,0}; // v=0
+    sys.setDefaultMass(10);
+    sys.setDefaultTimeAndState(0, Vector(2, qi), Vector(2, ui));
+
+    const int numSamples = 201;
+    const Real dt = 0.01;
+    Matrix yRef(4, numSamples);
+    DormandPrinceIntegrator ref(sys);
+    ref.setAccuracy(1e-12);
+    ref.setConstraintTolerance(1e-12);
+    ref.initialize(sys.getDefaultState());
+    for (int j=0; j < numSamples; ++j) {
+        ref.stepTo(j*dt);
+        yRef(j) = ref.getState().getY();
+    }
+
+    const Real accuracy = 1e-6;
+    DormandPrinceIntegrator integ(sys);
+    integ.setAccuracy(accuracy);
+    integ.setConstraintTolerance(1e-10);
+    integ.setReturnEveryInternalStep(true);
+    integ.initialize(sys.getDefaultState());
+    Vector y;
+    Real maxErr = 0;
+    int j = 0;
+    while (j < numSamples) {
+        while (j < numSamples && j*dt <= integ.getAdvancedTime()) {
+            ASSERT(integ.getInterpolationStartTime() <= j*dt);
+            integ.calcInterpolatedY(j*dt, y);
+            maxErr = std::max(maxErr, (y - yRef(j)).normInf());
+            ++j;
+        }
+        if (j < numSamples)
+            integ.stepTo((numSamples-1)*dt);
+    }
+    // There must have been far fewer steps than samples for this to have
+    // tested interpolation.
+    ASSERT(integ.getNumStepsTaken() < numSamples/4);
+    ASSERT(maxErr < 100*accuracy);
+}
+
+int main () {
+  try {
+    PendulumSystem sys;
+    sys.addEventHandler(new ZeroVelocityHandler(sys));
+    sys.addEventHandler(PeriodicHandler::handler = new PeriodicHandler());
+    sys.addEventHandler(new ZeroPositionHandler(sys));
+    sys.addEventReporter(PeriodicReporter::reporter = new PeriodicReporter(sys));
+    sys.addEventReporter(new OnceOnlyEventReporter());
+    sys.addEventReporter(new DiscontinuousReporter());
+    sys.realizeTopology();
+
+    // Test with various intervals for the event handler and event reporter, ones that are either
+    // large or small compared to the expected internal step size of the integrator.
+
+    for (int i = 0; i < 4; ++i) {
+        PeriodicHandler::handler->setEventInterval(i == 0 || i == 1 ? 0.01 : 2.0);
+        PeriodicReporter::reporter->setEventInterval(i == 0 || i == 2 ? 0.015 : 1.5);
+        
+        // Test the integrator in both normal and single step modes.
+        
+        DormandPrinceIntegrator integ(sys);
+        testIntegrator(integ, sys);
+        integ.setReturnEveryInternalStep(true);
+        testIntegrator(integ, sys);
+    }
+
+    testContinuousExtension();
+    cout << "Done" << endl;
+    return 0;
+  }
+  catch (std::exception& e) {
+    std::printf("FAILED: %s\n", e.what());
+    return 1;
+  }
+}
@@ -217,6 +217,34 @@ void resetHandlersAndReporters() {
     DiscontinuousReporter::eventCount = 0;
 }
 
+// The dense output y(t) must match the integrator's own states at the ends of
+// the most recent step, and evaluating it for several times at once must give
+// the same answers as one at a time.
+void checkInterpolatedY(const Integrator& integ, Real accuracy) {
+    const Real t0 = integ.getInterpolationStartTime();
+    const Real t1 = integ.getAdvancedTime();
+    ASSERT(t0 <= integ.getTime() && integ.getTime() <= t1);
+
+    Vector y;
+    integ.calcInterpolatedY(t1, y);
+    ASSERT((y - integ.getAdvancedState().getY()).normInf() == 0);
+    // The reported state may have been projected.
+    integ.calcInterpolatedY(integ.getTime(), y);
+    ASSERT((y - integ.getState().getY()).normInf() <= 10*accuracy);
+
+    Vector times(5);
+    for (int i=0; i < 5; ++i)
+        times[i] = t0 + i*(t1-t0)/4;
+    times[4] = t1;
+    Matrix Y;
+    integ.calcInterpolatedY(times, Y);
+    ASSERT(Y.nrow() == y.size() && Y.ncol() == 5);
+    for (int i=0; i < 5; ++i) {
+        integ.calcInterpolatedY(times[i], y);
+        ASSERT((Y(i) - y).normInf() == 0);
+    }
+}
+
 void testIntegrator (Integrator& integ, PendulumSystem& sys, Real accuracy=1e-4) {
     resetHandlersAndReporters();
 
@@ -244,6 +272,7 @@ void testIntegrator (Integrator& integ, PendulumSystem& sys, Real accuracy=1e-4)
     for (; time < 5.0; time += 1.0) {
         ts.stepTo(time);
         ASSERT(ts.getTime() == time);
+        checkInterpolatedY(integ, accuracy);
     }
     ASSERT(!OnceOnlyEventReporter::hasOccurred);
     ASSERT(!ZeroPositionHandler::hasAccelerated);
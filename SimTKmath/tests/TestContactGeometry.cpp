@@ -462,6 +462,82 @@ void testProjectDownhillToNearestPoint(const ContactGeometry& geom, Real r) {
 }
 
 
+// Shoot a geodesic over an implicit surface, optionally warm started from the
+// knot points of a previous geodesic, and return its knot points.
+std::vector<ContactGeometry::GeodesicKnotPoint> shootImplicitGeodesic(
+    const ContactGeometry& geom, const Vec3& point, const Vec3& tangent,
+    Real length, const std::vector<Real>& previousKnotArcLengths) {
+    std::vector<ContactGeometry::GeodesicKnotPoint> knots;
+    geom.shootGeodesicInDirectionImplicitly(point, tangent, length, 1e-3,
+        previousKnotArcLengths, 1e-9, 1e-9, 50,
+        [&](const ContactGeometry::GeodesicKnotPoint& q)
+        {   knots.push_back(q); });
+    return knots;
+}
+
+std::vector<Real> getKnotArcLengths(
+    const std::vector<ContactGeometry::GeodesicKnotPoint>& knots) {
+    std::vector<Real> arcLengths;
+    for (const ContactGeometry::GeodesicKnotPoint& q : knots)
+        arcLengths.push_back(q.arcLength);
+    return arcLengths;
+}
+
+void testWarmStartedGeodesic(const ContactGeometry& geom, const Vec3& point,
+                             const Vec3& tangent, Real length) {
+    const std::vector<ContactGeometry::GeodesicKnotPoint> cold =
+        shootImplicitGeodesic(geom, point, tangent, length, {});
+    ASSERT(cold.size() > 2);
+    ASSERT(cold.back().arcLength == length);
+
+    // Without previous knots, the warm started version is identical to the
+    // cold one.
+    std::vector<ContactGeometry::GeodesicKnotPoint> knots;
+    geom.shootGeodesicInDirectionImplicitly(point, tangent, length, 1e-3,
+        1e-9, 1e-9, 50,
+        [&](const ContactGeometry::GeodesicKnotPoint& q)
+        {   knots.push_back(q); });
+    ASSERT(knots.size() == cold.size());
+    ASSERT(knots.back().point == cold.back().point);
+
+    // Replaying the geodesic's own steps reproduces it.
+    const std::vector<Real> previousArcLengths = getKnotArcLengths(cold);
+    const std::vector<ContactGeometry::GeodesicKnotPoint> replay =
+        shootImplicitGeodesic(geom, point, tangent, length, previousArcLengths);
+    ASSERT(replay.size() == cold.size());
+    ASSERT(replay.back().arcLength == length);
+    for (std::size_t i = 0; i < cold.size(); ++i) {
+        ASSERT(std::abs(replay[i].arcLength - cold[i].arcLength)
+               < 1e-12 * length);
+        ASSERT((replay[i].point - cold[i].point).norm() < 1e-12);
+    }
+
+    // A slightly different geodesic is warm started from the previous one,
+    // and must be just as accurate as when shooting it from scratch.
+    const Rotation R(0.02, UnitVec3(geom.calcSurfaceUnitNormal(point)));
+    const Vec3 newTangent = R * tangent;
+    const Real newLength = 1.03 * length;
+    const std::vector<ContactGeometry::GeodesicKnotPoint> newCold =
+        shootImplicitGeodesic(geom, point, newTangent, newLength, {});
+    const std::vector<ContactGeometry::GeodesicKnotPoint> newWarm =
+        shootImplicitGeodesic(geom, point, newTangent, newLength,
+            previousArcLengths);
+    ASSERT(newWarm.back().arcLength == newLength);
+    ASSERT((newWarm.back().point - newCold.back().point).norm() < 1e-6);
+    ASSERT((newWarm.back().tangent - newCold.back().tangent).norm() < 1e-6);
+    ASSERT(std::abs(newWarm.back().jacobiRot - newCold.back().jacobiRot)
+           < 1e-6);
+    ASSERT(std::abs(newWarm.back().jacobiTrans - newCold.back().jacobiTrans)
+           < 1e-6);
+
+    // Warm starting from a zero-length geodesic is a cold start.
+    const std::vector<ContactGeometry::GeodesicKnotPoint> fromZero =
+        shootImplicitGeodesic(geom, point, newTangent, newLength, {0.});
+    ASSERT(fromZero.size() == newCold.size());
+    ASSERT(fromZero.back().point == newCold.back().point);
+}
+
+
 int main() {
     try {
         testHalfSpace();
@@ -476,6 +552,11 @@ int main() {
         testProjectDownhillToNearestPoint(ContactGeometry::Sphere(r), r);
         testProjectDownhillToNearestPoint(ContactGeometry::Ellipsoid(Vec3(1.5, 2.2, 3.1)), r);
 //        testProjectDownhillToNearestPoint(ContactGeometry::Torus(3*r, r), 3*r);
+
+        testWarmStartedGeodesic(ContactGeometry::Ellipsoid(Vec3(1.5, 2.2, 3.1)),
+                                Vec3(1.5, 0, 0), Vec3(0, 1, 1), 3.);
+        testWarmStartedGeodesic(ContactGeometry::Torus(2, 0.5),
+                                Vec3(2.5, 0, 0), Vec3(0, 1, 0.3), 4.);
     }
     catch(const std::exception& e) {
         cout << "exception: " << e.what() << endl;
@@ -416,6 +416,128 @@ void testMiscGeo() {
     SimTK_TEST((x1-x0).norm() < 3);
 }
 
+void testTriangle() {
+    const Geo::Triangle tri(Vec3(0,0,0), Vec3(2,0,0), Vec3(0,2,0));
+    Vec2 uv;
+
+    // Nearest points in the interior, past an edge, and past a vertex.
+    SimTK_TEST_EQ(tri.findNearestPoint(Vec3(.5,.5,3), uv), Vec3(.5,.5,0));
+    SimTK_TEST_EQ(tri.findPoint(uv), Vec3(.5,.5,0));
+    SimTK_TEST_EQ(tri.findNearestPoint(Vec3(2,2,-1), uv), Vec3(1,1,0));
+    SimTK_TEST_EQ(tri.findPoint(uv), Vec3(1,1,0));
+    SimTK_TEST_EQ(tri.findNearestPoint(Vec3(-1,-2,0), uv), Vec3(0,0,0));
+    SimTK_TEST_EQ(uv, Vec2(1,0));
+
+    Real distance;
+    SimTK_TEST(tri.intersectsRay(Vec3(.5,.25,2), UnitVec3(0,0,-1), 
+                                 distance, uv));
+    SimTK_TEST_EQ(distance, 2);
+    SimTK_TEST_EQ(tri.findPoint(uv), Vec3(.5,.25,0));
+    // Pointing away, missing, and in the plane.
+    SimTK_TEST(!tri.intersectsRay(Vec3(.5,.25,2), UnitVec3(0,0,1), 
+                                  distance, uv));
+    SimTK_TEST(!tri.intersectsRay(Vec3(2,2,2), UnitVec3(0,0,-1), 
+                                  distance, uv));
+    SimTK_TEST(!tri.intersectsRay(Vec3(-1,.5,0), UnitVec3(1,0,0), 
+                                  distance, uv));
+}
+
+// Compare each batched triangle test against the scalar one, using batch 
+// sizes that don't fill the vector lanes evenly.
+template <class P>
+void testTriangleBatch() {
+    typedef Vec<3,P> Vec3P;
+    Random::Uniform random(-1, 1);
+    random.setSeed(17);
+    const auto randomPoint = [&random](P scale) {
+        return Vec3P(P(scale*random.getValue()), P(scale*random.getValue()), 
+                     P(scale*random.getValue()));
+    };
+    const auto randomTriangle = [&randomPoint](const Vec3P& center) {
+        return Geo::Triangle_<P>(center+randomPoint(1), center+randomPoint(1),
+                                 center+randomPoint(1));
+    };
+
+    int nRayHits = 0;
+    for (int n : {0, 1, 3, 4, 7, 33}) {
+        Geo::TriangleBatch_<P> batch1, batch2;
+        for (int i=0; i < n; ++i) {
+            // Pairs near each other so that some of them overlap.
+            const Vec3P center = randomPoint(3);
+            batch1.addTriangle(randomTriangle(center));
+            batch2.addTriangle(randomTriangle(center));
+        }
+        SimTK_TEST(batch1.size() == n);
+
+        Array_<int> found;
+        batch1.findOverlappingPairs(batch2, found);
+        Array_<int> expected;
+        for (int i=0; i < n; ++i)
+            if (batch1.getTriangle(i).overlapsTriangle(batch2.getTriangle(i)))
+                expected.push_back(i);
+        SimTK_TEST(found == expected);
+        SimTK_TEST(n < 33 || !found.empty());
+
+        for (int trial=0; trial < 10; ++trial) {
+            const Vec3P point = randomPoint(4);
+            Array_<P> distanceSqr;
+            batch1.calcDistanceSqrToPoint(point, distanceSqr);
+            SimTK_TEST((int)distanceSqr.size() == n);
+            const P limit = 2;
+            found.clear(); expected.clear();
+            batch1.findTrianglesNearPoint(point, limit, found);
+            Vec<2,P> uv;
+            for (int i=0; i < n; ++i) {
+                const Vec3P nearest = 
+                    batch1.getTriangle(i).findNearestPoint(point, uv);
+                // Same arithmetic, so the answers must be identical.
+                SimTK_TEST(distanceSqr[i] == (nearest-point).normSqr());
+                if (distanceSqr[i] < limit)
+                    expected.push_back(i);
+            }
+            SimTK_TEST(found == expected);
+
+            const UnitVec<P,1> direction(-point);
+            P distance = -1, expectedDistance = NTraits<P>::getInfinity();
+            int which = -1, expectedWhich = -1;
+            Vec<2,P> expectedUV;
+            for (int i=0; i < n; ++i) {
+                P d; Vec<2,P> triUV;
+                if (batch1.getTriangle(i).intersectsRay(point, direction, 
+                                                        d, triUV)
+                    && d < expectedDistance)
+                {   expectedDistance = d; expectedWhich = i; 
+                    expectedUV = triUV; }
+            }
+            const bool hit = 
+                batch1.findRayIntersection(point, direction, distance, 
+                                           which, uv);
+            SimTK_TEST(hit == (expectedWhich >= 0));
+            if (hit) {
+                ++nRayHits;
+                SimTK_TEST(which == expectedWhich);
+                SimTK_TEST(distance == expectedDistance);
+                SimTK_TEST(uv == expectedUV);
+            }
+        }
+    }
+
+    SimTK_TEST(nRayHits > 0);
+
+    // Reuse after clear().
+    Geo::TriangleBatch_<P> batch;
+    batch.addTriangle(randomTriangle(Vec3P(0)));
+    batch.clear();
+    SimTK_TEST(batch.size() == 0);
+    const Geo::Triangle_<P> tri = randomTriangle(Vec3P(0));
+    batch.addTriangle(tri);
+    SimTK_TEST(batch.getTriangle(0)[2] == tri[2]);
+
+    Geo::TriangleBatch_<P> other;
+    Array_<int> found;
+    SimTK_TEST_MUST_THROW(batch.findOverlappingPairs(other, found));
+}
+
 int main() {
     SimTK_START_TEST("TestGeo");
         SimTK_SUBTEST(testMiscGeo);
@@ -424,5 +546,8 @@ int main() {
         SimTK_SUBTEST(testRandomPoints);
         SimTK_SUBTEST(testCollinearPoints);
         SimTK_SUBTEST(testCollocatedPoints);
+        SimTK_SUBTEST(testTriangle);
+        SimTK_SUBTEST(testTriangleBatch<double>);
+        SimTK_SUBTEST(testTriangleBatch<float>);
     SimTK_END_TEST();
 }
@@ -24,6 +24,12 @@
 #include "SimTKmath.h"
 #include <vector>
 #include <exception>
+#include <sstream>
+#include <cstdio>
+#include <fstream>
+#include <cstring>
+#include <iterator>
+#include <limits>
 
 using namespace SimTK;
 using namespace std;
@@ -201,6 +207,75 @@ void testOBBTree() {
         SimTK_TEST(faceReferenceCount[i] == 1);
 }
 
+// Count the nodes in the tree below and including the given node.
+int countOBBTreeNodes(ContactGeometry::TriangleMesh::OBBTreeNode node) {
+    if (node.isLeafNode())
+        return 1;
+    return 1 + countOBBTreeNodes(node.getFirstChildNode())
+             + countOBBTreeNodes(node.getSecondChildNode());
+}
+
+void testOBBTreeSplitRules() {
+    // Octahedra of very different sizes at random places, so that the two
+    // split rules will build different trees.
+    Random::Uniform random(0, 10);
+    random.setSeed(11);
+    vector<Vec3> vertices;
+    vector<int> faceIndices;
+    for (int i = 0; i < 40; i++) {
+        const int start = (int)vertices.size();
+        const Vec3 center(random.getValue(), random.getValue(), 
+                          random.getValue());
+        addOctohedron(vertices, faceIndices, Vec3(0));
+        const Real size = i%4 == 0 ? 2 : 0.1;
+        for (int j = start; j < (int)vertices.size(); j++)
+            vertices[j] = center + size*vertices[j];
+    }
+    ContactGeometry::TriangleMesh median(vertices, faceIndices);
+    SimTK_TEST(median.getOBBTreeSplitRule() 
+               == ContactGeometry::TriangleMesh::SplitAtMedian);
+
+    // Copies have their own tree, which must stay good after the original
+    // is gone.
+    ContactGeometry::TriangleMesh* original = 
+        new ContactGeometry::TriangleMesh(median);
+    ContactGeometry::TriangleMesh sah(*original);
+    delete original;
+    sah.rebuildOBBTree(ContactGeometry::TriangleMesh::SplitBySurfaceArea);
+    SimTK_TEST(sah.getOBBTreeSplitRule() 
+               == ContactGeometry::TriangleMesh::SplitBySurfaceArea);
+
+    for (const ContactGeometry::TriangleMesh* mesh : {&median, &sah}) {
+        vector<int> faceReferenceCount(mesh->getNumFaces(), 0);
+        validateOBBTree(*mesh, mesh->getOBBTreeNode(), mesh->getOBBTreeNode(),
+                        faceReferenceCount);
+        for (int i = 0; i < (int) faceReferenceCount.size(); i++)
+            SimTK_TEST(faceReferenceCount[i] == 1);
+        SimTK_TEST(countOBBTreeNodes(mesh->getOBBTreeNode()) 
+                   == mesh->getNumOBBTreeNodes());
+    }
+
+    // Queries must give the same answers whichever way the tree was built.
+    for (int i = 0; i < 100; i++) {
+        const Vec3 pos(random.getValue(), random.getValue(), 
+                       random.getValue());
+        bool inside1, inside2;
+        UnitVec3 normal1, normal2;
+        const Vec3 nearest1 = median.findNearestPoint(pos, inside1, normal1);
+        const Vec3 nearest2 = sah.findNearestPoint(pos, inside2, normal2);
+        SimTK_TEST_EQ((nearest1-pos).norm(), (nearest2-pos).norm());
+
+        const UnitVec3 dir(random.getValue()-5, random.getValue()-5, 
+                           random.getValue()-5);
+        Real distance1, distance2;
+        const bool hit1 = median.intersectsRay(pos, dir, distance1, normal1);
+        const bool hit2 = sah.intersectsRay(pos, dir, distance2, normal2);
+        SimTK_TEST(hit1 == hit2);
+        if (hit1 && hit2)
+            SimTK_TEST_EQ(distance1, distance2);
+    }
+}
+
 void testRayIntersection() {
     // Create an octrohedral mesh.
     
@@ -307,14 +382,213 @@ void testBoundingSphere() {
     }
 }
 
+// The cached per-face arrays must agree with the per-face accessors and with
+// the vertex positions they were calculated from.
+void testFaceData() {
+    const ContactGeometry::TriangleMesh 
+        mesh(PolygonalMesh::createSphereMesh(2, 3));
+    const int numFaces = mesh.getNumFaces();
+    const Array_<UnitVec3>& normals   = mesh.getFaceNormals();
+    const Array_<Real>&     areas     = mesh.getFaceAreas();
+    const Array_<Vec3>&     centroids = mesh.getFaceCentroids();
+    SimTK_TEST((int)normals.size() == numFaces);
+    SimTK_TEST((int)areas.size() == numFaces);
+    SimTK_TEST((int)centroids.size() == numFaces);
+    for (int i = 0; i < numFaces; i++) {
+        const Vec3& v0 = mesh.getVertexPosition(mesh.getFaceVertex(i, 0));
+        const Vec3& v1 = mesh.getVertexPosition(mesh.getFaceVertex(i, 1));
+        const Vec3& v2 = mesh.getVertexPosition(mesh.getFaceVertex(i, 2));
+        const Vec3 cross = (v1-v0) % (v2-v0);
+        SimTK_TEST(normals[i] == mesh.getFaceNormal(i));
+        SimTK_TEST(areas[i] == mesh.getFaceArea(i));
+        SimTK_TEST(centroids[i] == mesh.findCentroid(i));
+        SimTK_TEST_EQ(normals[i], cross/cross.norm());
+        SimTK_TEST_EQ(areas[i], cross.norm()/2);
+        SimTK_TEST_EQ(centroids[i], (v0+v1+v2)/3);
+        SimTK_TEST_EQ(centroids[i], mesh.findPoint(i, Vec2(1./3, 1./3)));
+        SimTK_TEST(dot(normals[i], centroids[i]) > 0); // points outward
+    }
+
+    // A copy has the same data.
+    const ContactGeometry::TriangleMesh copy(mesh);
+    SimTK_TEST(copy.getFaceCentroids() == centroids);
+
+    const ContactGeometry::TriangleMesh::MemoryUsage usage = 
+        mesh.calcMemoryUsage();
+    SimTK_TEST(usage.faceData >= 
+        numFaces*(sizeof(UnitVec3) + sizeof(Real) + sizeof(Vec3)));
+    SimTK_TEST(usage.vertices > 0 && usage.edges > 0 && usage.faces > 0);
+    SimTK_TEST(usage.obbTree >= mesh.getNumOBBTreeNodes()*sizeof(int));
+    SimTK_TEST(usage.getTotal() == usage.vertices + usage.edges + usage.faces
+                                   + usage.faceData + usage.obbTree);
+    std::ostringstream report;
+    report << usage;
+    SimTK_TEST(report.str().find("total") != std::string::npos);
+}
+
+// Make sure a mesh read from a cache file is the same as the one written,
+// and that createCached() builds the cache file once and then reuses it.
+void compareMeshes(const ContactGeometry::TriangleMesh& a,
+                   const ContactGeometry::TriangleMesh& b) {
+    SimTK_TEST(a.getNumVertices() == b.getNumVertices());
+    SimTK_TEST(a.getNumEdges() == b.getNumEdges());
+    SimTK_TEST(a.getNumFaces() == b.getNumFaces());
+    SimTK_TEST(a.getNumOBBTreeNodes() == b.getNumOBBTreeNodes());
+    SimTK_TEST(a.getOBBTreeSplitRule() == b.getOBBTreeSplitRule());
+    for (int i = 0; i < a.getNumVertices(); i++)
+        SimTK_TEST(a.getVertexPosition(i) == b.getVertexPosition(i));
+    for (int i = 0; i < a.getNumEdges(); i++)
+        for (int j = 0; j < 2; j++) {
+            SimTK_TEST(a.getEdgeVertex(i, j) == b.getEdgeVertex(i, j));
+            SimTK_TEST(a.getEdgeFace(i, j) == b.getEdgeFace(i, j));
+        }
+    for (int i = 0; i < a.getNumFaces(); i++)
+        for (int j = 0; j < 3; j++) {
+            SimTK_TEST(a.getFaceVertex(i, j) == b.getFaceVertex(i, j));
+            SimTK_TEST(a.getFaceEdge(i, j) == b.getFaceEdge(i, j));
+        }
+    SimTK_TEST(a.getFaceNormals() == b.getFaceNormals());
+    SimTK_TEST(a.getFaceAreas() == b.getFaceAreas());
+    SimTK_TEST(a.getFaceCentroids() == b.getFaceCentroids());
+    Vec3 centerA, centerB;
+    Real radiusA, radiusB;
+    a.getBoundingSphere(centerA, radiusA);
+    b.getBoundingSphere(centerB, radiusB);
+    SimTK_TEST(centerA == centerB && radiusA == radiusB);
+
+    // Queries go through the OBB tree so will find any difference there.
+    Random::Uniform random(-2, 2);
+    for (int i = 0; i < 100; i++) {
+        const Vec3 point(random.getValue(), random.getValue(), 
+                         random.getValue());
+        bool insideA, insideB;
+        int faceA, faceB;
+        Vec2 uvA, uvB;
+        SimTK_TEST(a.findNearestPoint(point, insideA, faceA, uvA)
+                   == b.findNearestPoint(point, insideB, faceB, uvB));
+        SimTK_TEST(insideA == insideB && faceA == faceB && uvA == uvB);
+        const UnitVec3 direction(-point);
+        Real distanceA = -1, distanceB = -1;
+        SimTK_TEST(a.intersectsRay(point, direction, distanceA, faceA, uvA)
+                   == b.intersectsRay(point, direction, distanceB, faceB, uvB));
+        SimTK_TEST(distanceA == distanceB);
+    }
+}
+
+// Write a copy of a cache file with the int at the given byte offset changed,
+// and make sure reading it is rejected.
+void testDamagedCacheFile(const String& pathname, std::size_t offset, 
+                          int value) {
+    std::string bytes;
+    {   std::ifstream in(pathname.c_str(), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), 
+                     std::istreambuf_iterator<char>()); }
+    SimTK_TEST(offset+sizeof(int) <= bytes.size());
+    std::memcpy(&bytes[offset], &value, sizeof(int));
+    {   std::ofstream out("damaged.simtkmeshcache", std::ios::binary);
+        out.write(bytes.data(), bytes.size()); }
+    SimTK_TEST_MUST_THROW(ContactGeometry::TriangleMesh::readCacheFile
+                                                ("damaged.simtkmeshcache"));
+}
+
+void testCacheFile() {
+    const PolygonalMesh sphere = PolygonalMesh::createSphereMesh(1.5, 3);
+    const ContactGeometry::TriangleMesh mesh(sphere, true);
+    mesh.writeCacheFile("sphere.simtkmeshcache");
+    const ContactGeometry::TriangleMesh loaded = 
+        ContactGeometry::TriangleMesh::readCacheFile("sphere.simtkmeshcache");
+    compareMeshes(mesh, loaded);
+    SimTK_TEST(loaded.isSmooth() == mesh.isSmooth());
+    SimTK_TEST(loaded.findNormalAtPoint(7, Vec2(.2, .3)) 
+               == mesh.findNormalAtPoint(7, Vec2(.2, .3)));
+
+    // The cache file name depends on the mesh and the settings.
+    using TriangleMesh = ContactGeometry::TriangleMesh;
+    const String name = TriangleMesh::getCacheFileName(sphere);
+    PolygonalMesh copy;
+    copy.copyAssign(sphere);
+    SimTK_TEST(name == TriangleMesh::getCacheFileName(copy));
+    SimTK_TEST(name != TriangleMesh::getCacheFileName(sphere, true));
+    SimTK_TEST(name != TriangleMesh::getCacheFileName(sphere, false, 
+                                           TriangleMesh::SplitBySurfaceArea));
+    copy.transformMesh(Transform(Vec3(0, 0, 1e-12)));
+    SimTK_TEST(name != TriangleMesh::getCacheFileName(copy));
+
+    const String areaName = TriangleMesh::getCacheFileName(sphere, false, 
+        TriangleMesh::SplitBySurfaceArea);
+    std::remove(name.c_str());
+    std::remove(areaName.c_str());
+    const TriangleMesh built = 
+        TriangleMesh::createCached(sphere, ".", false, 
+                                   TriangleMesh::SplitBySurfaceArea);
+    SimTK_TEST(Pathname::fileExists(areaName));
+    const TriangleMesh cached = 
+        TriangleMesh::createCached(sphere, ".", false, 
+                                   TriangleMesh::SplitBySurfaceArea);
+    SimTK_TEST(cached.getOBBTreeSplitRule() == 
+               TriangleMesh::SplitBySurfaceArea);
+    compareMeshes(built, cached);
+    compareMeshes(TriangleMesh(sphere), TriangleMesh::createCached(sphere, "."));
+
+    // A damaged cache file is replaced.
+    {   std::ofstream damaged(areaName.c_str(), std::ios::binary);
+        damaged << "not a cache file"; }
+    compareMeshes(built, TriangleMesh::createCached(sphere, ".", false, 
+                                            TriangleMesh::SplitBySurfaceArea));
+    compareMeshes(built, TriangleMesh::readCacheFile(areaName));
+    {   std::ofstream other("notacache.bin", std::ios::binary);
+        other << "not a cache file"; }
+    SimTK_TEST_MUST_THROW(TriangleMesh::readCacheFile("notacache.bin"));
+    SimTK_TEST_MUST_THROW(TriangleMesh::readCacheFile("nonexistent.bin"));
+
+    // Files whose indices point outside the mesh are rejected too. These
+    // offsets follow the layout described in ContactGeometry_TriangleMesh.cpp.
+    const int numFaces = mesh.getNumFaces();
+    const std::size_t splitRuleOffset = 32;
+    const std::size_t verticesOffset = 56 + 4*sizeof(Real);
+    const std::size_t edgesOffset = verticesOffset 
+        + mesh.getNumVertices()*(6*sizeof(Real)+sizeof(int));
+    const std::size_t facesOffset = 
+        edgesOffset + mesh.getNumEdges()*4*sizeof(int);
+    const std::size_t nodesOffset = 
+        facesOffset + numFaces*(6*sizeof(int)+7*sizeof(Real));
+    const std::size_t rootChildOffset = 
+        nodesOffset + sizeof(Transform) + 3*sizeof(Real);
+    testDamagedCacheFile("sphere.simtkmeshcache", splitRuleOffset, 2);
+    testDamagedCacheFile("sphere.simtkmeshcache", 
+        verticesOffset + 6*sizeof(Real), mesh.getNumEdges());
+    testDamagedCacheFile("sphere.simtkmeshcache", edgesOffset, -1);
+    testDamagedCacheFile("sphere.simtkmeshcache", 
+        edgesOffset + 3*sizeof(int), numFaces);
+    testDamagedCacheFile("sphere.simtkmeshcache", facesOffset, 
+                         mesh.getNumVertices());
+    testDamagedCacheFile("sphere.simtkmeshcache", 
+        facesOffset + 5*sizeof(int), mesh.getNumEdges());
+    testDamagedCacheFile("sphere.simtkmeshcache", rootChildOffset, 1);
+    testDamagedCacheFile("sphere.simtkmeshcache", rootChildOffset, 
+                         mesh.getNumOBBTreeNodes());
+    testDamagedCacheFile("sphere.simtkmeshcache", rootChildOffset + 8, 
+                         std::numeric_limits<int>::max()); // would overflow
+    const std::size_t trianglesOffset = nodesOffset 
+        + mesh.getNumOBBTreeNodes()*(sizeof(Transform)+3*sizeof(Real)
+                                     +3*sizeof(int));
+    testDamagedCacheFile("sphere.simtkmeshcache", trianglesOffset, numFaces);
+
+    // The undamaged file is still fine.
+    compareMeshes(mesh, TriangleMesh::readCacheFile("sphere.simtkmeshcache"));
+}
+
 int main() {
     SimTK_START_TEST("TestTriangleMesh");
         SimTK_SUBTEST(testTriangleMesh);
         SimTK_SUBTEST(testIncorrectMeshes);
         SimTK_SUBTEST(testOBBTree);
+        SimTK_SUBTEST(testOBBTreeSplitRules);
         SimTK_SUBTEST(testRayIntersection);
         SimTK_SUBTEST(testSmoothMesh);
         SimTK_SUBTEST(testFindNearestPoint);
         SimTK_SUBTEST(testBoundingSphere);
+        SimTK_SUBTEST(testFaceData);
+        SimTK_SUBTEST(testCacheFile);
     SimTK_END_TEST();
 }
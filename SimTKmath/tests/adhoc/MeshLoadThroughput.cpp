@@ -0,0 +1,139 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKmath.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+
+using namespace SimTK;
+
+/**
+ * This program measures how long it takes to get a mesh from a file into a 
+ * ContactGeometry::TriangleMesh, for each of the ways that can be done: 
+ * reading a Wavefront OBJ file, a binary STL file, or a binary mesh file and 
+ * then building the TriangleMesh, or reading a TriangleMesh cache file that
+ * already contains the built mesh and its OBB tree. Times are reported in 
+ * seconds per million triangles.
+ *
+ * Usage: MeshLoadThroughput
+ */
+
+static void writeObjFile(const PolygonalMesh& mesh, const char* pathname) {
+    std::ofstream ofs(pathname);
+    ofs.precision(17);
+    for (int v = 0; v < mesh.getNumVertices(); ++v) {
+        const Vec3& p = mesh.getVertexPosition(v);
+        ofs << "v " << p[0] << " " << p[1] << " " << p[2] << "\n";
+    }
+    for (int f = 0; f < mesh.getNumFaces(); ++f) {
+        ofs << "f";
+        for (int k = 0; k < mesh.getNumVerticesForFace(f); ++k)
+            ofs << " " << mesh.getFaceVertex(f, k)+1;
+        ofs << "\n";
+    }
+}
+
+// The sphere mesh is all triangles.
+static void writeBinaryStlFile(const PolygonalMesh& mesh, 
+                               const char* pathname) {
+    std::ofstream ofs(pathname, std::ios::binary);
+    const char header[80] = "MeshLoadThroughput";
+    ofs.write(header, 80);
+    const std::uint32_t nFaces = mesh.getNumFaces();
+    ofs.write((const char*)&nFaces, sizeof(nFaces));
+    for (int f = 0; f < mesh.getNumFaces(); ++f) {
+        Vec3 v[3];
+        for (int k = 0; k < 3; ++k)
+            v[k] = mesh.getVertexPosition(mesh.getFaceVertex(f, k));
+        const UnitVec3 n((v[1]-v[0]) % (v[2]-v[0]));
+        float record[12];
+        for (int i = 0; i < 3; ++i) {
+            record[i] = (float)n[i];
+            for (int k = 0; k < 3; ++k)
+                record[3*(k+1)+i] = (float)v[k][i];
+        }
+        const std::uint16_t attribute = 0;
+        ofs.write((const char*)record, sizeof(record));
+        ofs.write((const char*)&attribute, sizeof(attribute));
+    }
+}
+
+// Somewhere to put results so that they can't be optimized away.
+static volatile int sink;
+
+static void runMesh(int resolution) {
+    const PolygonalMesh sphere = 
+        PolygonalMesh::createSphereMesh(1, resolution);
+    writeObjFile(sphere, "MeshLoadThroughput.obj");
+    writeBinaryStlFile(sphere, "MeshLoadThroughput.stl");
+    sphere.writeBinaryMeshFile("MeshLoadThroughput.simtkmesh");
+    const double perMillion = 1e6/sphere.getNumFaces();
+
+    double start = realTime();
+    PolygonalMesh fromObj;
+    fromObj.loadObjFile("MeshLoadThroughput.obj");
+    const double objTime = realTime() - start;
+
+    start = realTime();
+    PolygonalMesh fromStl;
+    fromStl.loadStlFile("MeshLoadThroughput.stl");
+    const double stlTime = realTime() - start;
+
+    start = realTime();
+    PolygonalMesh fromBinary;
+    fromBinary.loadBinaryMeshFile("MeshLoadThroughput.simtkmesh");
+    const double binaryTime = realTime() - start;
+
+    start = realTime();
+    const ContactGeometry::TriangleMesh built(fromBinary);
+    const double buildTime = realTime() - start;
+
+    built.writeCacheFile("MeshLoadThroughput.simtkmeshcache");
+    start = realTime();
+    const ContactGeometry::TriangleMesh cached = ContactGeometry::TriangleMesh
+        ::readCacheFile("MeshLoadThroughput.simtkmeshcache");
+    const double cacheTime = realTime() - start;
+    sink = cached.getNumOBBTreeNodes() + fromObj.getNumVertices() 
+           + fromStl.getNumVertices();
+
+    std::printf("%8d | %8.3f %8.3f %8.3f | %8.3f | %8.3f\n", 
+                sphere.getNumFaces(), objTime*perMillion, stlTime*perMillion,
+                binaryTime*perMillion, buildTime*perMillion, 
+                cacheTime*perMillion);
+}
+
+int main() {
+    std::printf("seconds per million triangles\n");
+    std::printf("%8s | %8s %8s %8s | %8s | %8s\n", "faces", 
+                "obj", "stl", "binary", "build", "cache");
+    for (int resolution : {4, 5, 6})
+        runMesh(resolution);
+    for (const char* name : {"MeshLoadThroughput.obj", 
+                             "MeshLoadThroughput.stl",
+                             "MeshLoadThroughput.simtkmesh",
+                             "MeshLoadThroughput.simtkmeshcache"})
+        std::remove(name);
+    return 0;
+}
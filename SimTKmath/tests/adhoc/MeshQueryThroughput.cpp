@@ -0,0 +1,141 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKmath.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+/**
+ * This program measures how long it takes to build a TriangleMesh's OBB tree
+ * and how fast nearest point and ray queries run against it, for each of the
+ * available split rules. It uses finely tessellated spheres and a clutter
+ * of spheres whose triangles vary a lot in size, since that is where a surface
+ * area split should differ most from a median split.
+ *
+ * Usage: MeshQueryThroughput
+ */
+
+// A clutter of spheres of very different sizes and resolutions, so that
+// triangle size varies a lot across the mesh. The spheres are separate closed
+// surfaces, which TriangleMesh accepts.
+static PolygonalMesh createClutter(int nSpheres) {
+    Random::Uniform random(0, 1);
+    random.setSeed(3);
+    PolygonalMesh mesh;
+    for (int s = 0; s < nSpheres; ++s) {
+        const Vec3 center(10*random.getValue(), 10*random.getValue(),
+                          10*random.getValue());
+        const Real radius = s%10 == 0 ? 1 : 0.05;
+        const PolygonalMesh sphere =
+            PolygonalMesh::createSphereMesh(radius, s%10 == 0 ? 4 : 1);
+        const int start = mesh.getNumVertices();
+        for (int v = 0; v < sphere.getNumVertices(); ++v)
+            mesh.addVertex(center + sphere.getVertexPosition(v));
+        for (int f = 0; f < sphere.getNumFaces(); ++f) {
+            Array_<int> face;
+            for (int k = 0; k < sphere.getNumVerticesForFace(f); ++k)
+                face.push_back(start + sphere.getFaceVertex(f, k));
+            mesh.addFace(face);
+        }
+    }
+    return mesh;
+}
+
+// Somewhere to put query results so that they can't be optimized away.
+static volatile Real sink;
+
+// Time nQueries nearest point and ray queries at random points in the box
+// [lo,hi], reporting the average time per query in microseconds.
+static void timeQueries(const ContactGeometry::TriangleMesh& mesh,
+                        const Vec3& lo, const Vec3& hi, int nQueries,
+                        double& nearestUs, double& rayUs, int& nHits) {
+    Random::Uniform random(0, 1);
+    random.setSeed(5);
+    Array_<Vec3> points(nQueries);
+    Array_<UnitVec3> directions(nQueries);
+    for (int i = 0; i < nQueries; ++i) {
+        for (int k = 0; k < 3; ++k)
+            points[i][k] = lo[k] + (hi[k]-lo[k])*random.getValue();
+        directions[i] = UnitVec3(random.getValue()-0.5, random.getValue()-0.5,
+                                 random.getValue()-0.5);
+    }
+
+    bool inside;
+    UnitVec3 normal;
+    Real sum = 0;
+    double start = realTime();
+    for (int i = 0; i < nQueries; ++i)
+        sum += mesh.findNearestPoint(points[i], inside, normal)[0];
+    nearestUs = (realTime() - start)*1e6/nQueries;
+
+    Real distance;
+    nHits = 0;
+    start = realTime();
+    for (int i = 0; i < nQueries; ++i)
+        if (mesh.intersectsRay(points[i], directions[i], distance, normal)) {
+            sum += distance;
+            ++nHits;
+        }
+    rayUs = (realTime() - start)*1e6/nQueries;
+    sink = sum;
+}
+
+static void runMesh(const char* name, const PolygonalMesh& polyMesh,
+                    const Vec3& lo, const Vec3& hi) {
+    const ContactGeometry::TriangleMesh::OBBTreeSplitRule rules[] =
+    {   ContactGeometry::TriangleMesh::SplitAtMedian,
+        ContactGeometry::TriangleMesh::SplitBySurfaceArea };
+    const char* ruleNames[] = {"median", "area"};
+
+    ContactGeometry::TriangleMesh mesh(polyMesh);
+    for (int r = 0; r < 2; ++r) {
+        const double start = realTime();
+        mesh.rebuildOBBTree(rules[r]);
+        const double buildMs = (realTime() - start)*1e3;
+
+        double nearestUs, rayUs;
+        int nHits;
+        timeQueries(mesh, lo, hi, 20000, nearestUs, rayUs, nHits);
+        std::printf("%-8s %8d %-7s | %9.1fms %8d | %8.2fus %8.2fus %6d\n",
+                    name, mesh.getNumFaces(), ruleNames[r], buildMs,
+                    mesh.getNumOBBTreeNodes(), nearestUs, rayUs, nHits);
+    }
+}
+
+int main() {
+    std::printf("%-8s %8s %-7s | %11s %8s | %10s %10s %6s\n", "mesh",
+                "faces", "split", "build", "nodes", "nearest", "ray", "hits");
+
+    for (int resolution : {4, 6}) {
+        const PolygonalMesh sphere = PolygonalMesh::createSphereMesh(1,
+                                                                 resolution);
+        runMesh("sphere", sphere, Vec3(-1.5), Vec3(1.5));
+    }
+    for (int n : {100, 400}) {
+        const PolygonalMesh clutter = createClutter(n);
+        runMesh("clutter", clutter, Vec3(0), Vec3(10));
+    }
+    return 0;
+}
@@ -84,6 +84,8 @@ will include this one). **/
 #include "simbody/internal/Visualizer_Reporter.h"
 #include "simbody/internal/ConditionalConstraint.h"
 #include "simbody/internal/SemiExplicitEulerTimeStepper.h"
+#include "simbody/internal/DelassusOperator.h"
+#include "simbody/internal/MassMatrixFactorization.h"
 #include "simbody/internal/ImpulseSolver.h"
 #include "simbody/internal/PGSImpulseSolver.h"
 #include "simbody/internal/PLUSImpulseSolver.h"
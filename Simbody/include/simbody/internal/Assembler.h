@@ -518,6 +518,25 @@ since the analytic Jacobian is to be preferred. **/
 void setForceNumericalJacobian(bool yesno)
 {   forceNumericalJacobian = yesno; }
 
+/** Set the maximum number of threads used to calculate numerical gradients
+and Jacobians for assembly conditions that can't supply their own (or for
+all of them if setForceNumericalGradient() or setForceNumericalJacobian() is
+in effect). The perturbed evaluations are divided among the threads, each of
+which works on its own copy of the internal State, so the calcGoal() and
+calcErrors() methods of those assembly conditions must be safe to call 
+concurrently with different States. That is true of the built-in conditions.
+The default is 1, meaning that everything is done in the calling thread. 
+@see Differentiator::setNumberOfThreads() **/
+Assembler& setNumberOfThreads(int numThreads) {
+    SimTK_APIARGCHECK1_ALWAYS(numThreads >= 1, "Assembler", 
+        "setNumberOfThreads", "Illegal number of threads %d.", numThreads);
+    this->numThreads = numThreads;
+    return *this;
+}
+/** Return the maximum number of threads used to calculate numerical 
+derivatives. @see setNumberOfThreads() **/
+int getNumberOfThreads() const {return numThreads;}
+
 /** Use an RMS norm for the assembly errors rather than the default
 infinity norm (max absolute value). RMS is less stringent and defines
 success based on on a good "average" case rather than a good worst case.
@@ -634,6 +653,7 @@ Real    accuracy;               // 0 means use 1/OODefaultAccuracy
 Real    tolerance;              // 0 means use accuracy/10
 bool    forceNumericalGradient; // ignore analytic gradient methods
 bool    forceNumericalJacobian; // ignore analytic Jacobian methods
+int     numThreads;             // for numerical gradients and Jacobians
 bool    useRMSErrorNorm;        // what norm defines success?
 
 // Changes to any of these data members set isInitialized()=false.
@@ -432,6 +432,20 @@ public:
     multibody system over time, that is a different integrator. **/
     void setCurveSegmentAccuracy(Real accuracy);
 
+    /** Get whether geodesics over implicit surfaces are warm started.
+    See CableSpan::setWarmStartGeodesics. **/
+    bool getWarmStartGeodesics() const;
+
+    /** Set whether geodesics over obstacles without an analytic form are warm
+    started from the previously computed geodesic over the same obstacle. If
+    so, the integrator first tries the steps that were taken for the previous
+    geodesic, scaled to the new length, which saves many rejected steps when
+    the path changes little between solver iterations or time steps. The
+    accuracy of the geodesic is not affected. Disabled by default.
+    Note: This has no effect on obstacles with an analytic form, such as
+    spheres and cylinders. **/
+    void setWarmStartGeodesics(bool warmStart);
+
     /** Get the maximum number of solver iterations for finding the optimal
     path. **/
     int getSolverMaxIterations() const;
@@ -678,6 +692,25 @@ public:
     /** Get writeable access to a particular cable. **/
     CableSpan& updCable(CableSpanIndex ix);
 
+    /** Set the maximum number of threads used to solve the paths of this
+    subsystem's cables when realizing Stage::Position. The paths of different
+    cables are independent so they can be solved concurrently, one cable per
+    task. The default is 1, meaning that the paths are solved one after
+    another in the calling thread. The computed paths are the same for any
+    number of threads.
+
+    The paths are always solved serially if any cable wraps over a
+    ContactGeometry::SmoothHeightMap, which can't be used from several threads
+    at once, or if the State is being realized on a worker thread of some
+    other ParallelExecutor, as System::realizeBatch() does.
+    @param numThreads   The maximum number of threads to use; must be at
+                        least 1. **/
+    void setNumberOfThreads(int numThreads);
+
+    /** Get the maximum number of threads used to solve cable paths.
+    @see setNumberOfThreads() **/
+    int getNumberOfThreads() const;
+
     /** @cond **/ // Hide from Doxygen.
     SimTK_PIMPL_DOWNCAST(CableSubsystem, Subsystem);
 
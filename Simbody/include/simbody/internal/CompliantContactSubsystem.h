@@ -85,6 +85,25 @@ has not been set.
 @see getDissipatedEnergy(),setDissipatedEnergy(),setTrackDissipatedEnergy() **/
 bool getTrackDissipatedEnergy() const;
 
+/** Set the number of threads that a ContactForceGenerator may use to
+evaluate the elements of a single contact patch. Currently only the
+ElasticFoundation generator, used for contact involving a triangle mesh, makes
+use of them: it divides a patch's springs into fixed-size chunks and sums their
+forces chunk by chunk, so the contact forces are the same regardless of the
+number of threads. By default only one thread is used.
+
+@note The other surface in a mesh contact must then be safe to query from
+several threads at once. That is true of all the built-in ContactGeometry
+types except SmoothHeightMap, which is always processed on a single thread.
+@note This method should NOT be called while realizing the State. **/
+void setNumberOfThreads(unsigned numThreads);
+/** Return the number of threads used to evaluate a contact patch. This is 1
+unless setNumberOfThreads() has been called. **/
+int getNumberOfThreads() const;
+/** Return the ParallelExecutor that ContactForceGenerators should use to
+spread work over the threads requested with setNumberOfThreads(). **/
+ParallelExecutor& getParallelExecutor() const;
+
 /** Determine how many of the active Contacts are currently generating
 contact forces. You can call this at Velocity stage or later; the contact
 forces will be realized first if necessary before we report how many there 
@@ -245,6 +245,59 @@ const ContactTracker& getContactTracker(ContactGeometryTypeId surface1,
                                         bool& reverseOrder) const;
 /**@}**/
 
+/**@name                     Broad phase
+Control how the subsystem finds the pairs of contact surfaces that are close
+enough to be passed to a ContactTracker. **/
+/**@{**/
+
+/** The available broad phase algorithms. Both work on the bounding spheres
+("bubbles") of the contact surfaces and find exactly the same set of
+candidate pairs; they differ only in speed.
+  - SingleAxisSweep (the default) sorts the bubbles from scratch along the
+    single axis with the most variation every time and then sweeps along that
+    axis. It needs no memory between evaluations but is O(n log n) per
+    evaluation and degrades when many bubbles line up along the chosen axis.
+  - IncrementalSweepAndPrune keeps the bubbles' bounding box endpoints sorted
+    along all three axes, together with the set of overlapping boxes, in the
+    State. Each evaluation re-sorts with an insertion sort, which is nearly
+    linear when bodies move only a little between evaluations as in a
+    time-stepping simulation. **/
+enum BroadPhaseMethod {
+    SingleAxisSweep,
+    IncrementalSweepAndPrune
+};
+
+/** Choose the broad phase algorithm for this subsystem. This may be changed
+at any time; it affects only the speed of finding contacts, not the 
+results. **/
+void setBroadPhaseMethod(BroadPhaseMethod method);
+
+/** Return the broad phase algorithm currently in use. **/
+BroadPhaseMethod getBroadPhaseMethod() const;
+/**@}**/
+
+/**@name                     Parallel narrow phase
+The candidate pairs found by the broad phase are independent of one another,
+so their ContactTracker calls can be spread over several threads. **/
+/**@{**/
+
+/** Set the number of threads used to run the ContactTracker for the candidate
+surface pairs. Pairs are divided among the threads according to a rough
+estimate of their cost, so that a few expensive mesh-mesh pairs don't end up
+on the same thread. By default only one thread is used. The contacts found,
+and the ContactIds assigned to them, are the same regardless of the number
+of threads.
+
+@note Any ContactTracker you have registered must then be safe to call
+concurrently for different surface pairs.
+@note This method should NOT be called while realizing the State. **/
+void setNumberOfThreads(unsigned numThreads);
+
+/** Return the number of threads used for the narrow phase. This is 1 unless
+setNumberOfThreads() has been called. **/
+int getNumberOfThreads() const;
+/**@}**/
+
 /**@name                     Advanced/Obscure
 You probably don't want to call any of these methods. Some may be 
 unimplemented. **/
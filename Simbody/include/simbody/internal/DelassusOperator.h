@@ -0,0 +1,118 @@
+#ifndef SimTK_SIMBODY_DELASSUS_OPERATOR_H_
+#define SimTK_SIMBODY_DELASSUS_OPERATOR_H_
+
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simbody/internal/common.h"
+
+namespace SimTK {
+
+/** This is a block-sparse representation of the mXm constraint-space
+compliance ("Delassus") matrix A=G M\ ~G used by the ImpulseSolver classes.
+
+The mass matrix M is block diagonal with one block per multibody tree (that is,
+per base body and everything outboard of it), so A is a sum over the trees:
+<pre>
+    A = sum_t G_t M_t\ ~G_t
+</pre>
+Each term couples only the constraint equations that act on tree t, so it can
+be stored as a small dense block indexed by just those multipliers. Two
+multipliers are coupled only if they share a tree; for a heap of free bodies
+in contact the storage and the cost of a Gauss-Seidel sweep grow with the
+number of contacts per body rather than with the square of the total number
+of contacts.
+
+Use SimbodyMatterSubsystem::calcProjectedMInv(const State&, DelassusOperator&)
+to fill one of these in. Iterative solvers can then work directly from
+getDiagonal() and multiplyRow(); solvers that need factorizations can obtain
+the equivalent dense matrix with getAsDenseMatrix(). **/
+class SimTK_SIMBODY_EXPORT DelassusOperator {
+public:
+    /** Create an empty operator of dimension 0. **/
+    DelassusOperator() : m_size(0), m_denseIsValid(false) {}
+
+    /** Create an operator of dimension m that is all zero; use addBlock() to
+    give it content. **/
+    explicit DelassusOperator(int m) {clear(m);}
+
+    /** Discard all blocks and set the dimension to m. **/
+    void clear(int m);
+
+    /** Add a symmetric kXk block that couples the k multipliers given in
+    \a mults, so that A(mults[i],mults[j]) += block(i,j). The multipliers must
+    be distinct and less than size(). **/
+    void addBlock(const Array_<MultiplierIndex>& mults, const Matrix& block);
+
+    /** Return the dimension m of the square matrix A. **/
+    int size() const {return m_size;}
+
+    /** Return the number of dense blocks that make up A. **/
+    int getNumBlocks() const {return (int)m_blocks.size();}
+
+    /** Return the multipliers coupled by block \a b. **/
+    const Array_<MultiplierIndex>& getBlockMultipliers(int b) const
+    {   return m_blockMults[b]; }
+
+    /** Return the number of matrix entries actually stored for all the
+    blocks. Compare this with size()^2 for the dense matrix. **/
+    int getNumStoredEntries() const;
+
+    /** Return the diagonal element A(i,i). **/
+    Real getDiagonal(MultiplierIndex i) const {return m_diag[i];}
+
+    /** Return the inner product of row i of A with the m-vector \a x,
+    touching only the structurally nonzero entries of that row. **/
+    Real multiplyRow(MultiplierIndex i, const Vector& x) const;
+
+    /** Calculate Ax = A*x for an m-vector x. Ax is resized if necessary. **/
+    void multiply(const Vector& x, Vector& Ax) const;
+
+    /** Return A as a dense mXm matrix. This is assembled the first time it is
+    asked for after the operator changes, and then reused. **/
+    const Matrix& getAsDenseMatrix() const;
+
+private:
+    // Block b and the position of multiplier i within it.
+    struct RowEntry {
+        RowEntry() {}
+        RowEntry(int block, int local) : block(block), local(local) {}
+        int block, local;
+    };
+
+    int                              m_size;
+    Array_< Array_<MultiplierIndex> > m_blockMults;
+    // Each block is stored transposed so that a row of A restricted to the
+    // block is a contiguous column.
+    Array_<Matrix>                   m_blocks;
+    Array_< Array_<RowEntry> >       m_rowEntries; // m of these
+    Vector                           m_diag;       // m
+
+    mutable Matrix                   m_dense;
+    mutable bool                     m_denseIsValid;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMBODY_DELASSUS_OPERATOR_H_
@@ -125,6 +125,24 @@ public:
      * Set the transition velocity (vt) of the friction model.
      */
     void setTransitionVelocity(Real v);
+    /**
+     * Set the number of threads used to evaluate the springs of a single
+     * contact. The springs are divided into fixed-size chunks whose forces
+     * are summed separately and then combined in order, so the results are
+     * the same regardless of the number of threads. By default only one
+     * thread is used. When forces are already being calculated on several
+     * threads (see GeneralForceSubsystem::setNumberOfThreads()) each contact
+     * is processed on a single thread.
+     *
+     * The other object in each contact must be safe to query from several
+     * threads at once. That is true of all the built-in ContactGeometry types
+     * except SmoothHeightMap, which is always processed on a single thread.
+     */
+    void setNumberOfThreads(unsigned numThreads);
+    /**
+     * Get the number of threads used to evaluate the springs of a contact.
+     */
+    int getNumberOfThreads() const;
     SimTK_INSERT_DERIVED_HANDLE_DECLARATIONS(ElasticFoundationForce, ElasticFoundationForceImpl, Force);
 };
 
@@ -122,6 +122,31 @@ public:
      * may still invoke it to calculate forces based on contacts.
      */
     const Array_<Contact>& getContacts(const State& state, ContactSetIndex set) const;
+    /**
+     * Get the number of body pairs in a contact set whose extents overlapped along the sweep axis the
+     * last time contacts were calculated, so that their bounding spheres had to be tested.  The state
+     * must have been realized to at least Dynamics stage.
+     */
+    int getNumPairsTested(const State& state, ContactSetIndex set) const;
+    /**
+     * Get the number of body pairs in a contact set whose bounding spheres overlapped the last time
+     * contacts were calculated, so that they were passed on to full collision detection.  Comparing this
+     * to getNumPairsTested() shows how effective the broad phase is.  The state must have been realized
+     * to at least Dynamics stage.
+     */
+    int getNumPairsKept(const State& state, ContactSetIndex set) const;
+    /**
+     * Set whether the sort of bodies along the sweep axis should start from the order found the last
+     * time contacts were calculated for the same State.  Since bodies move very little between time
+     * steps, this reduces the sort to nearly linear time.  If the bodies have moved so much that this
+     * doesn't pay off, a full sort is done instead.  The contacts found are the same either way.  This is
+     * enabled by default.
+     */
+    void setUseWarmStart(bool warmStart);
+    /**
+     * Get whether the sweep sort is warm started from the previous order.
+     */
+    bool getUseWarmStart() const;
     SimTK_PIMPL_DOWNCAST(GeneralContactSubsystem, Subsystem);
 private:
     class GeneralContactSubsystemImpl& updImpl();
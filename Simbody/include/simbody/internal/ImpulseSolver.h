@@ -26,6 +26,7 @@
 
 #include "SimTKmath.h"
 #include "simbody/internal/common.h"
+#include "simbody/internal/DelassusOperator.h"
 
 namespace SimTK {
 
@@ -131,7 +132,8 @@ public:
                   int maxIters) 
     :   m_maxRollingTangVel(roll2slipTransitionSpeed),
         m_convergenceTol(convergenceTol),
-        m_maxIters(maxIters)
+        m_maxIters(maxIters),
+        m_useInitialGuess(false)
     {
         clearStats();
     }
@@ -156,6 +158,15 @@ public:
     }
     int getMaxIterations() const {return m_maxIters;}
 
+    /** If set, solve() takes the participating entries of \a pi on entry as
+    an initial guess for the unknown impulse rather than starting from zero.
+    The caller must then supply \a pi with length m; entries for
+    non-participating multipliers are ignored. This is useful for warm
+    starting from the impulses found on the previous time step. Solvers that 
+    can't make use of an initial guess ignore this setting. **/
+    void setUseInitialGuess(bool useGuess) {m_useInitialGuess = useGuess;}
+    bool getUseInitialGuess() const {return m_useInitialGuess;}
+
     // We'll keep stats separately for different "phases". The meaning of a
     // phase is up to the caller.
     static const int MaxNumPhases = 3;
@@ -167,12 +178,44 @@ public:
     }
 
     void clearStats(int phase) const {
-        SimTK_ERRCHK2(0<=phase&&phase<MaxNumPhases,
-            "ImpulseSolver::clearStats(phase)",
-            "Phase must be 0..%d but was %d\n", MaxNumPhases-1, phase);
+        checkPhase("clearStats", phase);
         m_nSolves[phase] = m_nIters[phase] = m_nFail[phase] = 0;
+        m_nWarmSolves[phase] = 0;
+        m_lastIters[phase] = 0; m_lastError[phase] = NaN;
     }
 
+    /** @name                     Statistics
+    Counts accumulated since construction or the last clearStats() call, for
+    the given phase. The meaning of an "iteration" depends on the concrete
+    solver. **/
+    /**@{**/
+    long long getNumSolves(int phase) const 
+    {   checkPhase("getNumSolves", phase); return m_nSolves[phase]; }
+    long long getNumIterations(int phase) const 
+    {   checkPhase("getNumIterations", phase); return m_nIters[phase]; }
+    long long getNumFailures(int phase) const 
+    {   checkPhase("getNumFailures", phase); return m_nFail[phase]; }
+    /** Number of solves that started from a caller-supplied initial guess;
+    see setUseInitialGuess(). **/
+    long long getNumWarmStartedSolves(int phase) const 
+    {   checkPhase("getNumWarmStartedSolves", phase); 
+        return m_nWarmSolves[phase]; }
+    /** Number of iterations taken by the most recent solve() for this phase.
+    This is zero if there was nothing to do, or if the solver doesn't track
+    iterations. **/
+    int getNumIterationsOfLastSolve(int phase) const 
+    {   checkPhase("getNumIterationsOfLastSolve", phase); 
+        return m_lastIters[phase]; }
+    /** The solver's estimate of the remaining error at the end of the most 
+    recent solve() for this phase, NaN if the solver doesn't provide one. **/
+    Real getErrorOfLastSolve(int phase) const 
+    {   checkPhase("getErrorOfLastSolve", phase); return m_lastError[phase]; }
+
+    long long getNumBilateralSolves() const {return m_nBilateralSolves;}
+    long long getNumBilateralIterations() const {return m_nBilateralIters;}
+    long long getNumBilateralFailures() const {return m_nBilateralFail;}
+    /**@}**/
+
     /** Solve. **/
     virtual bool solve
        (int                                 phase,
@@ -222,6 +265,47 @@ public:
         Vector&                             pi     // m, unknown result
         ) const = 0;
 
+    /** Same as the other solve() signature but with A supplied in the
+    block-sparse form produced by 
+    SimbodyMatterSubsystem::calcProjectedMInv(const State&,DelassusOperator&).
+    Iterative solvers can work from that directly without ever forming the
+    dense mXm matrix. The default implementation assembles the dense matrix
+    (once per operator) and calls the dense solve(). **/
+    virtual bool solve
+       (int                                 phase,
+        const Array_<MultiplierIndex>&      participating, // p<=m of these 
+        const DelassusOperator&             A,     // m X m, symmetric
+        const Vector&                       D,     // m, diag>=0 added to A
+        const Array_<MultiplierIndex>&      expanding, // nx<=m of these 
+        Vector&                             piExpand, // m
+        Vector&                             verrStart,   // m, RHS (in/out)
+        Vector&                             verrApplied, // m
+        Vector&                             pi,       // m, known+unknown
+        Array_<UncondRT>&                   unconditional,
+        Array_<UniContactRT>&               uniContact, // with friction
+        Array_<UniSpeedRT>&                 uniSpeed,
+        Array_<BoundedRT>&                  bounded,
+        Array_<ConstraintLtdFrictionRT>&    consLtdFriction,
+        Array_<StateLtdFrictionRT>&         stateLtdFriction
+        ) const 
+    {   return solve(phase, participating, A.getAsDenseMatrix(), D, 
+                     expanding, piExpand, verrStart, verrApplied, pi,
+                     unconditional, uniContact, uniSpeed, bounded,
+                     consLtdFriction, stateLtdFriction); }
+
+    /** Same as the other solveBilateral() signature but with A supplied in
+    block-sparse form. The default implementation assembles the dense matrix
+    and calls the dense solveBilateral(). **/
+    virtual bool solveBilateral
+       (const Array_<MultiplierIndex>&      participating, // p<=m of these 
+        const DelassusOperator&             A,     // m X m, symmetric
+        const Vector&                       D,     // m, diag>=0 added to A
+        const Vector&                       rhs,   // m, RHS
+        Vector&                             pi     // m, unknown result
+        ) const
+    {   return solveBilateral(participating, A.getAsDenseMatrix(), D, 
+                              rhs, pi); }
+
     // Printable names for the enum values for debugging.
     static const char* getContactTypeName(ContactType ct);
     static const char* getUniCondName(UniCond uc);
@@ -233,13 +317,24 @@ public:
                                 const Array_<UniContactRT>& uniContacts);
 
 protected:
+    static void checkPhase(const char* methodName, int phase) {
+        SimTK_ERRCHK3(0<=phase&&phase<MaxNumPhases,
+            "ImpulseSolver::checkPhase()",
+            "%s(): phase must be 0..%d but was %d\n", 
+            methodName, MaxNumPhases-1, phase);
+    }
+
     Real m_maxRollingTangVel; // Sliding above this speed if solver cares.
     Real m_convergenceTol;    // Meaning depends on concrete solver.
     int  m_maxIters;          // Meaning depends on concrete solver.
+    bool m_useInitialGuess;   // Start from incoming pi if solver can.
 
     mutable long long m_nSolves[MaxNumPhases];
     mutable long long m_nIters[MaxNumPhases];
     mutable long long m_nFail[MaxNumPhases];
+    mutable long long m_nWarmSolves[MaxNumPhases];
+    mutable int       m_lastIters[MaxNumPhases];
+    mutable Real      m_lastError[MaxNumPhases];
     mutable long long m_nBilateralSolves;
     mutable long long m_nBilateralIters;
     mutable long long m_nBilateralFail;
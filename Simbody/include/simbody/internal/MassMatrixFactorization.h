@@ -0,0 +1,127 @@
+#ifndef SimTK_SIMBODY_MASS_MATRIX_FACTORIZATION_H_
+#define SimTK_SIMBODY_MASS_MATRIX_FACTORIZATION_H_
+
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simbody/internal/common.h"
+
+namespace SimTK {
+
+/** This is a sparse representation of the nXn mobility-space mass matrix M of
+a multibody tree, together with its factorization M = ~L D L, where L is unit
+lower triangular and D is diagonal.
+
+Number the mobilities so that each one comes after its parent, where the
+parent of a mobility is the previous mobility of the same mobilizer, or else
+the last mobility of the nearest inboard mobilizer that has any. Then M(i,j)
+can be nonzero only if one of i and j is an ancestor of the other, and
+factoring M from the last mobility back to the first produces no fill-in:
+L has exactly the same pattern as the lower triangle of M. Simbody's mobility
+numbering has this property. For a branching tree of depth d this takes
+O(n d) storage and O(n d^2) time to factor, compared with O(n^2) and O(n^3)
+for the dense matrix; for a serial chain the two are the same.
+
+Use SimbodyMatterSubsystem::factorM() to fill one of these in from a State.
+The sparsity pattern (the "symbolic" part of the factorization) depends only
+on the topology, so if you reuse the same object at every step only the
+numerical values are recalculated. Then solve() and multiply() work with M
+and its inverse in O(n d) time.
+
+Row i of the matrix is stored as the entries M(i,i), M(i,p(i)), M(i,p(p(i))),
+..., that is, along the path from mobility i to its root, where p() is the
+parent. The factors are kept in a second array with the same layout, with D(i)
+in place of the diagonal entry. **/
+class SimTK_SIMBODY_EXPORT MassMatrixFactorization {
+public:
+    /** Create an empty factorization of dimension 0. **/
+    MassMatrixFactorization()
+    :   m_numStructureChanges(0), m_isFactored(false) {}
+
+    /** Set the sparsity pattern from the parent of each mobility, using -1
+    for mobilities that have no parent. Each parent must come before its child
+    (parent[i] < i). If the pattern is unchanged this does nothing, so the
+    symbolic analysis is done only once for a given topology. In either case
+    the numerical values must be filled in again with updRow(). **/
+    void setStructure(const Array_<int>& parent);
+
+    /** Return the dimension n of the square matrix M. **/
+    int size() const {return (int)m_parent.size();}
+
+    /** Return the parent mobility of mobility i, or -1 if it has none. **/
+    int getParent(int i) const {return m_parent[i];}
+
+    /** Return the number of entries of row i that are stored: one for each
+    mobility on the path from i to its root, including i itself. **/
+    int getRowLength(int i) const
+    {   return m_rowStart[i+1] - m_rowStart[i]; }
+
+    /** Return the number of entries stored for the lower triangle of M (and
+    for L). Compare this with n(n+1)/2 for the dense matrix. **/
+    int getNumStoredEntries() const {return (int)m_values.size();}
+
+    /** Return the number of times the sparsity pattern has actually been
+    analyzed by setStructure(), as opposed to found unchanged. **/
+    int getNumStructureChanges() const {return m_numStructureChanges;}
+
+    /** Get writable access to the getRowLength(i) stored entries of row i of
+    M, in the order described in the class documentation, to fill them in
+    before calling factor(). This discards the current factorization. **/
+    Real* updRow(int i) {m_isFactored = false; return &m_values[m_rowStart[i]];}
+
+    /** Factor the matrix whose rows were filled in with updRow(). The original
+    matrix entries are kept so that multiply() still has them. An exception is
+    thrown if M is found not to be positive definite. **/
+    void factor();
+
+    /** Return true if factor() has been called since the matrix entries were
+    last changed. **/
+    bool isFactored() const {return m_isFactored;}
+
+    /** Solve M x = b for x, where b is an n-vector. x is resized if necessary
+    and may be the same Vector as b. **/
+    void solve(const Vector& b, Vector& x) const;
+
+    /** Calculate Mx = M*x for an n-vector x, using the stored entries of M.
+    Mx is resized if necessary and must not be the same Vector as x. **/
+    void multiply(const Vector& x, Vector& Mx) const;
+
+    /** Return the diagonal element D(i) of the factorization. **/
+    Real getD(int i) const {return m_factor[m_rowStart[i]];}
+
+    /** Fill in \a M as the equivalent dense nXn matrix. **/
+    void getAsDenseMatrix(Matrix& M) const;
+
+private:
+    Array_<int>  m_parent;   // n of these
+    Array_<int>  m_rowStart; // n+1 of these
+    Array_<Real> m_values;   // lower triangle of M, row by row
+    Array_<Real> m_factor;   // D on the diagonal and L below, same layout
+    int          m_numStructureChanges;
+    bool         m_isFactored;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMBODY_MASS_MATRIX_FACTORIZATION_H_
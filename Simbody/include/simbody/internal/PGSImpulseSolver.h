@@ -50,6 +50,16 @@ When piUnknown_z[k] hits its upper limit of 0, we must have v_z[k] >= 0
 depends on all diag(A)[z[k]] > 0. That means that if v_z[k]<0 we could improve
 the solution by making piUnknown_z[k] negative, so it wouldn't have hit the
 limit.
+
+Each iteration is one Gauss-Seidel sweep over the participating rows, with
+successive over-relaxation (see setSOR()). If a sweep makes the error worse
+the relaxation factor is reduced for the rest of that solve. The iteration
+stops when the RMS error of the enforced equations is below the convergence
+tolerance, when the iteration limit is reached, or optionally when the error
+has stopped improving (see setMaxStalledIterations()). With
+setUseInitialGuess() the iteration starts from a caller-supplied impulse,
+typically the previous step's result, so a resting contact that hasn't 
+changed much converges in a few sweeps.
 **/
 
 class SimTK_SIMBODY_EXPORT PGSImpulseSolver : public ImpulseSolver {
@@ -58,7 +68,28 @@ public:
     :   ImpulseSolver(roll2slipTransitionSpeed,
                       1e-6, // default PGS convergence tolerance
                       100), // default PGS max number iterations
-        m_SOR(1.2) {}
+        m_SOR(1.2), m_maxStalledIters(0) {}
+
+    /** Set the successive over-relaxation factor used at the start of each
+    solve. Values between 1 and 2 over-relax and usually speed convergence; 
+    values below 1 under-relax. Must be in (0,2); default is 1.2. **/
+    void setSOR(Real sor) {
+        SimTK_APIARGCHECK1_ALWAYS(0 < sor && sor < 2, "PGSImpulseSolver", 
+            "setSOR", "Relaxation factor must be in (0,2) but was %g.", sor);
+        m_SOR = sor;
+    }
+    Real getSOR() const {return m_SOR;}
+
+    /** Give up early (reporting failure to converge) if the enforced error
+    has failed to shrink by at least 1% per sweep for this many consecutive
+    sweeps. Zero, the default, disables this check so that the iteration runs 
+    until it converges or reaches the iteration limit. **/
+    void setMaxStalledIterations(int n) {
+        SimTK_APIARGCHECK1_ALWAYS(n >= 0, "PGSImpulseSolver", 
+            "setMaxStalledIterations", "Illegal argument %d.", n);
+        m_maxStalledIters = n;
+    }
+    int getMaxStalledIterations() const {return m_maxStalledIters;}
 
     /** Solve with conditional constraints. In the common underdetermined
     case (redundant contact) we will return the first solution encountered but
@@ -94,8 +125,70 @@ public:
         Vector&                             pi     // m, unknown result
         ) const override;
 
+    /** Same as the dense solve() but working directly from the structurally
+    nonzero entries of the rows of A. Each Gauss-Seidel row update costs time
+    proportional to the number of multipliers coupled to that row rather than
+    to the number of participating multipliers. **/
+    bool solve
+       (int                                 phase,
+        const Array_<MultiplierIndex>&      participating,
+        const DelassusOperator&             A,
+        const Vector&                       D, 
+        const Array_<MultiplierIndex>&      expanding, // nx<=m of these 
+        Vector&                             piExpand,
+        Vector&                             verrStart, // in/out
+        Vector&                             verrApplied, // in/out
+        Vector&                             pi, 
+        Array_<UncondRT>&                   unconditional,
+        Array_<UniContactRT>&               uniContact,
+        Array_<UniSpeedRT>&                 uniSpeed,
+        Array_<BoundedRT>&                  bounded,
+        Array_<ConstraintLtdFrictionRT>&    consLtdFriction,
+        Array_<StateLtdFrictionRT>&         stateLtdFriction
+        ) const override;
+
+    /** Same as the dense solveBilateral() but working directly from the
+    rows of the block-sparse A. **/
+    bool solveBilateral
+       (const Array_<MultiplierIndex>&      participating, // p<=m of these 
+        const DelassusOperator&             A,     // m X m, symmetric
+        const Vector&                       D,     // m, diag>=0 added to A
+        const Vector&                       rhs,   // m, RHS
+        Vector&                             pi     // m, unknown result
+        ) const override;
+
 private:
+    // Both forms of A are handled by the same code; see PGSImpulseSolver.cpp.
+    template <class AccessA>
+    bool solveImpl
+       (int                                 phase,
+        const Array_<MultiplierIndex>&      participating,
+        const AccessA&                      A,
+        const Vector&                       D, 
+        const Array_<MultiplierIndex>&      expanding,
+        Vector&                             piExpand,
+        Vector&                             verrStart,
+        Vector&                             verrApplied,
+        Vector&                             pi, 
+        Array_<UncondRT>&                   unconditional,
+        Array_<UniContactRT>&               uniContact,
+        Array_<UniSpeedRT>&                 uniSpeed,
+        Array_<BoundedRT>&                  bounded,
+        Array_<ConstraintLtdFrictionRT>&    consLtdFriction,
+        Array_<StateLtdFrictionRT>&         stateLtdFriction
+        ) const;
+
+    template <class AccessA>
+    bool solveBilateralImpl
+       (const Array_<MultiplierIndex>&      participating,
+        const AccessA&                      A,
+        const Vector&                       D,
+        const Vector&                       rhs,
+        Vector&                             pi
+        ) const;
+
     Real m_SOR; 
+    int  m_maxStalledIters;
 };
 
 } // namespace SimTK
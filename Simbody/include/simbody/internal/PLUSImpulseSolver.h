@@ -41,6 +41,11 @@ public:
         m_cosMaxSlidingDirChange(std::cos(Pi/6)) // 30 degrees
     {}
 
+    // PLUS factors submatrices of A so it uses the base class's dense
+    // assembly when given a DelassusOperator.
+    using ImpulseSolver::solve;
+    using ImpulseSolver::solveBilateral;
+
     /** Solve with conditional constraints. **/
     bool solve
        (int                                 phase,
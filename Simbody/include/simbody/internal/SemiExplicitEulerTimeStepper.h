@@ -151,6 +151,16 @@ public:
     ImpulseSolverType getImpulseSolverType() const 
     {   return m_solverType; }
 
+    /** Start each step's contact impulse solve from the contact forces found
+    on the previous step, scaled by the new step size, rather than from zero.
+    Contacts are matched between steps by their UnilateralContactIndex; a
+    contact that wasn't proximal on the previous step starts from zero. This
+    lets an iterative solver like PGS resolve a resting stack in a few sweeps
+    rather than rebuilding the contact forces from scratch every step. Direct
+    solvers like PLUS ignore the initial guess. The default is \c true. **/
+    void setUseWarmStart(bool useWarmStart) {m_useWarmStart = useWarmStart;}
+    bool getUseWarmStart() const {return m_useWarmStart;}
+
     /** Set the impact capture velocity to be used by default when a contact
     does not provide its own. This is the impact velocity below which the
     coefficient of restitution is to be treated as zero. This avoids a Zeno's
@@ -387,6 +397,35 @@ private:
                                    Vector&      pverr, // in/out
                                    Vector&      positionImpulse);
 
+    // Invoke the impulse solver with whichever form of A=G M\ ~G was formed
+    // for this step: block-sparse for PGS, which needs only rows of A, or 
+    // dense for PLUS, which factors submatrices of it.
+    bool solveImpulses(int                                     phase,
+                       const Array_<MultiplierIndex>&          participating,
+                       const Array_<MultiplierIndex>&          expanding,
+                       Vector&                                 piExpand,
+                       Vector&                                 verrStart,
+                       Vector&                                 verrApplied,
+                       Vector&                                 pi,
+                       Array_<ImpulseSolver::UncondRT>&        unconditional,
+                       Array_<ImpulseSolver::UniContactRT>&    uniContact,
+                       Array_<ImpulseSolver::UniSpeedRT>&      uniSpeed,
+                       Array_<ImpulseSolver::BoundedRT>&       bounded,
+                       Array_<ImpulseSolver::ConstraintLtdFrictionRT>& 
+                                                               consLtdFriction,
+                       Array_<ImpulseSolver::StateLtdFrictionRT>&
+                                                            stateLtdFriction);
+    bool solveBilateralImpulses(const Array_<MultiplierIndex>& participating,
+                                const Vector&                  rhs,
+                                Vector&                        pi);
+
+    // Fill pi (length m) with h times the forces remembered from the last
+    // step for each proximal unilateral contact, zero elsewhere.
+    void calcWarmStartImpulse(Real h, int m, Vector& pi) const;
+    // Remember this step's contact forces (normal and friction), indexed by
+    // UnilateralContactIndex, for warm starting the next step.
+    void saveContactForces(const Vector& lambda);
+
 
 private:
     const MultibodySystem&      m_mbs;
@@ -397,6 +436,7 @@ private:
     int                         m_maxInducedImpactsPerStep;
     PositionProjectionMethod    m_projectionMethod;
     ImpulseSolverType           m_solverType;
+    bool                        m_useWarmStart;
 
 
     Real                        m_defaultCaptureVelocity;
@@ -408,10 +448,13 @@ private:
 
     // Persistent runtime data.
     State                       m_state;
+    // Last step's normal and friction forces for each unilateral contact.
+    Array_<Vec3,UnilateralContactIndex> m_prevContactForce;
     Vector                      m_emptyVector; // don't change this!
 
     // Step temporaries.
-    Matrix                      m_GMInvGt; // G M\ ~G
+    Matrix                      m_GMInvGt; // G M\ ~G (PLUS)
+    DelassusOperator            m_sparseGMInvGt; // G M\ ~G (PGS)
     Vector                      m_D; // soft diagonal
     Vector                      m_deltaU;
     Vector                      m_verr;
@@ -42,6 +42,8 @@ class Constraint;
 
 class UnilateralContact;
 class StateLimitedFriction;
+class DelassusOperator;
+class MassMatrixFactorization;
 
 /** This subsystem contains the bodies ("matter") in the multibody system,
 the mobilizers (joints) that define the generalized coordinates used to 
@@ -205,6 +207,85 @@ void setShowDefaultGeometry(bool show);
 geometry that can be used to visualize this multibody system. **/
 bool getShowDefaultGeometry() const;
 
+/** Set the number of threads the matter subsystem may use for its recursive
+tree sweeps. The base-to-tip kinematic sweeps visit the multibody tree one
+level at a time; every body at a given level depends only on its parent, so a
+sufficiently wide level can be divided among threads. The articulated body
+inertia and tree forward dynamics sweeps instead divide the tree into disjoint
+subtrees (see setParallelSubtreeSplitLevel()) that are processed concurrently
+before joining at their common trunk. By default only one thread is used,
+meaning all calculations are done serially in the calling thread. Results are
+identical to the serial computation regardless of the number of threads.
+
+@note Any Custom mobilizers in the system must then be safe to evaluate
+concurrently for different bodies.
+@note This method should NOT be called while realizing the State. It does
+not invalidate any stage; if the topology has already been realized the
+subtrees are just redistributed among the new number of threads.
+@see setMinNodesPerParallelLevel(), setMinNodesForParallelSubtrees() **/
+void setNumberOfThreads(unsigned numThreads);
+/** Return the number of threads the matter subsystem may use for its
+level-parallel kinematic sweeps. This is 1 unless setNumberOfThreads() has
+been called. **/
+int getNumberOfThreads() const;
+
+/** Set the smallest number of bodies a tree level must contain before its
+kinematics are divided among threads; narrower levels (chains, for example)
+are always processed serially because the threading overhead would exceed
+the work done. This has no effect unless setNumberOfThreads() was given a
+value greater than 1. The default is 32. **/
+void setMinNodesPerParallelLevel(int minNodes);
+/** Return the current minimum level width for parallel kinematic sweeps.
+@see setMinNodesPerParallelLevel() **/
+int getMinNodesPerParallelLevel() const;
+
+/** Choose the tree level at which the multibody tree is divided into subtrees
+for the subtree-parallel articulated body sweeps. Each mobilized body at this
+level roots a subtree that is assigned as a whole to one thread; the bodies
+closer to Ground form a trunk that is processed serially after (tip-to-base)
+or before (base-to-tip) the subtrees. The default, 1, splits the tree into the
+branches attached directly to Ground, which suits batches of free bodies or
+several mechanisms each mounted on Ground. A single free-floating robot has
+only one such branch; use 2 to split it at its limbs instead. 
+Subtree-parallel sweeps are used only when more than one thread is available,
+there are at least two subtrees, and together they contain at least
+getMinNodesForParallelSubtrees() bodies. Changing this invalidates the
+Topology stage. **/
+void setParallelSubtreeSplitLevel(int level);
+/** Return the tree level at which subtree-parallel sweeps divide the tree.
+@see setParallelSubtreeSplitLevel() **/
+int getParallelSubtreeSplitLevel() const;
+
+/** Set the smallest total number of bodies the subtrees below the split
+level (see setParallelSubtreeSplitLevel()) must contain before the
+articulated body sweeps process them concurrently. Smaller trees are swept
+serially because the threading overhead would exceed the work done. This has
+no effect unless setNumberOfThreads() was given a value greater than 1. The
+default is 32. **/
+void setMinNodesForParallelSubtrees(int minNodes);
+/** Return the current minimum subtree size for parallel articulated body
+sweeps. @see setMinNodesForParallelSubtrees() **/
+int getMinNodesForParallelSubtrees() const;
+
+/** Choose how constraint projection (System::projectQ() and
+System::projectU()) solves for each least-squares correction. By default the
+weighted constraint Jacobian is formed explicitly, one column at a time, and
+given a complete orthogonal factorization, which costs O(m^2 n) for m
+constraint equations and n mobilities and dominates the cost of integrating
+systems with many constraints. If you enable iterative projection, each
+correction is instead found by preconditioned conjugate gradients using only
+O(m+n) products with the Jacobian and its transpose, so the matrix is never
+formed. The Jacobi preconditioner this needs is calculated once and then reused
+at every step until the set of enabled constraints changes (that is, until
+Stage::Instance is invalidated). If the iteration fails to converge, for
+example because redundant constraints have inconsistent errors, that
+projection falls back to the factorization so the results meet the same
+accuracy requirements either way. The default is false. **/
+void setUseIterativeProjection(bool useIterative);
+/** Return true if constraint projection is set to use the iterative solver.
+@see setUseIterativeProjection() **/
+bool getUseIterativeProjection() const;
+
 /** The number of bodies includes all mobilized bodies \e including Ground,
 which is the first mobilized body, at MobilizedBodyIndex 0. (Note: if 
 special particle handling were implemented, the count here would \e not 
@@ -1359,6 +1440,21 @@ M^-1. Instead, call the method calcMInv() which can produce M^-1 directly.
 @see multiplyByM(), calcMInv() **/
 void calcM(const State&, Matrix& M) const;
 
+/** Calculate the mass matrix M in the tree-sparse form described in
+MassMatrixFactorization, and factor it. Only the entries of M that can be
+nonzero given the tree topology are calculated, with a composite rigid body
+pass that costs O(n d) for a tree of depth d rather than the O(n^2) of calcM().
+If \a MFac was used before with the same topology, its sparsity pattern is
+reused and only the numerical values are recalculated. Afterwards you can solve
+with M in O(n d) time using MFac.solve(). Unlike multiplyByMInv(), this works
+with the complete M including any prescribed mobilities.
+
+@par Required stage
+  \c Stage::Position
+
+@see calcM(), multiplyByMInv() **/
+void factorM(const State& state, MassMatrixFactorization& MFac) const;
+
 /** This operator explicitly calculates the inverse of the part of the system
 mobility-space mass matrix corresponding to free (non-prescribed)
 mobilities. The returned matrix is always n X n, but rows and columns 
@@ -1428,6 +1524,26 @@ it in O(m*n) time with O(n) intermediate storage, which is a \e lot better.
 void calcProjectedMInv(const State&   s,
                        Matrix&        GMInvGt) const;
 
+/** Calculate the same mXm matrix W=G M\ ~G as calcProjectedMInv(), but in the
+block-sparse form described in DelassusOperator. M is block diagonal with one
+block per tree of mobilized bodies hanging from Ground, so W is the sum of one
+small dense block per tree, coupling only the constraint equations that act on
+that tree. Only those blocks are stored, so a system of many free bodies in
+contact needs far less than the m^2 storage of the dense matrix.
+
+The blocks are computed with the same three operators used for the dense form,
+applied once for each constraint equation in each tree that it acts on, but 
+with each application confined to that tree's bodies and constraints. For many
+small trees the cost is then O(m) rather than O(m*n). The result is equal to
+the dense matrix to within roundoff error.
+
+@par Required stage
+  \c Stage::Velocity (articulated body inertias realized first if necessary)
+
+@see calcProjectedMInv(const State&, Matrix&) **/
+void calcProjectedMInv(const State&       s,
+                       DelassusOperator&  GMInvGt) const;
+
 /** Given a set of desired constraint-space speed changes, calculate the
 corresponding constraint-space impulses that would cause those changes. Here we 
 are solving the equation
@@ -28,6 +28,7 @@
 #include "simbody/internal/Assembler.h"
 #include "simbody/internal/AssemblyCondition.h"
 #include <map>
+#include <memory>
 #include <iostream>
 using std::cout; using std::endl;
 
@@ -244,24 +245,32 @@ public:
         // return fy = sum( w[i] * goal[i] ) for each of the goals that needs
         // a numerical gradient. Then we can calculate all of them at once.
         int f(const Vector& y, Real& fy) const override {
-            assembler.setInternalStateFromFreeQs(y);
+            const State& state = setStateFromFreeQs(assembler, ownState, y);
             fy = 0;
             for (unsigned i=0; i < numGoals.size(); ++i) {
                 AssemblyConditionIndex goalIx = numGoals[i];
                 const AssemblyCondition& cond = 
                     *assembler.conditions[goalIx];
                 Real goalValue;
-                const int stat = cond.calcGoal(assembler.getInternalState(), 
-                                               goalValue);
+                const int stat = cond.calcGoal(state, goalValue);
                 if (stat != 0)
                     return stat;
                 fy += assembler.weights[goalIx] * goalValue;
             }
             return 0;
         }
+
+        // A clone works on a copy of the internal state so that it can be
+        // evaluated concurrently with the original.
+        NumGradientFunc* clone() const override {
+            NumGradientFunc* copy = new NumGradientFunc(assembler, numGoals);
+            copy->ownState.reset(new State(assembler.getInternalState()));
+            return copy;
+        }
     private:
         Assembler&                              assembler;
         const Array_<AssemblyConditionIndex>&   numGoals;
+        std::unique_ptr<State>                  ownState; // clones only
     };
 
     int gradientFunc(const Vector&     parameters, 
@@ -314,8 +323,14 @@ public:
             // solution, otherwise IpOpt won't converge.
             Differentiator gradNumGoals
                (numGoals,Differentiator::CentralDifference);
+            gradNumGoals.setNumberOfThreads(assembler.numThreads);
             // weights are already included here
-            gradient += gradNumGoals.calcGradient(getFreeQsFromInternalState());
+            const Vector freeQs = getFreeQsFromInternalState();
+            gradient += gradNumGoals.calcGradient(freeQs);
+            // The perturbations left the internal state somewhere else, but
+            // the optimizer may ask for the objective here without saying
+            // the parameters are new.
+            setInternalStateFromFreeQs(freeQs);
 
             nEvalObjective += gradNumGoals.getNumCallsToUserFunction();
         }
@@ -371,14 +386,14 @@ public:
             assert(y.size() == assembler.getNumFreeQs());
             assert(fy.size() == totalNEqns);
 
-            assembler.setInternalStateFromFreeQs(y);
+            const State& state = setStateFromFreeQs(assembler, ownState, y);
             int nxtSlot = 0;
             for (unsigned i=0; i < numCons.size(); ++i) {
                 AssemblyConditionIndex consIx = numCons[i];
                 const AssemblyCondition& cond = 
                     *assembler.conditions[consIx];
                 const int stat = cond.calcErrors
-                   (assembler.getInternalState(), fy(nxtSlot, nEqns[i]));
+                   (state, fy(nxtSlot, nEqns[i]));
                 if (stat != 0)
                     return stat;
                 nxtSlot += nEqns[i];
@@ -387,11 +402,20 @@ public:
             assert(nxtSlot == totalNEqns); // must use all slots
             return 0;
         }
+
+        // See NumGradientFunc::clone().
+        NumJacobianFunc* clone() const override {
+            NumJacobianFunc* copy = 
+                new NumJacobianFunc(assembler, numCons, nEqns, totalNEqns);
+            copy->ownState.reset(new State(assembler.getInternalState()));
+            return copy;
+        }
     private:
         Assembler&                              assembler;
         const Array_<AssemblyConditionIndex>&   numCons;
         const Array_<int>&                      nEqns;
         const int                               totalNEqns;
+        std::unique_ptr<State>                  ownState; // clones only
     };
 
     int constraintJacobian(const Vector&    parameters, 
@@ -445,7 +469,10 @@ public:
             // gradient because we converge on the solution value 
             // rather than the derivative norm.
             Differentiator jacNumCons(numCons);
-            Matrix numJ = jacNumCons.calcJacobian(getFreeQsFromInternalState());
+            jacNumCons.setNumberOfThreads(assembler.numThreads);
+            const Vector freeQs = getFreeQsFromInternalState();
+            Matrix numJ = jacNumCons.calcJacobian(freeQs);
+            setInternalStateFromFreeQs(freeQs); // see gradientFunc()
             nEvalConstraints += jacNumCons.getNumCallsToUserFunction();
 
             // Fill in the missing rows.
@@ -470,6 +497,22 @@ public:
         nEvalObjective=nEvalConstraints=nEvalGradient=nEvalJacobian=0;
     }
 private:
+    // Set the free q's in the given state, or in the internal state if there
+    // isn't one, and realize it through Position stage.
+    static const State& setStateFromFreeQs(Assembler& assembler,
+                                           const std::unique_ptr<State>& state,
+                                           const Vector& freeQs) {
+        if (!state) {
+            assembler.setInternalStateFromFreeQs(freeQs);
+            return assembler.getInternalState();
+        }
+        Vector& q = state->updQ();
+        for (FreeQIndex fx(0); fx < assembler.getNumFreeQs(); ++fx)
+            q[assembler.getQIndexOfFreeQ(fx)] = freeQs[fx];
+        assembler.getMultibodySystem().realize(*state, Stage::Position);
+        return *state;
+    }
+
     const MultibodySystem& getSystem() const 
     {   return assembler.getMultibodySystem(); }
     const State& getInternalState() const 
@@ -500,6 +543,7 @@ private:
 Assembler::Assembler(const MultibodySystem& system)
 :   system(system), accuracy(0), tolerance(0), // i.e., 1e-3, 1e-4
     forceNumericalGradient(false), forceNumericalJacobian(false), 
+    numThreads(1),
     useRMSErrorNorm(false), alreadyInitialized(false), 
     asmSys(0), optimizer(0), nAssemblySteps(0), nInitializations(0)
 {
@@ -23,8 +23,14 @@
 #include "simbody/internal/MultibodySystem.h"
 #include "simbody/internal/SimbodyMatterSubsystem.h"
 
+#include "SimTKcommon/internal/ClonePtr.h"
+#include "SimTKcommon/internal/ParallelExecutor.h"
 #include "SimTKcommon/internal/State.h"
 
+#include <exception>
+#include <mutex>
+#include <vector>
+
 using namespace SimTK;
 
 // Define a unique index for cable segments.
@@ -51,6 +57,15 @@ namespace
 There are four: see NaturalGeodesicCorrections below. */
 constexpr int c_GeodesicDOF = 4;
 
+//------------------------------------------------------------------------------
+//  Fixed Size Problems
+//------------------------------------------------------------------------------
+/* The largest number of obstacles in contact with a cable segment for which
+the path corrections are computed using matrices of compile-time dimensions.
+Most cables touch only a few obstacles at once. See
+calcPathCorrectionFixedSize below. */
+constexpr int c_MaxFixedSizeObstacles = 4;
+
 //------------------------------------------------------------------------------
 //  Natural Geodesic Corrections
 //------------------------------------------------------------------------------
@@ -459,6 +474,9 @@ struct IntegratorTolerances {
     Real constraintProjectionTolerance = 1e-9;
     // TODO this is not connected to anything yet.
     int constraintProjectionMaxIterations = 50;
+    // Whether to replay the integrator steps of the previously computed
+    // geodesic when shooting a new one.
+    bool warmStartGeodesics = false;
 };
 
 //------------------------------------------------------------------------------
@@ -585,6 +603,31 @@ public:
         return MultibodySystem::downcast(getSystem());
     }
 
+    void setNumberOfThreads(int numThreads)
+    {
+        SimTK_APIARGCHECK1_ALWAYS(
+            numThreads > 0,
+            "CableSubsystem",
+            "setNumberOfThreads",
+            "Illegal number of threads %d.",
+            numThreads);
+        if (numThreads != m_numThreads) {
+            m_numThreads = numThreads;
+            // Realization is const and may run for different States at
+            // once, so the executor must not be created there.
+            if (numThreads > 1) {
+                m_executor.reset(new ParallelExecutor(numThreads));
+            } else {
+                m_executor.reset();
+            }
+        }
+    }
+
+    int getNumberOfThreads() const
+    {
+        return m_numThreads;
+    }
+
     SimTK_DOWNCAST(Impl, Subsystem::Guts);
 
 private:
@@ -626,6 +669,17 @@ private:
     // All cables in this subsystem.
     Array_<CableSpan, CableSpanIndex> cables;
 
+    // Maximum number of threads used for solving the cable paths.
+    int m_numThreads = 1;
+    // Used to solve the paths when m_numThreads > 1, and empty otherwise.
+    // ParallelExecutor::execute() is non-const; it can be called for
+    // different States at once.
+    mutable ClonePtr<ParallelExecutor> m_executor;
+
+    // Topology cache: false if any cable wraps an obstacle whose
+    // ContactGeometry can't be used from several threads at once.
+    bool m_canSolvePathsInParallel = true;
+
     //--------------------------------------------------------------------------
     friend CableSubsystemTestHelper;
 };
@@ -968,13 +1022,27 @@ public:
             // For implicit surfaces we must use a numerical integrator to
             // compute the initial and final frames. Because this is relatively
             // costly, we will cache this geodesic.
-            dataInst.geodesicKnotPoints.clear();
             const IntegratorTolerances& tols = getIntegratorTolerances();
+
+            // When warm starting, the knot points of the cached geodesic
+            // provide the step sizes to try first. The buffer is reused to
+            // avoid allocating on each shot.
+            static thread_local std::vector<Real> previousKnotArcLengths;
+            previousKnotArcLengths.clear();
+            if (tols.warmStartGeodesics) {
+                for (const ContactGeometry::GeodesicKnotPoint& q :
+                     dataInst.geodesicKnotPoints) {
+                    previousKnotArcLengths.push_back(q.arcLength);
+                }
+            }
+
+            dataInst.geodesicKnotPoints.clear();
             geometry.shootGeodesicInDirectionImplicitly(
                 point_S,
                 tangent_S,
                 length,
                 initIntegratorStepSize,
+                previousKnotArcLengths,
                 tols.geodesicIntegratorAccuracy,
                 tols.constraintProjectionTolerance,
                 tols.constraintProjectionMaxIterations,
@@ -2324,6 +2392,19 @@ private:
             getSubsystem().updCacheEntry(state, m_indexDataInst));
     }
 
+    // The MatrixWorkspaces used by the path solver. The cache entry holding
+    // them is shared by all cables of the subsystem, so when paths are being
+    // solved on the worker threads of a ParallelExecutor each of those
+    // threads uses a workspace of its own instead.
+    CableSpanData::Instance& updSolverWorkspace(const State& state) const
+    {
+        if (ParallelExecutor::isWorkerThread()) {
+            static thread_local CableSpanData::Instance workspace;
+            return workspace;
+        }
+        return updDataInst(state);
+    }
+
     // Mutable CableSpanData::Position cache access.
     CableSpanData::Position& updDataPos(const State& state) const
     {
@@ -2357,12 +2438,15 @@ private:
     /* Computes a single correction step for driving the path errors to zero.
     This correction can be computed using different algorithms. The resulting
     path corrections, and intermediate results are written to the
-    MatrixWorkspace data output. */
+    MatrixWorkspace data output. If useFixedSize is true, small problems are
+    solved without heap allocation (see calcPathCorrectionFixedSize); the
+    CableSubsystemTestHelper sets it to false to compare the two. */
     void calcSolverStep(
         const State& s,
         const CableSegment& cableSegment,
         CableSpanAlgorithm algorithm,
-        MatrixWorkspace& data) const;
+        MatrixWorkspace& data,
+        bool useFixedSize = true) const;
 
     const CableSpanData::Position& calcDataPos(const State& s) const;
 
@@ -2888,13 +2972,13 @@ Real calcPathErrorElement(
 stack them in a vector.
 
 If axes = {NormalAxis, BinormalAxis} this gives equation 14 in Scholz2015 */
-template <size_t N>
+template <size_t N, class VectorType>
 void calcPathErrorVector(
     const CableSegment& cableSegment,
     const State& s,
     const std::vector<LineSegment>& lines,
     std::array<CoordinateAxis, N> axes,
-    Vector& pathError)
+    VectorType& pathError)
 {
     // Reset path error vector to zero.
     pathError.setToZero();
@@ -2938,13 +3022,13 @@ namespace
 NaturalGeodesicCorrections of all CurveSegments.
 
 When axes = {Normal, Binormal}, this equals equation 53 in Scholz2015. */
-template <size_t N>
+template <size_t N, class MatrixType>
 void calcPathErrorJacobian(
     const CableSegment& cableSegment,
     const State& s,
     const std::vector<LineSegment>& lines,
     std::array<CoordinateAxis, N> axes,
-    Matrix& J)
+    MatrixType& J)
 {
     // Number of free coordinates for a generic geodesic.
     constexpr int NQ = c_GeodesicDOF;
@@ -3059,11 +3143,12 @@ where P, Q denotes the initial and final frenet frame, e denotes the direction
 of the straight line segment, and v denotes the variation of the Frenet frame
 position, and g_i is the block of the gradient related to that obstacle.
 Stacking of all blocks gives the total gradient. */
+template <class VectorType>
 void calcLengthGradient(
     const State& state,
     const CableSegment& cableSegment,
     const std::vector<LineSegment>& lines,
-    Vector& gradient)
+    VectorType& gradient)
 {
     // Reset path error vector to zero.
     gradient.setToZero();
@@ -3101,17 +3186,18 @@ NaturalGeodesicCorrections of all CurveSegments.
 
 This function can be derived taking the Jacobian of the gradient to the
 NaturalGeodesicCorrections of all curve segments. */
+template <class MatrixType>
 void calcLengthHessian(
     const State& state,
     const CableSegment& cableSegment,
     const std::vector<LineSegment>& lines,
-    Matrix& hessian)
+    MatrixType& hessian)
 {
     // Number of free coordinates for a generic geodesic.
     constexpr int NQ = c_GeodesicDOF;
 
     // Reset the values in the Jacobian.
-    Matrix& H = hessian;
+    MatrixType& H = hessian;
     H.setToZero();
 
     // Current indexes to write the elements of the Jacobian to,
@@ -3368,64 +3454,30 @@ Real calcCableSegmentLength(
 
 } // namespace
 
-//------------------------------------------------------------------------------
-//                      CableSpan::Impl Cache Computation
-//------------------------------------------------------------------------------
+//==============================================================================
+//                             Path Corrections
+//==============================================================================
+/* This section contains the computation of the path corrections from the path
+errors, see CableSpanAlgorithm's documentation for details.
+
+Cable segments with up to c_MaxFixedSizeObstacles obstacles in contact are
+handled using Mat and Vec types of compile-time dimensions together with the
+small factorizations below, so that no heap allocations are made. If any of
+these factorizations finds the problem too close to singular, the caller falls
+back to the dynamically sized matrices of the MatrixWorkspace, whose FactorQTZ
+handles rank deficiency. */
+namespace
+{
 
-void CableSpan::Impl::calcSolverStep(
+/* Computes the path corrections using the dynamically sized matrices and
+factorizations of the MatrixWorkspace. This handles any number of obstacles in
+contact with the cable, as well as rank deficient problems. */
+void calcPathCorrectionDynamicSize(
     const State& s,
     const CableSegment& cableSegment,
     CableSpanAlgorithm algorithm,
-    MatrixWorkspace& data) const
+    MatrixWorkspace& data)
 {
-    // SOLVER STEP 1: Compute the path errors. If the path errors are small the
-    // current path is the optimal path, and there is nothing to do. Otherwise
-    // we proceed with step 2: computing the corrections to reduce the path
-    // errors.
-
-    // The path errors are computed as the misalignment of the straight line
-    // segments with the curve segments.
-    // Start by computing the straight-line segments of this cable span.
-    calcLineSegments(
-        cableSegment,
-        s,
-        data.lineSegments);
-
-    data.maxPathError = 0.; // Reset the max path error field.
-    // Only compute the path errors if there are obstacles in contact with the
-    // cable.
-    if (data.numObstaclesInContact > 0) {
-        calcPathErrorVector<1>(
-            cableSegment,
-            s,
-            data.lineSegments,
-            {NormalAxis},
-            data.normalPathError);
-        calcPathErrorVector<1>(
-            cableSegment,
-            s,
-            data.lineSegments,
-            {BinormalAxis},
-            data.binormalPathError);
-        data.maxPathError = std::max(
-            data.normalPathError.normInf(),
-            data.binormalPathError.normInf());
-    }
-
-    // If the path error is small we have converged to the optimal solution,
-    // and there is no need to compute the geodesic corrections.
-    data.converged = data.maxPathError <= getParameters().smoothnessTolerance;
-    if (data.converged) {
-        return;
-    }
-
-    // SOLVER STEP 2: Compute the path correction step that reduces the path
-    // errors.
-    SimTK_ASSERT_ALWAYS(
-        data.numObstaclesInContact > 0,
-        "No obstacles in contact with the cable: unable to compute path corrections");
-    // The path corrections can be computed using different algorithms, see
-    // CableSpanAlgorithm's documentation for details.
     switch (algorithm) {
     // Compute the path corrections as outlined in Scholz2015.
     case CableSpanAlgorithm::Scholz2015: {
@@ -3556,6 +3608,420 @@ void CableSpan::Impl::calcSolverStep(
     default:
         SimTK_ASSERT(false, "Unknown CableSpanAlgorithm kind");
     }
+}
+
+/* Relative pivot tolerance below which the factorizations below consider a
+matrix too close to singular. This is a hundred times the default rank
+tolerance of FactorQTZ, to stay well clear of the problems for which FactorQTZ
+would reduce the rank. */
+template <int M, int N>
+Real calcFixedSizePivotTolerance()
+{
+    return 100. * std::max(M, N) * SignificantReal;
+}
+
+/* Solves A * x = b in the least squares sense, using a Householder QR
+factorization of A with column pivoting. Returns false, leaving x unchanged,
+if A is too close to rank deficient. */
+template <int M, int N>
+bool solveLeastSquares(Mat<M, N> A, Vec<M> b, Vec<N>& x)
+{
+    static_assert(M >= N, "Least squares problem must not be underdetermined");
+
+    // The column permutation, and the diagonal of the triangular factor R. The
+    // rest of R is stored in the upper triangle of A, and the Householder
+    // vectors in the lower part.
+    std::array<int, N> perm;
+    Vec<N> rDiag;
+    for (int j = 0; j < N; ++j) {
+        perm[j] = j;
+    }
+
+    for (int k = 0; k < N; ++k) {
+        // Move the remaining column with the largest norm to position k.
+        int pivot   = k;
+        Real maxNormSqr = -1.;
+        for (int j = k; j < N; ++j) {
+            Real normSqr = 0.;
+            for (int i = k; i < M; ++i) {
+                normSqr += square(A(i, j));
+            }
+            if (normSqr > maxNormSqr) {
+                maxNormSqr = normSqr;
+                pivot      = j;
+            }
+        }
+        if (pivot != k) {
+            for (int i = 0; i < M; ++i) {
+                std::swap(A(i, k), A(i, pivot));
+            }
+            std::swap(perm[k], perm[pivot]);
+        }
+
+        // Compute the Householder reflection that zeroes the column below
+        // the diagonal, giving diagonal element alpha.
+        Real alpha = std::sqrt(maxNormSqr);
+        if (!(alpha > calcFixedSizePivotTolerance<M, N>() *
+                          std::abs(k == 0 ? alpha : rDiag[0]))) {
+            return false;
+        }
+        if (A(k, k) > 0.) {
+            alpha = -alpha;
+        }
+        rDiag[k] = alpha;
+        A(k, k) -= alpha;
+        Real vNormSqr = 0.;
+        for (int i = k; i < M; ++i) {
+            vNormSqr += square(A(i, k));
+        }
+
+        // Apply the reflection to the remaining columns and to b.
+        for (int j = k + 1; j < N; ++j) {
+            Real vDotA = 0.;
+            for (int i = k; i < M; ++i) {
+                vDotA += A(i, k) * A(i, j);
+            }
+            const Real f = 2. * vDotA / vNormSqr;
+            for (int i = k; i < M; ++i) {
+                A(i, j) -= f * A(i, k);
+            }
+        }
+        Real vDotB = 0.;
+        for (int i = k; i < M; ++i) {
+            vDotB += A(i, k) * b[i];
+        }
+        const Real f = 2. * vDotB / vNormSqr;
+        for (int i = k; i < M; ++i) {
+            b[i] -= f * A(i, k);
+        }
+    }
+
+    // Back substitution: R * y = ~Q * b, and undo the column permutation.
+    Vec<N> y;
+    for (int k = N - 1; k >= 0; --k) {
+        Real sum = b[k];
+        for (int j = k + 1; j < N; ++j) {
+            sum -= A(k, j) * y[j];
+        }
+        y[k] = sum / rDiag[k];
+    }
+    for (int k = 0; k < N; ++k) {
+        x[perm[k]] = y[k];
+    }
+    return true;
+}
+
+/* Solves A * x = b for a symmetric positive definite matrix A, using a
+Cholesky factorization. Returns false, leaving x unchanged, if A is not
+sufficiently positive definite. */
+template <int N>
+bool solveCholesky(Mat<N, N> A, const Vec<N>& b, Vec<N>& x)
+{
+    Real maxDiag = 0.;
+    for (int i = 0; i < N; ++i) {
+        maxDiag = std::max(maxDiag, A(i, i));
+    }
+    const Real tolerance = calcFixedSizePivotTolerance<N, N>() * maxDiag;
+
+    // Compute the factor L, with A = L * ~L, in the lower triangle of A.
+    for (int j = 0; j < N; ++j) {
+        Real d = A(j, j);
+        for (int k = 0; k < j; ++k) {
+            d -= square(A(j, k));
+        }
+        if (!(d > tolerance)) {
+            return false;
+        }
+        A(j, j) = std::sqrt(d);
+        for (int i = j + 1; i < N; ++i) {
+            Real sum = A(i, j);
+            for (int k = 0; k < j; ++k) {
+                sum -= A(i, k) * A(j, k);
+            }
+            A(i, j) = sum / A(j, j);
+        }
+    }
+
+    // Solve L * y = b, followed by ~L * x = y.
+    Vec<N> y;
+    for (int i = 0; i < N; ++i) {
+        Real sum = b[i];
+        for (int k = 0; k < i; ++k) {
+            sum -= A(i, k) * y[k];
+        }
+        y[i] = sum / A(i, i);
+    }
+    for (int i = N - 1; i >= 0; --i) {
+        Real sum = y[i];
+        for (int k = i + 1; k < N; ++k) {
+            sum -= A(k, i) * x[k];
+        }
+        x[i] = sum / A(i, i);
+    }
+    return true;
+}
+
+/* Computes the eigenvalues lambda and eigenvectors W of the symmetric matrix
+S, such that S = W * diag(lambda) * ~W, using the cyclic Jacobi method (see
+Golub & Van Loan, Matrix Computations, section 8.5). */
+template <int N>
+void calcSymmetricEigenDecomposition(
+    Mat<N, N> S,
+    Vec<N>& lambda,
+    Mat<N, N>& W)
+{
+    // Generous upper bound: Convergence is quadratic and typically takes less
+    // than ten sweeps.
+    constexpr int c_MaxSweeps = 50;
+
+    W = Mat<N, N>(1.);
+    for (int sweep = 0; sweep < c_MaxSweeps; ++sweep) {
+        // Stop when the off-diagonal part is negligible.
+        Real offDiagSqr = 0.;
+        Real normSqr    = 0.;
+        for (int r = 0; r < N; ++r) {
+            normSqr += square(S(r, r));
+            for (int c = r + 1; c < N; ++c) {
+                offDiagSqr += square(S(r, c));
+            }
+        }
+        normSqr += 2. * offDiagSqr;
+        if (offDiagSqr <= square(Eps) * normSqr) {
+            break;
+        }
+
+        // Apply a rotation in each (p, q) plane that zeroes S(p, q).
+        for (int p = 0; p < N - 1; ++p) {
+            for (int q = p + 1; q < N; ++q) {
+                if (S(p, q) == 0.) {
+                    continue;
+                }
+                const Real tau = (S(q, q) - S(p, p)) / (2. * S(p, q));
+                const Real t   = (tau >= 0. ? 1. : -1.) /
+                               (std::abs(tau) + std::sqrt(1. + tau * tau));
+                const Real c   = 1. / std::sqrt(1. + t * t);
+                const Real sn  = t * c;
+                // S = ~J * S * J, and W = W * J, where J is the rotation.
+                for (int k = 0; k < N; ++k) {
+                    const Real skp = S(k, p);
+                    const Real skq = S(k, q);
+                    S(k, p)        = c * skp - sn * skq;
+                    S(k, q)        = sn * skp + c * skq;
+                }
+                for (int k = 0; k < N; ++k) {
+                    const Real spk = S(p, k);
+                    const Real sqk = S(q, k);
+                    S(p, k)        = c * spk - sn * sqk;
+                    S(q, k)        = sn * spk + c * sqk;
+                }
+                for (int k = 0; k < N; ++k) {
+                    const Real wkp = W(k, p);
+                    const Real wkq = W(k, q);
+                    W(k, p)        = c * wkp - sn * wkq;
+                    W(k, q)        = sn * wkp + c * wkq;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < N; ++i) {
+        lambda[i] = S(i, i);
+    }
+}
+
+/* Computes the path corrections of a cable segment with N obstacles in
+contact, using matrices of fixed dimensions. This mirrors
+calcPathCorrectionDynamicSize, see there for details. Returns false if the
+problem is too close to singular, in which case nothing was written to the
+MatrixWorkspace. */
+template <int N>
+bool calcPathCorrectionFixedSize(
+    const State& s,
+    const CableSegment& cableSegment,
+    CableSpanAlgorithm algorithm,
+    MatrixWorkspace& data)
+{
+    // Dimension of the free variable vector: all geodesic corrections.
+    constexpr int NQ = N * c_GeodesicDOF;
+
+    Vec<NQ> q;
+    switch (algorithm) {
+    case CableSpanAlgorithm::Scholz2015: {
+        // Four path error constraints, and one length constraint per curve
+        // segment.
+        constexpr int NC = N * 5;
+
+        Vec<NC> b;
+        Mat<NC, NQ> A;
+        calcPathErrorVector<2>(
+            cableSegment,
+            s,
+            data.lineSegments,
+            {NormalAxis, BinormalAxis},
+            b);
+        calcPathErrorJacobian<2>(
+            cableSegment,
+            s,
+            data.lineSegments,
+            {NormalAxis, BinormalAxis},
+            A);
+        for (int i = 0; i < N; ++i) {
+            A(N * 4 + i, c_GeodesicDOF * (i + 1) - 1) = data.maxPathError;
+        }
+
+        if (!solveLeastSquares(A, b, q)) {
+            return false;
+        }
+        q *= -1.;
+        break;
+    }
+    case CableSpanAlgorithm::MinimumLength: {
+        Vec<2 * N> e;
+        for (int i = 0; i < 2 * N; ++i) {
+            e[i] = data.normalPathError[i];
+        }
+        Mat<2 * N, NQ> J;
+        Vec<NQ> g;
+        Mat<NQ, NQ> H;
+        calcPathErrorJacobian<1>(cableSegment, s, data.lineSegments,
+            {NormalAxis}, J);
+        calcLengthGradient(s, cableSegment, data.lineSegments, g);
+        calcLengthHessian(s, cableSegment, data.lineSegments, H);
+
+        // The singular values of the symmetric (H + ~H) / 2 are the absolute
+        // values of its eigenvalues, and the singular vectors U are its
+        // eigenvectors up to sign. So Q^-1 = U * Σ^-1 * ~U can be computed
+        // from the eigen decomposition instead.
+        Vec<NQ> lambda;
+        Mat<NQ, NQ> W;
+        calcSymmetricEigenDecomposition<NQ>(0.5 * (H + ~H), lambda, W);
+        Mat<NQ, NQ> QInv;
+        for (int r = 0; r < NQ; ++r) {
+            for (int c = 0; c < NQ; ++c) {
+                Real elt = 0.;
+                for (int i = 0; i < NQ; ++i) {
+                    const Real weight = data.maxPathError;
+                    elt += W(r, i) * W(c, i) / (std::abs(lambda[i]) + weight);
+                }
+                QInv(r, c) = elt;
+            }
+        }
+
+        // Solve (J^T Q^-1 J) * λ = c - J Q^-1 g for the Lagrange multipliers,
+        // and compute the damped path corrections.
+        const Mat<2 * N, 2 * N> A = J * QInv * ~J;
+        const Vec<2 * N> b        = e - J * (QInv * g);
+        Vec<2 * N> multipliers;
+        if (!solveCholesky(A, b, multipliers)) {
+            return false;
+        }
+        q = QInv * (g + ~J * multipliers);
+        q *= -0.5;
+        break;
+    }
+    default:
+        return false;
+    }
+
+    for (int i = 0; i < NQ; ++i) {
+        data.pathCorrection[i] = q[i];
+    }
+    return true;
+}
+
+/* Computes the path corrections using fixed size matrices if there are at
+most c_MaxFixedSizeObstacles obstacles in contact. Returns false if the path
+corrections were not computed, and calcPathCorrectionDynamicSize should be
+used instead. */
+bool calcPathCorrectionFixedSize(
+    const State& s,
+    const CableSegment& cableSegment,
+    CableSpanAlgorithm algorithm,
+    MatrixWorkspace& data)
+{
+    static_assert(c_MaxFixedSizeObstacles == 4,
+        "Update the cases below to match c_MaxFixedSizeObstacles");
+    switch (data.numObstaclesInContact) {
+    case 1:
+        return calcPathCorrectionFixedSize<1>(s, cableSegment, algorithm, data);
+    case 2:
+        return calcPathCorrectionFixedSize<2>(s, cableSegment, algorithm, data);
+    case 3:
+        return calcPathCorrectionFixedSize<3>(s, cableSegment, algorithm, data);
+    case 4:
+        return calcPathCorrectionFixedSize<4>(s, cableSegment, algorithm, data);
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+//                      CableSpan::Impl Cache Computation
+//------------------------------------------------------------------------------
+
+void CableSpan::Impl::calcSolverStep(
+    const State& s,
+    const CableSegment& cableSegment,
+    CableSpanAlgorithm algorithm,
+    MatrixWorkspace& data,
+    bool useFixedSize) const
+{
+    // SOLVER STEP 1: Compute the path errors. If the path errors are small the
+    // current path is the optimal path, and there is nothing to do. Otherwise
+    // we proceed with step 2: computing the corrections to reduce the path
+    // errors.
+
+    // The path errors are computed as the misalignment of the straight line
+    // segments with the curve segments.
+    // Start by computing the straight-line segments of this cable span.
+    calcLineSegments(
+        cableSegment,
+        s,
+        data.lineSegments);
+
+    data.maxPathError = 0.; // Reset the max path error field.
+    // Only compute the path errors if there are obstacles in contact with the
+    // cable.
+    if (data.numObstaclesInContact > 0) {
+        calcPathErrorVector<1>(
+            cableSegment,
+            s,
+            data.lineSegments,
+            {NormalAxis},
+            data.normalPathError);
+        calcPathErrorVector<1>(
+            cableSegment,
+            s,
+            data.lineSegments,
+            {BinormalAxis},
+            data.binormalPathError);
+        data.maxPathError = std::max(
+            data.normalPathError.normInf(),
+            data.binormalPathError.normInf());
+    }
+
+    // If the path error is small we have converged to the optimal solution,
+    // and there is no need to compute the geodesic corrections.
+    data.converged = data.maxPathError <= getParameters().smoothnessTolerance;
+    if (data.converged) {
+        return;
+    }
+
+    // SOLVER STEP 2: Compute the path correction step that reduces the path
+    // errors.
+    SimTK_ASSERT_ALWAYS(
+        data.numObstaclesInContact > 0,
+        "No obstacles in contact with the cable: unable to compute path corrections");
+    // The path corrections can be computed using different algorithms, see
+    // CableSpanAlgorithm's documentation for details. Small problems are
+    // solved using matrices of fixed dimensions, unless they turn out to be
+    // too close to singular.
+    if (!useFixedSize ||
+        !calcPathCorrectionFixedSize(s, cableSegment, algorithm, data)) {
+        calcPathCorrectionDynamicSize(s, cableSegment, algorithm, data);
+    }
 
     // Compute the stepsize along the descending direction.
     const Real stepSize =
@@ -3641,7 +4107,7 @@ const CableSpanData::Position& CableSpan::Impl::calcDataPos(
             }
 
             // Grab the matrix workspace used by the solver.
-            MatrixWorkspace& workspace = updDataInst(s).updOrInsert(
+            MatrixWorkspace& workspace = updSolverWorkspace(s).updOrInsert(
                 countActive(s, cableSegment));
 
             // Compute the path corrections required to reach the optimal path.
@@ -4059,6 +4525,106 @@ void CableSubsystemTestHelper::Impl::runPerturbationTest(
     SimTK_ASSERT_ALWAYS(success, "Perturbation test failed");
 }
 
+// Test that the fixed size path correction computation agrees with the
+// dynamically sized one. The optimal path needs no correction, so the path is
+// first moved away from the optimum by applying a geodesic correction to each
+// curve segment that is in contact with its obstacle.
+void CableSubsystemTestHelper::Impl::runSolverTest(
+    const State& state,
+    const CableSubsystem& subsystem,
+    std::ostream& testReport) const
+{
+    // Result of this solver test.
+    bool success = true;
+
+    for (CableSpanIndex cableIx(0); cableIx < subsystem.getNumCables();
+         ++cableIx) {
+        testReport << "START Solver Test of Cable " << cableIx << "\n";
+        const CableSpan::Impl& cable = subsystem.getCable(cableIx).getImpl();
+
+        for (CableSegmentIndex ix(0); ix < cable.getNumCableSegments(); ++ix) {
+            testReport << "Testing CableSegment " << ix + 1 << " of "
+                       << cable.getNumCableSegments() << "\n";
+
+            const CableSegment& cableSegment = cable.getCableSegment(ix);
+            const int nActive = cable.countActive(state, cableSegment);
+            if (nActive == 0 || nActive > c_MaxFixedSizeObstacles) {
+                testReport << "CableSegment has " << nActive
+                           << " active segments: Skipping solver test\n";
+                continue;
+            }
+
+            // We do not want to mess with the actual state, so we make a copy.
+            const State sCopy = state;
+            cableSegment.getSubsystem().getMultibodySystem().realize(
+                sCopy, Stage::Position);
+            cableSegment.getCable().getDataPos(sCopy);
+
+            // Move the path away from the optimum.
+            const Real perturbation = m_solverTestParameters.perturbation;
+            for (ObstacleIndex ox : cableSegment.getObstacleIndexes()) {
+                const CurveSegment& curve = cable.getObstacleCurveSegment(ox);
+                if (curve.isInContactWithSurface(sCopy)) {
+                    curve.applyGeodesicCorrection(
+                        sCopy,
+                        {perturbation, -perturbation, perturbation, 0.});
+                }
+            }
+            for (ObstacleIndex ox : cableSegment.getObstacleIndexes()) {
+                cable.getObstacleCurveSegment(ox).invalidatePosEntry(sCopy);
+            }
+            for (ObstacleIndex ox : cableSegment.getObstacleIndexes()) {
+                cable.getObstacleCurveSegment(ox).calcDataPos(sCopy);
+            }
+            if (cable.countActive(sCopy, cableSegment) != nActive) {
+                testReport << "Wrapping status changed: Skipping solver test\n";
+                continue;
+            }
+
+            for (CableSpanAlgorithm algorithm :
+                 {CableSpanAlgorithm::Scholz2015,
+                  CableSpanAlgorithm::MinimumLength}) {
+                MatrixWorkspace fixedSize(nActive);
+                MatrixWorkspace dynamicSize(nActive);
+                cable.calcSolverStep(
+                    sCopy, cableSegment, algorithm, fixedSize, true);
+                cable.calcSolverStep(
+                    sCopy, cableSegment, algorithm, dynamicSize, false);
+                if (fixedSize.converged) {
+                    testReport << "Path is optimal: Skipping solver test\n";
+                    break;
+                }
+
+                const Real error =
+                    (fixedSize.pathCorrection - dynamicSize.pathCorrection)
+                        .normInf() /
+                    std::max(1., dynamicSize.pathCorrection.normInf());
+                const bool passedTest =
+                    error <= m_solverTestParameters.tolerance;
+                testReport << (passedTest ? "PASSED" : "FAILED")
+                           << " solver test for algorithm "
+                           << static_cast<int>(algorithm) << ":\n";
+                testReport << "    Fixed size   : "
+                           << fixedSize.pathCorrection << "\n";
+                testReport << "    Dynamic size : "
+                           << dynamicSize.pathCorrection << "\n";
+                testReport << "    Max diff     : " << error
+                           << " <= " << m_solverTestParameters.tolerance
+                           << " = eps\n";
+                success = success && passedTest;
+            }
+        }
+    }
+
+    // Flush all info to the report, in case we throw an exception.
+    if (success) {
+        testReport << "PASSED TEST: Solver test" << std::endl;
+    } else {
+        testReport << "FAILED TEST: Solver test" << std::endl;
+    }
+    SimTK_ASSERT_ALWAYS(success, "Solver test failed");
+}
+
 //==============================================================================
 //                      Resampling geodesic path points
 //==============================================================================
@@ -4296,6 +4862,18 @@ int CableSubsystem::Impl::realizeSubsystemTopologyImpl(State& state) const
         cable.updImpl().realizeTopology(state, indexDataInst);
     }
 
+    // A SmoothHeightMap keeps a mutable hint for finding the patch that
+    // contains a point, so it can't be shared between threads.
+    mutableThis->m_canSolvePathsInParallel = true;
+    for (const CableSpan& cable : cables) {
+        for (ObstacleIndex ix(0); ix < cable.getNumObstacles(); ++ix) {
+            if (ContactGeometry::SmoothHeightMap::isInstance(
+                    cable.getObstacleContactGeometry(ix))) {
+                mutableThis->m_canSolvePathsInParallel = false;
+            }
+        }
+    }
+
     return 0;
 }
 
@@ -4326,12 +4904,65 @@ int CableSubsystem::Impl::realizeSubsystemTimeImpl(const State& state) const
     return 0;
 }
 
+namespace {
+// Solve the path of one cable per index. Any exception is caught so that it
+// can't escape from a worker thread; the first one is kept for rethrowing once
+// all paths have been solved.
+class CablePathTask : public ParallelExecutor::Task {
+public:
+    CablePathTask(
+        const CableSubsystem::Impl& subsystem,
+        const State& state) :
+        m_subsystem(subsystem),
+        m_state(state)
+    {}
+
+    void execute(int index) override
+    {
+        try {
+            m_subsystem.getCableImpl(CableSpanIndex(index))
+                .realizePosition(m_state);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_errorMutex);
+            if (!m_firstError) {
+                m_firstError = std::current_exception();
+            }
+        }
+    }
+
+    void rethrowIfFailed() const
+    {
+        if (m_firstError) {
+            std::rethrow_exception(m_firstError);
+        }
+    }
+
+private:
+    const CableSubsystem::Impl& m_subsystem;
+    const State& m_state;
+    std::mutex m_errorMutex;
+    std::exception_ptr m_firstError;
+};
+} // namespace
+
 int CableSubsystem::Impl::realizeSubsystemPositionImpl(const State& state) const
 {
-    for (CableSpanIndex ix(0); ix < cables.size(); ++ix) {
-        getCable(ix).getImpl().realizePosition(state);
+    // The paths of different cables are independent, and each cable's data is
+    // kept in cache entries of its own, so the paths can be solved
+    // concurrently.
+    const int numCables = cables.size();
+    if (m_numThreads < 2 || numCables < 2 || !m_canSolvePathsInParallel ||
+        ParallelExecutor::isWorkerThread()) {
+        for (CableSpanIndex ix(0); ix < cables.size(); ++ix) {
+            getCable(ix).getImpl().realizePosition(state);
+        }
+        return 0;
     }
 
+    CablePathTask task(*this, state);
+    m_executor->execute(task, numCables);
+    task.rethrowIfFailed();
+
     return 0;
 }
 
@@ -4446,6 +5077,16 @@ CableSpan& CableSubsystem::updCable(CableSpanIndex ix)
     return updImpl().updCable(ix);
 }
 
+void CableSubsystem::setNumberOfThreads(int numThreads)
+{
+    updImpl().setNumberOfThreads(numThreads);
+}
+
+int CableSubsystem::getNumberOfThreads() const
+{
+    return getImpl().getNumberOfThreads();
+}
+
 bool CableSubsystem::isInstanceOf(const Subsystem& s)
 {
     return Impl::isA(s.getSubsystemGuts());
@@ -4716,6 +5357,16 @@ void CableSpan::setCurveSegmentAccuracy(Real accuracy)
     updImpl().updParameters().geodesicIntegratorAccuracy = accuracy;
 }
 
+bool CableSpan::getWarmStartGeodesics() const
+{
+    return getImpl().getParameters().warmStartGeodesics;
+}
+
+void CableSpan::setWarmStartGeodesics(bool warmStart)
+{
+    updImpl().updParameters().warmStartGeodesics = warmStart;
+}
+
 int CableSpan::getSolverMaxIterations() const
 {
     return getImpl().getParameters().solverMaxIterations;
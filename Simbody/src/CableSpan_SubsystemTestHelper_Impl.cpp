@@ -578,6 +578,7 @@ void CableSubsystemTestHelper::Impl::testCurrentPath(
     // Intentionally skip the perturbation test if the geodesic test fails.
     runGeodesicTest(state, subsystem, testReport);
     runPerturbationTest(state, subsystem, testReport);
+    runSolverTest(state, subsystem, testReport);
 }
 
 CableSubsystemTestHelper::CableSubsystemTestHelper() :
@@ -68,6 +68,16 @@ public:
         Real tolerance = 0.1;
     };
 
+    /** Parameters for configuring the solver test. **/
+    struct SolverTestParameters {
+        /** Geodesic correction applied to move the path away from the
+        optimum. **/
+        Real perturbation = 1e-3;
+        /** Tolerance used to assert that the path corrections computed using
+        fixed size and dynamically sized matrices are equal. **/
+        Real tolerance = 1e-8;
+    };
+
 private:
     //--------------------------------------------------------------------------
     // Tests
@@ -174,6 +184,19 @@ private:
         const CableSubsystem& subsystem,
         std::ostream& testReport) const;
 
+    /** This function asserts that the path corrections computed by the
+    CableSpan's solver using matrices of fixed dimensions, which is done for
+    cable segments touching only a few obstacles, equal those computed using
+    dynamically sized matrices. This is tested for each of the
+    CableSpanAlgorithm kinds, after moving the path away from its optimum.
+
+    Interesting test results are written to the testReport.
+    An exception is thrown when the test fails. **/
+    void runSolverTest(
+        const State& state,
+        const CableSubsystem& subsystem,
+        std::ostream& testReport) const;
+
     //--------------------------------------------------------------------------
     //  Data: Configuration parameters
     //--------------------------------------------------------------------------
@@ -186,6 +209,9 @@ private:
 
     /* Configuration parameters for the geodesic test. */
     GeodesicTestParameters m_integratorTestParameters;
+
+    /* Configuration parameters for the solver test. */
+    SolverTestParameters m_solverTestParameters;
 };
 
 } // namespace SimTK
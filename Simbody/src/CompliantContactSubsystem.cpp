@@ -36,6 +36,8 @@ patch analysis methods.
 #include "simbody/internal/SimbodyMatterSubsystem.h"
 #include "simbody/internal/MultibodySystem.h"
 
+#include "ElasticFoundationChunks.h"
+
 namespace SimTK {
 
 //==============================================================================
@@ -50,7 +52,8 @@ CompliantContactSubsystemImpl(const ContactTrackerSubsystem& tracker)
 :   ForceSubsystemRep("CompliantContactSubsystem", "0.0.1"),
     m_tracker(tracker), m_transitionVelocity(Real(0.01)), 
     m_ooTransitionVelocity(1/m_transitionVelocity), 
-    m_trackDissipatedEnergy(false), m_defaultGenerator(0) 
+    m_trackDissipatedEnergy(false), m_defaultGenerator(0),
+    m_executor(new ParallelExecutor(1))
 {   
 }
 
@@ -67,6 +70,14 @@ void setTrackDissipatedEnergy(bool shouldTrack) {
 }
 bool getTrackDissipatedEnergy() const {return m_trackDissipatedEnergy;}
 
+void setNumberOfThreads(unsigned numThreads) {
+    SimTK_APIARGCHECK_ALWAYS(numThreads > 0, "CompliantContactSubsystem",
+        "setNumberOfThreads", "Number of threads must be positive.");
+    m_executor = new ParallelExecutor(numThreads);
+}
+int getNumberOfThreads() const {return m_executor->getMaxThreads();}
+ParallelExecutor& getParallelExecutor() const {return *m_executor;}
+
 int getNumContactForces(const State& s) const {
     ensureForceCacheValid(s);
     const Array_<ContactForce>& forces = getForceCache(s);
@@ -383,6 +394,10 @@ GeneratorMap                        m_generators;
 // this will either do nothing silently or throw an error.
 ContactForceGenerator*              m_defaultGenerator;
 
+// Generators may use this to divide up the work of a single contact among
+// several threads; see setNumberOfThreads().
+mutable ClonePtr<ParallelExecutor>  m_executor;
+
     // TOPOLOGY "CACHE"
 
 // These must be set during realizeTopology and treated as const thereafter.
@@ -545,6 +560,13 @@ void CompliantContactSubsystem::setTrackDissipatedEnergy(bool shouldTrack)
 bool CompliantContactSubsystem::getTrackDissipatedEnergy() const
 {   return getImpl().getTrackDissipatedEnergy(); }
 
+void CompliantContactSubsystem::setNumberOfThreads(unsigned numThreads)
+{   updImpl().setNumberOfThreads(numThreads); }
+int CompliantContactSubsystem::getNumberOfThreads() const
+{   return getImpl().getNumberOfThreads(); }
+ParallelExecutor& CompliantContactSubsystem::getParallelExecutor() const
+{   return getImpl().getParallelExecutor(); }
+
 int CompliantContactSubsystem::getNumContactForces(const State& s) const
 {   return getImpl().getNumContactForces(s); }
 
@@ -1475,6 +1497,18 @@ void ContactForceGenerator::BrickHalfSpacePenalty::calcContactPatch
 //==============================================================================
 //                         ELASTIC FOUNDATION GENERATOR
 //==============================================================================
+namespace {
+// The contributions of one chunk of springs to the results of processOneMesh().
+struct ElasticFoundationSums {
+    SpatialVec              force = SpatialVec(Vec3(0), Vec3(0));
+    Real                    potentialEnergy = 0;
+    Real                    powerLoss = 0;
+    Vec3                    weightedCenterOfPressure = Vec3(0);
+    Real                    sumOfPressureMoments = 0;
+    Array_<ContactDetail>   details;
+};
+} // anonymous namespace
+
 void ContactForceGenerator::ElasticFoundation::calcContactForce
    (const State&            state,
     const Contact&          overlap,    // contains X_S1S2
@@ -1794,12 +1828,14 @@ calcWeightedPatchCentroid
     Vec3&                                   weightedPatchCentroid,
     Real&                                   patchArea) const
 {
+    const Array_<Real>& faceAreas     = mesh.getFaceAreas();
+    const Array_<Vec3>& faceCentroids = mesh.getFaceCentroids();
     weightedPatchCentroid = Vec3(0); patchArea = 0;
     for (std::set<int>::const_iterator iter = insideFaces.begin(); 
                                        iter != insideFaces.end(); ++iter)
     {   const int  face = *iter;
-        const Real area = mesh.getFaceArea(face);
-        weightedPatchCentroid   += area*mesh.findCentroid(face); 
+        const Real area = faceAreas[face];
+        weightedPatchCentroid   += area*faceCentroids[face]; 
         patchArea               += area; 
     }
 }
@@ -1861,159 +1897,193 @@ processOneMesh
     const Real vtrans   = subsys.getTransitionVelocity();
     const Real ooVtrans = subsys.getOOTransitionVelocity(); // 1/vtrans
 
-    // Now loop over all the faces again, evaluate the force from each 
-    // spring, and apply it at the patch centroid.
-    // This costs roughly 300 flops per contacting face.
-    for (std::set<int>::const_iterator iter = insideFaces.begin(); 
-                                       iter != insideFaces.end(); ++iter) 
-    {   const int   face        = *iter;
-        const Vec3  springPos_M = mesh.findCentroid(face);
-        const Real  faceArea    = areaScaleFactor*mesh.getFaceArea(face);
-
-        bool        inside;
-        UnitVec3    normal_O; // not used
-        const Vec3  nearestPoint_O = // 18 flops + cost of findNearestPoint
-            other.findNearestPoint(~X_MO*springPos_M, inside, normal_O);
-        if (!inside)
-            continue;
-        
-        // Although the "spring" is associated with just one surface (the mesh M)
-        // it is considered here to include the compression of both surfaces
-        // together, using composite material properties for stiffness and 
-        // dissipation properties of the spring. The total displacement vector
-        // for both surfaces points from the nearest point on the undeformed other 
-        // surface to the undeformed spring position (face centroid) on the 
-        // mesh. Since these overlap (we checked above) the nearest point is 
-        // *inside* the mesh thus the vector points towards the mesh exterior; 
-        // i.e., in the  direction that the force will be applied to the 
-        // "other" body. This is the same convention we use for the patch 
-        // normal for Hertz contact.
-        const Vec3 nearestPoint_M = X_MO*nearestPoint_O; // 18 flops
-        const Vec3 overlap_M      = springPos_M - nearestPoint_M; // 3 flops
-        const Real overlap        = overlap_M.norm(); // ~40 flops
-
-        // If there is no overlap we can't generate forces.
-        if (overlap == 0)
-            continue;
+    // Gather the spring locations (face centroids) and areas of the inside
+    // faces into contiguous arrays, so that the springs can be divided into
+    // chunks that are evaluated independently.
+    const Array_<Real>& faceAreas       = mesh.getFaceAreas();
+    const Array_<Vec3>& faceCentroids_M = mesh.getFaceCentroids();
+    const int nSprings = (int)insideFaces.size();
+    Array_<int>  faces(insideFaces.begin(), insideFaces.end());
+    Array_<Vec3> springPositions_M(nSprings);
+    Array_<Real> springAreas(nSprings);
+    for (int i=0; i < nSprings; ++i) {
+        springPositions_M[i] = faceCentroids_M[faces[i]];
+        springAreas[i]       = areaScaleFactor*faceAreas[faces[i]];
+    }
 
-        // The surfaces are compressed by total amount "overlap".
-        const UnitVec3 normal_M(overlap_M/overlap, true); // ~15 flops
-
-        // Calculate the contact point location based on the relative 
-        // squishiness of the two surfaces. The mesh deformation fraction (0-1)
-        // gives the fraction of the material squishing that is done by the
-        // mesh; the rest is done by the other surface. At 0 (rigid mesh) the 
-        // contact point will be at the undeformed mesh face centroid; at 1 
-        // (other body rigid) it will be at the (undeformed) nearest point on 
-        // the other body.
-        const Real meshSquish = meshDeformationFraction*overlap; // mesh displacement
-        // Remember that the normal points towards the exterior of this mesh.
-        const Vec3 contactPt_M = springPos_M - meshSquish*normal_M; // 6 flops
+    Array_<ElasticFoundationSums> chunkSums;
+
+    // Evaluate the force from each spring in a chunk and accumulate it at the 
+    // patch centroid. This costs roughly 300 flops per contacting face.
+    auto evaluateChunk =
+        [&](ElasticFoundationSums& sums, int first, int last) {
+        for (int i=first; i < last; ++i)
+        {   const Vec3& springPos_M = springPositions_M[i];
+            const Real  faceArea    = springAreas[i];
+
+            bool        inside;
+            UnitVec3    normal_O; // not used
+            const Vec3  nearestPoint_O = // 18 flops + cost of findNearestPoint
+                other.findNearestPoint(~X_MO*springPos_M, inside, normal_O);
+            if (!inside)
+                continue;
         
-        // Calculate the relative velocity of the two bodies at the contact 
-        // point. We're considering the mesh M fixed, so we just need the 
-        // velocity in M of the station of O that is coincident with the 
-        // contact point.
+            // Although the "spring" is associated with just one surface (the mesh M)
+            // it is considered here to include the compression of both surfaces
+            // together, using composite material properties for stiffness and 
+            // dissipation properties of the spring. The total displacement vector
+            // for both surfaces points from the nearest point on the undeformed other 
+            // surface to the undeformed spring position (face centroid) on the 
+            // mesh. Since these overlap (we checked above) the nearest point is 
+            // *inside* the mesh thus the vector points towards the mesh exterior; 
+            // i.e., in the  direction that the force will be applied to the 
+            // "other" body. This is the same convention we use for the patch 
+            // normal for Hertz contact.
+            const Vec3 nearestPoint_M = X_MO*nearestPoint_O; // 18 flops
+            const Vec3 overlap_M      = springPos_M - nearestPoint_M; // 3 flops
+            const Real overlap        = overlap_M.norm(); // ~40 flops
+
+            // If there is no overlap we can't generate forces.
+            if (overlap == 0)
+                continue;
+
+            // The surfaces are compressed by total amount "overlap".
+            const UnitVec3 normal_M(overlap_M/overlap, true); // ~15 flops
+
+            // Calculate the contact point location based on the relative 
+            // squishiness of the two surfaces. The mesh deformation fraction (0-1)
+            // gives the fraction of the material squishing that is done by the
+            // mesh; the rest is done by the other surface. At 0 (rigid mesh) the 
+            // contact point will be at the undeformed mesh face centroid; at 1 
+            // (other body rigid) it will be at the (undeformed) nearest point on 
+            // the other body.
+            const Real meshSquish = meshDeformationFraction*overlap; // mesh displacement
+            // Remember that the normal points towards the exterior of this mesh.
+            const Vec3 contactPt_M = springPos_M - meshSquish*normal_M; // 6 flops
+        
+            // Calculate the relative velocity of the two bodies at the contact 
+            // point. We're considering the mesh M fixed, so we just need the 
+            // velocity in M of the station of O that is coincident with the 
+            // contact point.
 
-        // O station, exp. in M
-        const Vec3 contactPtO_M = contactPt_M - pMO;    // 3 flops 
+            // O station, exp. in M
+            const Vec3 contactPtO_M = contactPt_M - pMO;    // 3 flops 
 
-        // All vectors are in M; dropping the "_M" notation now.
+            // All vectors are in M; dropping the "_M" notation now.
 
-        // Velocity of other at contact point is opposite direction of normal
-        // when penetration is increasing.
-        const Vec3 vel = vMO + wMO % contactPtO_M;      // 12 flops
+            // Velocity of other at contact point is opposite direction of normal
+            // when penetration is increasing.
+            const Vec3 vel = vMO + wMO % contactPtO_M;      // 12 flops
 
-        // Want odot > 0 when overlap is increasing; normal points the 
-        // other way. odot is signed penetration (overlap) rate.
-        const Real odot = -dot(vel, normal_M);          // 6 flops
-        const Vec3 velNormal  = -odot*normal_M;         // 4 flops
-        const Vec3 velTangent = vel-velNormal;          // 3 flops
+            // Want odot > 0 when overlap is increasing; normal points the 
+            // other way. odot is signed penetration (overlap) rate.
+            const Real odot = -dot(vel, normal_M);          // 6 flops
+            const Vec3 velNormal  = -odot*normal_M;         // 4 flops
+            const Vec3 velTangent = vel-velNormal;          // 3 flops
         
-        // Calculate scalar normal force                  (5 flops)
-        // Here kh has units of pressure/area/displacement
-        const Real fK = kh*faceArea*overlap; // normal elastic force (conservative)
-        const Real fC = fK*c*odot;           // normal dissipation force (loss)
-        const Real fNormal = fK + fC;        // normal force
-
-        // Total force can be negative under unusual circumstances ("yanking");
-        // that means no force is generated and no stored PE will be recovered.
-        // This will most often occur in to-be-rejected trial steps but can
-        // occasionally be real.
-        if (fNormal <= 0) {
-            //SimTK_DEBUG1("YANKING!!! (face %d)\n", face);
-            continue;
-        }
+            // Calculate scalar normal force                  (5 flops)
+            // Here kh has units of pressure/area/displacement
+            const Real fK = kh*faceArea*overlap; // normal elastic force (conservative)
+            const Real fC = fK*c*odot;           // normal dissipation force (loss)
+            const Real fNormal = fK + fC;        // normal force
+
+            // Total force can be negative under unusual circumstances ("yanking");
+            // that means no force is generated and no stored PE will be recovered.
+            // This will most often occur in to-be-rejected trial steps but can
+            // occasionally be real.
+            if (fNormal <= 0) {
+                //SimTK_DEBUG1("YANKING!!! (face %d)\n", faces[i]);
+                continue;
+            }
 
-        // 12 flops in this series.
-        const Vec3 forceK          = fK*normal_M;   // as applied to other surf
-        const Vec3 forceC          = fC*normal_M;
-        const Real PE              = fK*overlap/2;  // 1/2 kAx^2
-        const Real powerC          = fC*odot;       // rate of energy loss, >= 0
-        const Vec3 forceNormal     = forceK + forceC;
-
-        // This is the moment r X f about the resultant point produced by 
-        // applying this pure force at the contact point. Cost ~60 flops.
-        const Vec3 r = contactPt_M - resultantPt_M;
-        const Real pressureMoment = (r % forceNormal).norm();
-        weightedCenterOfPressure_M += pressureMoment*r;
-        sumOfAllPressureMoments    += pressureMoment;
+            // 12 flops in this series.
+            const Vec3 forceK          = fK*normal_M;   // as applied to other surf
+            const Vec3 forceC          = fC*normal_M;
+            const Real PE              = fK*overlap/2;  // 1/2 kAx^2
+            const Real powerC          = fC*odot;       // rate of energy loss, >= 0
+            const Vec3 forceNormal     = forceK + forceC;
+
+            // This is the moment r X f about the resultant point produced by 
+            // applying this pure force at the contact point. Cost ~60 flops.
+            const Vec3 r = contactPt_M - resultantPt_M;
+            const Real pressureMoment = (r % forceNormal).norm();
+            sums.weightedCenterOfPressure += pressureMoment*r;
+            sums.sumOfPressureMoments     += pressureMoment;
         
-        // Calculate the friction force. Cost is about 60 flops.
-        Vec3 forceFriction(0);
-        Real powerFriction = 0;
-        const Real vslipSq = velTangent.normSqr();  // 5 flops
-        if (vslipSq > square(SignificantReal)) {
-            const Real vslip = std::sqrt(vslipSq); // expensive: ~25 flops
-            // Express slip velocity as unitless multiple of transition velocity.
-            const Real v = vslip * ooVtrans;
-            // Must scale viscous coefficient to match unitless velocity.
-            const Real mu=stribeck(us,ud,uv*vtrans,v); // ~10 flops
-            //const Real mu=hollars(us,ud,uv*vtrans,v);
-            const Real fFriction = fNormal * mu;
-            // Force direction on O opposes O's velocity.
-            forceFriction = (-fFriction/vslip)*velTangent; // ~20 flops
-            powerFriction = fFriction * vslip; // always >= 0
-        }
-
-        const Vec3 forceLoss  = forceC + forceFriction;     // 3 flops
-        const Vec3 forceTotal = forceK + forceLoss;         // 3 flops
-
-        // Accumulate the moment and force on the *other* surface as though 
-        // applied at the point of O that is coincident with the resultant
-        // point; we'll move it later.                      (15 flops)
-        resultantForceOnOther_M += SpatialVec(r % forceTotal, forceTotal);
-
-        // Accumulate potential energy stored in elastic displacement.
-        potentialEnergy += PE;                  // 1 flop
-
-        // Don't include dot(forceK,velNormal) power due to conservative force
-        // here. This way we don't double-count the energy on the way in as
-        // integrated power and potential energy. Although the books would 
-        // balance again when the contact is broken, it makes continuous 
-        // contact look as though some energy has been lost. In the "yanking" 
-        // case above, without including the conservative power term we will 
-        // actually lose energy because the deformed material isn't allowed to 
-        // push back on us so the energy is lost to surface vibrations or some
-        // other unmodeled effect.
-        const Real powerLossThisElement = powerC + powerFriction; // 1 flop
-        powerLoss += powerLossThisElement;                        // 1 flop
+            // Calculate the friction force. Cost is about 60 flops.
+            Vec3 forceFriction(0);
+            Real powerFriction = 0;
+            const Real vslipSq = velTangent.normSqr();  // 5 flops
+            if (vslipSq > square(SignificantReal)) {
+                const Real vslip = std::sqrt(vslipSq); // expensive: ~25 flops
+                // Express slip velocity as unitless multiple of transition velocity.
+                const Real v = vslip * ooVtrans;
+                // Must scale viscous coefficient to match unitless velocity.
+                const Real mu=stribeck(us,ud,uv*vtrans,v); // ~10 flops
+                //const Real mu=hollars(us,ud,uv*vtrans,v);
+                const Real fFriction = fNormal * mu;
+                // Force direction on O opposes O's velocity.
+                forceFriction = (-fFriction/vslip)*velTangent; // ~20 flops
+                powerFriction = fFriction * vslip; // always >= 0
+            }
 
-        if (wantDetails) {
-            contactDetails_M->push_back();
-            ContactDetail& detail = contactDetails_M->back();
-            detail.m_contactPt          = contactPt_M;
-            detail.m_patchNormal        = normal_M;
-            detail.m_slipVelocity       = velTangent;
-            detail.m_forceOnSurface2    = forceTotal;
-            detail.m_deformation        = overlap;
-            detail.m_deformationRate    = odot;
-            detail.m_patchArea          = faceArea;
-            detail.m_peakPressure       = (faceArea != 0 ? fNormal/faceArea 
-                                                         : Real(0));
-            detail.m_potentialEnergy    = PE;
-            detail.m_powerLoss          = powerLossThisElement;
+            const Vec3 forceLoss  = forceC + forceFriction;     // 3 flops
+            const Vec3 forceTotal = forceK + forceLoss;         // 3 flops
+
+            // Accumulate the moment and force on the *other* surface as though 
+            // applied at the point of O that is coincident with the resultant
+            // point; we'll move it later.                      (15 flops)
+            sums.force += SpatialVec(r % forceTotal, forceTotal);
+
+            // Accumulate potential energy stored in elastic displacement.
+            sums.potentialEnergy += PE;             // 1 flop
+
+            // Don't include dot(forceK,velNormal) power due to conservative force
+            // here. This way we don't double-count the energy on the way in as
+            // integrated power and potential energy. Although the books would 
+            // balance again when the contact is broken, it makes continuous 
+            // contact look as though some energy has been lost. In the "yanking" 
+            // case above, without including the conservative power term we will 
+            // actually lose energy because the deformed material isn't allowed to 
+            // push back on us so the energy is lost to surface vibrations or some
+            // other unmodeled effect.
+            const Real powerLossThisElement = powerC + powerFriction; // 1 flop
+            sums.powerLoss += powerLossThisElement;                   // 1 flop
+
+            if (wantDetails) {
+                sums.details.push_back();
+                ContactDetail& detail = sums.details.back();
+                detail.m_contactPt          = contactPt_M;
+                detail.m_patchNormal        = normal_M;
+                detail.m_slipVelocity       = velTangent;
+                detail.m_forceOnSurface2    = forceTotal;
+                detail.m_deformation        = overlap;
+                detail.m_deformationRate    = odot;
+                detail.m_patchArea          = faceArea;
+                detail.m_peakPressure       = (faceArea != 0 ? fNormal/faceArea 
+                                                             : Real(0));
+                detail.m_potentialEnergy    = PE;
+                detail.m_powerLoss          = powerLossThisElement;
+            }
         }
+    };
+
+    // Chunks can be evaluated concurrently if the other surface can be
+    // queried from several threads at once.
+    evaluateElasticFoundationChunks(subsys.getParallelExecutor(),
+        !ContactGeometry::SmoothHeightMap::isInstance(other),
+        nSprings, chunkSums, evaluateChunk);
+
+    // Combine the chunks in order.
+    for (const ElasticFoundationSums& sums : chunkSums) {
+        resultantForceOnOther_M    += sums.force;
+        potentialEnergy            += sums.potentialEnergy;
+        powerLoss                  += sums.powerLoss;
+        weightedCenterOfPressure_M += sums.weightedCenterOfPressure;
+        sumOfAllPressureMoments    += sums.sumOfPressureMoments;
+        if (wantDetails)
+            contactDetails_M->insert(contactDetails_M->end(), 
+                                     sums.details.begin(), sums.details.end());
     }
 }
 
@@ -2411,6 +2411,24 @@ addInAccelerationConstraintForces
 
 
 
+// The Function-based constraints below (CoordinateCoupler, SpeedCoupler and
+// PrescribedMotion) pass their arguments to the Function in a Vector. They may
+// be evaluated concurrently for different States (see System::realizeBatch())
+// so they can't share one in the constraint, and allocating a new one for 
+// every evaluation would be slow. Instead each thread keeps one argument 
+// Vector per argument count, allocated the first time it is needed.
+static Vector& updFunctionArguments(int n) {
+    static thread_local Array_<Vector> argumentsBySize;
+    if (n >= (int)argumentsBySize.size())
+        argumentsBySize.resize(n+1);
+    Vector& x = argumentsBySize[n];
+    if (x.size() != n)
+        x.resize(n);
+    return x;
+}
+
+
+
 //==============================================================================
 //                       CONSTRAINT::COORDINATE COUPLER
 //==============================================================================
@@ -2429,7 +2447,7 @@ Constraint::CoordinateCouplerImpl::CoordinateCouplerImpl
     const Array_<MobilizerQIndex>&      coordQIndex)
 :   Implementation(matter, 1, 0, 0), function(function), 
     coordBodies(coordMobod.size()), coordIndices(coordQIndex),
-    temp(coordBodies.size()), referenceCount(new int[1]) 
+    referenceCount(new int[1]) 
 {
     assert(coordBodies.size() == coordIndices.size());
     assert(coordIndices.size() == function->getArgumentSize());
@@ -2448,6 +2466,7 @@ calcPositionErrors
     const Array_<Real,     ConstrainedQIndex>&      constrainedQ,
     Array_<Real>&                                   perr) const
 {
+    Vector& temp = updFunctionArguments(coordBodies.size());
     for (int i = 0; i < temp.size(); ++i)
         temp[i] = getOneQ(s, constrainedQ, coordBodies[i], coordIndices[i]);
     perr[0] = function->calcValue(temp);
@@ -2460,6 +2479,7 @@ calcPositionDotErrors
     const Array_<Real,      ConstrainedQIndex>&     constrainedQDot,
     Array_<Real>&                                   pverr) const
 {
+    Vector& temp = updFunctionArguments(coordBodies.size());
     pverr[0] = 0;
     for (int i = 0; i < temp.size(); ++i)
         temp[i] = getOneQFromState(s, coordBodies[i], coordIndices[i]);
@@ -2479,6 +2499,7 @@ calcPositionDotDotErrors
     const Array_<Real,      ConstrainedQIndex>&     constrainedQDotDot,
     Array_<Real>&                                   paerr) const
 {
+    Vector& temp = updFunctionArguments(coordBodies.size());
     paerr[0] = 0.0;
     for (int i = 0; i < temp.size(); ++i)
         temp[i] = getOneQFromState(s, coordBodies[i], coordIndices[i]);
@@ -2512,6 +2533,7 @@ addInPositionConstraintForces
     Array_<SpatialVec,ConstrainedBodyIndex>&    bodyForces,
     Array_<Real,ConstrainedQIndex>&             qForces) const
 {
+    Vector& temp = updFunctionArguments(coordBodies.size());
     assert(multipliers.size() == 1);
     assert(bodyForces.size() == 0);
 
@@ -2562,11 +2584,12 @@ Constraint::SpeedCouplerImpl::SpeedCouplerImpl
 :   Implementation(matter, 0, 1, 0), function(function), 
     speedBodies(speedBody.size()), speedIndices(speedIndex), 
     coordBodies(coordBody), coordIndices(coordIndex),
-    temp(speedBody.size()+coordBody.size()), referenceCount(new int[1]) 
+    referenceCount(new int[1]) 
 {
     assert(speedBodies.size() == speedIndices.size());
     assert(coordBodies.size() == coordIndices.size());
-    assert(temp.size() == function->getArgumentSize());
+    assert(speedBodies.size()+coordBodies.size()
+           == function->getArgumentSize());
     assert(function->getMaxDerivativeOrder() >= 2);
 
     referenceCount[0] = 1;
@@ -2584,6 +2607,8 @@ calcVelocityErrors
     const Array_<Real,      ConstrainedUIndex>&     constrainedU,
     Array_<Real>&                                   verr) const
 {
+    Vector& temp = updFunctionArguments(speedBodies.size()
+                                        + coordBodies.size());
     for (int i = 0; i < (int) speedBodies.size(); ++i)
         temp[i] = getOneU(s, constrainedU, speedBodies[i], speedIndices[i]);
     for (int i = 0; i < (int) coordBodies.size(); ++i)
@@ -2601,6 +2626,8 @@ calcVelocityDotErrors
     const Array_<Real,      ConstrainedUIndex>&     constrainedUDot,
     Array_<Real>&                                   vaerr) const 
 {
+    Vector& temp = updFunctionArguments(speedBodies.size()
+                                        + coordBodies.size());
     for (int i = 0; i < (int)speedBodies.size(); ++i)
         temp[i] = getOneUFromState(s, speedBodies[i], speedIndices[i]);
     for (int i = 0; i < (int)coordBodies.size(); ++i) {
@@ -2635,6 +2662,8 @@ addInVelocityConstraintForces
     Array_<SpatialVec,ConstrainedBodyIndex>&    bodyForces,
     Array_<Real,ConstrainedUIndex>&             mobilityForces) const
 {
+    Vector& temp = updFunctionArguments(speedBodies.size()
+                                        + coordBodies.size());
     assert(multipliers.size() == 1);
     const Real lambda = multipliers[0];
 
@@ -2674,7 +2703,7 @@ Constraint::PrescribedMotionImpl::PrescribedMotionImpl
     MobilizedBodyIndex coordBody, 
     MobilizerQIndex coordIndex)
 :   Implementation(matter, 1, 0, 0), function(function), 
-    coordIndex(coordIndex), temp(1), referenceCount(new int[1]) 
+    coordIndex(coordIndex), referenceCount(new int[1]) 
 {
     assert(function->getArgumentSize() == 1);
     assert(function->getMaxDerivativeOrder() >= 2);
@@ -2691,6 +2720,7 @@ calcPositionErrors
     const Array_<Real,     ConstrainedQIndex>&      constrainedQ,
     Array_<Real>&                                   perr) const
 {
+    Vector& temp = updFunctionArguments(1);
     temp[0] = s.getTime();
     perr[0] = getOneQ(s, constrainedQ, coordBody, coordIndex) 
               - function->calcValue(temp);
@@ -2703,6 +2733,7 @@ calcPositionDotErrors
     const Array_<Real,      ConstrainedQIndex>&     constrainedQDot,
     Array_<Real>&                                   pverr) const
 {
+    Vector& temp = updFunctionArguments(1);
     temp[0] = s.getTime();
     Array_<int> components(1, 0); // i.e., components={0}
     pverr[0] = getOneQDot(s, constrainedQDot, coordBody, coordIndex) 
@@ -2716,6 +2747,7 @@ calcPositionDotDotErrors
     const Array_<Real,      ConstrainedQIndex>&     constrainedQDotDot,
     Array_<Real>&                                   paerr) const
 {
+    Vector& temp = updFunctionArguments(1);
     temp[0] = s.getTime();
     Array_<int> components(2, 0); // i.e., components={0,0}
     paerr[0] = getOneQDotDot(s, constrainedQDotDot, coordBody, coordIndex)  
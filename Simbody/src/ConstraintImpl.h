@@ -3128,10 +3128,6 @@ Array_<MobilizerQIndex>             coordIndices;
 //  TOPOLOGY CACHE
 //  None.
 
-//  A reusable temporary variable allocated to the correct size
-//  to hold all the Function arguments.
-mutable Vector                      temp;
-
 // This allows copies to be made of this constraint which share
 // the function object.
 int*                                referenceCount;
@@ -3192,7 +3188,6 @@ Array_<ConstrainedMobilizerIndex>   speedBodies;
 Array_<MobilizedBodyIndex>          coordBodies;
 Array_<MobilizerUIndex>             speedIndices;
 Array_<MobilizerQIndex>             coordIndices;
-mutable Vector                      temp;
 };
 
 
@@ -3250,7 +3245,6 @@ const Function*             function;
 int*                        referenceCount;
 ConstrainedMobilizerIndex   coordBody;
 MobilizerQIndex             coordIndex;
-mutable Vector              temp;
 };
 
 
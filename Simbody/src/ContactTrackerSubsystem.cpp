@@ -32,6 +32,9 @@ using std::pair; using std::make_pair;
 #include <iostream>
 using std::cout; using std::endl;
 #include <set>
+#include <functional>
+#include <unordered_set>
+#include <cstdint>
 
 using namespace SimTK;
 
@@ -83,6 +86,63 @@ static std::ostream& operator<<(std::ostream& o, const BubbleExtent& bx) {
     return o;
 }
 
+// Persistent data for the incremental sweep-and-prune broad phase. We keep
+// the endpoints of every bubble's axis-aligned bounding box sorted along each
+// of the three axes, together with the set of bubble pairs whose boxes
+// overlap. Between realizations the bubbles move only a little, so
+// re-sorting with insertion sort is nearly linear and every swap of a lower
+// endpoint past an upper one (or vice versa) tells us exactly which pair
+// started or stopped overlapping. This lives in a lazy cache entry that
+// depends on Position stage, so each State carries its own copy. When the
+// positions change the entry is out of date, but its old contents are still
+// used to warm start the next re-sort.
+struct SweepAndPrune {
+    // One end of a bubble's box along an axis. The code is 2*bubble for the
+    // lower end and 2*bubble+1 for the upper end. Lower ends sort before upper
+    // ends at the same value so that touching boxes count as overlapping.
+    struct Endpoint {
+        Real value;
+        int  code;
+        bool isUpper() const {return (code & 1) != 0;}
+        int  bubble()  const {return code >> 1;}
+        bool operator<(const Endpoint& e) const {
+            return value < e.value 
+                || (value == e.value && (code & 1) < (e.code & 1));
+        }
+    };
+
+    static std::uint64_t pairKey(int b1, int b2) {
+        if (b1 > b2) std::swap(b1,b2);
+        return (std::uint64_t(b1) << 32) | std::uint64_t(b2);
+    }
+
+    void clear() {
+        for (int a=0; a < 3; ++a) endpoints[a].clear();
+        overlapping.clear();
+    }
+
+    Array_<Endpoint,int>            endpoints[3];
+    Array_<Vec3,int>                lower, upper, centers; // per bubble
+    std::unordered_set<std::uint64_t> overlapping;
+};
+static std::ostream& operator<<(std::ostream& o, const SweepAndPrune& sap) {
+    return o << "SweepAndPrune: " << sap.centers.size() << " bubbles, " 
+             << sap.overlapping.size() << " overlapping pairs";
+}
+
+// One candidate surface pair for the narrow phase. The tracker and the
+// surface order it requires are looked up serially; then trackContact() can
+// be run for many pairs concurrently, each writing only its own "next"
+// Contact. The results are merged back in pair order so they don't depend on
+// the number of threads.
+struct NarrowPhasePair {
+    const ContactTracker* tracker;
+    ContactSurfaceIndex   trackSurf1, trackSurf2; // in tracker's order
+    const Contact*        prev;   // null if this pair wasn't being tracked
+    double                cost;   // rough estimate for load balancing
+    Contact               next;   // output
+};
+
 typedef std::map< pair<ContactGeometryTypeId,ContactGeometryTypeId>,
                   pair<ContactTracker*,bool> > TrackerMap;
 
@@ -116,6 +176,36 @@ std::ostream& operator<<(std::ostream& o, const PairMap& pm) {
     return o;
 }
 
+// Each task index processes one bin of narrow phase pairs; see
+// ContactTrackerSubsystemImpl::ensureActiveContactsUpdated().
+class NarrowPhaseTask : public ParallelExecutor::Task {
+public:
+    NarrowPhaseTask(const std::function<void(NarrowPhasePair&)>& track,
+                    Array_<NarrowPhasePair,int>& pairs,
+                    const Array_<Array_<int,int>,int>& bins)
+    :   track(track), pairs(pairs), bins(bins) {}
+    void execute(int bin) override {
+        for (int i : bins[bin])
+            track(pairs[i]);
+    }
+private:
+    const std::function<void(NarrowPhasePair&)>& track;
+    Array_<NarrowPhasePair,int>&                  pairs;
+    const Array_<Array_<int,int>,int>&            bins;
+};
+
+// A rough relative cost for tracking contact between two geometries: meshes
+// cost in proportion to their face counts, everything else is cheap.
+double estimateTrackingCost(const ContactGeometry& geom1,
+                            const ContactGeometry& geom2) {
+    double cost = 1;
+    if (ContactGeometry::TriangleMesh::isInstance(geom1))
+        cost *= 1 + ContactGeometry::TriangleMesh::getAs(geom1).getNumFaces();
+    if (ContactGeometry::TriangleMesh::isInstance(geom2))
+        cost *= 1 + ContactGeometry::TriangleMesh::getAs(geom2).getNumFaces();
+    return cost;
+}
+
 } // end of anonymous namespace
 
 namespace SimTK {
@@ -126,7 +216,10 @@ class ContactTrackerSubsystemImpl : public Subsystem::Guts {
 public:
 // Constructor registers a default set of Trackers to use with geometry
 // we know about. These can be overridden later.
-ContactTrackerSubsystemImpl() : m_defaultTracker(0) {
+ContactTrackerSubsystemImpl() 
+:   m_defaultTracker(0), 
+    m_broadPhaseMethod(ContactTrackerSubsystem::SingleAxisSweep),
+    m_narrowPhaseExecutor(new ParallelExecutor(1)) {
     adoptContactTracker(new ContactTracker::HalfSpaceSphere());
     adoptContactTracker(new ContactTracker::SphereSphere());
     adoptContactTracker(new ContactTracker::HalfSpaceEllipsoid());
@@ -224,6 +317,8 @@ int realizeSubsystemTopologyImpl(State& state) const override {
     wThis->m_predictedContactsIx = allocateAutoUpdateDiscreteVariable
         (state, Stage::Dynamics, new Value<ContactSnapshot>(), 
          Stage::Acceleration);  // update depends on accelerations
+    wThis->m_sweepAndPruneIx = allocateLazyCacheEntry
+        (state, Stage::Position, new Value<SweepAndPrune>());
 
     const SimbodyMatterSubsystem& matter = getMatterSubsystem();
 
@@ -274,14 +369,40 @@ int realizeSubsystemVelocityImpl(const State& state) const override {
     return 0;
 }
 
+// Return true if two bubbles belong to surfaces that are allowed to
+// interact, that is, they are on different bodies and not in a common clique.
+bool canInteract(BubbleIndex bbx1, BubbleIndex bbx2) const {
+    const Surface& surf1 = m_surfaces[m_bubbles[bbx1].surface];
+    const Surface& surf2 = m_surfaces[m_bubbles[bbx2].surface];
+    if (surf1.mobod == surf2.mobod) return false;
+    assert(m_bubbles[bbx1].surface != m_bubbles[bbx2].surface); // duh!
+    return !surf1.surface->isInSameClique(*surf2.surface);
+}
+
+// We'll need to do a narrow phase investigation of the surfaces of these two
+// bubbles; use the lower-numbered one as the index to avoid duplicates. The
+// pair is inserted with a null Contact if it isn't already in the PairMap.
+void insertPair(BubbleIndex bbx1, BubbleIndex bbx2, PairMap& pairs) const {
+    ContactSurfaceIndex low=m_bubbles[bbx1].surface, 
+                        high=m_bubbles[bbx2].surface;
+    if (low > high) std::swap(low,high);
+    pairs[low].insert(make_pair(high,(Contact*)0));
+}
+
 // Adds new pairs to the existing set, if not already present.
 void addInBroadPhasePairs(const State& state, PairMap& pairs) const {
+    if (m_broadPhaseMethod == ContactTrackerSubsystem::SingleAxisSweep)
+        addInSingleAxisSweepPairs(state, pairs);
+    else
+        addInSweepAndPrunePairs(state, pairs);
+}
+
+void addInSingleAxisSweepPairs(const State& state, PairMap& pairs) const {
     const int numBubbles = getNumBubbles();
     
     // Perform a sweep-and-prune on a single axis to identify potential 
     // contacts. First, find which axis has the most variation in body 
     // locations. That is the axis we will use.
-    // TODO: this one-axis method is not good enough in general
     
     Vector_<Vec3> centers(numBubbles);
     for (BubbleIndex bbx(0); bbx < numBubbles; ++bbx) {
@@ -335,26 +456,161 @@ void addInBroadPhasePairs(const State& state, PairMap& pairs) const {
 
             // The bubbles are touching. We'll add the corresponding surfaces
             // to the narrow-phase list unless there are relevant exclusions.
-            const Surface& surf1 = m_surfaces[bubb1.surface];
-            const Surface& surf2 = m_surfaces[bubb2.surface];
-            // Ignore if on the same body.
-            if (surf1.mobod == surf2.mobod) continue;
-            assert(bubb1.surface != bubb2.surface); // duh!
-            // Ignore if surfaces are in a common clique.
-            if (surf1.surface->isInSameClique(*surf2.surface)) continue;
-            // We'll need to do a narrow phase investigation of these two
-            // surfaces; use the lower-numbered one as the index to avoid
-            // duplicates.
-            ContactSurfaceIndex low=bubb1.surface, high=bubb2.surface;
-            if (low > high) std::swap(low,high);
-            ContactSurfaceSet& surfSet = pairs[low];
-            // Insert this pair with null Contact if the pair isn't already
-            // in the PairMap.
-            surfSet.insert(make_pair(high,(Contact*)0));
+            if (!canInteract(extent1.index, extent2.index)) continue;
+            insertPair(extent1.index, extent2.index, pairs);
         }
     }
 }
 
+// Update the persistent sweep-and-prune data in the State for the current
+// bubble locations if necessary, then add the pairs whose bubbles are 
+// touching. The pairs found are exactly the same as for the single-axis sweep.
+void addInSweepAndPrunePairs(const State& state, PairMap& pairs) const {
+    if (!isCacheValueRealized(state, m_sweepAndPruneIx))
+        updateSweepAndPrune(state);
+    const SweepAndPrune& sap = Value<SweepAndPrune>::downcast
+                                    (getCacheEntry(state, m_sweepAndPruneIx));
+
+    for (std::uint64_t key : sap.overlapping) {
+        const BubbleIndex bbx1(int(key >> 32)), bbx2(int(key & 0xffffffff));
+        const Real radius1 = m_bubbles[bbx1].getRadius();
+        const Real radius2 = m_bubbles[bbx2].getRadius();
+        if ((sap.centers[bbx1]-sap.centers[bbx2]).normSqr() 
+            > square(radius1+radius2))
+            continue; // boxes overlap but the bubbles aren't touching
+        insertPair(bbx1, bbx2, pairs);
+    }
+}
+
+// Bring the sweep-and-prune data up to date with the current positions,
+// starting from whatever it held after the last evaluation, and mark it
+// realized.
+void updateSweepAndPrune(const State& state) const {
+    SweepAndPrune& sap = Value<SweepAndPrune>::updDowncast
+                                    (updCacheEntry(state, m_sweepAndPruneIx));
+    const int numBubbles = getNumBubbles();
+
+    sap.centers.resize(numBubbles);
+    sap.lower.resize(numBubbles);
+    sap.upper.resize(numBubbles);
+    for (BubbleIndex bbx(0); bbx < numBubbles; ++bbx) {
+        const Bubble&  bubb = m_bubbles[bbx];
+        const Surface& surf = m_surfaces[bubb.surface];
+        const Vec3 center = surf.mobod->getBodyTransform(state) 
+                            * bubb.getCenter();
+        const Vec3 extent(bubb.getRadius());
+        sap.centers[bbx] = center;
+        sap.lower[bbx]   = center - extent;
+        sap.upper[bbx]   = center + extent;
+    }
+
+    if (sap.endpoints[0].size() != 2*numBubbles)
+        rebuildSweepAndPrune(sap);
+    else
+        for (int axis=0; axis < 3; ++axis)
+            resortSweepAndPruneAxis(sap, axis);
+    markCacheValueRealized(state, m_sweepAndPruneIx);
+}
+
+static bool boxesOverlap(const SweepAndPrune& sap, int b1, int b2) {
+    for (int axis=0; axis < 3; ++axis)
+        if (   sap.lower[b1][axis] > sap.upper[b2][axis] 
+            || sap.lower[b2][axis] > sap.upper[b1][axis])
+            return false;
+    return true;
+}
+
+// Start from scratch: sort the endpoints on every axis, then find the
+// overlapping pairs with a single sweep along the axis with the most spread.
+// This is used the first time through and whenever the number of bubbles
+// has changed.
+void rebuildSweepAndPrune(SweepAndPrune& sap) const {
+    const int numBubbles = getNumBubbles();
+    sap.clear();
+    for (int axis=0; axis < 3; ++axis) {
+        Array_<SweepAndPrune::Endpoint,int>& ends = sap.endpoints[axis];
+        ends.resize(2*numBubbles);
+        for (int b=0; b < numBubbles; ++b) {
+            ends[2*b].value   = sap.lower[b][axis]; ends[2*b].code   = 2*b;
+            ends[2*b+1].value = sap.upper[b][axis]; ends[2*b+1].code = 2*b+1;
+        }
+        std::sort(ends.begin(), ends.end());
+    }
+
+    Vec3 lo(Infinity), hi(-Infinity);
+    for (int b=0; b < numBubbles; ++b)
+        for (int axis=0; axis < 3; ++axis) {
+            lo[axis] = std::min(lo[axis], sap.centers[b][axis]);
+            hi[axis] = std::max(hi[axis], sap.centers[b][axis]);
+        }
+    const Vec3 spread = hi - lo;
+    int sweepAxis = (spread[0] > spread[1] ? 0 : 1);
+    if (spread[2] > spread[sweepAxis])
+        sweepAxis = 2;
+
+    // Bubbles whose boxes contain the current sweep position, with each
+    // bubble's slot in that list so that removal is O(1).
+    Array_<int,int> active;
+    Array_<int,int> activeSlot(numBubbles, -1);
+    for (const SweepAndPrune::Endpoint& e : sap.endpoints[sweepAxis]) {
+        const int b = e.bubble();
+        if (e.isUpper()) {
+            const int slot = activeSlot[b];
+            activeSlot[active.back()] = slot;
+            active[slot] = active.back();
+            active.pop_back();
+            continue;
+        }
+        for (int other : active)
+            if (boxesOverlap(sap, b, other) 
+                && canInteract(BubbleIndex(b), BubbleIndex(other)))
+                sap.overlapping.insert(SweepAndPrune::pairKey(b, other));
+        activeSlot[b] = active.size();
+        active.push_back(b);
+    }
+}
+
+// Refresh the endpoint values along one axis and restore sorted order with
+// an insertion sort. Each time a lower endpoint moves below an upper one the
+// two boxes have started overlapping along this axis, and we add the pair if
+// they now overlap along all three. Each time an upper endpoint moves below a
+// lower one the boxes have separated and the pair is removed.
+void resortSweepAndPruneAxis(SweepAndPrune& sap, int axis) const {
+    Array_<SweepAndPrune::Endpoint,int>& ends = sap.endpoints[axis];
+    for (SweepAndPrune::Endpoint& e : ends) {
+        const int b = e.bubble();
+        e.value = e.isUpper() ? sap.upper[b][axis] : sap.lower[b][axis];
+    }
+
+    for (int i=1; i < ends.size(); ++i) {
+        const SweepAndPrune::Endpoint key = ends[i];
+        int j = i-1;
+        for (; j >= 0 && key < ends[j]; --j) {
+            const SweepAndPrune::Endpoint& passed = ends[j];
+            if (key.isUpper() != passed.isUpper()) {
+                const int b1 = key.bubble(), b2 = passed.bubble();
+                const std::uint64_t pairKey = SweepAndPrune::pairKey(b1, b2);
+                if (!key.isUpper()) {
+                    if (boxesOverlap(sap, b1, b2) 
+                        && canInteract(BubbleIndex(b1), BubbleIndex(b2)))
+                        sap.overlapping.insert(pairKey);
+                } else
+                    sap.overlapping.erase(pairKey);
+            }
+            ends[j+1] = ends[j];
+        }
+        ends[j+1] = key;
+    }
+}
+
+void setBroadPhaseMethod(ContactTrackerSubsystem::BroadPhaseMethod method) {
+    m_broadPhaseMethod = method;
+}
+
+ContactTrackerSubsystem::BroadPhaseMethod getBroadPhaseMethod() const {
+    return m_broadPhaseMethod;
+}
+
 // Call this any time after positions are known, to ensure that the active
 // contact set has been updated for those positions. We can use three
 // sources of information to compute the update:
@@ -408,12 +664,11 @@ void ensureActiveContactsUpdated(const State& state) const {
     addInBroadPhasePairs(state, interesting);
     //cout << "Interesting pairs:\n" << interesting << "\n";
 
+    // Collect the pairs for which we have a tracker, in PairMap order.
+    Array_<NarrowPhasePair,int> work;
     PairMap::const_iterator p = interesting.begin();
     for (; p != interesting.end(); ++p) {
         const ContactSurfaceIndex index1 = p->first;
-        const Transform transform1 = 
-            m_surfaces[index1].mobod->getBodyTransform(state)
-                * m_surfaces[index1].X_BS;
         const ContactGeometry& geom1 = m_surfaces[index1].surface->getShape();
         const ContactGeometryTypeId typeId1 = geom1.getTypeId();
 
@@ -421,61 +676,132 @@ void ensureActiveContactsUpdated(const State& state) const {
         ContactSurfaceSet::const_iterator q = others.begin();
         for (; q != others.end(); ++q) {
             const ContactSurfaceIndex index2 = q->first;
-            const Transform transform2 = 
-                m_surfaces[index2].mobod->getBodyTransform(state)
-                    * m_surfaces[index2].X_BS;
             const ContactGeometry& geom2 = 
                 m_surfaces[index2].surface->getShape();
             const ContactGeometryTypeId typeId2 = geom2.getTypeId();
             if (!hasContactTracker(typeId1,typeId2))
                 continue; // No algorithm available for detecting collisions between these two objects.
             bool mustReverse;
-            const ContactTracker& tracker = 
-                getContactTracker(typeId1, typeId2, mustReverse);
+            work.push_back(NarrowPhasePair());
+            NarrowPhasePair& pair = work.back();
+            pair.tracker = &getContactTracker(typeId1, typeId2, mustReverse);
 
             // Put the surfaces in the order required by the tracker.
-            const ContactSurfaceIndex trackSurf1 = (mustReverse? index2:index1);
-            const ContactSurfaceIndex trackSurf2 = (mustReverse? index1:index2);
-
-            UntrackedContact untracked; // empty handle in case we need it
-            const Contact* prev = q->second;
-            if (prev && prev->getCondition() == Contact::Broken)
-                prev = 0; // that contact expired
-            if (!prev) { 
-                untracked = UntrackedContact(trackSurf1, trackSurf2);
-                prev = &untracked;
-            }
-            Contact next; // empty handle
-            if (mustReverse)
-                tracker.trackContact
-                   (*prev, transform2,geom2, transform1,geom1, 0/*TODO*/, next);
-            else
-                tracker.trackContact
-                   (*prev, transform1,geom1, transform2,geom2, 0/*TODO*/, next);
-
-            if (!next.isEmpty()) {
-                next.setSurfaces(trackSurf1,trackSurf2);
-                next.setContactId(prev->getCondition()==Contact::Untracked
-                                    ? Contact::createNewContactId()
-                                    : prev->getContactId()); // persistent
-                if (   prev->getCondition()==Contact::Untracked
-                    || prev->getCondition()==Contact::Anticipated)
-                    next.setCondition(Contact::NewContact);
-                else { // was NewContact or Ongoing; now Ongoing or Broken
-                    assert(prev->getCondition()==Contact::NewContact
-                           || prev->getCondition()==Contact::Ongoing);
-                    if (next.getTypeId() != BrokenContact::classTypeId())
-                        next.setCondition(Contact::Ongoing);
-                    // Condition will already by Broken for a BrokenContact
-                }
-                nextActive.adoptContact(next);
-            }
+            pair.trackSurf1 = (mustReverse? index2:index1);
+            pair.trackSurf2 = (mustReverse? index1:index2);
+
+            pair.prev = q->second;
+            if (pair.prev && pair.prev->getCondition() == Contact::Broken)
+                pair.prev = 0; // that contact expired
+            pair.cost = estimateTrackingCost(geom1, geom2);
         }
     }
 
+    // Track each pair; this is the expensive part and the pairs are
+    // independent so they can be spread over threads.
+    const std::function<void(NarrowPhasePair&)> track = 
+        [&](NarrowPhasePair& pair) {trackPair(state, pair);};
+    Array_<Array_<int,int>,int> bins;
+    assignPairsToBins(work, bins);
+    if (bins.size() > 1) {
+        NarrowPhaseTask task(track, work, bins);
+        m_narrowPhaseExecutor->execute(task, bins.size());
+    } else
+        for (NarrowPhasePair& pair : work)
+            track(pair);
+
+    // Merge the results serially, in pair order, so that ContactIds are
+    // assigned deterministically.
+    for (NarrowPhasePair& pair : work) {
+        Contact& next = pair.next;
+        if (next.isEmpty())
+            continue;
+        const Contact::Condition prevCondition = 
+            pair.prev ? pair.prev->getCondition() : Contact::Untracked;
+        next.setSurfaces(pair.trackSurf1,pair.trackSurf2);
+        next.setContactId(prevCondition==Contact::Untracked
+                            ? Contact::createNewContactId()
+                            : pair.prev->getContactId()); // persistent
+        if (   prevCondition==Contact::Untracked
+            || prevCondition==Contact::Anticipated)
+            next.setCondition(Contact::NewContact);
+        else { // was NewContact or Ongoing; now Ongoing or Broken
+            assert(prevCondition==Contact::NewContact
+                   || prevCondition==Contact::Ongoing);
+            if (next.getTypeId() != BrokenContact::classTypeId())
+                next.setCondition(Contact::Ongoing);
+            // Condition will already by Broken for a BrokenContact
+        }
+        nextActive.adoptContact(next);
+    }
+
     markDiscreteVarUpdateValueRealized(state, m_activeContactsIx);
 }
 
+// Run the narrow phase tracker for one candidate pair, leaving the result
+// (possibly empty) in pair.next. This touches nothing else so may be called
+// concurrently for different pairs.
+void trackPair(const State& state, NarrowPhasePair& pair) const {
+    const Surface& surf1 = m_surfaces[pair.trackSurf1];
+    const Surface& surf2 = m_surfaces[pair.trackSurf2];
+    const Transform transform1 = 
+        surf1.mobod->getBodyTransform(state) * surf1.X_BS;
+    const Transform transform2 = 
+        surf2.mobod->getBodyTransform(state) * surf2.X_BS;
+
+    UntrackedContact untracked; // empty handle in case we need it
+    const Contact* prev = pair.prev;
+    if (!prev) { 
+        untracked = UntrackedContact(pair.trackSurf1, pair.trackSurf2);
+        prev = &untracked;
+    }
+    pair.tracker->trackContact
+       (*prev, transform1,surf1.surface->getShape(), 
+               transform2,surf2.surface->getShape(), 0/*TODO*/, pair.next);
+}
+
+// Divide the narrow phase pairs into one bin per thread, balancing the
+// estimated cost with a greedy longest-processing-time assignment: consider
+// the pairs from most to least expensive, putting each into the bin with the
+// least total cost so far. Leaves a single bin if the work isn't worth
+// dividing up.
+void assignPairsToBins(const Array_<NarrowPhasePair,int>& pairs,
+                       Array_<Array_<int,int>,int>& bins) const {
+    bins.clear();
+    const int numThreads = m_narrowPhaseExecutor->getMaxThreads();
+    const int numPairs = pairs.size();
+    if (numThreads < 2 || numPairs < 2 || ParallelExecutor::isWorkerThread())
+        return;
+
+    Array_<int,int> order(numPairs);
+    for (int i=0; i < numPairs; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+                     {   return pairs[a].cost > pairs[b].cost; });
+
+    const int numBins = std::min(numThreads, numPairs);
+    bins.resize(numBins);
+    Array_<double,int> binCost(numBins, 0.);
+    for (int i : order) {
+        int lightest = 0;
+        for (int b=1; b < numBins; ++b)
+            if (binCost[b] < binCost[lightest])
+                lightest = b;
+        bins[lightest].push_back(i);
+        binCost[lightest] += pairs[i].cost;
+    }
+}
+
+void setNumberOfThreads(unsigned numThreads) {
+    SimTK_APIARGCHECK_ALWAYS(numThreads > 0, "ContactTrackerSubsystem",
+        "setNumberOfThreads", "Number of threads must be positive.");
+    m_narrowPhaseExecutor = new ParallelExecutor(numThreads);
+}
+
+int getNumberOfThreads() const {
+    return m_narrowPhaseExecutor->getMaxThreads();
+}
+
 // Call this any time after accelerations are known, to ensure that the
 // predicted contact set has been updated for new velocities and accelerations.
 // We can use three sources of information to compute the update:
@@ -581,6 +907,10 @@ friend class ContactTrackerSubsystem;
 // delete it when replacing or destructing.
 TrackerMap          m_contactTrackers;
 ContactTracker*     m_defaultTracker;
+ContactTrackerSubsystem::BroadPhaseMethod   
+                    m_broadPhaseMethod;
+mutable ClonePtr<ParallelExecutor>
+                    m_narrowPhaseExecutor;
 
     // TOPOLOGY CACHE
 // The pair is the first assigned index, and the number of contact surfaces
@@ -591,6 +921,7 @@ Array_<Surface,ContactSurfaceIndex>     m_surfaces;
 Array_<Bubble,BubbleIndex>              m_bubbles;
 DiscreteVariableIndex                   m_activeContactsIx;
 DiscreteVariableIndex                   m_predictedContactsIx;
+CacheEntryIndex                         m_sweepAndPruneIx;
 };
 
 } // namespace SimTK
@@ -669,6 +1000,22 @@ getContactTracker(ContactGeometryTypeId surface1,
                   bool& reverseOrder) const
 {   return getImpl().getContactTracker(surface1,surface2,reverseOrder); }
 
+void ContactTrackerSubsystem::
+setBroadPhaseMethod(BroadPhaseMethod method)
+{   updImpl().setBroadPhaseMethod(method); }
+
+ContactTrackerSubsystem::BroadPhaseMethod ContactTrackerSubsystem::
+getBroadPhaseMethod() const
+{   return getImpl().getBroadPhaseMethod(); }
+
+void ContactTrackerSubsystem::
+setNumberOfThreads(unsigned numThreads)
+{   updImpl().setNumberOfThreads(numThreads); }
+
+int ContactTrackerSubsystem::
+getNumberOfThreads() const
+{   return getImpl().getNumberOfThreads(); }
+
 const ContactSnapshot& ContactTrackerSubsystem::
 getPreviousActiveContacts(const State& state) const
 {   return getImpl().getPrevActiveContacts(state); }
@@ -0,0 +1,123 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simbody/internal/common.h"
+#include "simbody/internal/DelassusOperator.h"
+
+namespace SimTK {
+
+void DelassusOperator::clear(int m) {
+    SimTK_APIARGCHECK1_ALWAYS(m >= 0, "DelassusOperator", "clear",
+        "Illegal dimension %d.", m);
+    m_size = m;
+    m_blockMults.clear();
+    m_blocks.clear();
+    m_rowEntries.clear();
+    m_rowEntries.resize(m);
+    m_diag.resize(m);
+    m_diag.setToZero();
+    m_denseIsValid = false;
+}
+
+void DelassusOperator::
+addBlock(const Array_<MultiplierIndex>& mults, const Matrix& block) {
+    const int k = (int)mults.size();
+    SimTK_APIARGCHECK2_ALWAYS(block.nrow()==k && block.ncol()==k,
+        "DelassusOperator", "addBlock",
+        "Block must be %dx%d to match the multiplier list.", k, k);
+
+    const int b = (int)m_blocks.size();
+    m_blockMults.push_back(mults);
+    m_blocks.push_back(Matrix(k, k)); // transposed copy; see header
+    Matrix& blockT = m_blocks.back();
+    for (int j=0; j < k; ++j)
+        for (int i=0; i < k; ++i)
+            blockT(j,i) = block(i,j);
+    for (int i=0; i < k; ++i) {
+        const MultiplierIndex mx = mults[i];
+        SimTK_APIARGCHECK2_ALWAYS(0 <= mx && mx < m_size,
+            "DelassusOperator", "addBlock",
+            "Multiplier index %d out of range 0..%d.", (int)mx, m_size-1);
+        m_rowEntries[mx].push_back(RowEntry(b, i));
+        m_diag[mx] += block(i,i);
+    }
+    m_denseIsValid = false;
+}
+
+int DelassusOperator::getNumStoredEntries() const {
+    int n = 0;
+    for (unsigned b=0; b < m_blocks.size(); ++b)
+        n += m_blocks[b].nrow() * m_blocks[b].ncol();
+    return n;
+}
+
+Real DelassusOperator::multiplyRow(MultiplierIndex i, const Vector& x) const {
+    assert(x.size() == m_size);
+    assert(x.hasContiguousData());
+    const Real* xp = &x[0];
+    const Array_<RowEntry>& entries = m_rowEntries[i];
+    Real sum = 0;
+    for (unsigned e=0; e < entries.size(); ++e) {
+        const Array_<MultiplierIndex>& mults = m_blockMults[entries[e].block];
+        const Real* row = &m_blocks[entries[e].block](0, entries[e].local);
+        for (unsigned c=0; c < mults.size(); ++c)
+            sum += row[c] * xp[mults[c]];
+    }
+    return sum;
+}
+
+void DelassusOperator::multiply(const Vector& x, Vector& Ax) const {
+    assert(x.size() == m_size);
+    Ax.resize(m_size);
+    Ax.setToZero();
+    for (unsigned b=0; b < m_blocks.size(); ++b) {
+        const Array_<MultiplierIndex>& mults = m_blockMults[b];
+        const Matrix& blockT = m_blocks[b];
+        for (unsigned r=0; r < mults.size(); ++r) {
+            const Real* row = &blockT(0, r);
+            Real sum = 0;
+            for (unsigned c=0; c < mults.size(); ++c)
+                sum += row[c] * x[mults[c]];
+            Ax[mults[r]] += sum;
+        }
+    }
+}
+
+const Matrix& DelassusOperator::getAsDenseMatrix() const {
+    if (m_denseIsValid)
+        return m_dense;
+    m_dense.resize(m_size, m_size);
+    m_dense.setToZero();
+    for (unsigned b=0; b < m_blocks.size(); ++b) {
+        const Array_<MultiplierIndex>& mults = m_blockMults[b];
+        const Matrix& blockT = m_blocks[b];
+        for (unsigned j=0; j < mults.size(); ++j)
+            for (unsigned i=0; i < mults.size(); ++i)
+                m_dense(mults[i], mults[j]) += blockT(j,i);
+    }
+    m_denseIsValid = true;
+    return m_dense;
+}
+
+} // namespace SimTK
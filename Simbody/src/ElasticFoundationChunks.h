@@ -0,0 +1,89 @@
+#ifndef SimTK_SIMBODY_ELASTIC_FOUNDATION_CHUNKS_H_
+#define SimTK_SIMBODY_ELASTIC_FOUNDATION_CHUNKS_H_
+
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* This internal header is shared by the two elastic foundation models,
+ElasticFoundationForce and CompliantContactSubsystem's ElasticFoundation
+generator. Both evaluate the springs of one contact in chunks that can run
+on a ParallelExecutor. */
+
+#include "SimTKcommon.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace SimTK {
+
+/* The springs are evaluated in chunks of this many, each summed separately.
+The chunk size is fixed so that the results don't depend on the number of
+threads, as long as the caller combines the chunk sums in order. */
+static const int ElasticFoundationChunkSize = 256;
+
+/* Each task index evaluates one chunk of springs. */
+class ElasticFoundationChunkTask : public ParallelExecutor::Task {
+public:
+    explicit ElasticFoundationChunkTask
+       (const std::function<void(int)>& evaluate) : evaluate(evaluate) {}
+    void execute(int chunk) override {evaluate(chunk);}
+private:
+    const std::function<void(int)>& evaluate;
+};
+
+/* Divide nSprings springs into chunks, resize chunkSums to have one default-
+constructed Sums per chunk, and call evaluate(sums, first, last) for each
+chunk to accumulate springs [first,last) into that chunk's sums. The chunks
+are run on the executor if there is more than one of them, the caller allows
+it, and we aren't already on one of an executor's worker threads; otherwise
+they are run in order on this thread. */
+template <class Sums, class Evaluate>
+void evaluateElasticFoundationChunks
+   (ParallelExecutor& executor, bool allowParallel, int nSprings,
+    Array_<Sums>& chunkSums, const Evaluate& evaluate)
+{
+    const int nChunks =
+        (nSprings + ElasticFoundationChunkSize-1) / ElasticFoundationChunkSize;
+    chunkSums.clear();
+    chunkSums.resize(nChunks);
+
+    std::function<void(int)> evaluateChunk = [&](int chunk) {
+        const int first = chunk*ElasticFoundationChunkSize;
+        const int last  =
+            std::min(first + ElasticFoundationChunkSize, nSprings);
+        evaluate(chunkSums[chunk], first, last);
+    };
+
+    if (allowParallel && nChunks > 1 && executor.getMaxThreads() > 1
+        && !ParallelExecutor::isWorkerThread()) {
+        ElasticFoundationChunkTask task(evaluateChunk);
+        executor.execute(task, nChunks);
+    } else {
+        for (int chunk=0; chunk < nChunks; ++chunk)
+            evaluateChunk(chunk);
+    }
+}
+
+} // namespace SimTK
+
+#endif // SimTK_SIMBODY_ELASTIC_FOUNDATION_CHUNKS_H_
@@ -27,6 +27,7 @@
 #include "simbody/internal/GeneralContactSubsystem.h"
 #include "simbody/internal/MobilizedBody.h"
 #include "ElasticFoundationForceImpl.h"
+#include "ElasticFoundationChunks.h"
 #include <map>
 #include <set>
 
@@ -53,9 +54,24 @@ void ElasticFoundationForce::setTransitionVelocity(Real v) {
     updImpl().transitionVelocity = v;
 }
 
+void ElasticFoundationForce::setNumberOfThreads(unsigned numThreads) {
+    updImpl().setNumberOfThreads(numThreads);
+}
+
+int ElasticFoundationForce::getNumberOfThreads() const {
+    return getImpl().getNumberOfThreads();
+}
+
 ElasticFoundationForceImpl::ElasticFoundationForceImpl
    (GeneralContactSubsystem& subsystem, ContactSetIndex set) : 
-        subsystem(subsystem), set(set), transitionVelocity(Real(0.01)) {
+        subsystem(subsystem), set(set), transitionVelocity(Real(0.01)),
+        executor(new ParallelExecutor(1)) {
+}
+
+void ElasticFoundationForceImpl::setNumberOfThreads(unsigned numThreads) {
+    SimTK_APIARGCHECK_ALWAYS(numThreads > 0, "ElasticFoundationForce",
+        "setNumberOfThreads", "Number of threads must be positive.");
+    executor = new ParallelExecutor(numThreads);
 }
 
 void ElasticFoundationForceImpl::setBodyParameters
@@ -70,22 +86,6 @@ void ElasticFoundationForceImpl::setBodyParameters
     parameters[bodyIndex] = 
         Parameters(stiffness, dissipation, staticFriction, dynamicFriction, 
                    viscousFriction);
-    const ContactGeometry::TriangleMesh& mesh = 
-        ContactGeometry::TriangleMesh::getAs
-                (subsystem.getBodyGeometry(set, bodyIndex));
-    Parameters& param = parameters[bodyIndex];
-    param.springPosition.resize(mesh.getNumFaces());
-    param.springNormal.resize(mesh.getNumFaces());
-    param.springArea.resize(mesh.getNumFaces());
-    Vec2 uv(Real(1./3.), Real(1./3.));
-    for (int i = 0; i < (int) param.springPosition.size(); i++) {
-        param.springPosition[i] = 
-           (mesh.getVertexPosition(mesh.getFaceVertex(i, 0))
-            +mesh.getVertexPosition(mesh.getFaceVertex(i, 1))
-            +mesh.getVertexPosition(mesh.getFaceVertex(i, 2)))/3;
-        param.springNormal[i] = -mesh.findNormalAtPoint(i, uv);
-        param.springArea[i] = mesh.getFaceArea(i);
-    }
     subsystem.invalidateSubsystemTopologyCache();
 }
 
@@ -125,6 +125,16 @@ void ElasticFoundationForceImpl::calcForce
     }
 }
 
+namespace {
+// The contributions of one chunk of springs: the forces on the two bodies,
+// in Ground and about their origins, and the potential energy.
+struct SpringChunkSums {
+    SpatialVec  force1 = SpatialVec(Vec3(0), Vec3(0));
+    SpatialVec  force2 = SpatialVec(Vec3(0), Vec3(0));
+    Real        pe = 0;
+};
+} // anonymous namespace
+
 void ElasticFoundationForceImpl::processContact
    (const State& state, 
     ContactSurfaceIndex meshIndex, ContactSurfaceIndex otherBodyIndex, 
@@ -132,64 +142,93 @@ void ElasticFoundationForceImpl::processContact
     Real areaScale, Vector_<SpatialVec>& bodyForces, Real& pe) const 
 {
     const ContactGeometry& otherObject = subsystem.getBodyGeometry(set, otherBodyIndex);
+    // A spring is placed at the centroid of each face of the mesh.
+    const ContactGeometry::TriangleMesh& mesh = 
+        ContactGeometry::TriangleMesh::getAs(subsystem.getBodyGeometry(set, meshIndex));
+    const Array_<Vec3>& springPosition = mesh.getFaceCentroids();
+    const Array_<Real>& springArea = mesh.getFaceAreas();
     const MobilizedBody& body1 = subsystem.getBody(set, meshIndex);
     const MobilizedBody& body2 = subsystem.getBody(set, otherBodyIndex);
     const Transform t1g = body1.getBodyTransform(state)*subsystem.getBodyTransform(set, meshIndex); // mesh to ground
     const Transform t2g = body2.getBodyTransform(state)*subsystem.getBodyTransform(set, otherBodyIndex); // other object to ground
     const Transform t12 = ~t2g*t1g; // mesh to other object
+    const Rotation& R1 = body1.getBodyRotation(state);
+    const Rotation& R2 = body2.getBodyRotation(state);
+
+    // Divide the springs into chunks that can be evaluated independently.
+
+    const Array_<int> faces(insideFaces.begin(), insideFaces.end());
+    const int nSprings = (int) faces.size();
+    Array_<SpringChunkSums> chunkSums;
 
-    // Loop over all the springs, and evaluate the force from each one.
+    // Loop over the springs in a chunk, and evaluate the force from each one.
 
-    for (std::set<int>::const_iterator iter = insideFaces.begin(); 
-                                       iter != insideFaces.end(); ++iter) {
-        int face = *iter;
-        UnitVec3 normal;
-        bool inside;
-        Vec3 nearestPoint = otherObject.findNearestPoint(t12*param.springPosition[face], inside, normal);
-        if (!inside)
-            continue;
+    auto evaluateChunk = [&](SpringChunkSums& sums, int first, int last) {
+        for (int i = first; i < last; ++i) {
+            int face = faces[i];
+            UnitVec3 normal;
+            bool inside;
+            Vec3 nearestPoint = otherObject.findNearestPoint(t12*springPosition[face], inside, normal);
+            if (!inside)
+                continue;
         
-        // Find how much the spring is displaced.
+            // Find how much the spring is displaced.
         
-        nearestPoint = t2g*nearestPoint;
-        const Vec3 springPosInGround = t1g*param.springPosition[face];
-        const Vec3 displacement = nearestPoint-springPosInGround;
-        const Real distance = displacement.norm();
-        if (distance == 0.0)
-            continue;
-        const Vec3 forceDir = displacement/distance;
+            nearestPoint = t2g*nearestPoint;
+            const Vec3 springPosInGround = t1g*springPosition[face];
+            const Vec3 displacement = nearestPoint-springPosInGround;
+            const Real distance = displacement.norm();
+            if (distance == 0.0)
+                continue;
+            const Vec3 forceDir = displacement/distance;
         
-        // Calculate the relative velocity of the two bodies at the contact point.
+            // Calculate the relative velocity of the two bodies at the contact point.
         
-        const Vec3 station1 = body1.findStationAtGroundPoint(state, nearestPoint);
-        const Vec3 station2 = body2.findStationAtGroundPoint(state, nearestPoint);
-        const Vec3 v1 = body1.findStationVelocityInGround(state, station1);
-        const Vec3 v2 = body2.findStationVelocityInGround(state, station2);
-        const Vec3 v = v2-v1;
-        const Real vnormal = dot(v, forceDir);
-        const Vec3 vtangent = v-vnormal*forceDir;
+            const Vec3 station1 = body1.findStationAtGroundPoint(state, nearestPoint);
+            const Vec3 station2 = body2.findStationAtGroundPoint(state, nearestPoint);
+            const Vec3 v1 = body1.findStationVelocityInGround(state, station1);
+            const Vec3 v2 = body2.findStationVelocityInGround(state, station2);
+            const Vec3 v = v2-v1;
+            const Real vnormal = dot(v, forceDir);
+            const Vec3 vtangent = v-vnormal*forceDir;
         
-        // Calculate the damping force.
+            // Calculate the damping force.
         
-        const Real area = areaScale * param.springArea[face];
-        const Real f = param.stiffness*area*distance*(1+param.dissipation*vnormal);
-        Vec3 force = (f > 0 ? f*forceDir : Vec3(0));
+            const Real area = areaScale * springArea[face];
+            const Real f = param.stiffness*area*distance*(1+param.dissipation*vnormal);
+            Vec3 force = (f > 0 ? f*forceDir : Vec3(0));
         
-        // Calculate the friction force.
+            // Calculate the friction force.
         
-        const Real vslip = vtangent.norm();
-        if (f > 0 && vslip != 0) {
-            const Real vrel = vslip/transitionVelocity;
-            const Real ffriction = 
-                f*(std::min(vrel, Real(1))
-                 *(param.dynamicFriction+2*(param.staticFriction-param.dynamicFriction)
-                 /(1+vrel*vrel))+param.viscousFriction*vslip);
-            force += ffriction*vtangent/vslip;
+            const Real vslip = vtangent.norm();
+            if (f > 0 && vslip != 0) {
+                const Real vrel = vslip/transitionVelocity;
+                const Real ffriction = 
+                    f*(std::min(vrel, Real(1))
+                     *(param.dynamicFriction+2*(param.staticFriction-param.dynamicFriction)
+                     /(1+vrel*vrel))+param.viscousFriction*vslip);
+                force += ffriction*vtangent/vslip;
+            }
+
+            sums.force1 += SpatialVec((R1*station1) % force, force);
+            sums.force2 -= SpatialVec((R2*station2) % force, force);
+            sums.pe += param.stiffness*area*displacement.normSqr()/2;
         }
+    };
+
+    // The chunks can be evaluated concurrently unless the other object can't
+    // be queried from several threads at once.
+
+    evaluateElasticFoundationChunks(*executor,
+        !ContactGeometry::SmoothHeightMap::isInstance(otherObject),
+        nSprings, chunkSums, evaluateChunk);
+
+    // Apply the chunks' forces in order.
 
-        body1.applyForceToBodyPoint(state, station1, force, bodyForces);
-        body2.applyForceToBodyPoint(state, station2, -force, bodyForces);
-        pe += param.stiffness*area*displacement.normSqr()/2;
+    for (const SpringChunkSums& sums : chunkSums) {
+        bodyForces[body1.getMobilizedBodyIndex()] += sums.force1;
+        bodyForces[body2.getMobilizedBodyIndex()] += sums.force2;
+        pe += sums.pe;
     }
 }
 
@@ -42,6 +42,8 @@ public:
     void setBodyParameters
        (ContactSurfaceIndex bodyIndex, Real stiffness, Real dissipation, 
         Real staticFriction, Real dynamicFriction, Real viscousFriction);
+    void setNumberOfThreads(unsigned numThreads);
+    int getNumberOfThreads() const {return executor->getMaxThreads();}
     void calcForce(const State& state, Vector_<SpatialVec>& bodyForces, 
                    Vector_<Vec3>& particleForces, Vector& mobilityForces) const override;
     Real calcPotentialEnergy(const State& state) const override;
@@ -58,6 +60,8 @@ private:
     const ContactSetIndex set;
     std::map<ContactSurfaceIndex, Parameters> parameters;
     Real transitionVelocity;
+    // Used to evaluate the springs of a contact in parallel chunks.
+    mutable ClonePtr<ParallelExecutor> executor;
     mutable CacheEntryIndex energyCacheIndex;
 };
 
@@ -69,9 +73,6 @@ public:
             stiffness(stiffness), dissipation(dissipation), staticFriction(staticFriction), dynamicFriction(dynamicFriction), viscousFriction(viscousFriction) {
     }
     Real stiffness, dissipation, staticFriction, dynamicFriction, viscousFriction;
-    Array_<Vec3> springPosition;
-    Array_<UnitVec3> springNormal;
-    Array_<Real> springArea;
 };
 
 } // namespace SimTK
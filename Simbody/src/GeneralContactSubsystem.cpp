@@ -38,6 +38,23 @@ std::ostream& operator<<(std::ostream& o, const Array_<Array_<Contact> >&) {
     return o;
 }
 
+// Persistent data for the sweep of one contact set: the order of the bodies
+// along the sweep axis the last time contacts were found, which is used to
+// warm start the next sort, and statistics about that sweep.
+class ContactSetSweep {
+public:
+    ContactSetSweep() : axis(-1), numPairsTested(0), numPairsKept(0) {}
+    int                                 axis;
+    Array_<ContactSurfaceIndex>         order;
+    int                                 numPairsTested, numPairsKept;
+};
+
+// Useless, but required by Value<T>.
+std::ostream& operator<<(std::ostream& o, const Array_<ContactSetSweep>&) {
+    assert(false);
+    return o;
+}
+
 class ContactSet {
 public:
     Array_<MobilizedBody,ContactSurfaceIndex>   bodies;
@@ -64,7 +81,7 @@ public:
 //==============================================================================
 class GeneralContactSubsystemImpl : public Subsystem::Guts {
 public:
-    GeneralContactSubsystemImpl() {}
+    GeneralContactSubsystemImpl() : useWarmStart(true) {}
 
     GeneralContactSubsystemImpl* cloneImpl() const override {
         return new GeneralContactSubsystemImpl(*this);
@@ -133,9 +150,26 @@ public:
         return contacts[set];
     }
     
+    int getNumPairsTested(const State& state, ContactSetIndex set) const {
+        return getSweep(state, set, "GeneralContactSubsystemImpl::getNumPairsTested()").numPairsTested;
+    }
+
+    int getNumPairsKept(const State& state, ContactSetIndex set) const {
+        return getSweep(state, set, "GeneralContactSubsystemImpl::getNumPairsKept()").numPairsKept;
+    }
+
+    void setUseWarmStart(bool warmStart) {
+        useWarmStart = warmStart;
+    }
+
+    bool getUseWarmStart() const {
+        return useWarmStart;
+    }
+    
     int realizeSubsystemTopologyImpl(State& state) const override {
         contactsCacheIndex = state.allocateCacheEntry(getMySubsystemIndex(), Stage::Dynamics, new Value<Array_<Array_<Contact> > >());
         contactsValidCacheIndex = state.allocateCacheEntry(getMySubsystemIndex(), Stage::Position, new Value<bool>());
+        sweepCacheIndex = allocateLazyCacheEntry(state, Stage::Position, new Value<Array_<ContactSetSweep> >());
         for (int i = 0; i < (int) sets.size(); ++i) {
             const ContactSet& set = sets[i];
             int numBodies = set.bodies.size();
@@ -159,8 +193,12 @@ public:
         if (contactsValid)
             return 0;
         Array_<Array_<Contact> >& contacts = Value<Array_<Array_<Contact> > >::updDowncast(updCacheEntry(state, contactsCacheIndex)).upd();
+        // The sweeps are recomputed along with the contacts, but whatever they held from the
+        // last evaluation is still there to warm start the sort, even though it is out of date.
+        Array_<ContactSetSweep>& sweeps = Value<Array_<ContactSetSweep> >::updDowncast(updCacheEntry(state, sweepCacheIndex)).upd();
         int numSets = getNumContactSets();
         contacts.resize(numSets);
+        sweeps.resize(numSets);
         
         // Loop over all contact sets.
         
@@ -183,12 +221,24 @@ public:
             if (var[2] > var[axis])
                 axis = 2;
             
-            // Find the extent of each body along the axis and sort them by starting location.
+            // Find the extent of each body along the axis and sort them by starting location.  Between
+            // time steps the order barely changes, so if we sorted along the same axis last time we start
+            // from that order and finish with an insertion sort.
             
+            ContactSetSweep& sweep = sweeps[setIndex];
+            const bool warmStart = useWarmStart && sweep.axis == axis && (int) sweep.order.size() == numBodies;
             Array_<ContactBodyExtent> extents(numBodies);
-            for (ContactSurfaceIndex i(0); i < numBodies; i++)
-                extents[i] = ContactBodyExtent(centers[i][axis]-set.sphereRadii[i], centers[i][axis]+set.sphereRadii[i], i);
-            std::sort(extents.begin(), extents.end());
+            for (ContactSurfaceIndex i(0); i < numBodies; i++) {
+                const ContactSurfaceIndex index = (warmStart ? sweep.order[i] : i);
+                extents[i] = ContactBodyExtent(centers[index][axis]-set.sphereRadii[index], centers[index][axis]+set.sphereRadii[index], index);
+            }
+            if (!warmStart || !insertionSort(extents))
+                std::sort(extents.begin(), extents.end());
+            sweep.axis = axis;
+            sweep.order.resize(numBodies);
+            for (int i = 0; i < numBodies; i++)
+                sweep.order[i] = extents[i].index;
+            sweep.numPairsTested = sweep.numPairsKept = 0;
             
             // Now sweep along the axis, finding potential contacts.
             
@@ -202,9 +252,11 @@ public:
                     
                     const ContactSurfaceIndex index2 = extents[j].index;
                     const Real sumRadius = set.sphereRadii[index1]+set.sphereRadii[index2];
+                    ++sweep.numPairsTested;
                     if ((centers[index1]-centers[index2]).normSqr() <= sumRadius*sumRadius) {
                         // Do a full collision detection.
 
+                        ++sweep.numPairsKept;
                         const Transform transform2 = set.bodies[index2].getBodyTransform(state)*set.transforms[index2];
                         const ContactGeometry& geom2 = set.geometry[index2];
                         const ContactGeometryTypeId typeId2 = geom2.getTypeId();
@@ -230,16 +282,47 @@ public:
             }
         }
         contactsValid = true;
+        markCacheValueRealized(state, sweepCacheIndex);
         return 0;
     }
 
     SimTK_DOWNCAST(GeneralContactSubsystemImpl, Subsystem::Guts);
 
 private:
+    const ContactSetSweep& getSweep(const State& state, ContactSetIndex set, const char* methodName) const {
+        assert(set >= 0 && set < sets.size());
+        SimTK_STAGECHECK_GE_ALWAYS(state.getSubsystemStage(getMySubsystemIndex()), Stage::Dynamics, methodName);
+        const Array_<ContactSetSweep>& sweeps = Value<Array_<ContactSetSweep> >::downcast(getCacheEntry(state, sweepCacheIndex)).get();
+        return sweeps[set];
+    }
+
+    // Sort extents that are expected to be almost in order already. If that turns out not to be the
+    // case, give up once the work done exceeds what a full sort would cost and return false; the
+    // extents are then left in some intermediate order.
+    static bool insertionSort(Array_<ContactBodyExtent>& extents) {
+        const int n = extents.size();
+        long long budget = 8*(long long) n + 64;
+        for (int i = 1; i < n; i++) {
+            const ContactBodyExtent extent = extents[i];
+            int j = i-1;
+            for (; j >= 0 && extent < extents[j]; j--) {
+                extents[j+1] = extents[j];
+                if (--budget < 0) {
+                    extents[j] = extent;
+                    return false;
+                }
+            }
+            extents[j+1] = extent;
+        }
+        return true;
+    }
+
     Array_<ContactSet>      sets;
+    bool                    useWarmStart;
 
     mutable CacheEntryIndex contactsCacheIndex;
     mutable CacheEntryIndex contactsValidCacheIndex;
+    mutable CacheEntryIndex sweepCacheIndex;
 };
 
 
@@ -287,6 +370,22 @@ const Array_<Contact>& GeneralContactSubsystem::getContacts(const State& state,
     return getImpl().getContacts(state, set);
 }
 
+int GeneralContactSubsystem::getNumPairsTested(const State& state, ContactSetIndex set) const {
+    return getImpl().getNumPairsTested(state, set);
+}
+
+int GeneralContactSubsystem::getNumPairsKept(const State& state, ContactSetIndex set) const {
+    return getImpl().getNumPairsKept(state, set);
+}
+
+void GeneralContactSubsystem::setUseWarmStart(bool warmStart) {
+    updImpl().setUseWarmStart(warmStart);
+}
+
+bool GeneralContactSubsystem::getUseWarmStart() const {
+    return getImpl().getUseWarmStart();
+}
+
 bool GeneralContactSubsystem::isInstanceOf(const Subsystem& s) {
     return GeneralContactSubsystemImpl::isA(s.getSubsystemGuts());
 }
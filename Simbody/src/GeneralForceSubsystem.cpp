@@ -39,7 +39,9 @@
 
 #include "ForceImpl.h"
 
+#include <atomic>
 #include <memory>
+#include <typeinfo>
 
 //Threading constants used by CalcForcesTask
 namespace {
@@ -81,7 +83,15 @@ public:
             Vector_<SpatialVec>& rigidBodyForces,
             Vector_<Vec3>& particleForces,
             Vector& mobilityForces) = 0;
-    
+
+    // A task holds pointers into the State it is calculating forces for, so
+    // it can be used by only one realization at a time. tryAcquire() returns
+    // false if some other realization is already using this task.
+    bool tryAcquire() {return !m_inUse.exchange(true);}
+    void release() {m_inUse = false;}
+
+private:
+    std::atomic<bool> m_inUse{false};
 };
 /*Calculates each enabled force's contribution in the MultibodySystem.
 CalcForcesParallelTask allows force calculations to occur in parallel with
@@ -516,6 +526,39 @@ private:
     Vector m_mobilityForceCacheLocal;
 };
 
+/* Provides the task to be used by one realization of the Dynamics stage, and
+gives it back on destruction. That is the subsystem's own task unless another
+realization is using it, as happens when System::realizeBatch() realizes
+several States at once. Then a copy kept for this thread is used instead, or
+a new one if that is in use too. */
+class CalcForcesTaskLease {
+public:
+    explicit CalcForcesTaskLease(CalcForcesTask& shared) {
+        if (shared.tryAcquire()) {
+            m_task = &shared;
+            return;
+        }
+        static thread_local ClonePtr<CalcForcesTask> spare;
+        if (spare.empty()
+            || (typeid(*spare) != typeid(shared) && spare->tryAcquire()))
+            spare.reset(shared.clone());
+        if (typeid(*spare) == typeid(shared) && spare->tryAcquire()) {
+            m_task = &spare.updRef();
+            return;
+        }
+        m_ownTask.reset(shared.clone());
+        m_task = &m_ownTask.updRef();
+    }
+    ~CalcForcesTaskLease() {
+        if (m_ownTask.empty())
+            m_task->release();
+    }
+    CalcForcesTask& updTask() {return *m_task;}
+private:
+    CalcForcesTask*             m_task;
+    ClonePtr<CalcForcesTask>    m_ownTask;
+};
+
 } //namespace
 
 namespace SimTK{
@@ -825,15 +868,20 @@ public:
         Vector&                mobilityForces  =
                                     mbs.updMobilityForces (s, Stage::Dynamics);
 
+        // The task holds pointers into the State being realized, so each
+        // concurrent realization needs a task of its own.
+        CalcForcesTaskLease lease(calcForcesTask.updRef());
+        CalcForcesTask& calcTask = lease.updTask();
+
         // Short circuit if we're not doing any caching here. Note that we're
         // checking whether the *index* is valid (i.e. does the cache entry
         // exist?), not the contents.
         if (!cachedForcesAreValidCacheIndex.isValid()) {
             // Call calcForce() on all Forces, in parallel.
-            calcForcesTask->initializeAll(forces, s,
+            calcTask.initializeAll(forces, s,
                     enabledNonParallelForces, enabledParallelForces,
                     rigidBodyForces, particleForces, mobilityForces);
-            calcForcesExecutor->execute(calcForcesTask.updRef(),
+            calcForcesExecutor->execute(calcTask,
                           enabledParallelForces.size() + NumNonParallelThreads);
 
             // Allow forces to do their own realization, but wait until all
@@ -872,21 +920,21 @@ public:
 
             // Run through all the forces, accumulating directly into the
             // force arrays or indirectly into the cache as appropriate.
-            calcForcesTask->initializeCachedAndNonCached(forces, s,
+            calcTask.initializeCachedAndNonCached(forces, s,
                                 enabledNonParallelForces, enabledParallelForces,
                                 rigidBodyForces, particleForces, mobilityForces,
                                 rigidBodyForceCache, particleForceCache,
                                 mobilityForceCache);
-            calcForcesExecutor->execute(calcForcesTask.updRef(),
+            calcForcesExecutor->execute(calcTask,
                           enabledParallelForces.size() + NumNonParallelThreads);
             cachedForcesAreValid = true;
         } else {
             // Cache already valid; just need to do the non-cached ones (the
             // ones for which dependsOnlyOnPositions is false).
-            calcForcesTask->initializeNonCached(forces, s,
+            calcTask.initializeNonCached(forces, s,
                                enabledNonParallelForces, enabledParallelForces,
                                rigidBodyForces, particleForces, mobilityForces);
-            calcForcesExecutor->execute(calcForcesTask.updRef(),
+            calcForcesExecutor->execute(calcTask,
                           enabledParallelForces.size() + NumNonParallelThreads);
         }
 
@@ -0,0 +1,159 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simbody/internal/common.h"
+#include "simbody/internal/MassMatrixFactorization.h"
+
+namespace SimTK {
+
+void MassMatrixFactorization::setStructure(const Array_<int>& parent) {
+    const int n = (int)parent.size();
+    if (n == size()) {
+        int i = 0;
+        while (i < n && parent[i] == m_parent[i]) ++i;
+        if (i == n)
+            return; // same pattern as before
+    }
+
+    // The stored row of mobility i is the path from i to its root, so its
+    // length is one more than the length of its parent's row.
+    m_parent.resize(n);
+    m_rowStart.resize(n+1);
+    m_rowStart[0] = 0;
+    for (int i=0; i < n; ++i) {
+        const int p = parent[i];
+        SimTK_APIARGCHECK2_ALWAYS(-1 <= p && p < i,
+            "MassMatrixFactorization", "setStructure",
+            "Mobility %d has parent %d; each parent must precede its child.",
+            i, p);
+        m_parent[i] = p;
+        m_rowStart[i+1] = m_rowStart[i] + (p < 0 ? 1 : getRowLength(p)+1);
+    }
+    m_values.resize(m_rowStart[n]);
+    m_factor.resize(m_rowStart[n]);
+    m_isFactored = false;
+    ++m_numStructureChanges;
+}
+
+// Factor M = ~L D L working from the last mobility back to the first, so
+// that each mobility's row is complete before it is used to update those of
+// its ancestors. Row i of the ancestor is a suffix of the path stored in row
+// k, so both are traversed with contiguous accesses. See Featherstone, R.
+// "Efficient Factorization of the Joint-Space Inertia Matrix for Branched
+// Kinematic Trees", Int. J. Robotics Research 24(6):487-500 (2005).
+void MassMatrixFactorization::factor() {
+    const int n = size();
+    m_factor = m_values;
+    Real* F = m_factor.begin();
+
+    for (int k=n-1; k >= 0; --k) {
+        const int  len = getRowLength(k);
+        Real*      rowK = F + m_rowStart[k];
+        const Real Dk = rowK[0];
+        SimTK_ERRCHK1_ALWAYS(Dk > 0,
+            "MassMatrixFactorization::factor()",
+            "The mass matrix is not positive definite at mobility %d.", k);
+
+        int i = m_parent[k];
+        for (int p=1; p < len; ++p, i = m_parent[i]) {
+            const Real a = rowK[p] / Dk;
+            Real* rowI = F + m_rowStart[i];
+            for (int q=0; q < len-p; ++q)
+                rowI[q] -= a*rowK[p+q];
+            rowK[p] = a;
+        }
+    }
+    m_isFactored = true;
+}
+
+void MassMatrixFactorization::solve(const Vector& b, Vector& x) const {
+    const int n = size();
+    SimTK_ERRCHK_ALWAYS(m_isFactored, "MassMatrixFactorization::solve()",
+        "The matrix must be factored first.");
+    SimTK_APIARGCHECK2_ALWAYS(b.size() == n,
+        "MassMatrixFactorization", "solve",
+        "Right hand side has length %d but matrix has dimension %d.",
+        b.size(), n);
+    if (&x != &b)
+        x = b;
+    const Real* F = m_factor.begin();
+
+    // Solve ~L y = b, from the tips in toward the roots.
+    for (int k=n-1; k >= 0; --k) {
+        const Real* rowK = F + m_rowStart[k];
+        const Real  xk = x[k];
+        int j = m_parent[k];
+        for (int p=1; j >= 0; ++p, j = m_parent[j])
+            x[j] -= rowK[p]*xk;
+    }
+
+    // Then D z = y, and finally L x = z from the roots outward.
+    for (int k=0; k < n; ++k)
+        x[k] /= F[m_rowStart[k]];
+    for (int k=0; k < n; ++k) {
+        const Real* rowK = F + m_rowStart[k];
+        Real xk = x[k];
+        int j = m_parent[k];
+        for (int p=1; j >= 0; ++p, j = m_parent[j])
+            xk -= rowK[p]*x[j];
+        x[k] = xk;
+    }
+}
+
+void MassMatrixFactorization::multiply(const Vector& x, Vector& Mx) const {
+    const int n = size();
+    SimTK_APIARGCHECK2_ALWAYS(x.size() == n,
+        "MassMatrixFactorization", "multiply",
+        "Vector has length %d but matrix has dimension %d.", x.size(), n);
+    Mx.resize(n);
+    Mx.setToZero();
+    const Real* M = m_values.begin();
+
+    for (int k=0; k < n; ++k) {
+        const Real* rowK = M + m_rowStart[k];
+        const Real  xk = x[k];
+        Real Mxk = rowK[0]*xk;
+        int j = m_parent[k];
+        for (int p=1; j >= 0; ++p, j = m_parent[j]) {
+            Mxk   += rowK[p]*x[j];
+            Mx[j] += rowK[p]*xk; // symmetric entry M(j,k)
+        }
+        Mx[k] += Mxk;
+    }
+}
+
+void MassMatrixFactorization::getAsDenseMatrix(Matrix& M) const {
+    const int n = size();
+    M.resize(n, n);
+    M.setToZero();
+    for (int k=0; k < n; ++k) {
+        const Real* rowK = m_values.begin() + m_rowStart[k];
+        M(k,k) = rowK[0];
+        int j = m_parent[k];
+        for (int p=1; j >= 0; ++p, j = m_parent[j])
+            M(k,j) = M(j,k) = rowK[p];
+    }
+}
+
+} // namespace SimTK
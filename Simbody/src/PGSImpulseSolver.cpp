@@ -35,84 +35,178 @@ using namespace SimTK;
 // Local utilities.
 namespace {
 
+// A sweep that doesn't reduce the enforced error below this fraction of its
+// previous value counts as stalled; see setMaxStalledIterations().
+const Real StalledRate = Real(0.99);
+
+// The PGS iterations need only the diagonal of A and products of rows of A
+// with the current pi. These two adaptors provide those for a dense A and for
+// the block-sparse DelassusOperator so that the same solver code serves both.
+
+// Dense A. Vectors must be contiguous, Matrix must be packed and in column
+// order (i.e. columns are contiguous.) So A(r,c) = A[r + c*m].
+class DenseA {
+public:
+    explicit DenseA(const Matrix& A) : A(A) {
+        assert(A.hasContiguousData()); // packed
+        assert(A.nrow()==0 || A(0).hasContiguousData()); // in column order
+    }
+
+    int size() const {return A.nrow();}
+    Real diag(MultiplierIndex row) const {return A(row,row);}
+    const Matrix& getDense() const {return A;}
+
+    // Calculate A[row]*pi, but only looking at the given columns.
+    Real rowSum(const Array_<MultiplierIndex>& columns,
+                MultiplierIndex                row,
+                const Vector&                  pi) const
+    {
+        assert(pi.hasContiguousData());
+        const Real* pip = &pi[0];
+        const int m = A.nrow();
+        const Real* Ap = &A(0,0);
+
+        Real rowSum = 0;
+        for (unsigned c=0; c < columns.size(); ++c) {
+            const MultiplierIndex cx = columns[c];
+            const Real* cp = Ap + cx*m; // point to start of column
+            rowSum += cp[row]*pip[cx];
+        }
+        return rowSum;
+    }
+
+    // Calculate sums=A[rows]*pi, but only looking at the given columns.
+    // We expect that A is in column order so we'll work down the rows before
+    // we switch columns.
+    void rowSums(const Array_<int>& columns, // these are MultiplierIndex ints
+                 const Array_<int>& rows,
+                 const Vector&      pi,
+                 Array_<Real>&      sums) const
+    {
+        assert(pi.hasContiguousData());
+        const Real* pip = &pi[0];
+        const int m = A.nrow();
+        const Real* Ap = &A(0,0);
+
+        sums.resize(rows.size()); sums.fill(Real(0));
+        for (unsigned c=0; c < columns.size(); ++c) {
+            const int cx = columns[c];
+            const Real* cp = Ap + cx*m; // point to start of column
+            for (unsigned i=0; i<rows.size(); ++i)
+                sums[i] += cp[rows[i]]*pip[cx];
+        }
+    }
+
+    // Multiply A by a sparse, full-length (m) column containing only the
+    // indicated non-zero entries. Useful for A*piExpand.
+    void multiplySparse(const Array_<MultiplierIndex>& nonZero,
+                        const Vector& sparseCol, Vector& Ax) const
+    {
+        const int m = A.nrow();
+        Ax.resize(m);
+        for (MultiplierIndex row(0); row < m; ++row) {
+            const RowVectorView Ar = A[row];
+            Real result = 0;
+            for (unsigned nz(0); nz < nonZero.size(); ++nz) {
+                const MultiplierIndex mx = nonZero[nz];
+                result += Ar[mx] * sparseCol[mx];
+            }
+            Ax[row] = result;
+        }
+    }
+
+    void multiply(const Vector& x, Vector& Ax) const {Ax = A*x;}
+
+private:
+    const Matrix& A;
+};
+
+// Block-sparse A. Only the structurally nonzero entries of a row are visited.
+// The solvers keep pi zero outside the participating set, so a full row
+// product gives the same answer as one restricted to participating columns.
+class SparseA {
+public:
+    explicit SparseA(const DelassusOperator& A) : A(A) {}
+
+    int size() const {return A.size();}
+    Real diag(MultiplierIndex row) const {return A.getDiagonal(row);}
+    const Matrix& getDense() const {return A.getAsDenseMatrix();}
+
+    Real rowSum(const Array_<MultiplierIndex>&, MultiplierIndex row,
+                const Vector& pi) const
+    {   return A.multiplyRow(row, pi); }
+
+    void rowSums(const Array_<int>&, const Array_<int>& rows,
+                 const Vector& pi, Array_<Real>& sums) const
+    {
+        sums.resize(rows.size());
+        for (unsigned i=0; i<rows.size(); ++i)
+            sums[i] = A.multiplyRow(MultiplierIndex(rows[i]), pi);
+    }
+
+    void multiplySparse(const Array_<MultiplierIndex>& nonZero,
+                        const Vector& sparseCol, Vector& Ax) const
+    {
+        Vector x(A.size(), Real(0));
+        for (unsigned nz(0); nz < nonZero.size(); ++nz)
+            x[nonZero[nz]] = sparseCol[nonZero[nz]];
+        A.multiply(x, Ax);
+    }
+
+    void multiply(const Vector& x, Vector& Ax) const {A.multiply(x, Ax);}
+
+private:
+    const DelassusOperator& A;
+};
+
 // Calculate (A+D)[row]*pi, but only looking at the given columns.
-// Vectors must be contiguous, Matrix must be packed and in column order (i.e.
-// columns are contiguous.) So A(r,c) = A[r + c*m].
+template <class AccessA>
 Real doRowSum(const Array_<MultiplierIndex>& columns,
               const MultiplierIndex&         row,
-              const Matrix&                  A,
+              const AccessA&                 A,
               const Vector&                  D,
               const Vector&                  pi)
 {
-    assert(pi.hasContiguousData());
-    const Real* pip = &pi[0];
-    const int m = A.nrow();
-
-    assert(A.hasContiguousData()); // packed
-    assert(A(0).hasContiguousData()); // in column order
-    const Real* Ap = &A(0,0);
-
-    Real rowSum = 0;
-    for (unsigned c=0; c < columns.size(); ++c) {
-        const MultiplierIndex cx = columns[c];
-        const Real* cp = Ap + cx*m; // point to start of column
-        rowSum += cp[row]*pip[cx];
-    }
+    Real rowSum = A.rowSum(columns, row, pi);
     if (D.size()) {
         assert(D.hasContiguousData());
         const Real* Dp = &D[0];
-        rowSum += Dp[row]*pip[row];
+        rowSum += Dp[row]*pi[row];
     }
     return rowSum;
 }
 
 // Calculate sums=(A+D)[rows]*pi, but only looking at the given columns.
-// We expect that A is in column order so we'll work down the rows before
-// we switch columns.
-// Vectors must be contiguous, Matrix must be packed and in column order (i.e.
-// columns are contiguous.) So A(r,c) = A[r + c*m].
+template <class AccessA>
 void doRowSums(const Array_<int>& columns, // these are MultiplierIndex ints
                const Array_<int>& rows,
-               const Matrix&      A, 
+               const AccessA&     A, 
                const Vector&      D,
                const Vector&      pi,
                Array_<Real>&      sums)
 {
-    assert(pi.hasContiguousData());
-    const Real* pip = &pi[0];
-    const int m = A.nrow(), n = A.ncol();
-
-    assert(A.hasContiguousData()); // packed
-    assert(A(0).hasContiguousData()); // in column order
-    const Real* Ap = &A(0,0);
-
-    sums.resize(rows.size()); sums.fill(Real(0));
-    for (unsigned c=0; c < columns.size(); ++c) {
-        const int cx = columns[c];
-        const Real* cp = Ap + cx*m; // point to start of column
-        for (unsigned i=0; i<rows.size(); ++i)
-            sums[i] += cp[rows[i]]*pip[cx];
-    }
+    A.rowSums(columns, rows, pi, sums);
     if (D.size()) {
         assert(D.hasContiguousData());
         const Real* Dp = &D[0];
         for (unsigned i=0; i<rows.size(); ++i)
-            sums[i] += Dp[rows[i]]*pip[rows[i]];
+            sums[i] += Dp[rows[i]]*pi[rows[i]];
     }
 }
 
 // Given a rowSum, update one element of pi and return the squared error.
 // If the corresponding diagonal of A is nonpositive, we will quietly skip
 // the update.
+template <class AccessA>
 inline Real doUpdate(const MultiplierIndex& row,
-                     const Matrix&          A,
+                     const AccessA&         A,
                      const Vector&          D,
                      const Vector&          rhs,
                      const Real&            SOR, // successive over relaxation
                      const Real&            rowSum,
                      Vector&                pi)
 {
-    Real Arr = A(row,row);
+    Real Arr = A.diag(row);
     if (D.size()) Arr += D[row];
     const Real er = rhs[row]-rowSum;
     if (Arr > Real(0))
@@ -122,8 +216,9 @@ inline Real doUpdate(const MultiplierIndex& row,
 
 // Same but now we're doing multiple row updates and return the sum of the
 // squared errors for those rows.
+template <class AccessA>
 Real doUpdates(const Array_<int>& rows, // These are MultiplierIndex ints
-               const Matrix&                  A,
+               const AccessA&                 A,
                const Vector&                  D,
                const Vector&                  rhs,
                const Real&                    SOR,
@@ -134,7 +229,7 @@ Real doUpdates(const Array_<int>& rows, // These are MultiplierIndex ints
     Real er2 = 0;
     for (unsigned i=0; i<rows.size(); ++i) {
         const MultiplierIndex row(rows[i]);
-        Real Arr = A(row,row);
+        Real Arr = A.diag(row);
         if (hasDiag) Arr += D[row];
         const Real er = rhs[row]-rowSums[i];
         if (Arr > Real(0))
@@ -144,22 +239,6 @@ Real doUpdates(const Array_<int>& rows, // These are MultiplierIndex ints
     return er2;
 }
 
-// Multiply the active entries of a row of the full matrix A (mXm) by a sparse,
-// full-length (m) column containing only the indicated non-zero entries. 
-// Useful for A[r]*piExpand.
-static Real multRowTimesSparseCol(const Matrix& A, MultiplierIndex row, 
-           const Array_<MultiplierIndex>& nonZero,
-           const Vector& sparseCol) 
-{
-    const RowVectorView Ar = A[row];
-    Real result = 0;
-    for (unsigned nz(0); nz < nonZero.size(); ++nz) {
-        const MultiplierIndex mx = nonZero[nz];
-        result += Ar[mx] * sparseCol[mx];
-    }
-    return result;
-}
-
 /** Given a unilateral multiplier pi and its sign convention, ensure that
 sign*pi<=0. Return true if any change is made. **/
 inline ImpulseSolver::UniCond boundUnilateral(Real sign, Real& pi) {
@@ -285,8 +364,55 @@ Implicitly, complementarity conditions must hold:
 //------------------------------------------------------------------------------
 bool PGSImpulseSolver::
 solve(int                                 phase,
+      const Array_<MultiplierIndex>&      participating,
+      const Matrix&                       A,
+      const Vector&                       D,
+      const Array_<MultiplierIndex>&      expanding,
+      Vector&                             piExpand,
+      Vector&                             verrStart,
+      Vector&                             verrApplied,
+      Vector&                             pi,
+      Array_<UncondRT>&                   unconditional,
+      Array_<UniContactRT>&               uniContact,
+      Array_<UniSpeedRT>&                 uniSpeed,
+      Array_<BoundedRT>&                  bounded,
+      Array_<ConstraintLtdFrictionRT>&    consLtdFriction,
+      Array_<StateLtdFrictionRT>&         stateLtdFriction
+      ) const 
+{
+    return solveImpl(phase, participating, DenseA(A), D, expanding, piExpand,
+                     verrStart, verrApplied, pi, unconditional, uniContact,
+                     uniSpeed, bounded, consLtdFriction, stateLtdFriction);
+}
+
+bool PGSImpulseSolver::
+solve(int                                 phase,
+      const Array_<MultiplierIndex>&      participating,
+      const DelassusOperator&             A,
+      const Vector&                       D,
+      const Array_<MultiplierIndex>&      expanding,
+      Vector&                             piExpand,
+      Vector&                             verrStart,
+      Vector&                             verrApplied,
+      Vector&                             pi,
+      Array_<UncondRT>&                   unconditional,
+      Array_<UniContactRT>&               uniContact,
+      Array_<UniSpeedRT>&                 uniSpeed,
+      Array_<BoundedRT>&                  bounded,
+      Array_<ConstraintLtdFrictionRT>&    consLtdFriction,
+      Array_<StateLtdFrictionRT>&         stateLtdFriction
+      ) const 
+{
+    return solveImpl(phase, participating, SparseA(A), D, expanding, piExpand,
+                     verrStart, verrApplied, pi, unconditional, uniContact,
+                     uniSpeed, bounded, consLtdFriction, stateLtdFriction);
+}
+
+template <class AccessA>
+bool PGSImpulseSolver::
+solveImpl(int                                 phase,
       const Array_<MultiplierIndex>&      participating, // p<=m of these 
-      const Matrix&                       A,     // m X m, symmetric
+      const AccessA&                      A,     // m X m, symmetric
       const Vector&                       D,     // m, diag >= 0 added to A
       const Array_<MultiplierIndex>&      expanding,
       Vector&                             piExpand,   // m
@@ -306,8 +432,8 @@ solve(int                                 phase,
     ++m_nSolves[phase];
 
 #ifndef NDEBUG
-   {FactorQTZ fac(A);
-    cout << "A=" << A; cout << "D=" << D; 
+   {FactorQTZ fac(A.getDense());
+    cout << "A=" << A.getDense(); cout << "D=" << D; 
     cout << "verrStart=" << verrStart << endl;
     cout << "verrApplied=" << verrApplied << endl;
     cout << "expanding mx=" << expanding << endl;
@@ -317,11 +443,11 @@ solve(int                                 phase,
     if (verrApplied.size()) verrDbg += verrApplied;
     fac.solve(verrDbg, x); 
     cout << "x=" << x << endl;
-    cout << "resid=" << A*x-verrDbg << endl;}
+    cout << "resid=" << A.getDense()*x-verrDbg << endl;}
 #endif
 
-    const int m=A.nrow();
-    assert(A.ncol()==m); assert(D.size()==m);
+    const int m=A.size();
+    assert(D.size()==m);
     assert(verrStart.size()==m); 
     assert(verrApplied.size()==0 || verrApplied.size()==m);
     assert(piExpand.size()==m); 
@@ -330,8 +456,21 @@ solve(int                                 phase,
     const int nx = (int)expanding.size();
     assert(p<=m); assert(nx<=m);
     
+    // Start from zero, or from the caller's guess for the participating
+    // multipliers. Either way pi must be zero for the others since the sparse
+    // row sums depend on that.
+    const bool warmStart = m_useInitialGuess && pi.size()==m;
+    Array_<Real> guess;
+    if (warmStart) {
+        guess.resize(p);
+        for (int k=0; k < p; ++k) guess[k] = pi[participating[k]];
+    }
     pi.resize(m);
     pi.setToZero(); // Use this for piUnknown
+    if (warmStart) {
+        ++m_nWarmSolves[phase];
+        for (int k=0; k < p; ++k) pi[participating[k]] = guess[k];
+    }
 
     // If there are applied forces, add them to the rhs.
     if (verrApplied.size()) 
@@ -339,11 +478,12 @@ solve(int                                 phase,
 
     // Move expansion impulse to RHS. We will always apply the full expansion
     // impulse in one interval in this solver.
-    if (nx) 
-        for (MultiplierIndex mx(0); mx < m; ++mx) {
-            verrStart[mx] -= multRowTimesSparseCol(A,mx,expanding,piExpand)
-                             + D[mx]*piExpand[mx];
-        }
+    if (nx) {
+        Vector ApiExpand;
+        A.multiplySparse(expanding, piExpand, ApiExpand);
+        for (MultiplierIndex mx(0); mx < m; ++mx)
+            verrStart[mx] -= ApiExpand[mx] + D[mx]*piExpand[mx];
+    }
 
     // Now rhs = verrStart + verrApplied - [A+D]*piExpand.
     #ifndef NDEBUG
@@ -384,6 +524,7 @@ solve(int                                 phase,
 
     if (p == 0) {
         SimTK_DEBUG1("PGS %d: nothing to do; converged in 0 iters.\n", phase);
+        m_lastIters[phase] = 0; m_lastError[phase] = 0;
         // Returning pi=0; can still have piExpand!=0 so verr is updated.
         return true;
     }
@@ -393,7 +534,7 @@ solve(int                                 phase,
     bool converged = false;
     Real normRMSall = Infinity, normRMSenf = Infinity, sor = m_SOR;
     Real prevNormRMSenf = NaN;
-    int its = 1;
+    int its = 1, stalled = 0;
     Array_<Real> rowSums; // handy temp
     for (; its <= m_maxIters; ++its) {
         ++m_nIters[phase];
@@ -508,6 +649,14 @@ solve(int                                 phase,
             converged = true;
             break;
         }
+        if (m_maxStalledIters > 0) {
+            stalled = rate > StalledRate ? stalled+1 : 0;
+            if (stalled >= m_maxStalledIters) {
+                SimTK_DEBUG3("PGS %d stalled at %g after %d iters\n", 
+                             phase, normRMSenf, its);
+                break;
+            }
+        }
         #ifndef NDEBUG
         cout << "pi=" << pi << " err=" << normRMSenf << " rate=" << rate << endl;
         #endif
@@ -518,8 +667,12 @@ solve(int                                 phase,
                phase, its, normRMSenf);
         ++m_nFail[phase];
     }
+    m_lastIters[phase] = std::min(its, m_maxIters);
+    m_lastError[phase] = normRMSenf;
 
-    verrStart -= A*pi;
+    Vector Api;
+    A.multiply(pi, Api);
+    verrStart -= Api;
     verrStart -= D.elementwiseMultiply(pi);
     #ifndef NDEBUG
     cout << "FINAL@" << its << " pi=" << pi << " verr=" << verrStart
@@ -534,8 +687,33 @@ solve(int                                 phase,
 //------------------------------------------------------------------------------
 bool PGSImpulseSolver::
 solveBilateral
+   (const Array_<MultiplierIndex>&  participating,
+    const Matrix&                   A,
+    const Vector&                   D,
+    const Vector&                   rhs,
+    Vector&                         pi
+    ) const
+{
+    return solveBilateralImpl(participating, DenseA(A), D, rhs, pi);
+}
+
+bool PGSImpulseSolver::
+solveBilateral
+   (const Array_<MultiplierIndex>&  participating,
+    const DelassusOperator&         A,
+    const Vector&                   D,
+    const Vector&                   rhs,
+    Vector&                         pi
+    ) const
+{
+    return solveBilateralImpl(participating, SparseA(A), D, rhs, pi);
+}
+
+template <class AccessA>
+bool PGSImpulseSolver::
+solveBilateralImpl
    (const Array_<MultiplierIndex>&  participating, // p<=m of these 
-    const Matrix&                   A,     // m X m, symmetric
+    const AccessA&                  A,     // m X m, symmetric
     const Vector&                   D,     // m, diag>=0 added to A
     const Vector&                   rhs,   // m, RHS
     Vector&                         pi     // m, unknown result
@@ -545,10 +723,9 @@ solveBilateral
     SimTK_DEBUG(  "PGS BILATERAL SOLVER:\n");
     ++m_nBilateralSolves;
 
-    const int m=A.nrow(); 
+    const int m=A.size(); 
     const int p = (int)participating.size();
 
-    assert(A.ncol()==m); 
     assert(D.size()==0 || D.size()==m);
     assert(rhs.size()==m);
     assert(p<=m);
@@ -568,7 +745,7 @@ solveBilateral
     bool converged = false;
     Real normRMSenf = Infinity, sor = m_SOR;
     Real prevNormRMSenf = NaN;
-    int its = 1;
+    int its = 1, stalled = 0;
     Array_<Real> rowSums; // handy temp
     for (; its <= m_maxIters; ++its) {
         ++m_nBilateralIters;
@@ -605,6 +782,11 @@ solveBilateral
             converged = true;
             break;
         }
+        if (m_maxStalledIters > 0) {
+            stalled = rate > StalledRate ? stalled+1 : 0;
+            if (stalled >= m_maxStalledIters)
+                break;
+        }
         #ifndef NDEBUG
         cout << "pi=" << pi << " err=" << normRMSenf << " rate=" << rate << endl;
         #endif
@@ -617,13 +799,13 @@ solveBilateral
     }
 
     #ifndef NDEBUG
-    cout << "A=" << A;
+    cout << "A=" << A.getDense();
     cout << "D=" << D << endl;
     cout << "rhs=" << rhs << endl;
     cout << "active=" << participating << endl;
     cout << "-> pi=" << pi << endl;
-    if (D.size()) cout << "resid=" << A*pi+D.elementwiseMultiply(pi)-rhs << endl;
-    else cout << "resid=" << A*pi-rhs << endl;
+    if (D.size()) cout << "resid=" << A.getDense()*pi+D.elementwiseMultiply(pi)-rhs << endl;
+    else cout << "resid=" << A.getDense()*pi-rhs << endl;
     #endif
     SimTK_DEBUG("--------------------------------\n");
     return converged;
@@ -64,6 +64,7 @@ SemiExplicitEulerTimeStepper(const MultibodySystem& mbs)
     m_maxInducedImpactsPerStep(DefMaxInducedImpactsPerStep),
     m_projectionMethod(DefPosProjMethod),
     m_solverType(DefImpulseSolverType), 
+    m_useWarmStart(true),
     m_defaultCaptureVelocity(0),    // means: use 2 x constraintTol
     m_defaultMinCORVelocity(0),     // means: use capture velocity
     m_defaultTransitionVelocity(0), // means: use 2 x constraintTol
@@ -104,6 +105,7 @@ stepTo(Real time) {
     const int m = verr0.size();
 
     if (m==0) {
+        m_prevContactForce.clear();
         takeUnconstrainedStep(s, h);
         return Integrator::ReachedScheduledEvent;
     }
@@ -114,8 +116,13 @@ stepTo(Real time) {
     // separate and no time is going by during an impact.
     calcCoefficientsOfFriction(s, verr0);
 
-    // Calculate the constraint compliance matrix A=GM\~G.
-    matter.calcProjectedMInv(s, m_GMInvGt); // m X m
+    // Calculate the constraint compliance matrix A=GM\~G. PGS works from its
+    // rows only, so we can give it the block-sparse form which stores just
+    // the entries coupled through a shared tree of bodies.
+    if (m_solverType == PGS)
+        matter.calcProjectedMInv(s, m_sparseGMInvGt);
+    else
+        matter.calcProjectedMInv(s, m_GMInvGt); // m X m
 
     // TODO: this is for soft constraints. D >= 0.
     m_D.resize(m); m_D.setToZero();
@@ -313,8 +320,14 @@ stepTo(Real time) {
     // needs to know the sliding velocity for proper friction classification and
     // that velocity is what's in verr0.
     Vector verrStart = verr0;
-    // Use lambda as a temp here; we are really calculating lambda*h.
+    // Use lambda as a temp here; we are really calculating lambda*h. If
+    // warm starting, it begins with the impulses the last step's contact
+    // forces would deliver over this step.
+    if (m_useWarmStart)
+        calcWarmStartImpulse(h, m, lambda);
+    m_solver->setUseInitialGuess(m_useWarmStart);
     doCompressionPhase(s, verrStart, m_verr, lambda);
+    m_solver->setUseInitialGuess(false);
     #ifndef NDEBUG
     cout << "   dynamics impulse=" << lambda << endl;
     cout << "   updated verrStart=" << verrStart << endl;
@@ -324,6 +337,7 @@ stepTo(Real time) {
     // Convert multipliers from impulses to forces. These are the multipliers
     // reported at end of step.
     lambda /= h;
+    saveContactForces(lambda);
 
     // Calculate constraint forces ~G*lambda (body frcs Fc, mobility frcs fc).
     Vector_<SpatialVec> Fc; Vector fc; 
@@ -719,6 +733,7 @@ classifyUnilateralContactsForSimultaneousImpact
 void SemiExplicitEulerTimeStepper::initialize(const State& initState) {
     m_state = initState;
     m_mbs.realize(m_state, Stage::Acceleration);
+    m_prevContactForce.clear(); // no warm start for the first step
 
     if (!m_solver) {
         const Real transVel = getDefaultFrictionTransitionVelocityInUse();
@@ -1145,8 +1160,10 @@ calcExpansionImpulseIfAny(const State& s, const Array_<int>& impacters,
 //------------------------------------------------------------------------------
 //                         DO COMPRESSION PHASE
 //------------------------------------------------------------------------------
-// This phase uses all the proximal constraints and should use a starting
-// guess for impulse saved from the last step if possible.
+// This phase uses all the proximal constraints. When the solver has been
+// told to use an initial guess, compImpulse on entry is that guess; the 
+// dynamics phase warm starts it from the last step's contact forces (see
+// calcWarmStartImpulse()).
 bool SemiExplicitEulerTimeStepper::
 doCompressionPhase(const State& s, Vector& verrStart, Vector& verrApplied, 
                    Vector& compImpulse) 
@@ -1156,10 +1173,9 @@ doCompressionPhase(const State& s, Vector& verrStart, Vector& verrApplied,
     cout << "  verrStart=" << verrStart << endl;
     cout << "  verrApplied=" << verrApplied << endl;
 #endif
-    // TODO: improve initial guess
     m_expansionImpulse.setToZero(); //TODO: shouldn't need to zero this
-    bool converged = m_solver->solve(0,
-        m_allParticipating,m_GMInvGt,m_D,
+    bool converged = solveImpulses(0,
+        m_allParticipating,
         Array_<MultiplierIndex>(), m_expansionImpulse, 
         verrStart, verrApplied, 
         compImpulse,
@@ -1184,8 +1200,8 @@ doExpansionPhase(const State&   state,
                  Vector&        verrStart, 
                  Vector&        reactionImpulse) {
     // TODO: improve initial guess
-    bool converged = m_solver->solve(1,
-        m_participating,m_GMInvGt,m_D,
+    bool converged = solveImpulses(1,
+        m_participating,
         expanding,expansionImpulse, verrStart,m_emptyVector,
         reactionImpulse,
         m_unconditional,m_uniContact,m_uniSpeed,m_bounded,
@@ -1209,8 +1225,8 @@ doInducedImpactRound(const State& s,
 #ifndef NDEBUG
     printf("IMP t=%.15g verr=", s.getTime()); cout << verrStart << endl;
 #endif
-    bool converged = m_solver->solve(0,
-        m_participating,m_GMInvGt,m_D,
+    bool converged = solveImpulses(0,
+        m_participating,
         expanding,expansionImpulse, verrStart,m_emptyVector,
         impulse,
         m_unconditional,m_uniContact,m_uniSpeed,m_bounded,
@@ -1233,8 +1249,8 @@ doPositionCorrectionPhase(const State& state, Vector& pverr,
         SimTK_DEBUG1("UNILATERAL POSITION CORRECTION, %d participators\n",
                      (int)m_posParticipating.size());
         m_expansionImpulse.setToZero(); //TODO: shouldn't need to zero this
-        converged = m_solver->solve(2,
-            m_posParticipating,m_GMInvGt,m_D,
+        converged = solveImpulses(2,
+            m_posParticipating,
             Array_<MultiplierIndex>(), m_expansionImpulse,
             pverr, m_emptyVector,
             positionImpulse,
@@ -1255,12 +1271,87 @@ doPositionCorrectionPhase(const State& state, Vector& pverr,
         }
         SimTK_DEBUG1("BILATERAL POSITION CORRECTION, %d participators\n",
                     (int)m_participating.size());
-        converged = m_solver->solveBilateral(m_participating,m_GMInvGt,m_D,
-                                             pverr, positionImpulse);
+        converged = solveBilateralImpulses(m_participating,
+                                           pverr, positionImpulse);
     }
     return converged;
 }
 
+//------------------------------------------------------------------------------
+//                             SOLVE IMPULSES
+//------------------------------------------------------------------------------
+bool SemiExplicitEulerTimeStepper::
+solveImpulses(int                                     phase,
+              const Array_<MultiplierIndex>&          participating,
+              const Array_<MultiplierIndex>&          expanding,
+              Vector&                                 piExpand,
+              Vector&                                 verrStart,
+              Vector&                                 verrApplied,
+              Vector&                                 pi,
+              Array_<ImpulseSolver::UncondRT>&        unconditional,
+              Array_<ImpulseSolver::UniContactRT>&    uniContact,
+              Array_<ImpulseSolver::UniSpeedRT>&      uniSpeed,
+              Array_<ImpulseSolver::BoundedRT>&       bounded,
+              Array_<ImpulseSolver::ConstraintLtdFrictionRT>& consLtdFriction,
+              Array_<ImpulseSolver::StateLtdFrictionRT>& stateLtdFriction) 
+{
+    if (m_solverType == PGS)
+        return m_solver->solve(phase, participating, m_sparseGMInvGt, m_D,
+                               expanding, piExpand, verrStart, verrApplied, pi,
+                               unconditional, uniContact, uniSpeed, bounded,
+                               consLtdFriction, stateLtdFriction);
+    return m_solver->solve(phase, participating, m_GMInvGt, m_D,
+                           expanding, piExpand, verrStart, verrApplied, pi,
+                           unconditional, uniContact, uniSpeed, bounded,
+                           consLtdFriction, stateLtdFriction);
+}
+
+bool SemiExplicitEulerTimeStepper::
+solveBilateralImpulses(const Array_<MultiplierIndex>& participating,
+                       const Vector&                  rhs,
+                       Vector&                        pi) 
+{
+    if (m_solverType == PGS)
+        return m_solver->solveBilateral(participating, m_sparseGMInvGt, m_D,
+                                        rhs, pi);
+    return m_solver->solveBilateral(participating, m_GMInvGt, m_D, rhs, pi);
+}
+
+//------------------------------------------------------------------------------
+//                          CALC WARM START IMPULSE
+//------------------------------------------------------------------------------
+void SemiExplicitEulerTimeStepper::
+calcWarmStartImpulse(Real h, int m, Vector& pi) const {
+    pi.resize(m); 
+    pi.setToZero();
+    for (unsigned i=0; i < m_uniContact.size(); ++i) {
+        const ImpulseSolver::UniContactRT& rt = m_uniContact[i];
+        if ((int)rt.m_ucx >= (int)m_prevContactForce.size())
+            continue; // no forces saved
+        const Vec3& f = m_prevContactForce[rt.m_ucx];
+        pi[rt.m_Nk] = h*f[0];
+        for (unsigned j=0; j < rt.m_Fk.size(); ++j)
+            pi[rt.m_Fk[j]] = h*f[1+j];
+    }
+}
+
+//------------------------------------------------------------------------------
+//                           SAVE CONTACT FORCES
+//------------------------------------------------------------------------------
+void SemiExplicitEulerTimeStepper::
+saveContactForces(const Vector& lambda) {
+    const SimbodyMatterSubsystem& matter = m_mbs.getMatterSubsystem();
+    m_prevContactForce.resize(matter.getNumUnilateralContacts());
+    m_prevContactForce.fill(Vec3(0)); // for contacts that weren't proximal
+    for (unsigned i=0; i < m_uniContact.size(); ++i) {
+        const ImpulseSolver::UniContactRT& rt = m_uniContact[i];
+        Vec3& f = m_prevContactForce[rt.m_ucx];
+        f[0] = lambda[rt.m_Nk];
+        for (unsigned j=0; j < rt.m_Fk.size(); ++j)
+            f[1+j] = lambda[rt.m_Fk[j]];
+    }
+}
+
 //------------------------------------------------------------------------------
 //                       ANY POSITION ERRORS VIOLATED
 //------------------------------------------------------------------------------
@@ -107,6 +107,46 @@ void SimbodyMatterSubsystem::setShowDefaultGeometry(bool show) {
     updRep().setShowDefaultGeometry(show);
 }
 
+void SimbodyMatterSubsystem::setNumberOfThreads(unsigned numThreads) {
+    updRep().setNumberOfThreads(numThreads);
+}
+
+int SimbodyMatterSubsystem::getNumberOfThreads() const {
+    return getRep().getNumberOfThreads();
+}
+
+void SimbodyMatterSubsystem::setMinNodesPerParallelLevel(int minNodes) {
+    updRep().setMinNodesPerParallelLevel(minNodes);
+}
+
+int SimbodyMatterSubsystem::getMinNodesPerParallelLevel() const {
+    return getRep().getMinNodesPerParallelLevel();
+}
+
+void SimbodyMatterSubsystem::setParallelSubtreeSplitLevel(int level) {
+    updRep().setParallelSubtreeSplitLevel(level);
+}
+
+int SimbodyMatterSubsystem::getParallelSubtreeSplitLevel() const {
+    return getRep().getParallelSubtreeSplitLevel();
+}
+
+void SimbodyMatterSubsystem::setMinNodesForParallelSubtrees(int minNodes) {
+    updRep().setMinNodesForParallelSubtrees(minNodes);
+}
+
+int SimbodyMatterSubsystem::getMinNodesForParallelSubtrees() const {
+    return getRep().getMinNodesForParallelSubtrees();
+}
+
+void SimbodyMatterSubsystem::setUseIterativeProjection(bool useIterative) {
+    updRep().setUseIterativeProjection(useIterative);
+}
+
+bool SimbodyMatterSubsystem::getUseIterativeProjection() const {
+    return getRep().getUseIterativeProjection();
+}
+
 
 ConstraintIndex SimbodyMatterSubsystem::
 adoptConstraint(Constraint& child) {return updRep().adoptConstraint(child);}
@@ -475,6 +515,10 @@ void SimbodyMatterSubsystem::multiplyByMInv(const State&    state,
 void SimbodyMatterSubsystem::calcM(const State& s, Matrix& M) const 
 {   getRep().calcM(s, M); }
 
+void SimbodyMatterSubsystem::
+factorM(const State& s, MassMatrixFactorization& MFac) const
+{   getRep().factorM(s, MFac); }
+
 void SimbodyMatterSubsystem::calcMInv(const State& s, Matrix& MInv) const 
 {   getRep().calcMInv(s, MInv); }
 
@@ -485,6 +529,10 @@ void SimbodyMatterSubsystem::calcProjectedMInv(const State&   s,
                                                Matrix&        GMInvGt) const
 {   getRep().calcGMInvGt(s, GMInvGt); }
 
+void SimbodyMatterSubsystem::calcProjectedMInv(const State&       s,
+                                               DelassusOperator&  GMInvGt) const
+{   getRep().calcGMInvGtBlocks(s, GMInvGt); }
+
 void SimbodyMatterSubsystem::
 solveForConstraintImpulses(const State&     state,
                            const Vector&    deltaV,
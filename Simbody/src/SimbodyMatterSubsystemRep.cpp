@@ -102,6 +102,9 @@ void SimbodyMatterSubsystemRep::clearTopologyCache() {
     // be deleted when the MobilizedBodyImpl objects are.
     rbNodeLevels.clear();
     nodeNum2NodeMap.clear();
+    subtreeNodeLevels.clear();
+    numSubtreeNodes = 0;
+    subtreeBins.clear();
 
     showDefaultGeometry = true;
 }
@@ -291,6 +294,8 @@ void SimbodyMatterSubsystemRep::endConstruction(State& s) {
         DOFTotal += ndof; SqDOFTotal += ndof*ndof;
         maxNQTotal += n.getMaxNQ();
     }
+
+    buildParallelSubtrees();
     
     // Order doesn't matter for constraints as long as the bodies are already 
     // there. Quaternion normalization constraints exist only at the 
@@ -477,6 +482,12 @@ int SimbodyMatterSubsystemRep::realizeSubsystemTopologyImpl(State& s) const {
         allocateLazyCacheEntry(s, Stage::Dynamics,
                                new Value<SBConstrainedAccelerationCache>());
 
+    // Preconditioners for iterative projection are kept until the set of
+    // enabled constraints changes, which happens at Instance stage.
+    tc.projectionPreconditionerCacheIndex =
+        allocateLazyCacheEntry(s, Stage::Instance,
+                               new Value<SBProjectionPreconditionerCache>());
+
     tc.valid = true;
 
     // Allocate a cache entry for the topologyCache, and save a copy there.
@@ -1130,9 +1141,11 @@ realizePositionKinematics(const State& state) const {
     // Any body which is using quaternions should calculate the quaternion
     // constraint here and put it in the appropriate slot of qErr.
     // Set generalized coordinates: sweep from base to tips.
+    // Each level depends only on the one before it, so a wide level may be
+    // split among threads (see forEachNodeInLevel()).
     for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++)
-            rbNodeLevels[i][j]->realizePosition(stateDigest); 
+        forEachNodeInLevel(i, [&stateDigest](const RigidBodyNode& node)
+                              {   node.realizePosition(stateDigest); });
 
     // Ask the constraints to calculate ancestor-relative kinematics (still 
     // goes in TreePositionCache).
@@ -1238,9 +1251,8 @@ realizeArticulatedBodyInertias(const State& state) const {
     SBArticulatedBodyInertiaCache&  abc = updArticulatedBodyInertiaCache(state);
 
     // tip-to-base sweep
-    for (int i=rbNodeLevels.size()-1 ; i>=0 ; --i) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
-            rbNodeLevels[i][j]->realizeArticulatedBodyInertiasInward(ic,tpc,abc);
+    sweepTreeInward([&](const RigidBodyNode& node)
+                    {   node.realizeArticulatedBodyInertiasInward(ic,tpc,abc); });
 
     markCacheValueRealized(state, abx);
 }
@@ -1375,8 +1387,8 @@ realizeVelocityKinematics(const State& state) const {
 
     // Set generalized speeds: sweep from base to tips.
     for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
-            rbNodeLevels[i][j]->realizeVelocity(stateDigest); 
+        forEachNodeInLevel(i, [&stateDigest](const RigidBodyNode& node)
+                              {   node.realizeVelocity(stateDigest); });
 
     // Ask the constraints to calculate ancestor-relative velocity kinematics 
     // (still goes in TreeVelocityCache).
@@ -2752,6 +2764,56 @@ calcWeightedPVrTranspose(
 
 
 
+//==============================================================================
+//                       GET PROJECT Q,U PRECONDITIONER
+//==============================================================================
+// Iterative projection solves A ~A y = b with a Jacobi preconditioner, which
+// needs the squared norms of the rows of A; those are the squared norms of the
+// columns of ~A as calculated above. We calculate them the first time they are
+// needed after the constraint set changes and then reuse them at every step.
+// They are a little out of date once q and u have moved on, but that only
+// affects the convergence rate, not the answer. A zero row (a constraint that
+// has no effect on free coordinates) is left unscaled.
+static void calcInvertedColumnNormsSquared(const Matrix& At, Vector& ooDiag) {
+    ooDiag.resize(At.ncol());
+    for (int j=0; j < At.ncol(); ++j) {
+        const Real d = At(j).normSqr();
+        ooDiag[j] = d > 0 ? 1/d : Real(1);
+    }
+}
+
+const Vector& SimbodyMatterSubsystemRep::
+getProjectQPreconditioner(const State&  s,
+                          const Vector& Tp,     // 1/perr tols (mp)
+                          const Vector& ooWu)   // 1/u weights (nu)
+                          const
+{
+    SBProjectionPreconditionerCache& pc = updProjectionPreconditionerCache(s);
+    if (pc.ooDiagQ.size() != Tp.size()) {
+        Matrix Pqwrt;
+        calcWeightedPqrTranspose(s, Tp, ooWu, Pqwrt); // nfq X mp
+        calcInvertedColumnNormsSquared(Pqwrt, pc.ooDiagQ);
+    }
+    return pc.ooDiagQ;
+}
+
+const Vector& SimbodyMatterSubsystemRep::
+getProjectUPreconditioner(const State&  s,
+                          const Vector& Tpv,    // 1/pverr tols (mp+mv)
+                          const Vector& ooWu)   // 1/u weights (nu)
+                          const
+{
+    SBProjectionPreconditionerCache& pc = updProjectionPreconditionerCache(s);
+    if (pc.ooDiagU.size() != Tpv.size()) {
+        Matrix PVwrt;
+        calcWeightedPVrTranspose(s, Tpv, ooWu, PVwrt); // nfu X (mp+mv)
+        calcInvertedColumnNormsSquared(PVwrt, pc.ooDiagU);
+    }
+    return pc.ooDiagU;
+}
+
+
+
 //==============================================================================
 //                      CALC BIAS FOR MULTIPLY BY PVA
 //==============================================================================
@@ -3559,6 +3621,304 @@ calcGMInvGt(const State&   s,
 
 
 
+// =============================================================================
+//                            CALC GMINVGT BLOCKS
+// =============================================================================
+// M is block diagonal with one block per tree (a base body and everything
+// outboard of it), so G M^-1 ~G = sum_t G_t M_t^-1 ~G_t. Column j of ~G is
+// nonzero only in the mobilities of the trees that hold constrained bodies or
+// constrained mobilizers of equation j's Constraint, and G_t has nonzero rows
+// only for those same equations (we're assuming the force transmission matrix
+// is ~G here, as calcGMInvGt() does). So we first find each tree's equations
+// from the Constraints' topology, then form the dense block G_t M_t^-1 ~G_t 
+// one column at a time without leaving the tree:
+//   - the Constraint's forces for a unit multiplier are mapped to the tree's
+//     mobilities by an inward sweep over just the tree's nodes,
+//   - M_t^-1 is applied by two sweeps over those nodes, and
+//   - G_t is applied by moving the result out to the tree's bodies and asking
+//     only the tree's Constraints for their errors.
+// The scratch arrays span the whole system but only the tree's entries are
+// written; those are zeroed again before moving on to the next tree so that a
+// Constraint that also reaches another tree sees nothing there.
+//
+// Complexity is O(sum_t k_t*(n_t + c_t)) where tree t has k_t equations and
+// n_t mobilities, and c_t is the size of its Constraints. For a system of many
+// small trees that is O(m) rather than the O(m*n) of calcGMInvGt().
+void SimbodyMatterSubsystemRep::
+calcGMInvGtBlocks(const State&        s,
+                  DelassusOperator&   GMInvGt) const
+{
+    const SBInstanceCache&      ic  = getInstanceCache(s);
+    const SBTreePositionCache&  tpc = getTreePositionCache(s);
+
+    const int mHolo    = ic.totalNHolonomicConstraintEquationsInUse;
+    const int mNonholo = ic.totalNNonholonomicConstraintEquationsInUse;
+    const int mAccOnly = ic.totalNAccelerationOnlyConstraintEquationsInUse;
+    const int m        = mHolo+mNonholo+mAccOnly;  
+    const int nu       = getNU(s);
+    const int nb       = getNumBodies();
+
+    GMInvGt.clear(m);
+    if (m==0) return;
+
+    realizeArticulatedBodyInertias(s); // (may already have been realized)
+    const SBArticulatedBodyInertiaCache& abc = getArticulatedBodyInertiaCache(s);
+    // i.e., we must be *done* with Stage::Position
+    const SBStateDigest sbState(s, *this, Stage(Stage::Position).next());
+
+    // Number the trees, list each tree's nodes base to tip, and record which
+    // tree each body and mobility belongs to (Ground belongs to none).
+    Array_<int> treeOfNode(nb, -1), treeOfU(nu, -1);
+    Array_<RBNodePtrList> treeNodes;
+    for (int level=1; level < (int)rbNodeLevels.size(); ++level)
+        for (const RigidBodyNode* node : rbNodeLevels[level]) {
+            const int tree = level==1 ? (int)treeNodes.size()
+                : treeOfNode[node->getParent()->getNodeNum()];
+            if (level==1) treeNodes.push_back();
+            treeOfNode[node->getNodeNum()] = tree;
+            treeNodes[tree].push_back(node);
+            for (int i=0; i < node->getDOF(); ++i)
+                treeOfU[node->getUIndex()+i] = tree;
+        }
+    const int nTrees = (int)treeNodes.size();
+
+    // Pass 1: find the Constraints and equations that act on each tree.
+    Array_< Array_<ConstraintIndex> > treeConstraints(nTrees);
+    Array_< Array_<MultiplierIndex> > treeMults(nTrees);
+    Array_<ConstraintIndex> constraintOfMult(m);
+    Array_<int> lastSeen(nTrees, -1);
+    for (ConstraintIndex cx(0); cx < constraints.size(); ++cx) {
+        if (isConstraintDisabled(s,cx))
+            continue;
+        const ConstraintImpl& crep = constraints[cx]->getImpl();
+        const SBInstancePerConstraintInfo& 
+                              cInfo = ic.getConstraintInstanceInfo(cx);
+        const Segment& holoSeg    = cInfo.holoErrSegment;
+        const Segment& nonholoSeg = cInfo.nonholoErrSegment;
+        const Segment& accOnlySeg = cInfo.accOnlyErrSegment;
+        for (int i=0; i < holoSeg.length; ++i)
+            constraintOfMult[holoSeg.offset+i] = cx;
+        for (int i=0; i < nonholoSeg.length; ++i)
+            constraintOfMult[mHolo+nonholoSeg.offset+i] = cx;
+        for (int i=0; i < accOnlySeg.length; ++i)
+            constraintOfMult[mHolo+mNonholo+accOnlySeg.offset+i] = cx;
+
+        auto addTree = [&](int tree) {
+            if (tree < 0 || lastSeen[tree] == cx)
+                return;
+            lastSeen[tree] = cx;
+            treeConstraints[tree].push_back(cx);
+            Array_<MultiplierIndex>& mults = treeMults[tree];
+            for (int i=0; i < holoSeg.length; ++i)
+                mults.push_back(MultiplierIndex(holoSeg.offset+i));
+            for (int i=0; i < nonholoSeg.length; ++i)
+                mults.push_back(MultiplierIndex(mHolo+nonholoSeg.offset+i));
+            for (int i=0; i < accOnlySeg.length; ++i)
+                mults.push_back
+                   (MultiplierIndex(mHolo+mNonholo+accOnlySeg.offset+i));
+        };
+        for (ConstrainedBodyIndex cbx(0); 
+             cbx < crep.getNumConstrainedBodies(); ++cbx)
+            addTree(treeOfNode[crep.getMobilizedBodyIndexOfConstrainedBody(cbx)]);
+        for (ConstrainedMobilizerIndex cmx(0); 
+             cmx < crep.getNumConstrainedMobilizers(); ++cmx)
+            addTree(treeOfNode
+                [crep.getMobilizedBodyIndexOfConstrainedMobilizer(cmx)]);
+    }
+
+    Vector bias(m);
+    calcBiasForMultiplyByPVA(s,true,true,true,bias);
+
+    // Whole-system scratch. Entries of Ground and of trees other than the
+    // current one must stay zero (or stay the coriolis acceleration, for 
+    // A_GB), since Constraints that span trees will look at them.
+    const SpatialVec zeroSV(Vec3(0));
+    Array_<SpatialVec,MobilizedBodyIndex> F_G(nb, zeroSV), z(nb), zPlus(nb),
+        MInvA_GB(nb, zeroSV), V_GB(nb, zeroSV), A_GB;
+    const Array_<SpatialVec,MobilizedBodyIndex>* allAC_GB = 0;
+    if (mNonholo || mAccOnly) {
+        allAC_GB = &getTreeVelocityCache(s).totalCoriolisAcceleration;
+        A_GB.resize(nb);
+        for (MobilizedBodyIndex b(0); b < nb; ++b)
+            A_GB[b] = (*allAC_GB)[b];
+    }
+    Array_<Real> fu(nu, Real(0)), eps(nu), ulike(nu, Real(0)),
+                 qlike(getTotalQAlloc(), Real(0));
+    Array_<int> rowOfMult(m, -1);
+
+    // Per-Constraint scratch; these grow to the largest Constraint.
+    Array_<SpatialVec,ConstrainedBodyIndex> oneF_G, V_AB, A_AB;
+    Array_<Real,ConstrainedUIndex>          onefu, udot;
+    Array_<Real,ConstrainedQIndex>          onefq, qdot;
+    Array_<Real>                            unitLambda, err;
+
+    // Pass 2: form each tree's block a column at a time.
+    Matrix block;
+    for (int tree=0; tree < nTrees; ++tree) {
+        Array_<MultiplierIndex>& mults = treeMults[tree];
+        const RBNodePtrList& nodes = treeNodes[tree];
+        const int k  = (int)mults.size();
+        const int nn = (int)nodes.size();
+        if (k == 0) continue;
+        std::sort(mults.begin(), mults.end());
+        for (int r=0; r < k; ++r)
+            rowOfMult[mults[r]] = r;
+        block.resize(k, k);
+
+        for (int c=0; c < k; ++c) {
+            const MultiplierIndex j = mults[c];
+            const ConstraintIndex cx = constraintOfMult[j];
+            const ConstraintImpl& crep = constraints[cx]->getImpl();
+            const SBInstancePerConstraintInfo& 
+                                  cInfo = ic.getConstraintInstanceInfo(cx);
+            const int ncb = crep.getNumConstrainedBodies();
+            const int ncu = cInfo.getNumConstrainedU();
+
+            // Generate this Constraint's forces for a unit multiplier j.
+            oneF_G.resize(ncb);      onefu.resize(ncu);
+            oneF_G.fill(zeroSV);     onefu.fill(Real(0));
+            if (j < mHolo) {
+                const Segment& seg = cInfo.holoErrSegment;
+                unitLambda.resize(seg.length); unitLambda.fill(Real(0));
+                unitLambda[j-seg.offset] = 1;
+                onefq.resize(cInfo.getNumConstrainedQ()); 
+                onefq.fill(Real(0));
+                crep.addInPositionConstraintForces(s, unitLambda, oneF_G, onefq);
+                crep.convertQForcesToUForces(s, onefq, onefu);
+            } else if (j < mHolo+mNonholo) {
+                const Segment& seg = cInfo.nonholoErrSegment;
+                unitLambda.resize(seg.length); unitLambda.fill(Real(0));
+                unitLambda[j-mHolo-seg.offset] = 1;
+                crep.addInVelocityConstraintForces(s, unitLambda, oneF_G, onefu);
+            } else {
+                const Segment& seg = cInfo.accOnlyErrSegment;
+                unitLambda.resize(seg.length); unitLambda.fill(Real(0));
+                unitLambda[j-mHolo-mNonholo-seg.offset] = 1;
+                crep.addInAccelerationConstraintForces
+                                                (s, unitLambda, oneF_G, onefu);
+            }
+            const Rotation R_GA = crep.isAncestorDifferentFromGround()
+                ? crep.getAncestorMobilizedBody().getBodyRotation(s)
+                : Rotation();
+
+            // Map the forces on this tree's bodies to its mobilities, and
+            // add in the forces applied directly to its mobilities. The
+            // result is column j of ~G restricted to the tree.
+            for (ConstrainedBodyIndex cbx(0); cbx < ncb; ++cbx) {
+                const MobilizedBodyIndex mbx = 
+                    crep.getMobilizedBodyIndexOfConstrainedBody(cbx);
+                if (treeOfNode[mbx] == tree)
+                    F_G[mbx] += R_GA*oneF_G[cbx];
+            }
+            for (int i=nn-1; i >= 0; --i)
+                nodes[i]->multiplyBySystemJacobianTranspose(tpc, z.begin(),
+                                                F_G.begin(), fu.begin());
+            for (ConstrainedBodyIndex cbx(0); cbx < ncb; ++cbx)
+                F_G[crep.getMobilizedBodyIndexOfConstrainedBody(cbx)] = zeroSV;
+            for (ConstrainedUIndex cux(0); cux < ncu; ++cux) {
+                const UIndex ux = cInfo.getUIndexFromConstrainedU(cux);
+                if (treeOfU[ux] == tree)
+                    fu[ux] += onefu[cux];
+            }
+
+            // ulike = M_t^-1 * fu.
+            for (int i=nn-1; i >= 0; --i)
+                nodes[i]->multiplyByMInvPass1Inward(ic, tpc, abc, fu.begin(),
+                                    z.begin(), zPlus.begin(), eps.begin());
+            for (int i=0; i < nn; ++i)
+                nodes[i]->multiplyByMInvPass2Outward(ic, tpc, abc, 
+                                    eps.begin(), MInvA_GB.begin(), ulike.begin());
+
+            // Body velocities J*ulike, qlike = N*ulike for holonomic 
+            // constraints, and body accelerations J*ulike + Jdot*u for the
+            // others, all for just this tree.
+            for (int i=0; i < nn; ++i) {
+                const RigidBodyNode& node = *nodes[i];
+                node.multiplyBySystemJacobian(tpc, ulike.begin(), V_GB.begin());
+                const MobilizedBodyIndex mbx(node.getNodeNum());
+                if (allAC_GB)
+                    A_GB[mbx] = V_GB[mbx] + (*allAC_GB)[mbx];
+                if (mHolo && node.getMaxNQ()) {
+                    // See multiplyByN() about the unused q element.
+                    qlike[node.getQIndex() + node.getMaxNQ()-1] = 0;
+                    node.multiplyByN(sbState, false, 
+                                     &ulike[node.getUIndex()],
+                                     &qlike[node.getQIndex()]);
+                }
+            }
+
+            // Row entries of G_t*ulike come from this tree's Constraints.
+            for (ConstraintIndex ecx : treeConstraints[tree]) {
+                const ConstraintImpl& erep = constraints[ecx]->getImpl();
+                const SBInstancePerConstraintInfo& 
+                                      eInfo = ic.getConstraintInstanceInfo(ecx);
+                const Segment& holoSeg    = eInfo.holoErrSegment;
+                const Segment& nonholoSeg = eInfo.nonholoErrSegment;
+                const Segment& accOnlySeg = eInfo.accOnlyErrSegment;
+                const int mp = holoSeg.length;
+                const int mv = nonholoSeg.length;
+                const int ma = accOnlySeg.length;
+
+                if (mp) {
+                    const int encq = eInfo.getNumConstrainedQ();
+                    erep.convertBodyVelocityToConstrainedBodyVelocity
+                                                            (s, V_GB, V_AB);
+                    qdot.resize(encq);
+                    for (ConstrainedQIndex cqx(0); cqx < encq; ++cqx)
+                        qdot[cqx] = qlike[eInfo.getQIndexFromConstrainedQ(cqx)];
+                    err.resize(mp);
+                    erep.calcPositionDotErrors(s, V_AB, qdot, err);
+                    for (int i=0; i < mp; ++i) {
+                        const int row = holoSeg.offset+i;
+                        block(rowOfMult[row], c) = err[i] - bias[row];
+                    }
+                }
+
+                if (!(mv || ma))
+                    continue;
+
+                const int encu = eInfo.getNumConstrainedU();
+                erep.convertBodyAccelToConstrainedBodyAccel(s, A_GB, A_AB);
+                udot.resize(encu);
+                for (ConstrainedUIndex cux(0); cux < encu; ++cux)
+                    udot[cux] = ulike[eInfo.getUIndexFromConstrainedU(cux)];
+                if (mv) {
+                    err.resize(mv);
+                    erep.calcVelocityDotErrors(s, A_AB, udot, err);
+                    for (int i=0; i < mv; ++i) {
+                        const int row = mHolo+nonholoSeg.offset+i;
+                        block(rowOfMult[row], c) = err[i] - bias[row];
+                    }
+                }
+                if (ma) {
+                    err.resize(ma);
+                    erep.calcAccelerationErrors(s, A_AB, udot, err);
+                    for (int i=0; i < ma; ++i) {
+                        const int row = mHolo+mNonholo+accOnlySeg.offset+i;
+                        block(rowOfMult[row], c) = err[i] - bias[row];
+                    }
+                }
+            }
+        }
+        GMInvGt.addBlock(mults, block);
+
+        // Leave nothing of this tree behind in the scratch arrays.
+        for (int i=0; i < nn; ++i) {
+            const RigidBodyNode& node = *nodes[i];
+            const MobilizedBodyIndex mbx(node.getNodeNum());
+            V_GB[mbx] = zeroSV;
+            if (allAC_GB)
+                A_GB[mbx] = (*allAC_GB)[mbx];
+            for (int u=0; u < node.getDOF(); ++u)
+                ulike[node.getUIndex()+u] = 0;
+            for (int q=0; q < node.getMaxNQ(); ++q)
+                qlike[node.getQIndex()+q] = 0;
+        }
+    }
+}
+
+
+
 // =============================================================================
 //                     SOLVE FOR CONSTRAINT IMPULSES
 // =============================================================================
@@ -4080,6 +4440,62 @@ void SimbodyMatterSubsystemRep::enforcePositionConstraints
 
 
 
+//==============================================================================
+//                            SOLVE MINIMUM NORM CG
+//==============================================================================
+// Used by projectQ() and projectU() when iterative projection is enabled.
+// Find the minimum-norm solution x of the underdetermined system A x = b
+// without forming A, given operators multA(x, Ax) and multAt(y, Aty). This is
+// conjugate gradients on A ~A y = b with x = ~A y (Craig's method), using the
+// diagonal preconditioner ooDiag = diag(A ~A)^-1. We accumulate x directly, so
+// each iteration costs one product with A and one with ~A and y is never
+// needed. For a consistent system this converges to the same x as the
+// pseudoinverse, even if A is rank deficient.
+//
+// We stop when the residual b - A x (RMS or infinity norm) is at most tol and
+// return the number of iterations used, or -1 if that didn't happen within
+// maxIts iterations, in which case x is garbage.
+template <class MultA, class MultAt>
+static int solveMinimumNormCG(const MultA&   multA,
+                              const MultAt&  multAt,
+                              const Vector&  ooDiag,
+                              const Vector&  b,
+                              Real           tol,
+                              bool           useNormInf,
+                              int            maxIts,
+                              Vector&        x)
+{
+    Vector r(b), z, p, w, Aw;
+    x = 0; // caller sized this
+    if ((useNormInf ? r.normInf() : r.normRMS()) <= tol)
+        return 0;
+
+    z = r.rowScale(ooDiag);
+    p = z;
+    Real rz = ~r*z;
+    for (int its=1; its <= maxIts; ++its) {
+        multAt(p, w);                   // w = ~A p
+        const Real ww = w.normSqr();    // = ~p (A ~A) p
+        if (!(ww > 0))
+            return -1; // breakdown; A is missing a direction we need
+        const Real alpha = rz/ww;
+        x += alpha*w;                   // x = ~A y
+        multA(w, Aw);
+        r -= alpha*Aw;
+        if ((useNormInf ? r.normInf() : r.normRMS()) <= tol)
+            return its;
+        z = r.rowScale(ooDiag);
+        const Real rzNew = ~r*z;
+        p *= rzNew/rz;
+        p += z;
+        rz = rzNew;
+    }
+    return -1;
+}
+//............................ SOLVE MINIMUM NORM CG ...........................
+
+
+
 //==============================================================================
 //                                  PROJECT Q
 //==============================================================================
@@ -4261,25 +4677,73 @@ int SimbodyMatterSubsystemRep::projectQ
     // if the attempts here make the constraint norm worse.
     const Vector saveQ = getQ(s);
 
-    Matrix Pqwrt(nfq,mHolo);
+    Matrix Pqwrt; // nfq X mp, only if needed
     Vector dfq_WLS(nfq), du(nu), dq(nq); // = Wq^+ dq_WLS
     Vector udfq_WLS(hasPrescribedMotion ? nq : 0); // unpacked if needed
     udfq_WLS.setToZero(); // must initialize unwritten elements
     FactorQTZ Pqwr_qtz;
+    bool isFactored = false; // Pqwr_qtz is for the current q
+
+    // With iterative projection we use these operators instead of forming
+    // Pqwrt; the factorization is used only if the iteration fails, and then
+    // for the rest of this projection.
+    //      A x = Tp P Wu^-1 N^+ unpack(x)   (mp)
+    //    ~A y  = pack(~N^+ Wu^-1 ~P Tp y)   (nfq)
+    bool useCG = useIterativeProjection;
+    const Vector ooDiag = useCG
+        ? getProjectQPreconditioner(s, perrWeights, uAbsScale) : Vector();
+    const int maxCGIts = 2*mHolo + 10;
+    Vector bias_cg, cgq(hasPrescribedMotion ? nq : 0), cgu(nu);
+    cgq.setToZero(); // must initialize unwritten elements
+    auto multA = [&](const Vector& x, Vector& Ax) {
+        if (hasPrescribedMotion) {
+            unpackFreeQ(s, x, cgq); // zeroes in q_p slots
+            multiplyByNInv(s,false,cgq,cgu);
+        } else
+            multiplyByNInv(s,false,x,cgu);
+        cgu.rowScaleInPlace(uAbsScale);
+        multiplyByPVA(s, true, false, false, bias_cg, cgu, Ax);
+        Ax.rowScaleInPlace(perrWeights);
+    };
+    auto multAt = [&](const Vector& y, Vector& Aty) {
+        multiplyByPVATranspose(s, true, false, false, 
+                               y.rowScale(perrWeights), cgu);
+        cgu.rowScaleInPlace(uAbsScale);
+        if (hasPrescribedMotion) {
+            multiplyByNInv(s,true/*transpose*/,cgu,cgq);
+            Aty.resize(nfq); // packFreeQ() doesn't size its output
+            packFreeQ(s, cgq, Aty);
+        } else
+            multiplyByNInv(s,true/*transpose*/,cgu,Aty);
+    };
+
+    // Find the weighted dq_WLS=Wq*dq that removes the scaled errors b, 
+    // iteratively to within tol if we can, otherwise using the pseudoinverse.
+    auto solveWLS = [&](const Vector& b, Real tol) {
+        if (useCG) {
+            calcBiasForMultiplyByPq(s, bias_cg);
+            if (solveMinimumNormCG(multA, multAt, ooDiag, b, tol, useNormInf,
+                                   maxCGIts, dfq_WLS) >= 0)
+                return;
+            useCG = false;
+        }
+        if (!isFactored) {
+            calcWeightedPqrTranspose(s, perrWeights, uAbsScale, Pqwrt);
+            // This factorization acts like a pseudoinverse.
+            Pqwr_qtz.factor<Real>(~Pqwrt, conditioningTol); 
+            isFactored = true;
+        }
+        Pqwr_qtz.solve(b, dfq_WLS);
+    };
+
     Real prevPerrNormAchieved = perrNormAchieved; // watch for divergence
     bool diverged = false;
     const int MaxIterations  = 20;
     do {
-        calcWeightedPqrTranspose(s, perrWeights, uAbsScale, Pqwrt);//nfq X mp
-
-        // This factorization acts like a pseudoinverse.
-        Pqwr_qtz.factor<Real>(~Pqwrt, conditioningTol); 
-
-        //printf("projectQ %d: m=%d condTol=%g rank=%d rcond=%g\n",
-        //    nItsUsed, Pqwrt.ncol(), conditioningTol, Pqwr_qtz.getRank(),
-        //    Pqwr_qtz.getRCondEstimate());
-
-        Pqwr_qtz.solve(scaledPerrs, dfq_WLS); // this is weighted dq_WLS=Wq*dq
+        // Each Newton step needs to remove only most of the current error.
+        isFactored = false; // q has changed
+        solveWLS(scaledPerrs, std::max(Real(0.1)*consAccuracyToTryFor,
+                                       Real(0.01)*perrNormAchieved));
         lastChangeMadeWRMS = dfq_WLS.normRMS(); // change in weighted norm
 
         // switch back to unweighted dq=Wq^+*dq_WLS
@@ -4394,13 +4858,13 @@ int SimbodyMatterSubsystemRep::projectQ
             zeroKnownQ(s, qErrest_0); // zero out prescribed entries
             multiplyByPq(s, bias_p, qErrest_0, Tp_Pq_qErrest); // (Pq*qErrest)_r
             Tp_Pq_qErrest.rowScaleInPlace(perrWeights); // now Tp*(Pq*qErrest)_r
-            Pqwr_qtz.solve(Tp_Pq_qErrest, dfq_WLS); // weighted
+            solveWLS(Tp_Pq_qErrest, Real(0.1)*consAccuracyToTryFor);// weighted
             unpackFreeQ(s, dfq_WLS, udfq_WLS); // zeroes in q_p slots
             multiplyByNInv(s,false,udfq_WLS,du);
         } else {
             multiplyByPq(s, bias_p, qErrest, Tp_Pq_qErrest); // Pq*qErrest
             Tp_Pq_qErrest.rowScaleInPlace(perrWeights); // now Tp*Pq*qErrest
-            Pqwr_qtz.solve(Tp_Pq_qErrest, dfq_WLS); // weighted
+            solveWLS(Tp_Pq_qErrest, Real(0.1)*consAccuracyToTryFor);// weighted
             multiplyByNInv(s,false,dfq_WLS,du);
         }
         // Here du = du_WLS = N^+ * dq_WLS
@@ -4798,28 +5262,74 @@ int SimbodyMatterSubsystemRep::projectU
     // if the attempts here make the constraint norm worse.
     const Vector saveU = getU(s);
 
-    Matrix PVwrt(nfu, mHolo+mNonholo);
+    Matrix PVwrt; // nfu X (mp+mv), only if needed
     Vector dfu_WLS(nfu);
     Vector du(nu); // unpacked into here if necessary
     if (hasPrescribedMotion)
         du.setToZero(); // must initialize unwritten elements
 
-    calcWeightedPVrTranspose(s, pverrWeights, uRelScale, PVwrt);
-    // PVwrt is now Eu^-1 (Pt Vt) Tpv
-
-    // Calculate pseudoinverse (just once)
     FactorQTZ PVwr_qtz;
-    PVwr_qtz.factor<Real>(~PVwrt, conditioningTol);
+    bool isFactored = false;
+
+    // With iterative projection we use these operators instead of forming
+    // PVwrt; the factorization is used only if the iteration fails, and then
+    // for the rest of this projection.
+    //      A x = Tpv [P;V] Eu^-1 unpack(x)   (mp+mv)
+    //    ~A y  = pack(Eu^-1 ~[P;V] Tpv y)    (nfu)
+    bool useCG = useIterativeProjection;
+    const Vector ooDiag = useCG
+        ? getProjectUPreconditioner(s, pverrWeights, uRelScale) : Vector();
+    const int maxCGIts = 2*(mHolo+mNonholo) + 10;
+    Vector bias_cg, cgu(nu);
+    cgu.setToZero(); // must initialize unwritten elements
+    auto multA = [&](const Vector& x, Vector& Ax) {
+        if (hasPrescribedMotion) {
+            unpackFreeU(s, x, cgu); // zeroes in u_p slots
+            cgu.rowScaleInPlace(uRelScale);
+        } else
+            cgu = x.rowScale(uRelScale);
+        multiplyByPVA(s, true, true, false, bias_cg, cgu, Ax);
+        Ax.rowScaleInPlace(pverrWeights);
+    };
+    auto multAt = [&](const Vector& y, Vector& Aty) {
+        multiplyByPVATranspose(s, true, true, false, 
+                               y.rowScale(pverrWeights), cgu);
+        cgu.rowScaleInPlace(uRelScale);
+        if (hasPrescribedMotion) {
+            Aty.resize(nfu); // packFreeU() doesn't size its output
+            packFreeU(s, cgu, Aty);
+        } else
+            Aty = cgu;
+    };
+
+    // Find the weighted du_WLS=Eu*du that removes the scaled errors b, 
+    // iteratively to within tol if we can, otherwise using the pseudoinverse.
+    auto solveWLS = [&](const Vector& b, Real tol) {
+        if (useCG) {
+            calcBiasForMultiplyByPVA(s, true, true, false, bias_cg);
+            if (solveMinimumNormCG(multA, multAt, ooDiag, b, tol, useNormInf,
+                                   maxCGIts, dfu_WLS) >= 0)
+                return;
+            useCG = false;
+        }
+        if (!isFactored) {
+            calcWeightedPVrTranspose(s, pverrWeights, uRelScale, PVwrt);
+            // PVwrt is now Eu^-1 (Pt Vt) Tpv
 
-    //printf("projectU m=%d condTol=%g rank=%d rcond=%g\n",
-    //    PVwrt.ncol(), conditioningTol, PVwr_qtz.getRank(),
-    //    PVwr_qtz.getRCondEstimate());
+            // Calculate pseudoinverse (just once)
+            PVwr_qtz.factor<Real>(~PVwrt, conditioningTol);
+            isFactored = true;
+        }
+        PVwr_qtz.solve(b, dfu_WLS);
+    };
 
     Real prevPVerrNormAchieved = pverrNormAchieved; // watch for divergence
     bool diverged = false;
     const int MaxIterations  = 7;
     do {
-        PVwr_qtz.solve(scaledPVerrs, dfu_WLS);
+        // Each step needs to remove only most of the current error.
+        solveWLS(scaledPVerrs, std::max(Real(0.1)*consAccuracyToTryFor,
+                                        Real(0.01)*pverrNormAchieved));
         lastChangeMadeWRMS = dfu_WLS.normRMS(); // change in weighted norm
 
         // switch back to unweighted du=Eu^-1*du_WLS
@@ -4921,12 +5431,13 @@ int SimbodyMatterSubsystemRep::projectU
             multiplyByPVA(s,true,true,false,bias_pv,
                             uErrest_0,Tpv_PV_uErrest);
             Tpv_PV_uErrest.rowScaleInPlace(pverrWeights); // = Tpv*PV*uErrest_0
-            PVwr_qtz.solve(Tpv_PV_uErrest, dfu_WLS);
+            solveWLS(Tpv_PV_uErrest, Real(0.1)*consAccuracyToTryFor);
             unpackFreeU(s, dfu_WLS, du); // still weighted
         } else {
             multiplyByPVA(s,true,true,false,bias_pv,uErrest,Tpv_PV_uErrest);
             Tpv_PV_uErrest.rowScaleInPlace(pverrWeights); // = Tpv PV uErrEst
-            PVwr_qtz.solve(Tpv_PV_uErrest, du);
+            solveWLS(Tpv_PV_uErrest, Real(0.1)*consAccuracyToTryFor);
+            du = dfu_WLS;
         }
         du.rowScaleInPlace(uRelScale); // now du=Eu^-1*unpack(dfu_WLS)
         uErrest -= du; // this is unweighted now
@@ -5324,22 +5835,18 @@ void SimbodyMatterSubsystemRep::calcTreeAccelerations(const State& s,
     for (int i=0; i < (int)ic.zeroUDot.size(); ++i)
         udotPtr[ic.zeroUDot[i]] = 0;
 
-    for (int i=rbNodeLevels.size()-1 ; i>=0 ; i--) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
-            const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.calcUDotPass1Inward(ic,tpc,abc,abvc,
-                mobilityForcePtr, bodyForcePtr, udotPtr, zPtr, zPlusPtr,
-                hingeForcePtr);
-        }
+    sweepTreeInward([&](const RigidBodyNode& node) {
+        node.calcUDotPass1Inward(ic,tpc,abc,abvc,
+            mobilityForcePtr, bodyForcePtr, udotPtr, zPtr, zPlusPtr,
+            hingeForcePtr);
+    });
 
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
-            const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.calcUDotPass2Outward(ic,tpc,abc,tvc,dc, 
-                hingeForcePtr, aPtr, udotPtr, tauPtr);
-            node.calcQDotDot(sbs, &udotPtr[node.getUIndex()], 
-                             &qdotdotPtr[node.getQIndex()]);
-        }
+    sweepTreeOutward([&](const RigidBodyNode& node) {
+        node.calcUDotPass2Outward(ic,tpc,abc,tvc,dc, 
+            hingeForcePtr, aPtr, udotPtr, tauPtr);
+        node.calcQDotDot(sbs, &udotPtr[node.getUIndex()], 
+                         &qdotdotPtr[node.getQIndex()]);
+    });
 }
 //......................... CALC TREE ACCELERATIONS ............................
 
@@ -5482,6 +5989,70 @@ void SimbodyMatterSubsystemRep::calcM(const State& s, Matrix& M) const {
 
 
 
+//==============================================================================
+//                                 FACTOR M
+//==============================================================================
+// Fill in the tree-sparse mass matrix with the composite rigid body algorithm
+// and factor it. Column k of M, for a mobility k of body B, is the generalized
+// force produced by a unit acceleration of k alone. That is the spatial force
+// F = R_B H_Bk on B's composite body, shifted inward along B's ancestors and
+// projected onto each of their mobilities in turn. These are exactly the
+// entries of row k in the order MassMatrixFactorization stores them.
+void SimbodyMatterSubsystemRep::
+factorM(const State& s, MassMatrixFactorization& MFac) const {
+    SimTK_STAGECHECK_GE_ALWAYS(getStage(s), Stage::Position,
+        "SimbodyMatterSubsystem::factorM()");
+
+    const SBTreePositionCache& tpc = getTreePositionCache(s);
+    const int nb = getNumBodies();
+    const int nu = getTotalDOF();
+
+    // The parent of a mobility is the one before it on the same mobilizer,
+    // or the last mobility of the nearest inboard body that has any.
+    Array_<int,MobilizedBodyIndex> lastU(nb, -1);
+    Array_<int> parent(nu);
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        const RigidBodyNode& node = getRigidBodyNode(mbx);
+        const int u0 = node.getUIndex(), ndof = node.getDOF();
+        const int inboard = lastU[node.getParent()->getNodeNum()];
+        for (int c=0; c < ndof; ++c)
+            parent[u0+c] = c==0 ? inboard : u0+c-1;
+        lastU[mbx] = ndof ? u0+ndof-1 : inboard;
+    }
+    MFac.setStructure(parent);
+    if (nu == 0) {MFac.factor(); return;}
+
+    realizeCompositeBodyInertias(s);
+    const Array_<SpatialInertia,MobilizedBodyIndex>& R =
+        getCompositeBodyInertiaCache(s).compositeBodyInertia;
+
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        const RigidBodyNode& node = getRigidBodyNode(mbx);
+        const int u0 = node.getUIndex();
+        for (int c=0; c < node.getDOF(); ++c) {
+            Real* row = MFac.updRow(u0+c);
+            SpatialVec F = R[mbx] * node.getHCol(tpc, c);
+            int e = 0;
+            for (int r=c; r >= 0; --r)
+                row[e++] = ~node.getHCol(tpc, r) * F;
+
+            const RigidBodyNode* child = &node;
+            for (const RigidBodyNode* anc = node.getParent(); 
+                 !anc->isGroundNode(); child = anc, anc = anc->getParent())
+            {
+                F = child->getPhi(tpc) * F; // shift to ancestor's origin
+                for (int r=anc->getDOF()-1; r >= 0; --r)
+                    row[e++] = ~anc->getHCol(tpc, r) * F;
+            }
+            assert(e == MFac.getRowLength(u0+c));
+        }
+    }
+
+    MFac.factor();
+}
+
+
+
 //==============================================================================
 //                                CALC MInv
 //==============================================================================
@@ -6397,6 +6968,246 @@ void SimbodyMatterSubsystemRep::setShowDefaultGeometry(bool show) {
     showDefaultGeometry = show;
 }
 
+void SimbodyMatterSubsystemRep::setNumberOfThreads(unsigned numThreads) {
+    SimTK_APIARGCHECK_ALWAYS(numThreads > 0, "SimbodyMatterSubsystem",
+        "setNumberOfThreads", "Number of threads must be positive.");
+    if ((int)numThreads == levelExecutor->getMaxThreads())
+        return;
+    levelExecutor = new ParallelExecutor(numThreads);
+    // The subtrees themselves don't depend on the number of threads, so if
+    // the topology has been realized we can just redistribute them rather 
+    // than invalidate it. Otherwise they'll be binned when it is realized.
+    assignSubtreesToBins();
+}
+
+int SimbodyMatterSubsystemRep::getNumberOfThreads() const {
+    return levelExecutor->getMaxThreads();
+}
+
+void SimbodyMatterSubsystemRep::setMinNodesPerParallelLevel(int minNodes) {
+    SimTK_APIARGCHECK1_ALWAYS(minNodes > 0, "SimbodyMatterSubsystem",
+        "setMinNodesPerParallelLevel",
+        "Minimum level width must be positive but was %d.", minNodes);
+    minNodesPerParallelLevel = minNodes;
+}
+
+int SimbodyMatterSubsystemRep::getMinNodesPerParallelLevel() const {
+    return minNodesPerParallelLevel;
+}
+
+void SimbodyMatterSubsystemRep::setParallelSubtreeSplitLevel(int level) {
+    SimTK_APIARGCHECK1_ALWAYS(level > 0, "SimbodyMatterSubsystem",
+        "setParallelSubtreeSplitLevel",
+        "Split level must be at least 1 (the base bodies) but was %d.", level);
+    if (level == parallelSubtreeSplitLevel)
+        return;
+    invalidateSubsystemTopologyCache();
+    parallelSubtreeSplitLevel = level;
+}
+
+int SimbodyMatterSubsystemRep::getParallelSubtreeSplitLevel() const {
+    return parallelSubtreeSplitLevel;
+}
+
+void SimbodyMatterSubsystemRep::setMinNodesForParallelSubtrees(int minNodes) {
+    SimTK_APIARGCHECK1_ALWAYS(minNodes > 0, "SimbodyMatterSubsystem",
+        "setMinNodesForParallelSubtrees",
+        "Minimum subtree size must be positive but was %d.", minNodes);
+    minNodesForParallelSubtrees = minNodes;
+}
+
+int SimbodyMatterSubsystemRep::getMinNodesForParallelSubtrees() const {
+    return minNodesForParallelSubtrees;
+}
+
+
+
+//==============================================================================
+//                           FOR EACH NODE IN LEVEL
+//==============================================================================
+namespace {
+// Each task index processes one contiguous chunk of a level's nodes so that
+// the per-index dispatch cost is paid once per thread rather than per node.
+class LevelChunkTask : public ParallelExecutor::Task {
+public:
+    LevelChunkTask(const RBNodePtrList& nodes, int numChunks,
+                   const std::function<void(const RigidBodyNode&)>& nodeOp)
+    :   nodes(nodes), numChunks(numChunks), nodeOp(nodeOp) {}
+
+    void execute(int chunk) override {
+        const int n = (int)nodes.size();
+        const int begin = (int)((long long)chunk*n/numChunks);
+        const int end   = (int)((long long)(chunk+1)*n/numChunks);
+        for (int j=begin; j < end; ++j)
+            nodeOp(*nodes[j]);
+    }
+private:
+    const RBNodePtrList&                                nodes;
+    const int                                           numChunks;
+    const std::function<void(const RigidBodyNode&)>&    nodeOp;
+};
+}
+
+void SimbodyMatterSubsystemRep::forEachNodeInLevel(int level,
+    const std::function<void(const RigidBodyNode&)>& nodeOp) const
+{
+    const RBNodePtrList& nodes = rbNodeLevels[level];
+    const int numThreads = levelExecutor->getMaxThreads();
+
+    // Stay serial for narrow levels, or if we're already running on a
+    // worker thread, since the executor can't be entered recursively.
+    if (numThreads < 2 || (int)nodes.size() < minNodesPerParallelLevel
+        || ParallelExecutor::isWorkerThread())
+    {
+        for (int j=0; j < (int)nodes.size(); ++j)
+            nodeOp(*nodes[j]);
+        return;
+    }
+
+    const int numChunks = std::min(numThreads, (int)nodes.size());
+    LevelChunkTask task(nodes, numChunks, nodeOp);
+    levelExecutor->execute(task, numChunks);
+}
+
+
+
+//==============================================================================
+//                           PARALLEL SUBTREE SWEEPS
+//==============================================================================
+// Called from endConstruction() once rbNodeLevels is complete. Nodes are
+// stored in the levels in increasing node number order, and a node's parent
+// always has a lower number, so we can find each node's subtree from its 
+// parent's.
+void SimbodyMatterSubsystemRep::buildParallelSubtrees() {
+    subtreeNodeLevels.clear();
+    numSubtreeNodes = 0;
+
+    const int split = parallelSubtreeSplitLevel;
+    if ((int)rbNodeLevels.size() > split) {
+        Array_<int,MobilizedBodyIndex> subtreeOf(getNumMobilizedBodies(), -1);
+        subtreeNodeLevels.resize(rbNodeLevels[split].size());
+        for (int j=0; j < (int)rbNodeLevels[split].size(); ++j) {
+            const RigidBodyNode& root = *rbNodeLevels[split][j];
+            subtreeOf[root.getNodeNum()] = j;
+            subtreeNodeLevels[j].resize(rbNodeLevels.size() - split);
+            subtreeNodeLevels[j][0].push_back(&root);
+        }
+        for (int i=split+1; i < (int)rbNodeLevels.size(); ++i)
+            for (int j=0; j < (int)rbNodeLevels[i].size(); ++j) {
+                const RigidBodyNode& node = *rbNodeLevels[i][j];
+                const int k = subtreeOf[node.getParent()->getNodeNum()];
+                subtreeOf[node.getNodeNum()] = k;
+                subtreeNodeLevels[k][i-split].push_back(&node);
+            }
+        // Drop the empty levels below each subtree's deepest node.
+        for (auto& levels : subtreeNodeLevels) {
+            while (levels.back().empty())
+                levels.pop_back();
+            for (const auto& level : levels)
+                numSubtreeNodes += (int)level.size();
+        }
+    }
+
+    assignSubtreesToBins();
+}
+
+// Greedy longest-processing-time assignment: consider subtrees from largest
+// to smallest, putting each in the bin that currently has the fewest nodes.
+void SimbodyMatterSubsystemRep::assignSubtreesToBins() {
+    subtreeBins.clear();
+    const int numThreads = levelExecutor->getMaxThreads();
+    const int numSubtrees = (int)subtreeNodeLevels.size();
+    if (numThreads < 2 || numSubtrees < 2)
+        return;
+
+    Array_<int> subtreeSize(numSubtrees, 0), order(numSubtrees);
+    for (int k=0; k < numSubtrees; ++k) {
+        order[k] = k;
+        for (const auto& level : subtreeNodeLevels[k])
+            subtreeSize[k] += (int)level.size();
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+                     {   return subtreeSize[a] > subtreeSize[b]; });
+
+    subtreeBins.resize(std::min(numThreads, numSubtrees));
+    Array_<int> binSize(subtreeBins.size(), 0);
+    for (int k : order) {
+        const int bin = (int)(std::min_element(binSize.begin(), binSize.end())
+                              - binSize.begin());
+        subtreeBins[bin].push_back(k);
+        binSize[bin] += subtreeSize[k];
+    }
+}
+
+namespace {
+// Each task index sweeps all the subtrees in one bin, inward or outward.
+class SubtreeBinTask : public ParallelExecutor::Task {
+public:
+    SubtreeBinTask(const Array_< Array_<RBNodePtrList> >& subtreeNodeLevels,
+                   const Array_< Array_<int> >& bins, bool inward,
+                   const std::function<void(const RigidBodyNode&)>& nodeOp)
+    :   subtreeNodeLevels(subtreeNodeLevels), bins(bins), inward(inward),
+        nodeOp(nodeOp) {}
+
+    void execute(int bin) override {
+        for (int k : bins[bin]) {
+            const Array_<RBNodePtrList>& levels = subtreeNodeLevels[k];
+            const int nLevels = (int)levels.size();
+            for (int l=0; l < nLevels; ++l) {
+                const RBNodePtrList& nodes = levels[inward ? nLevels-1-l : l];
+                for (int j=0; j < (int)nodes.size(); ++j)
+                    nodeOp(*nodes[j]);
+            }
+        }
+    }
+private:
+    const Array_< Array_<RBNodePtrList> >&              subtreeNodeLevels;
+    const Array_< Array_<int> >&                        bins;
+    const bool                                          inward;
+    const std::function<void(const RigidBodyNode&)>&    nodeOp;
+};
+}
+
+void SimbodyMatterSubsystemRep::sweepTreeInward
+   (const std::function<void(const RigidBodyNode&)>& nodeOp) const
+{
+    const int nLevels = (int)rbNodeLevels.size();
+    int firstTrunkLevel = nLevels-1; // serial from here down to Ground
+
+    if (subtreeBins.size() >= 2 
+        && numSubtreeNodes >= minNodesForParallelSubtrees
+        && !ParallelExecutor::isWorkerThread())
+    {
+        SubtreeBinTask task(subtreeNodeLevels, subtreeBins, true, nodeOp);
+        levelExecutor->execute(task, (int)subtreeBins.size());
+        firstTrunkLevel = parallelSubtreeSplitLevel-1;
+    }
+
+    for (int i=firstTrunkLevel ; i>=0 ; --i) 
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
+            nodeOp(*rbNodeLevels[i][j]);
+}
+
+void SimbodyMatterSubsystemRep::sweepTreeOutward
+   (const std::function<void(const RigidBodyNode&)>& nodeOp) const
+{
+    const int nLevels = (int)rbNodeLevels.size();
+    const bool inParallel = subtreeBins.size() >= 2 
+        && numSubtreeNodes >= minNodesForParallelSubtrees
+        && !ParallelExecutor::isWorkerThread();
+    const int endTrunkLevel = 
+        inParallel ? parallelSubtreeSplitLevel : nLevels;
+
+    for (int i=0 ; i<endTrunkLevel ; ++i) 
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
+            nodeOp(*rbNodeLevels[i][j]);
+
+    if (inParallel) {
+        SubtreeBinTask task(subtreeNodeLevels, subtreeBins, false, nodeOp);
+        levelExecutor->execute(task, (int)subtreeBins.size());
+    }
+}
+
 std::ostream& operator<<(std::ostream& o, const SimbodyMatterSubsystemRep& tree) {
     o << "SimbodyMatterSubsystemRep has " << tree.getNumBodies() << " bodies (incl. G) in "
       << tree.rbNodeLevels.size() << " levels." << std::endl;
@@ -6428,20 +7239,35 @@ void SBStateDigest::fillThroughStage(const SimbodyMatterSubsystemRep& matter, St
         q = &matter.getQ(state);
         u = &matter.getU(state);
     }
+    // Cache entries that have already been realized and can no longer be 
+    // written at stage g are taken read-only. Asking for write access would
+    // clone any entry that a copied State still shares with its source.
+    const Stage done = matter.getStage(state);
     if (g >= Stage::Model) {
         mv = &matter.getModelVars(state);
-        mc = &matter.updModelCache(state);
+        if (g == Stage::Model || done < Stage::Model)
+            mc = updMC = &matter.updModelCache(state);
+        else
+            mc = &matter.getModelCache(state);
         iv = &matter.getInstanceVars(state);
     }
     if (g >= Stage::Instance) {
-        if (topo.instanceCacheIndex.isValid())
-            ic = &matter.updInstanceCache(state);
+        if (topo.instanceCacheIndex.isValid()) {
+            if (g == Stage::Instance || done < Stage::Instance)
+                ic = updIC = &matter.updInstanceCache(state);
+            else
+                ic = &matter.getInstanceCache(state);
+        }
         
-        // All cache entries, for any stage, can be modified at instance stage 
-        // or later.
+        // All other cache entries, for any stage, can be modified at instance
+        // stage or later.
         
-        if (topo.timeCacheIndex.isValid())
-            tc = &matter.updTimeCache(state);
+        if (topo.timeCacheIndex.isValid()) {
+            if (g <= Stage::Time || done < Stage::Time)
+                tc = updTC = &matter.updTimeCache(state);
+            else
+                tc = &matter.getTimeCache(state);
+        }
         if (topo.treePositionCacheIndex.isValid())
             tpc = &matter.updTreePositionCache(state);
         if (topo.constrainedPositionCacheIndex.isValid())
@@ -6450,8 +7276,12 @@ void SBStateDigest::fillThroughStage(const SimbodyMatterSubsystemRep& matter, St
             tvc = &matter.updTreeVelocityCache(state);
         if (topo.constrainedVelocityCacheIndex.isValid())
             cvc = &matter.updConstrainedVelocityCache(state);
-        if (topo.dynamicsCacheIndex.isValid())
-            dc = &matter.updDynamicsCache(state);
+        if (topo.dynamicsCacheIndex.isValid()) {
+            if (g <= Stage::Dynamics || done < Stage::Dynamics)
+                dc = updDC = &matter.updDynamicsCache(state);
+            else
+                dc = &matter.getDynamicsCache(state);
+        }
         if (topo.treeAccelerationCacheIndex.isValid())
             tac = &matter.updTreeAccelerationCache(state);
         if (topo.constrainedAccelerationCacheIndex.isValid())
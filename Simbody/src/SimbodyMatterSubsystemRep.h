@@ -30,6 +30,8 @@
 #include "simbody/internal/MultibodySystem.h"
 #include "simbody/internal/SimbodyMatterSubsystem.h"
 #include "simbody/internal/SimbodyMatterSubtree.h"
+#include "simbody/internal/DelassusOperator.h"
+#include "simbody/internal/MassMatrixFactorization.h"
 #include "simbody/internal/MobilizedBody.h"
 #include "simbody/internal/MobilizedBody_Ground.h"
 
@@ -48,6 +50,7 @@ using std::pair;
 #include <map>
 #include <set>
 #include <algorithm>
+#include <functional>
 
 class RigidBodyNode;
 class RBDistanceConstraint;
@@ -141,7 +144,12 @@ private:
 class SimbodyMatterSubsystemRep : public SimTK::Subsystem::Guts {
 public:
     SimbodyMatterSubsystemRep() 
-      : Subsystem::Guts("SimbodyMatterSubsystem", "0.7.1")
+      : Subsystem::Guts("SimbodyMatterSubsystem", "0.7.1"),
+        levelExecutor(new ParallelExecutor(1)),
+        minNodesPerParallelLevel(32),
+        parallelSubtreeSplitLevel(1),
+        minNodesForParallelSubtrees(32),
+        useIterativeProjection(false)
     { 
         clearTopologyCache();
     }
@@ -601,6 +609,11 @@ public:
     // filled in.
     void calcM(const State& s, Matrix& M) const;
 
+    // Calculate only the structurally nonzero entries of the mass matrix in
+    // O(n*depth) time with the composite rigid body algorithm, and factor
+    // them. State must have already been realized to Position stage.
+    void factorM(const State& s, MassMatrixFactorization& MFac) const;
+
     // Calculate the mass matrix inverse in O(n^2) time. State must have already
     // been realized to Position stage. MInv must be resizeable or already the
     // right size (nXn). The result is symmetric but the entire matrix is
@@ -940,6 +953,14 @@ public:
     void calcGMInvGt(const State&   state,
                      Matrix&        GMInvGt) const;
 
+    // Same, but produce the block-sparse form that stores one dense block
+    // for each base body's tree, coupling only the constraint equations whose
+    // forces reach that tree. Costs one column calculation for each 
+    // (equation, tree) pair, each confined to that tree's bodies and
+    // constraints, instead of one whole-system calculation per equation.
+    void calcGMInvGtBlocks(const State&        state,
+                           DelassusOperator&   GMInvGt) const;
+
     // Use factored GMInvGt to solve GMinvGt*impulse=deltaV. The main benefit
     // of this method is that it promises to use the same method Simbody does
     // to deal with constraint redundancies.
@@ -1142,6 +1163,21 @@ public:
             (s.updCacheEntry(getMySubsystemIndex(),topologyCache.constrainedAccelerationCacheIndex)).upd();
     }
 
+    // This lazy cache entry is cleared the first time it is used after
+    // Stage::Instance is invalidated; see SBProjectionPreconditionerCache.
+    SBProjectionPreconditionerCache& updProjectionPreconditionerCache(const State& s) const { //mutable
+        const CacheEntryIndex ppx = topologyCache.projectionPreconditionerCacheIndex;
+        const bool isRealized = isCacheValueRealized(s, ppx);
+        SBProjectionPreconditionerCache& pc = 
+            Value<SBProjectionPreconditionerCache>::updDowncast
+                (s.updCacheEntry(getMySubsystemIndex(),ppx)).upd();
+        if (!isRealized) {
+            pc.clear();
+            markCacheValueRealized(s, ppx);
+        }
+        return pc;
+    }
+
 
     const SBModelVars& getModelVars(const State& s) const {
         return Value<SBModelVars>::downcast
@@ -1213,6 +1249,41 @@ public:
     bool getShowDefaultGeometry() const;
     void setShowDefaultGeometry(bool show);
 
+    void setNumberOfThreads(unsigned numThreads);
+    int getNumberOfThreads() const;
+    void setMinNodesPerParallelLevel(int minNodes);
+    int getMinNodesPerParallelLevel() const;
+
+    // Apply nodeOp to every node at the given tree level. If the level is
+    // wide enough and we have been given more than one thread, the level's
+    // nodes are divided into contiguous chunks that are processed
+    // concurrently; otherwise the nodes are processed here in order. Either
+    // way this returns only after every node in the level is done.
+    void forEachNodeInLevel(int level,
+        const std::function<void(const RigidBodyNode&)>& nodeOp) const;
+
+    void setParallelSubtreeSplitLevel(int level);
+    int getParallelSubtreeSplitLevel() const;
+    void setMinNodesForParallelSubtrees(int minNodes);
+    int getMinNodesForParallelSubtrees() const;
+
+    void setUseIterativeProjection(bool useIterative)
+    {   useIterativeProjection = useIterative; }
+    bool getUseIterativeProjection() const {return useIterativeProjection;}
+
+    // Apply nodeOp to every node in the tree, either tip-to-base (inward) or
+    // base-to-tip (outward). Each node is visited only after all its children
+    // (inward) or its parent (outward). When parallel subtree sweeps are
+    // possible, the disjoint subtrees rooted at parallelSubtreeSplitLevel are
+    // swept concurrently and the trunk above them serially; otherwise this
+    // is the ordinary level-by-level sweep. Node operations that only read
+    // from their children (inward) or parent (outward) produce bitwise
+    // identical results either way.
+    void sweepTreeInward
+       (const std::function<void(const RigidBodyNode&)>& nodeOp) const;
+    void sweepTreeOutward
+       (const std::function<void(const RigidBodyNode&)>& nodeOp) const;
+
     void calcTreeForwardDynamicsOperator(const State&,
         const Vector&                   mobilityForces,
         const Vector_<Vec3>&            particleForces,
@@ -1272,6 +1343,17 @@ public:
         const Vector&    Wuinv, // 1/u weights
         Matrix&          PVrt) const;
 
+    // Return the inverted diagonals of A ~A for the matrices A whose
+    // transposes are calculated by the two methods above, for use as
+    // preconditioners by iterative projection. These are calculated on first
+    // use and then reused until Stage::Instance is invalidated.
+    const Vector& getProjectQPreconditioner(const State&   s,
+                                            const Vector&  Tp,
+                                            const Vector&  ooWu) const;
+    const Vector& getProjectUPreconditioner(const State&   s,
+                                            const Vector&  Tpv,
+                                            const Vector&  ooWu) const;
+
     const Array_<QIndex>& getFreeQIndex(const State& state) const;
     const Array_<QIndex>& getPresQIndex(const State& state) const;
     const Array_<QIndex>& getZeroQIndex(const State& state) const;
@@ -1340,6 +1422,21 @@ private:
     Array_<UnilateralContact*,UnilateralContactIndex>       uniContacts;
     Array_<StateLimitedFriction*,StateLimitedFrictionIndex> stateLtdFriction;
 
+    // For level-parallel kinematic sweeps. The executor has just one thread
+    // unless the user asks for more, in which case levels with at least
+    // minNodesPerParallelLevel nodes are split among the threads.
+    mutable ClonePtr<ParallelExecutor>  levelExecutor;
+    int                                 minNodesPerParallelLevel;
+    // For subtree-parallel inward/outward sweeps: each node at this level
+    // roots a subtree that can be processed independently of the others.
+    // The subtrees are swept concurrently only if together they have at
+    // least minNodesForParallelSubtrees nodes.
+    int                                 parallelSubtreeSplitLevel;
+    int                                 minNodesForParallelSubtrees;
+    // If set, projectQ() and projectU() solve for their corrections with
+    // preconditioned conjugate gradients rather than factoring the Jacobian.
+    bool                                useIterativeProjection;
+
     // Our realizeTopology method calls this after all bodies & constraints have been added,
     // to construct part of the topology cache below.
     void endConstruction(State&);
@@ -1367,6 +1464,20 @@ private:
     // Map nodeNum (a.k.a. MobilizedBodyIndex) to (level,offset).
     Array_<RigidBodyNodeIndex,MobilizedBodyIndex> nodeNum2NodeMap;
 
+    // Partition of the tree used for subtree-parallel sweeps. Subtree k is
+    // rooted at node rbNodeLevels[parallelSubtreeSplitLevel][k], and
+    // subtreeNodeLevels[k][l] lists that subtree's nodes at level 
+    // parallelSubtreeSplitLevel+l. The levels above the split are the trunk.
+    // subtreeBins groups the subtrees into one bin per thread, balanced by
+    // node count; setNumberOfThreads() regroups them without invalidating
+    // the topology.
+    Array_< Array_<RBNodePtrList> >     subtreeNodeLevels;
+    int                                 numSubtreeNodes;
+    Array_< Array_<int> >               subtreeBins;
+
+    void buildParallelSubtrees();
+    void assignSubtreesToBins();
+
         // Constraints
 
     // Here we sort the above constraints by branch (ancestor's base body), then by
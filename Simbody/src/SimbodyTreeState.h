@@ -92,6 +92,7 @@ class SBConstrainedVelocityCache;
 class SBDynamicsCache;
 class SBTreeAccelerationCache;
 class SBConstrainedAccelerationCache;
+class SBProjectionPreconditionerCache;
 
 class SBModelVars;
 class SBInstanceVars;
@@ -156,7 +157,8 @@ public:
                           articulatedBodyVelocityCacheIndex,
                           dynamicsCacheIndex, 
                           treeAccelerationCacheIndex, 
-                          constrainedAccelerationCacheIndex;
+                          constrainedAccelerationCacheIndex,
+                          projectionPreconditionerCacheIndex;
 
 
     // These are instance variables that exist regardless of modeling
@@ -1232,6 +1234,31 @@ public:
 
 
 
+// =============================================================================
+//                      PROJECTION PRECONDITIONER CACHE
+// =============================================================================
+// When iterative constraint projection is in use, this holds the inverted
+// diagonals of A ~A for the weighted position and velocity constraint
+// Jacobians A used by projectQ() and projectU(). These depend on q and u, but
+// they are only preconditioners so we keep them until the set of constraints
+// changes; that is, until Stage::Instance is invalidated. Each is filled in the
+// first time it is needed, so an empty Vector means "not yet calculated".
+
+class SBProjectionPreconditionerCache {
+public:
+    Vector ooDiagQ;     // mp,    for Tp P Wu^-1 N^+
+    Vector ooDiagU;     // mp+mv, for Tpv [P;V] Eu^-1
+
+public:
+    void clear() {
+        ooDiagQ.clear();
+        ooDiagU.clear();
+    }
+};
+//..................... PROJECTION PRECONDITIONER CACHE ........................
+
+
+
 
 /* 
  * Generalized state variable collection for a SimbodyMatterSubsystem. 
@@ -1507,8 +1534,8 @@ public:
     // Model
     SBModelCache& updModelCache() const {
         assert(stage == Stage::Model);
-        assert(mc);
-        return *mc;
+        assert(updMC);
+        return *updMC;
     }
     const SBModelCache& getModelCache() const {
         assert(stage > Stage::Model);
@@ -1519,8 +1546,8 @@ public:
     // Instance
     SBInstanceCache& updInstanceCache() const {
         assert(stage == Stage::Instance);
-        assert(ic);
-        return *ic;
+        assert(updIC);
+        return *updIC;
     }
     const SBInstanceCache& getInstanceCache() const {
         assert(stage > Stage::Instance);
@@ -1531,8 +1558,8 @@ public:
     // Time
     SBTimeCache& updTimeCache() const {
         assert(stage >= Stage::Instance && stage <= Stage::Time);
-        assert(tc);
-        return *tc;
+        assert(updTC);
+        return *updTC;
     }
     const SBTimeCache& getTimeCache() const {
         assert(stage > Stage::Time);
@@ -1617,8 +1644,8 @@ public:
     // Dynamics
     SBDynamicsCache& updDynamicsCache() const {
         assert(stage >= Stage::Instance && stage <= Stage::Dynamics);
-        assert(dc);
-        return *dc;
+        assert(updDC);
+        return *updDC;
     }
     const SBDynamicsCache& getDynamicsCache() const {
         assert(stage > Stage::Dynamics);
@@ -1689,9 +1716,10 @@ public:
 
         // cache
         mc=0; ic=0; tc=0; 
+        updMC=0; updIC=0; updTC=0;
         qErr=0; tpc=0; cpc=0;
         qdot=uErr=0; tvc=0; cvc=0; 
-        dc=0; 
+        dc=0; updDC=0;
         udot=qdotdot=udotErr=0; tac=0; cac=0;
     }
 
@@ -1712,9 +1740,17 @@ private:
     const SBDynamicsVars*           dv;
     const SBAccelerationVars*       av;
 
-    SBModelCache*                   mc;
-    SBInstanceCache*                ic;
-    SBTimeCache*                    tc;
+    // The model, instance, time and dynamics caches are read-only once
+    // their stage has been realized. They are then obtained with const
+    // access, so that a State copy that still shares them with its source
+    // doesn't clone them. The upd pointers are set only when the digest is
+    // for a stage at which the entry can still be written.
+    const SBModelCache*             mc;
+    const SBInstanceCache*          ic;
+    const SBTimeCache*              tc;
+    SBModelCache*                   updMC;
+    SBInstanceCache*                updIC;
+    SBTimeCache*                    updTC;
 
     Vector*                         qErr;
     SBTreePositionCache*            tpc;
@@ -1725,7 +1761,8 @@ private:
     SBTreeVelocityCache*            tvc;
     SBConstrainedVelocityCache*     cvc;
 
-    SBDynamicsCache*                dc;
+    const SBDynamicsCache*          dc;
+    SBDynamicsCache*                updDC;
 
     Vector*                         udot;
     Vector*                         qdotdot;
@@ -1166,6 +1166,225 @@ void testRobustInitialPath()
         expectedLength);
 }
 
+/** Solve the paths of many cables concurrently.
+
+A number of cables wrap the same set of obstacles, each from its own moving
+origin. The paths are solved on one thread in one State and on several threads
+in another, and must come out exactly the same. **/
+void testParallelCables()
+{
+    // Create the system.
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    CableSubsystem cables(system);
+
+    // A dummy body.
+    Body::Rigid aBody(MassProperties(1., Vec3(0), Inertia(1)));
+
+    // The obstacles are shared by all cables.
+    std::shared_ptr<ContactGeometry> torus(new ContactGeometry::Torus(1., 0.2));
+    std::shared_ptr<ContactGeometry> ellipsoid(
+        new ContactGeometry::Ellipsoid({1.5, 2.6, 1.}));
+    std::shared_ptr<ContactGeometry> sphere(new ContactGeometry::Sphere(1.));
+    std::shared_ptr<ContactGeometry> cylinder(
+        new ContactGeometry::Cylinder(1.));
+
+    const int numCables = 12;
+    Array_<MobilizedBody::Translation> origins;
+    Array_<CableSpan> cableSpans;
+    for (int i = 0; i < numCables; ++i) {
+        const Real offset = 0.05 * i;
+        origins.push_back(MobilizedBody::Translation(
+            matter.Ground(),
+            Vec3(-8., 0.1 + offset, offset),
+            aBody,
+            Transform()));
+        CableSpan cable(
+            cables,
+            origins.back(),
+            Vec3{0.},
+            matter.Ground(),
+            Vec3{10., 1. - offset, -1.});
+        cable.addObstacle(
+            matter.Ground(),
+            Transform(Rotation(0.5 * Pi, YAxis), Vec3{-4., 0., 0.}),
+            torus,
+            {0.1, 0.2, 0.});
+        cable.addObstacle(
+            matter.Ground(),
+            Transform(Vec3{-1., 0., 0.}),
+            ellipsoid,
+            {0.0, 0., 1.1});
+        cable.addObstacle(
+            matter.Ground(),
+            Transform(Vec3{2.5, 0., 0.}),
+            sphere,
+            {0.1, 1.1, 0.});
+        cable.addObstacle(
+            matter.Ground(),
+            Transform(Rotation(0.5 * Pi, XAxis), Vec3{6., 0., 0.}),
+            cylinder,
+            Vec3{0., -1., 0.});
+        cableSpans.push_back(cable);
+    }
+
+    // Check the thread count settings.
+    SimTK_ASSERT_ALWAYS(
+        cables.getNumberOfThreads() == 1,
+        "Test failed: cable paths should be solved serially by default.");
+    bool threw = false;
+    try {
+        cables.setNumberOfThreads(0);
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    SimTK_ASSERT_ALWAYS(threw, "Test failed: zero threads should be illegal.");
+
+    system.realizeTopology();
+    State serialState   = system.getDefaultState();
+    State parallelState = system.getDefaultState();
+
+    for (Real angle = 0.; angle < 2. * Pi; angle += 0.1) {
+        for (int i = 0; i < numCables; ++i) {
+            const Vec3 q(
+                1.1 * sin(angle + i),
+                5. * sin(angle * 1.5),
+                5. * sin(angle * 2. - 0.1 * i));
+            origins[i].setQ(serialState, q);
+            origins[i].setQ(parallelState, q);
+        }
+
+        cables.setNumberOfThreads(1);
+        system.realize(serialState, Stage::Position);
+        cables.setNumberOfThreads(4);
+        system.realize(parallelState, Stage::Position);
+
+        for (const CableSpan& cable : cableSpans) {
+            SimTK_ASSERT3_ALWAYS(
+                cable.calcLength(serialState) ==
+                    cable.calcLength(parallelState),
+                "Test failed: Cable length on one thread (=%.17g) differs "
+                "from the length on several threads (=%.17g) at angle %f",
+                cable.calcLength(serialState),
+                cable.calcLength(parallelState),
+                angle);
+            SimTK_ASSERT_ALWAYS(
+                cable.getNumSolverIterations(serialState) ==
+                    cable.getNumSolverIterations(parallelState),
+                "Test failed: Cable path solver took a different number of "
+                "iterations on several threads.");
+        }
+
+        // Continue from these paths, as a time stepper would.
+        serialState.autoUpdateDiscreteVariables();
+        parallelState.autoUpdateDiscreteVariables();
+    }
+
+    std::cout << "PASSED TEST: testParallelCables" << std::endl;
+}
+
+/** Warm start the geodesics over implicit surfaces.
+
+Two identical cables wrap a torus and an ellipsoid, one of them warm starting
+its geodesics from the previous ones. Both must find the same paths. **/
+void testWarmStartedGeodesics()
+{
+    // Create the system.
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    CableSubsystem cables(system);
+
+    // A dummy body.
+    Body::Rigid aBody(MassProperties(1., Vec3(0), Inertia(1)));
+    MobilizedBody::Translation cableOriginBody(
+        matter.Ground(),
+        Vec3(-8., 0.1, 0.),
+        aBody,
+        Transform());
+
+    std::shared_ptr<ContactGeometry> torus(new ContactGeometry::Torus(1., 0.2));
+    std::shared_ptr<ContactGeometry> ellipsoid(
+        new ContactGeometry::Ellipsoid({1.5, 2.6, 1.}));
+
+    Array_<CableSpan> cableSpans;
+    for (int i = 0; i < 2; ++i) {
+        CableSpan cable(
+            cables,
+            cableOriginBody,
+            Vec3{0.},
+            matter.Ground(),
+            Vec3{4., 1., -1.});
+        cable.addObstacle(
+            matter.Ground(),
+            Transform(Rotation(0.5 * Pi, YAxis), Vec3{-4., 0., 0.}),
+            torus,
+            {0.1, 0.2, 0.});
+        cable.addObstacle(
+            matter.Ground(),
+            Transform(Vec3{-1., 0., 0.}),
+            ellipsoid,
+            {0.0, 0., 1.1});
+        cableSpans.push_back(cable);
+    }
+    CableSpan& coldCable = cableSpans[0];
+    CableSpan& warmCable = cableSpans[1];
+
+    SimTK_ASSERT_ALWAYS(
+        !coldCable.getWarmStartGeodesics(),
+        "Test failed: warm starting geodesics should be disabled by default.");
+    warmCable.setWarmStartGeodesics(true);
+
+    system.realizeTopology();
+    State s = system.getDefaultState();
+
+    for (Real angle = 0.; angle < 2. * Pi; angle += 0.05) {
+        cableOriginBody.setQ(
+            s,
+            Vec3(
+                1.1 * sin(angle),
+                5. * sin(angle * 1.5),
+                5. * sin(angle * 2.)));
+        system.realize(s, Stage::Position);
+
+        SimTK_ASSERT3_ALWAYS(
+            std::abs(coldCable.calcLength(s) - warmCable.calcLength(s)) < 1e-6,
+            "Test failed: Cable length with warm started geodesics (=%.17g) "
+            "differs from the length without (=%.17g) at angle %f",
+            warmCable.calcLength(s),
+            coldCable.calcLength(s),
+            angle);
+        SimTK_ASSERT_ALWAYS(
+            warmCable.getSmoothness(s) <= warmCable.getSmoothnessTolerance(),
+            "Test failed: Cable path with warm started geodesics was not "
+            "solved.");
+
+        // The warm started geodesics must end up on the same path.
+        for (CableSpanObstacleIndex ix(0); ix < warmCable.getNumObstacles();
+             ++ix) {
+            SimTK_ASSERT_ALWAYS(
+                coldCable.isInContactWithObstacle(s, ix) ==
+                    warmCable.isInContactWithObstacle(s, ix),
+                "Test failed: Warm started geodesics changed obstacle "
+                "contact.");
+            if (!warmCable.isInContactWithObstacle(s, ix)) {
+                continue;
+            }
+            const Vec3 coldEnd =
+                coldCable.calcCurveSegmentFinalFrenetFrame(s, ix).p();
+            const Vec3 warmEnd =
+                warmCable.calcCurveSegmentFinalFrenetFrame(s, ix).p();
+            SimTK_ASSERT_ALWAYS(
+                (coldEnd - warmEnd).norm() < 1e-6,
+                "Test failed: Warm started geodesic ends at a different "
+                "point.");
+        }
+
+        s.autoUpdateDiscreteVariables();
+    }
+
+    std::cout << "PASSED TEST: testWarmStartedGeodesics" << std::endl;
+}
+
 int main()
 {
     testSimpleCable();
@@ -1175,4 +1394,6 @@ int main()
     testAllSurfaceKinds(true);  // Test length derivative.
     testSolverOptimum();
     testRobustInitialPath();
+    testParallelCables();
+    testWarmStartedGeodesics();
 }
@@ -148,6 +148,53 @@ void testSphereSphere() {
     }
 }
 
+// Move many spheres by small amounts, as between time steps, and check that
+// the warm-started sweep finds the same contacts and tests the same pairs as
+// sorting from scratch each time.
+void testSweepWarmStart() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    GeneralContactSubsystem contacts(system);
+    const int numBodies = 200;
+    Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+    ContactSetIndex setIndex = contacts.createContactSet();
+    for (int i = 0; i < numBodies; ++i) {
+        MobilizedBody::Free b(matter.updGround(), Transform(), body, Transform());
+        contacts.addBody(setIndex, b, ContactGeometry::Sphere(0.1), Transform());
+    }
+    ASSERT(contacts.getUseWarmStart());
+    State state = system.realizeTopology();
+    Random::Uniform random(0.0, 1.0);
+    Array_<Vec3> positions(numBodies);
+    for (int i = 0; i < numBodies; i++)
+        positions[i] = Vec3(5*random.getValue(), random.getValue(), random.getValue());
+    int totalKept = 0;
+    for (int iteration = 0; iteration < 50; ++iteration) {
+        for (int i = 0; i < numBodies; i++) {
+            positions[i] += 0.02*Vec3(random.getValue()-0.5, random.getValue()-0.5, random.getValue()-0.5);
+            matter.getMobilizedBody(MobilizedBodyIndex(i+1)).setQToFitTranslation(state, positions[i]);
+        }
+        system.realize(state, Stage::Velocity);
+        SimTK_TEST_MUST_THROW(contacts.getNumPairsTested(state, setIndex)); // stale until Dynamics
+        contacts.setUseWarmStart(true);
+        system.realize(state, Stage::Dynamics);
+        const int numContacts = contacts.getContacts(state, setIndex).size();
+        const int tested = contacts.getNumPairsTested(state, setIndex);
+        const int kept = contacts.getNumPairsKept(state, setIndex);
+        ASSERT(numContacts <= kept && kept <= tested);
+        totalKept += kept;
+
+        State fresh = state;
+        fresh.invalidateAllCacheAtOrAbove(Stage::Position);
+        contacts.setUseWarmStart(false);
+        system.realize(fresh, Stage::Dynamics);
+        ASSERT(contacts.getContacts(fresh, setIndex).size() == numContacts);
+        ASSERT(contacts.getNumPairsTested(fresh, setIndex) == tested);
+        ASSERT(contacts.getNumPairsKept(fresh, setIndex) == kept);
+    }
+    ASSERT(totalKept > 0);
+}
+
 void testHalfSpaceEllipsoid() {
     MultibodySystem system;
     SimbodyMatterSubsystem matter(system);
@@ -536,6 +583,7 @@ int main() {
     try {
         testHalfSpaceSphere();
         testSphereSphere();
+        testSweepWarmStart();
         testHalfSpaceEllipsoid();
         testEllipsoidEllipsoid();
         testHalfSpaceTriangleMesh();
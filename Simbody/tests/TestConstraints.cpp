@@ -605,6 +605,197 @@ void testConstraintMatrices() {
     delete &system;
 }
 
+// Test the block-sparse form of G*M^-1*~G against the dense one. The system is
+// a forest: a chain, two free bodies, and a pin-jointed pair, with constraints
+// inside one tree, between two trees, and between a tree and Ground, so the
+// operator ends up with several blocks of different sizes.
+void testBlockSparseProjectedMInv() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body(MassProperties(1.5, Vec3(.1,.2,-.03), 
+                     UnitInertia(1.1, 1.2, 1.3, .01, -.02, .07)));
+    MobilizedBody::Gimbal link1(matter.Ground(), Vec3(0,1,0), 
+                                body, Vec3(.5,0,0));
+    MobilizedBody::Ball link2(link1, Vec3(-.1,.3,.2), body, Vec3(.5,0,0));
+    MobilizedBody::Pin link3(link2, Vec3(-.1,.3,.2), body, Vec3(.5,0,0));
+    MobilizedBody::Free free1(matter.Ground(), Vec3(2,0,0), body, Vec3(0));
+    MobilizedBody::Free free2(matter.Ground(), Vec3(3,0,0), body, Vec3(0));
+    MobilizedBody::Pin pin1(matter.Ground(), Vec3(-2,0,0), body, Vec3(0,.5,0));
+    MobilizedBody::Pin pin2(pin1, Vec3(0,-.5,0), body, Vec3(0,.5,0));
+
+    Constraint::Ball(link1, Vec3(.1,0,0), link3, Vec3(0,.2,0));
+    Constraint::Ball(free1, Vec3(.5,0,0), free2, Vec3(-.5,0,0));
+    Constraint::Rod(free2, Vec3(0), link3, Vec3(.1,0,0), 2);
+    Constraint::PointInPlane(matter.Ground(), UnitVec3(0,1,0), -1, 
+                             pin2, Vec3(0,-.5,0));
+    Constraint::ConstantSpeed(pin1, .3);
+
+    // Use a seeded generator of our own rather than createState() so that
+    // the result doesn't depend on which tests ran before this one.
+    Random::Uniform random(-1, 1);
+    random.setSeed(7);
+    State state = system.realizeTopology();
+    for (int i=0; i < state.getNY(); ++i)
+        state.updY()[i] = random.getValue();
+    system.realize(state, Stage::Velocity);
+    const int m = state.getNMultipliers();
+
+    Matrix GMInvGt;
+    matter.calcProjectedMInv(state, GMInvGt);
+    DelassusOperator sparse;
+    matter.calcProjectedMInv(state, sparse);
+
+    SimTK_TEST(sparse.size() == m);
+    SimTK_TEST(sparse.getNumBlocks() == 4); // one per tree
+    SimTK_TEST(sparse.getNumStoredEntries() < m*m);
+    SimTK_TEST_EQ(sparse.getAsDenseMatrix(), GMInvGt);
+
+    Vector x(m);
+    for (int i=0; i < m; ++i) x[i] = random.getValue();
+    const Vector denseAx = GMInvGt*x;
+    Vector Ax;
+    sparse.multiply(x, Ax);
+    SimTK_TEST_EQ(Ax, denseAx);
+    for (MultiplierIndex i(0); i < m; ++i) {
+        SimTK_TEST_EQ(sparse.getDiagonal(i), GMInvGt(i,i));
+        SimTK_TEST_EQ(sparse.multiplyRow(i, x), denseAx[i]);
+    }
+
+    // PGS should follow the same iterates from either form of A.
+    PGSImpulseSolver pgs(0);
+    Array_<MultiplierIndex> participating;
+    for (MultiplierIndex i(0); i < m; ++i) participating.push_back(i);
+    const Vector D(m, Real(0.1)); // regularize to get a unique solution
+    Vector piDense, piSparse;
+    pgs.solveBilateral(participating, GMInvGt, D, x, piDense);
+    pgs.solveBilateral(participating, sparse, D, x, piSparse);
+    SimTK_TEST_EQ_TOL(piDense, piSparse, 1e-8);
+}
+
+// For a chain of free bodies linked by ball constraints every tree is a single
+// body with at most two constraints on it. Each block then couples the ball
+// constraints on either side of one body, and the blocks must still agree with
+// the dense matrix when the velocities contribute coriolis terms.
+void testBlockSparseProjectedMInvChain() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body(MassProperties(1.5, Vec3(.1,.2,-.03), 
+                     UnitInertia(1.1, 1.2, 1.3, .01, -.02, .07)));
+    const int nBodies = 20;
+    MobilizedBody prev = matter.Ground();
+    for (int i=0; i < nBodies; ++i) {
+        MobilizedBody::Free free(matter.Ground(), Vec3(i,0,0), body, Vec3(0));
+        if (i > 0)
+            Constraint::Ball(prev, Vec3(.5,0,0), free, Vec3(-.5,0,0));
+        prev = free;
+    }
+    State state = system.realizeTopology();
+    for (int i=0; i < state.getNU(); ++i)
+        state.updU()[i] = std::sin(Real(i)); // nonzero coriolis terms
+    system.realize(state, Stage::Velocity);
+
+    Matrix GMInvGt;
+    matter.calcProjectedMInv(state, GMInvGt);
+    DelassusOperator sparse;
+    matter.calcProjectedMInv(state, sparse);
+
+    SimTK_TEST(sparse.getNumBlocks() == nBodies);
+    SimTK_TEST_EQ(sparse.getAsDenseMatrix(), GMInvGt);
+}
+
+// Iterative projection should find the same corrections as factoring the
+// constraint Jacobian, including the ones removed from the error estimates,
+// and must notice when the set of constraints changes.
+void testIterativeProjection() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body(MassProperties(1.5, Vec3(.1,.2,-.03), 
+                     UnitInertia(1.1, 1.2, 1.3, .01, -.02, .07)));
+    MobilizedBody::Gimbal link1(matter.Ground(), Vec3(0,1,0), 
+                                body, Vec3(.5,0,0));
+    MobilizedBody::Ball link2(link1, Vec3(-.1,.3,.2), body, Vec3(.5,0,0));
+    MobilizedBody::Pin link3(link2, Vec3(-.1,.3,.2), body, Vec3(.5,0,0));
+    MobilizedBody::Pin tip(link3, Vec3(-.1,.3,.2), body, Vec3(.5,0,0));
+    MobilizedBody::Free free1(matter.Ground(), Vec3(2,0,0), body, Vec3(0));
+    MobilizedBody::Free free2(matter.Ground(), Vec3(3,0,0), body, Vec3(0));
+    MobilizedBody::Pin pin1(matter.Ground(), Vec3(-2,0,0), body, Vec3(0,.5,0));
+    MobilizedBody::Pin pin2(pin1, Vec3(0,-.5,0), body, Vec3(0,.5,0));
+    // Keep the loop and point-in-plane Jacobians well away from singular.
+    link3.setDefaultAngle(.5);
+    pin1.setDefaultAngle(.5);
+    Motion::Sinusoid(tip, Motion::Position, .1, 2, 0); // packs q's and u's
+
+    Constraint::Ball(link1, Vec3(-1.23,.54,.4), link3, Vec3(0,.2,0));
+    Constraint::Ball(free1, Vec3(.5,0,0), free2, Vec3(-.5,0,0));
+    Constraint::Rod rod(free2, Vec3(0), link3, Vec3(.1,0,0), 5);
+    Constraint::PointInPlane(matter.Ground(), UnitVec3(0,1,0), -1.75, 
+                             pin2, Vec3(0,-.5,0));
+    Constraint::ConstantSpeed(pin1, -.3); // away from pin2 straightening
+
+    // The default configuration nearly satisfies the constraints.
+    system.realizeTopology();
+    State state = system.getDefaultState();
+    Assembler(system).setAccuracy(ConstraintTol).assemble(state);
+    system.realize(state, Stage::Velocity);
+    system.project(state, ConstraintTol);
+
+    // Move a little way off the constraint manifold.
+    Random::Uniform random(-1e-3, 1e-3);
+    for (int i=0; i < state.getNY(); ++i)
+        state.updY()[i] += random.getValue();
+    system.prescribe(state);
+    Vector qErrest(state.getNQ()), uErrest(state.getNU());
+    for (int i=0; i < qErrest.size(); ++i) qErrest[i] = random.getValue();
+    for (int i=0; i < uErrest.size(); ++i) uErrest[i] = random.getValue();
+
+    const ProjectOptions options(ConstraintTol);
+    ProjectResults results;
+    auto project = [&](State& s, Vector& qErr, Vector& uErr) {
+        system.realize(s, Stage::Position);
+        system.projectQ(s, qErr, options, results);
+        SimTK_TEST(results.getExitStatus() == ProjectResults::Succeeded);
+        SimTK_TEST(results.getNormOnExit() <= ConstraintTol);
+        system.realize(s, Stage::Velocity);
+        system.projectU(s, uErr, options, results);
+        SimTK_TEST(results.getExitStatus() == ProjectResults::Succeeded);
+        SimTK_TEST(results.getNormOnExit() <= ConstraintTol);
+    };
+
+    SimTK_TEST(!matter.getUseIterativeProjection());
+    State factored = state;
+    Vector qErrestFactored = qErrest, uErrestFactored = uErrest;
+    project(factored, qErrestFactored, uErrestFactored);
+
+    matter.setUseIterativeProjection(true);
+    SimTK_TEST(matter.getUseIterativeProjection());
+    State iterative = state;
+    Vector qErrestIterative = qErrest, uErrestIterative = uErrest;
+    project(iterative, qErrestIterative, uErrestIterative);
+
+    SimTK_TEST_EQ_TOL(iterative.getQ(), factored.getQ(), 1e-8);
+    SimTK_TEST_EQ_TOL(iterative.getU(), factored.getU(), 1e-8);
+    SimTK_TEST_EQ_TOL(qErrestIterative, qErrestFactored, 1e-8);
+    SimTK_TEST_EQ_TOL(uErrestIterative, uErrestFactored, 1e-8);
+
+    // Disabling a constraint leaves fewer equations to precondition.
+    rod.disable(iterative);
+    for (int i=0; i < iterative.getNY(); ++i)
+        iterative.updY()[i] += random.getValue();
+    system.prescribe(iterative);
+    Vector noErrest;
+    project(iterative, noErrest, noErrest);
+
+    // Integrate with the preconditioners reused from step to step.
+    RungeKuttaMersonIntegrator integ(system);
+    integ.setAccuracy(1e-5);
+    integ.setConstraintTolerance(1e-6);
+    TimeStepper ts(system, integ);
+    ts.initialize(iterative);
+    ts.stepTo(1);
+    SimTK_TEST(ts.getState().getQErr().normInf() < 1e-5);
+    SimTK_TEST(ts.getState().getUErr().normInf() < 1e-5);
+}
+
 // Test the operator SimbodyMatterSubsystem::calcConstraintAccelerationErrors(),
 // which computes pvaerr = G udot - b. For the most part, we just ensure that
 // this operator gives results consistent with other methods.
@@ -760,7 +951,10 @@ int main() {
         SimTK_SUBTEST(testWeldConstraintWithPreAssembly);
         SimTK_SUBTEST(testConstraintForces);
         SimTK_SUBTEST(testConstraintMatrices);
+        SimTK_SUBTEST(testBlockSparseProjectedMInv);
+        SimTK_SUBTEST(testBlockSparseProjectedMInvChain);
         SimTK_SUBTEST(testConstraintAccelerationErrors);
         SimTK_SUBTEST(testDisablingConstraints);
+        SimTK_SUBTEST(testIterativeProjection);
     SimTK_END_TEST();
 }
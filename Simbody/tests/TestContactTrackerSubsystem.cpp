@@ -0,0 +1,211 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Check that the ContactTrackerSubsystem broad phase methods find every pair
+of overlapping spheres, and that the incremental sweep-and-prune stays correct
+as the bodies move, including large jumps that reorder many endpoints. Also
+check that the parallel narrow phase gives the same contacts as the serial
+one. */
+
+#include "SimTKsimbody.h"
+
+#include <set>
+#include <utility>
+
+using namespace SimTK;
+using namespace std;
+
+typedef set<pair<int,int>> SurfacePairs;
+
+static const Real Radius = 0.1;
+
+// Free bodies each carrying a sphere; every fifth body carries a second,
+// overlapping sphere (which must be ignored) and pairs of consecutive
+// bodies divisible by 7 share a contact clique.
+static void buildSpheres(MultibodySystem& system, SimbodyMatterSubsystem& matter,
+                         int numBodies) {
+    const ContactMaterial material(1e6, 0, 0, 0, 0);
+    for (int i=0; i < numBodies; ++i) {
+        Body::Rigid body(MassProperties(1, Vec3(0), Inertia(1)));
+        body.addContactSurface(Transform(),
+            ContactSurface(ContactGeometry::Sphere(Radius), material));
+        if (i % 5 == 0)
+            body.addContactSurface(Vec3(Radius/2, 0, 0),
+                ContactSurface(ContactGeometry::Sphere(Radius), material));
+        MobilizedBody::Free(matter.Ground(), Transform(), body, Transform());
+    }
+    for (int i=1; i+1 < numBodies; i += 7) {
+        const ContactCliqueId clique = ContactSurface::createNewContactClique();
+        matter.updMobilizedBody(MobilizedBodyIndex(i)).updBody()
+            .updContactSurface(0).joinClique(clique);
+        matter.updMobilizedBody(MobilizedBodyIndex(i+1)).updBody()
+            .updContactSurface(0).joinClique(clique);
+    }
+}
+
+static SurfacePairs getContactPairs(const ContactTrackerSubsystem& tracker,
+                                    const State& state) {
+    SurfacePairs pairs;
+    const ContactSnapshot& contacts = tracker.getActiveContacts(state);
+    for (int i=0; i < contacts.getNumContacts(); ++i) {
+        int s1 = contacts.getContact(i).getSurface1();
+        int s2 = contacts.getContact(i).getSurface2();
+        if (s1 > s2) std::swap(s1, s2);
+        pairs.insert(make_pair(s1, s2));
+    }
+    return pairs;
+}
+
+// Every pair of spheres that overlap, ignoring exclusions.
+static SurfacePairs findPairsByBruteForce(const ContactTrackerSubsystem& tracker,
+                                          const State& state) {
+    SurfacePairs pairs;
+    const int n = tracker.getNumSurfaces();
+    for (ContactSurfaceIndex i(0); i < n; ++i) {
+        const Vec3 pi = tracker.getMobilizedBody(i).getBodyTransform(state)
+                        * tracker.getContactSurfaceTransform(i).p();
+        for (ContactSurfaceIndex j(i+1); j < n; ++j) {
+            const MobilizedBody& mj = tracker.getMobilizedBody(j);
+            if (tracker.getMobilizedBody(i).getMobilizedBodyIndex()
+                == mj.getMobilizedBodyIndex()) continue;
+            if (tracker.getContactSurface(i)
+                    .isInSameClique(tracker.getContactSurface(j))) continue;
+            const Vec3 pj = mj.getBodyTransform(state)
+                            * tracker.getContactSurfaceTransform(j).p();
+            if ((pi-pj).norm() < 2*Radius)
+                pairs.insert(make_pair((int)i, (int)j));
+        }
+    }
+    return pairs;
+}
+
+void testBroadPhaseMethodsAgree() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    ContactTrackerSubsystem tracker(system);
+    const int numBodies = 400;
+    buildSpheres(system, matter, numBodies);
+    SimTK_TEST(tracker.getBroadPhaseMethod()
+               == ContactTrackerSubsystem::SingleAxisSweep);
+
+    State state = system.realizeTopology();
+    Random::Uniform random(-1, 1);
+    random.setSeed(4);
+    Array_<Vec3> positions(numBodies);
+    for (int i=0; i < numBodies; ++i)
+        positions[i] = Vec3(random.getValue(), random.getValue(), 
+                            random.getValue());
+
+    int totalPairs = 0;
+    for (int step=0; step < 30; ++step) {
+        // Small motions most of the time, and occasionally scramble a tenth
+        // of the bodies.
+        for (int i=0; i < numBodies; ++i) {
+            if (step % 10 == 9 && i % 10 == 0)
+                positions[i] = Vec3(random.getValue(), random.getValue(),
+                                    random.getValue());
+            else
+                positions[i] += 0.02*Vec3(random.getValue(), 
+                                          random.getValue(), 
+                                          random.getValue());
+            matter.getMobilizedBody(MobilizedBodyIndex(i+1))
+                .setQToFitTranslation(state, positions[i]);
+        }
+        system.realize(state, Stage::Position);
+        const SurfacePairs expected = findPairsByBruteForce(tracker, state);
+        totalPairs += (int)expected.size();
+
+        // This State keeps its sweep-and-prune data from step to step.
+        tracker.setBroadPhaseMethod
+           (ContactTrackerSubsystem::IncrementalSweepAndPrune);
+        SimTK_TEST(getContactPairs(tracker, state) == expected);
+
+        State fresh = state;
+        fresh.invalidateAllCacheAtOrAbove(Stage::Position);
+        tracker.setBroadPhaseMethod(ContactTrackerSubsystem::SingleAxisSweep);
+        system.realize(fresh, Stage::Position);
+        SimTK_TEST(getContactPairs(tracker, fresh) == expected);
+    }
+    SimTK_TEST(totalPairs > 0);
+}
+
+// A mixture of spheres and sphere-shaped meshes, so that the narrow phase
+// sees pairs of very different costs.
+void testParallelNarrowPhase() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    ContactTrackerSubsystem tracker(system);
+    const ContactMaterial material(1e6, 0, 0, 0, 0);
+    const int numBodies = 150;
+    for (int i=0; i < numBodies; ++i) {
+        Body::Rigid body(MassProperties(1, Vec3(0), Inertia(1)));
+        if (i % 6 == 0)
+            body.addContactSurface(Transform(), ContactSurface(
+                ContactGeometry::TriangleMesh
+                    (PolygonalMesh::createSphereMesh(1.5*Radius, 2)), 
+                material));
+        else
+            body.addContactSurface(Transform(),
+                ContactSurface(ContactGeometry::Sphere(Radius), material));
+        MobilizedBody::Free(matter.Ground(), Transform(), body, Transform());
+    }
+
+    State state = system.realizeTopology();
+    Random::Uniform random(0, 1);
+    random.setSeed(9);
+    for (int i=0; i < numBodies; ++i)
+        matter.getMobilizedBody(MobilizedBodyIndex(i+1)).setQToFitTranslation
+           (state, Vec3(random.getValue(), random.getValue(), 
+                        random.getValue()));
+    system.realize(state, Stage::Position);
+
+    SimTK_TEST(tracker.getNumberOfThreads() == 1);
+    const ContactSnapshot serial = tracker.getActiveContacts(state);
+    SimTK_TEST(serial.getNumContacts() > 0);
+
+    tracker.setNumberOfThreads(4);
+    SimTK_TEST(tracker.getNumberOfThreads() == 4);
+    State parallelState = state;
+    parallelState.invalidateAllCacheAtOrAbove(Stage::Position);
+    system.realize(parallelState, Stage::Position);
+    const ContactSnapshot& parallel = tracker.getActiveContacts(parallelState);
+
+    SimTK_TEST(parallel.getNumContacts() == serial.getNumContacts());
+    for (int i=0; i < serial.getNumContacts(); ++i) {
+        const Contact& c1 = serial.getContact(i);
+        const Contact& c2 = parallel.getContact(i);
+        SimTK_TEST(c1.getSurface1() == c2.getSurface1());
+        SimTK_TEST(c1.getSurface2() == c2.getSurface2());
+        SimTK_TEST(c1.getTypeId() == c2.getTypeId());
+        SimTK_TEST(c1.getCondition() == c2.getCondition());
+    }
+
+    SimTK_TEST_MUST_THROW(tracker.setNumberOfThreads(0));
+}
+
+int main() {
+    SimTK_START_TEST("TestContactTrackerSubsystem");
+        SimTK_SUBTEST(testBroadPhaseMethodsAgree);
+        SimTK_SUBTEST(testParallelNarrowPhase);
+    SimTK_END_TEST();
+}
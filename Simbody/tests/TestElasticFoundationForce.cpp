@@ -266,11 +266,101 @@ void testEffSphereOnPlaneNewFormulation(bool verbose = false)
     }
 }
 
+// Calculate the forces on a sphere mesh that is sliding and spinning while
+// pressed deep enough into a half space that its springs are evaluated in
+// several chunks, using both formulations and the given number of threads.
+void calcSlidingSphereForces(unsigned numThreads, SpatialVec& oldForce,
+                             SpatialVec& newForce, Real& newPE,
+                             int& numDetails)
+{
+    const Real stiffness = 1e7, dissipation = 0.1;
+    const Real us = 0.8, ud = 0.5, uv = 0.1;
+    const Real radius = 1.0, penetration = 0.3;
+    const PolygonalMesh sphereMesh(PolygonalMesh::createSphereMesh(radius, 5));
+    const Transform X_GH(Rotation(-0.5*Pi, ZAxis), 
+                         Vec3(0.0, penetration-radius, 0.0));
+    const Vec3 velocity(0.3, -0.1, 0.2), angularVelocity(0.5, 2, -1);
+    const Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+    {
+        MultibodySystem system;
+        SimbodyMatterSubsystem matter(system);
+        GeneralContactSubsystem contacts(system);
+        GeneralForceSubsystem forces(system);
+        const ContactSetIndex setIndex = contacts.createContactSet();
+        const MobilizedBody::Free mesh(matter.updGround(), Transform(), 
+                                       body, Transform());
+        contacts.addBody(setIndex, mesh, 
+                         ContactGeometry::TriangleMesh(sphereMesh), Transform());
+        contacts.addBody(setIndex, matter.updGround(), 
+                         ContactGeometry::HalfSpace(), X_GH);
+        ElasticFoundationForce ef(forces, contacts, setIndex);
+        ef.setBodyParameters(ContactSurfaceIndex(0), stiffness, dissipation, 
+                             us, ud, uv);
+        ef.setNumberOfThreads(numThreads);
+        ASSERT(ef.getNumberOfThreads() == (int)numThreads);
+        State state = system.realizeTopology();
+        mesh.setUToFitAngularVelocity(state, angularVelocity);
+        mesh.setUToFitLinearVelocity(state, velocity);
+        system.realize(state, Stage::Dynamics);
+        oldForce = system.getRigidBodyForces(state, Stage::Dynamics)
+                                            [mesh.getMobilizedBodyIndex()];
+    }
+    {
+        MultibodySystem system;
+        SimbodyMatterSubsystem matter(system);
+        ContactTrackerSubsystem tracker(system);
+        CompliantContactSubsystem contactForces(system, tracker);
+        contactForces.setNumberOfThreads(numThreads);
+        ASSERT(contactForces.getNumberOfThreads() == (int)numThreads);
+        matter.Ground().updBody().addContactSurface(X_GH,
+            ContactSurface(ContactGeometry::HalfSpace(),
+                           ContactMaterial(stiffness, dissipation, us, ud, uv),
+                           1.0));
+        Body::Rigid meshBody(MassProperties(1.0, Vec3(0), Inertia(1)));
+        meshBody.addContactSurface(Transform(),
+            ContactSurface(ContactGeometry::TriangleMesh(sphereMesh),
+                           ContactMaterial(stiffness, dissipation, us, ud, uv),
+                           1.0));
+        const MobilizedBody::Free mesh(matter.updGround(), Transform(), 
+                                       meshBody, Transform());
+        State state = system.realizeTopology();
+        mesh.setUToFitAngularVelocity(state, angularVelocity);
+        mesh.setUToFitLinearVelocity(state, velocity);
+        system.realize(state, Stage::Dynamics);
+        ASSERT(contactForces.getNumContactForces(state) == 1);
+        const ContactForce& force = contactForces.getContactForce(state, 0);
+        newForce = force.getForceOnSurface2();
+        newPE = force.getPotentialEnergy();
+        ContactPatch patch;
+        ASSERT(contactForces.calcContactPatchDetailsById
+                                    (state, force.getContactId(), patch));
+        numDetails = patch.getNumDetails();
+    }
+}
+
+// Evaluating the springs on several threads must give exactly the same
+// forces as evaluating them on one.
+void testParallelSprings() {
+    SpatialVec oldForce1, newForce1, oldForce4, newForce4;
+    Real newPE1, newPE4;
+    int numDetails1, numDetails4;
+    calcSlidingSphereForces(1, oldForce1, newForce1, newPE1, numDetails1);
+    calcSlidingSphereForces(4, oldForce4, newForce4, newPE4, numDetails4);
+
+    ASSERT(numDetails1 > 1000); // several chunks of springs
+    ASSERT(numDetails4 == numDetails1);
+    ASSERT(oldForce4 == oldForce1);
+    ASSERT(newForce4 == newForce1);
+    ASSERT(newPE4 == newPE1);
+    ASSERT(oldForce1[1].norm() > 0 && newForce1[1].norm() > 0);
+}
+
 int main() {
     try {
         testForces();
         testEffSphereOnPlaneOldFormulation();
         testEffSphereOnPlaneNewFormulation();
+        testParallelSprings();
     }
     catch(const std::exception& e) {
         cout << "exception: " << e.what() << endl;
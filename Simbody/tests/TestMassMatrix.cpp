@@ -1484,6 +1484,86 @@ void testVelocityKinematics() {
     syscomv = matter.calcSystemMassCenterVelocityInGround(state); // OK
 }
 
+// Compare the tree-sparse mass matrix and its factorization with the dense
+// mass matrix, for a branched tree with welds and a variety of mobilizers.
+void testMassMatrixFactorization() {
+    MultibodySystem system;
+    MyForceImpl* frcp;
+    makeSystem(false, system, frcp);
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+
+    State state = system.realizeTopology();
+    const int nu = state.getNU();
+    const Real Slop = nu*SignificantReal;
+
+    system.realizeModel(state);
+    state.updQ() = Test::randVector(state.getNQ());
+
+    MassMatrixFactorization MFac;
+    // Not allowed until Position stage.
+    SimTK_TEST_MUST_THROW(matter.factorM(state, MFac));
+    system.realize(state, Stage::Position);
+    matter.factorM(state, MFac);
+    SimTK_TEST(MFac.size() == nu);
+    SimTK_TEST(MFac.isFactored());
+    SimTK_TEST(MFac.getNumStructureChanges() == 1);
+    // The side branches don't couple so fewer than half are stored.
+    SimTK_TEST(MFac.getNumStoredEntries() < nu*(nu+1)/2);
+
+    Matrix M, sparseM;
+    matter.calcM(state, M);
+    MFac.getAsDenseMatrix(sparseM);
+    SimTK_TEST_EQ_TOL(sparseM, M, Slop);
+
+    // Entries that aren't stored are zero in M, too.
+    for (int i=0; i < nu; ++i) {
+        Array_<bool> onPath(nu, false);
+        for (int j=i; j >= 0; j = MFac.getParent(j))
+            onPath[j] = true;
+        for (int j=0; j < i; ++j)
+            if (!onPath[j])
+                SimTK_TEST_EQ_TOL(M(i,j), 0, Slop);
+    }
+
+    const Vector v = 100*Test::randVector(nu);
+    Vector Mv, x;
+    MFac.multiply(v, Mv);
+    SimTK_TEST_EQ_TOL(Mv, M*v, Slop);
+    MFac.solve(Mv, x);
+    SimTK_TEST_EQ_TOL(x, v, Slop);
+    x = Mv; MFac.solve(x, x); // in place
+    SimTK_TEST_EQ_TOL(x, v, Slop);
+
+    Vector MInvv;
+    matter.multiplyByMInv(state, v, MInvv);
+    MFac.solve(v, x);
+    SimTK_TEST_EQ_TOL(x, MInvv, Slop);
+
+    // A new configuration reuses the sparsity pattern.
+    state.updQ() = Test::randVector(state.getNQ());
+    system.realize(state, Stage::Position);
+    matter.factorM(state, MFac);
+    SimTK_TEST(MFac.getNumStructureChanges() == 1);
+    matter.calcM(state, M);
+    MFac.getAsDenseMatrix(sparseM);
+    SimTK_TEST_EQ_TOL(sparseM, M, Slop);
+    MFac.multiply(v, Mv);
+    MFac.solve(Mv, x);
+    SimTK_TEST_EQ_TOL(x, v, Slop);
+
+    // A mass matrix with a zero on the diagonal can't be factored.
+    Array_<int> parent(2); parent[0] = -1; parent[1] = 0;
+    MassMatrixFactorization bad;
+    bad.setStructure(parent);
+    SimTK_TEST(bad.getRowLength(1) == 2);
+    bad.updRow(0)[0] = 1;
+    Real* row1 = bad.updRow(1); row1[0] = 0; row1[1] = 0;
+    SimTK_TEST_MUST_THROW(bad.factor());
+    SimTK_TEST(!bad.isFactored());
+    parent[1] = 1; // a mobility can't be its own parent
+    SimTK_TEST_MUST_THROW(bad.setStructure(parent));
+}
+
 int main() {
     SimTK_START_TEST("TestMassMatrix");
         SimTK_SUBTEST(testPositionKinematics);
@@ -1495,6 +1575,7 @@ int main() {
         SimTK_SUBTEST(testArticulatedBodyVelocity);
         SimTK_SUBTEST(testUnconstrainedSystem);
         SimTK_SUBTEST(testConstrainedSystem);
+        SimTK_SUBTEST(testMassMatrixFactorization);
         SimTK_SUBTEST(testTaskJacobians);
     SimTK_END_TEST();
 }
@@ -0,0 +1,188 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Check the PGSImpulseSolver's warm start, early exit, and statistics, and
+the SemiExplicitEulerTimeStepper's reuse of contact forces from one step as
+the initial guess for the next. */
+
+#include "SimTKsimbody.h"
+
+#include <iostream>
+
+using namespace SimTK;
+using namespace std;
+
+// Empty lists for the constraint kinds we aren't using.
+struct NoOtherConstraints {
+    Array_<ImpulseSolver::UniContactRT>            uniContact;
+    Array_<ImpulseSolver::UniSpeedRT>              uniSpeed;
+    Array_<ImpulseSolver::BoundedRT>               bounded;
+    Array_<ImpulseSolver::ConstraintLtdFrictionRT> consLtdFriction;
+    Array_<ImpulseSolver::StateLtdFrictionRT>      stateLtdFriction;
+};
+
+// Solve A pi = rhs with all equations unconditional, returning convergence.
+static bool solveUnconditional(const PGSImpulseSolver& pgs, const Matrix& A,
+                               const Vector& rhs, Vector& pi) {
+    const int m = A.nrow();
+    Array_<MultiplierIndex> participating;
+    Array_<ImpulseSolver::UncondRT> unconditional(1);
+    for (MultiplierIndex i(0); i < m; ++i) {
+        participating.push_back(i);
+        unconditional[0].m_mults.push_back(i);
+    }
+    NoOtherConstraints none;
+    Vector D(m, Real(0)), piExpand(m, Real(0)), verr = rhs, noApplied;
+    return pgs.solve(0, participating, A, D, Array_<MultiplierIndex>(),
+                     piExpand, verr, noApplied, pi, unconditional,
+                     none.uniContact, none.uniSpeed, none.bounded,
+                     none.consLtdFriction, none.stateLtdFriction);
+}
+
+void testWarmStartFromSolution() {
+    const int m = 8;
+    Matrix B(m, m);
+    Random::Uniform random(-1, 1);
+    random.setSeed(3);
+    for (int i=0; i < m; ++i)
+        for (int j=0; j < m; ++j) B(i,j) = random.getValue();
+    Matrix A = B*~B;
+    A.updDiag() += 1;  // well-conditioned SPD
+    Vector rhs(m);
+    for (int i=0; i < m; ++i) rhs[i] = random.getValue();
+
+    PGSImpulseSolver pgs(0);
+    pgs.setMaxIterations(1000);
+    pgs.setConvergenceTol(1e-10);
+    Vector pi;
+    SimTK_TEST(solveUnconditional(pgs, A, rhs, pi));
+    const int coldIters = pgs.getNumIterationsOfLastSolve(0);
+    SimTK_TEST(coldIters > 2);
+    SimTK_TEST(pgs.getNumSolves(0) == 1);
+    SimTK_TEST(pgs.getNumIterations(0) == coldIters);
+    SimTK_TEST(pgs.getErrorOfLastSolve(0) < 1e-10);
+    SimTK_TEST_EQ_TOL(A*pi, rhs, 1e-8);
+
+    // Without the flag an incoming pi is ignored.
+    Vector piAgain = pi;
+    SimTK_TEST(solveUnconditional(pgs, A, rhs, piAgain));
+    SimTK_TEST(pgs.getNumIterationsOfLastSolve(0) == coldIters);
+    SimTK_TEST(pgs.getNumWarmStartedSolves(0) == 0);
+
+    // Starting from the answer we should be done almost immediately.
+    pgs.setUseInitialGuess(true);
+    Vector piWarm = pi;
+    SimTK_TEST(solveUnconditional(pgs, A, rhs, piWarm));
+    SimTK_TEST(pgs.getNumIterationsOfLastSolve(0) <= 2);
+    SimTK_TEST(pgs.getNumWarmStartedSolves(0) == 1);
+    SimTK_TEST_EQ_TOL(piWarm, pi, 1e-8);
+
+    pgs.clearStats();
+    SimTK_TEST(pgs.getNumSolves(0) == 0);
+    SimTK_TEST(pgs.getNumIterationsOfLastSolve(0) == 0);
+}
+
+// An inconsistent system can't converge; with a stall limit the solver should
+// give up long before the iteration limit.
+void testStalledEarlyExit() {
+    const Matrix A(2, 2, Real(1)); // singular
+    Vector rhs(2); rhs[0] = 1; rhs[1] = -1;
+
+    PGSImpulseSolver pgs(0);
+    Vector pi;
+    SimTK_TEST(!solveUnconditional(pgs, A, rhs, pi));
+    SimTK_TEST(pgs.getNumIterationsOfLastSolve(0) == pgs.getMaxIterations());
+
+    pgs.setMaxStalledIterations(5);
+    SimTK_TEST(pgs.getMaxStalledIterations() == 5);
+    SimTK_TEST(!solveUnconditional(pgs, A, rhs, pi));
+    SimTK_TEST(pgs.getNumIterationsOfLastSolve(0) < 20);
+    SimTK_TEST(pgs.getNumFailures(0) == 2);
+}
+
+void testBadSettings() {
+    PGSImpulseSolver pgs(0);
+    pgs.setSOR(1.5);
+    SimTK_TEST(pgs.getSOR() == 1.5);
+    SimTK_TEST_MUST_THROW(pgs.setSOR(0));
+    SimTK_TEST_MUST_THROW(pgs.setSOR(2));
+    SimTK_TEST_MUST_THROW(pgs.setMaxStalledIterations(-1));
+}
+
+// Let a box settle on the ground on four frictional point contacts and count
+// the PGS iterations needed with and without warm starting.
+static long long runRestingBox(bool useWarmStart, Vec3& finalPos) {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    GeneralForceSubsystem forces(system);
+    Force::Gravity(forces, matter, -ZAxis, 9.81);
+
+    const Vec3 halfDims(.2, .1, .05);
+    Body::Rigid boxBody(MassProperties(2, Vec3(0),
+                                       UnitInertia::brick(halfDims)));
+    MobilizedBody::Free box(matter.Ground(), Vec3(0),
+                            boxBody, Vec3(0));
+    for (int i=-1; i <= 1; i += 2)
+        for (int j=-1; j <= 1; j += 2) {
+            const Vec3 pt(i*halfDims[0], j*halfDims[1], -halfDims[2]);
+            matter.adoptUnilateralContact(new PointPlaneContact
+               (matter.Ground(), ZAxis, 0., box, pt, 0, .8, .5, 0));
+        }
+    State state = system.realizeTopology();
+    box.setQToFitTranslation(state, Vec3(0, 0, halfDims[2]));
+    box.setUToFitLinearVelocity(state, Vec3(.05, 0, 0)); // slide a little
+
+    SemiExplicitEulerTimeStepper ts(system);
+    ts.setImpulseSolverType(SemiExplicitEulerTimeStepper::PGS);
+    ts.setUseWarmStart(useWarmStart);
+    SimTK_TEST(ts.getUseWarmStart() == useWarmStart);
+    ts.initialize(state);
+
+    const Real h = 1e-3;
+    for (int step=1; step <= 300; ++step)
+        ts.stepTo(step*h);
+
+    finalPos = box.getBodyOriginLocation(ts.getState());
+    const ImpulseSolver& solver = ts.getImpulseSolver();
+    SimTK_TEST((solver.getNumWarmStartedSolves(0) > 0) == useWarmStart);
+    return solver.getNumIterations(0);
+}
+
+void testStepperWarmStart() {
+    Vec3 coldPos, warmPos;
+    const long long coldIters = runRestingBox(false, coldPos);
+    const long long warmIters = runRestingBox(true, warmPos);
+    cout << "PGS iterations: cold=" << coldIters
+         << " warm=" << warmIters << endl;
+    SimTK_TEST(warmIters < coldIters);
+    SimTK_TEST_EQ_TOL(warmPos, coldPos, 1e-3);
+}
+
+int main() {
+    SimTK_START_TEST("TestPGSImpulseSolver");
+        SimTK_SUBTEST(testWarmStartFromSolution);
+        SimTK_SUBTEST(testStalledEarlyExit);
+        SimTK_SUBTEST(testBadSettings);
+        SimTK_SUBTEST(testStepperWarmStart);
+    SimTK_END_TEST();
+}
@@ -0,0 +1,155 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Check that the level-parallel kinematic sweeps and the subtree-parallel
+articulated body sweeps enabled with SimbodyMatterSubsystem::setNumberOfThreads()
+produce exactly the same results as the serial sweeps. */
+
+#include "SimTKsimbody.h"
+
+#include <iostream>
+
+using namespace SimTK;
+using namespace std;
+
+// Build a forest of numBranches short branches hanging from Ground. Each
+// branch is a Ball-jointed base body (so there are quaternions) carrying a
+// chain of Pin-jointed links, so every level of the tree is numBranches wide.
+static void buildForest(SimbodyMatterSubsystem& matter, int numBranches,
+                        int chainLength) {
+    const Body::Rigid body(MassProperties(1, Vec3(0), Inertia(1)));
+    for (int b=0; b < numBranches; ++b) {
+        MobilizedBody::Ball base(matter.Ground(), Vec3(b, 0, 0),
+                                 body, Vec3(0, 1, 0));
+        MobilizedBodyIndex parentx = base.getMobilizedBodyIndex();
+        for (int i=0; i < chainLength; ++i) {
+            MobilizedBody::Pin link(matter.updMobilizedBody(parentx),
+                                    Vec3(0, -1, 0), body, Vec3(0, 1, 0));
+            parentx = link.getMobilizedBodyIndex();
+        }
+    }
+}
+
+void testParallelMatchesSerial() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    buildForest(matter, 40, 4);
+
+    State state = system.realizeTopology();
+    Random::Uniform random(-1, 1);
+    random.setSeed(17);
+    for (int i=0; i < state.getNQ(); ++i) state.updQ()[i] = random.getValue();
+    for (int i=0; i < state.getNU(); ++i) state.updU()[i] = random.getValue();
+    system.realize(state, Stage::Velocity);
+
+    const int nb = matter.getNumBodies();
+    Array_<Transform>  serialX(nb);
+    Array_<SpatialVec> serialV(nb);
+    for (MobilizedBodyIndex mbx(0); mbx < nb; ++mbx) {
+        serialX[mbx] = matter.getMobilizedBody(mbx).getBodyTransform(state);
+        serialV[mbx] = matter.getMobilizedBody(mbx).getBodyVelocity(state);
+    }
+    const Vector serialQErr  = state.getQErr();
+    const Vector serialQDot  = state.getQDot();
+
+    // Changing the number of threads doesn't invalidate the topology.
+    matter.setNumberOfThreads(4);
+    matter.setMinNodesPerParallelLevel(2);
+    SimTK_TEST(matter.getNumberOfThreads() == 4);
+    SimTK_TEST(matter.getMinNodesPerParallelLevel() == 2);
+    SimTK_TEST(system.systemTopologyHasBeenRealized());
+
+    matter.invalidatePositionKinematics(state);
+    system.realize(state, Stage::Velocity);
+
+    for (MobilizedBodyIndex mbx(0); mbx < nb; ++mbx) {
+        const MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+        SimTK_TEST(mobod.getBodyTransform(state).p() == serialX[mbx].p());
+        SimTK_TEST(mobod.getBodyTransform(state).R().asMat33()
+                   == serialX[mbx].R().asMat33());
+        SimTK_TEST(mobod.getBodyVelocity(state) == serialV[mbx]);
+    }
+    for (int i=0; i < serialQErr.size(); ++i)
+        SimTK_TEST(state.getQErr()[i] == serialQErr[i]);
+    for (int i=0; i < serialQDot.size(); ++i)
+        SimTK_TEST(state.getQDot()[i] == serialQDot[i]);
+}
+
+// Compare the subtree-parallel articulated body inertia and tree forward
+// dynamics sweeps against the serial ones, splitting both at the base bodies
+// and one level further out.
+void testSubtreeParallelDynamics() {
+    for (int split = 1; split <= 2; ++split) {
+        MultibodySystem system;
+        SimbodyMatterSubsystem matter(system);
+        GeneralForceSubsystem forces(system);
+        Force::Gravity(forces, matter, -YAxis, 9.8);
+        buildForest(matter, 40, 4);
+        matter.setParallelSubtreeSplitLevel(split);
+        SimTK_TEST(matter.getParallelSubtreeSplitLevel() == split);
+
+        State state = system.realizeTopology();
+        Random::Uniform random(-1, 1);
+        random.setSeed(split);
+        for (int i=0; i < state.getNQ(); ++i) 
+            state.updQ()[i] = random.getValue();
+        for (int i=0; i < state.getNU(); ++i) 
+            state.updU()[i] = random.getValue();
+        system.realize(state, Stage::Acceleration);
+        const Vector serialUDot    = state.getUDot();
+        const Vector serialQDotDot = state.getQDotDot();
+
+        // The subtrees are regrouped for the new number of threads without 
+        // realizing the topology again.
+        matter.setNumberOfThreads(3);
+        matter.setMinNodesForParallelSubtrees(2);
+        SimTK_TEST(matter.getMinNodesForParallelSubtrees() == 2);
+        SimTK_TEST(system.systemTopologyHasBeenRealized());
+        const Vector q = state.getQ();
+        state.updQ() = q; // invalidate everything from Position on
+        system.realize(state, Stage::Acceleration);
+
+        for (int i=0; i < serialUDot.size(); ++i)
+            SimTK_TEST(state.getUDot()[i] == serialUDot[i]);
+        for (int i=0; i < serialQDotDot.size(); ++i)
+            SimTK_TEST(state.getQDotDot()[i] == serialQDotDot[i]);
+    }
+}
+
+void testBadArguments() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    SimTK_TEST(matter.getNumberOfThreads() == 1);
+    SimTK_TEST_MUST_THROW(matter.setNumberOfThreads(0));
+    SimTK_TEST_MUST_THROW(matter.setMinNodesPerParallelLevel(0));
+    SimTK_TEST_MUST_THROW(matter.setParallelSubtreeSplitLevel(0));
+    SimTK_TEST_MUST_THROW(matter.setMinNodesForParallelSubtrees(0));
+}
+
+int main() {
+    SimTK_START_TEST("TestParallelKinematics");
+        SimTK_SUBTEST(testParallelMatchesSerial);
+        SimTK_SUBTEST(testSubtreeParallelDynamics);
+        SimTK_SUBTEST(testBadArguments);
+    SimTK_END_TEST();
+}
@@ -0,0 +1,210 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Check that System::realizeBatch() realizes many States of one System in
+parallel with exactly the same results as realizing them one at a time. */
+
+#include "SimTKsimbody.h"
+
+#include <iostream>
+#include <thread>
+
+using namespace SimTK;
+using namespace std;
+
+// A force that fails for States whose time is negative, so that we can check
+// how errors inside a batch are reported.
+class PickyForceImpl : public Force::Custom::Implementation {
+public:
+    void calcForce(const State& state, Vector_<SpatialVec>& bodyForces,
+                   Vector_<Vec3>& particleForces,
+                   Vector& mobilityForces) const override {
+        SimTK_ERRCHK1_ALWAYS(state.getTime() >= 0, "PickyForceImpl::calcForce",
+                             "Negative time %g.", state.getTime());
+    }
+    Real calcPotentialEnergy(const State& state) const override {return 0;}
+};
+
+// A chain of pin and ball joints with springs, gravity, a coordinate coupler
+// and a loop-closing ball constraint, so that realizing it exercises all the
+// subsystems and the constraint machinery. The subsystem handles are kept
+// here because Force::Gravity holds on to the matter subsystem.
+class TestSystem : public MultibodySystem {
+public:
+    TestSystem() : matter(*this), forces(*this) {
+        Force::Gravity(forces, matter, -YAxis, 9.8);
+        Force::Custom(forces, new PickyForceImpl());
+
+        const Body::Rigid body(MassProperties(1, Vec3(0), Inertia(1)));
+        MobilizedBody parent = matter.Ground();
+        Array_<MobilizedBodyIndex> pins;
+        for (int i=0; i < 6; ++i) {
+            if (i % 2 == 0) {
+                MobilizedBody::Pin link(parent, Vec3(0, -1, 0), body, Vec3(0));
+                Force::MobilityLinearSpring(forces, link, MobilizerQIndex(0),
+                                            10, 0.1*i);
+                pins.push_back(link.getMobilizedBodyIndex());
+                parent = link;
+            } else {
+                parent = MobilizedBody::Ball(parent, Vec3(0, -1, 0),
+                                             body, Vec3(0));
+            }
+        }
+        MobilizedBody::Free loose(matter.Ground(), Vec3(3, 0, 0),
+                                  body, Vec3(0));
+        Constraint::Ball(loose, Vec3(0, 1, 0), parent, Vec3(0));
+
+        Array_<MobilizerQIndex> pinQs(2, MobilizerQIndex(0));
+        Array_<MobilizedBodyIndex> coupled(pins.begin(), pins.begin()+2);
+        Constraint::CoordinateCoupler(matter,
+            new Function::Linear(Vector(Vec3(1, -2, 0))), coupled, pinQs);
+        realizeTopology();
+    }
+
+    SimbodyMatterSubsystem matter;
+    GeneralForceSubsystem  forces;
+};
+
+static void makeStates(const MultibodySystem& system, int n,
+                       Array_<State>& states) {
+    Random::Uniform random(-1, 1);
+    random.setSeed(7);
+    states.clear();
+    for (int k=0; k < n; ++k) {
+        State state = system.getDefaultState();
+        state.setTime(0.01*k);
+        for (int i=0; i < state.getNQ(); ++i)
+            state.updQ()[i] = random.getValue();
+        for (int i=0; i < state.getNU(); ++i)
+            state.updU()[i] = random.getValue();
+        states.push_back(state);
+    }
+}
+
+static bool isSame(const Vector& a, const Vector& b) {
+    if (a.size() != b.size()) return false;
+    for (int i=0; i < a.size(); ++i)
+        if (a[i] != b[i]) return false;
+    return true;
+}
+
+void testBatchMatchesSerial() {
+    TestSystem system;
+    system.setNumberOfBatchThreads(4);
+    SimTK_TEST(system.getNumberOfBatchThreads() == 4);
+
+    const int n = 64;
+    Array_<State> serial, batch;
+    makeStates(system, n, serial);
+    makeStates(system, n, batch);
+
+    for (const State& state : serial)
+        system.realize(state, Stage::Acceleration);
+
+    system.resetAllCountersToZero();
+    system.realizeBatch(batch, Stage::Acceleration);
+    SimTK_TEST(system.getNumRealizationsOfThisStage(Stage::Acceleration) == n);
+    SimTK_TEST(system.getNumRealizationsOfThisStage(Stage::Position) == n);
+
+    for (int k=0; k < n; ++k) {
+        SimTK_TEST(batch[k].getSystemStage() == Stage::Acceleration);
+        // Same arithmetic in the same order, so the answers must be identical.
+        SimTK_TEST(isSame(batch[k].getUDot(), serial[k].getUDot()));
+        SimTK_TEST(isSame(batch[k].getMultipliers(),
+                          serial[k].getMultipliers()));
+        SimTK_TEST(isSame(batch[k].getUDotErr(), serial[k].getUDotErr()));
+    }
+
+    // Realizing to a stage the States have already reached does nothing.
+    system.realizeBatch(batch, Stage::Velocity);
+    SimTK_TEST(system.getNumRealizationsOfThisStage(Stage::Acceleration) == n);
+
+    // A single thread gives the same answers too.
+    system.setNumberOfBatchThreads(1);
+    Array_<State> single;
+    makeStates(system, n, single);
+    system.realizeBatch(single, Stage::Acceleration);
+    for (int k=0; k < n; ++k)
+        SimTK_TEST(isSame(single[k].getUDot(), serial[k].getUDot()));
+}
+
+// Several threads may realize batches of the same System at once.
+void testConcurrentBatches() {
+    TestSystem system;
+    system.setNumberOfBatchThreads(4);
+
+    const int n = 32, numCallers = 4;
+    Array_<State> serial;
+    makeStates(system, n, serial);
+    for (const State& state : serial)
+        system.realize(state, Stage::Acceleration);
+
+    Array_< Array_<State> > batches(numCallers);
+    for (Array_<State>& batch : batches)
+        makeStates(system, n, batch);
+    std::vector<std::thread> callers;
+    for (Array_<State>& batch : batches)
+        callers.emplace_back([&system, &batch]() 
+            {   system.realizeBatch(batch, Stage::Acceleration); });
+    for (std::thread& caller : callers)
+        caller.join();
+
+    for (const Array_<State>& batch : batches)
+        for (int k=0; k < n; ++k)
+            SimTK_TEST(isSame(batch[k].getUDot(), serial[k].getUDot()));
+}
+
+void testBatchErrors() {
+    TestSystem system;
+    system.setNumberOfBatchThreads(3);
+    SimTK_TEST_MUST_THROW(system.setNumberOfBatchThreads(0));
+
+    // An empty batch is fine.
+    system.realizeBatch(Array_<State>());
+
+    // States that don't belong to this System are rejected before any
+    // realization is done.
+    Array_<State> states;
+    makeStates(system, 8, states);
+    states.push_back(State());
+    SimTK_TEST_MUST_THROW(system.realizeBatch(states));
+    SimTK_TEST(states[0].getSystemStage() == Stage::Model);
+
+    // A failure while realizing one State is reported after the others are
+    // done.
+    states.pop_back();
+    states[5].setTime(-1);
+    SimTK_TEST_MUST_THROW(system.realizeBatch(states, Stage::Dynamics));
+    for (int k=0; k < (int)states.size(); ++k) {
+        const Stage expected = k == 5 ? Stage::Velocity : Stage::Dynamics;
+        SimTK_TEST(states[k].getSystemStage() == expected);
+    }
+}
+
+int main() {
+    SimTK_START_TEST("TestRealizeBatch");
+        SimTK_SUBTEST(testBatchMatchesSerial);
+        SimTK_SUBTEST(testConcurrentBatches);
+        SimTK_SUBTEST(testBatchErrors);
+    SimTK_END_TEST();
+}
@@ -0,0 +1,170 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace SimTK;
+
+/**
+ * This program measures how much faster the Assembler solves a marker-based
+ * inverse kinematics problem when its numerical derivatives are evaluated on
+ * several threads (Assembler::setNumberOfThreads()). The model is a chain of
+ * 100 pin-jointed links whose axes alternate between x and z, so there are 100
+ * free q's. Markers are attached to the links and their observed locations
+ * are taken from a known target pose. We solve the problem twice: once with
+ * the markers as an assembly goal using a forced numerical gradient, and once
+ * with every third marker as an assembly error condition (Markers can only be
+ * a goal, so that uses the StationErrors condition below) using a forced
+ * numerical Jacobian. We report the wall clock time for each thread count,
+ * the number of calls made to the assembly conditions, and the largest
+ * difference between the solution and the one found on a single thread.
+ *
+ * Usage: AssemblerParallelDerivatives
+ */
+
+static const int NumLinks = 100;
+
+static void createChain(MultibodySystem& system,
+                        Array_<MobilizedBodyIndex>& links) {
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia(.1)));
+    MobilizedBody parent = matter.Ground();
+    for (int i = 0; i < NumLinks; ++i) {
+        const Rotation axis = i % 2 ? Rotation(Pi/2, YAxis) : Rotation();
+        parent = MobilizedBody::Pin(parent, Transform(axis, Vec3(0, -.1, 0)),
+                                    body, Transform(axis, Vec3(0, .1, 0)));
+        links.push_back(parent.getMobilizedBodyIndex());
+    }
+    system.realizeTopology();
+}
+
+// Requires each of a set of stations to be at its observed location, three
+// errors per station. This supplies no Jacobian of its own.
+class StationErrors : public AssemblyCondition {
+public:
+    StationErrors() : AssemblyCondition("StationErrors") {}
+
+    void addStation(MobilizedBodyIndex body, const Vec3& station,
+                    const Vec3& observation) {
+        bodies.push_back(body);
+        stations.push_back(station);
+        observations.push_back(observation);
+    }
+
+    int getNumErrors(const State&) const override 
+    {   return 3*(int)bodies.size(); }
+
+    int calcErrors(const State& state, Vector& err) const override {
+        const SimbodyMatterSubsystem& matter = getMatterSubsystem();
+        for (unsigned i = 0; i < bodies.size(); ++i) {
+            const Vec3 loc = matter.getMobilizedBody(bodies[i])
+                .findStationLocationInGround(state, stations[i]);
+            Vec3::updAs(&err[3*i]) = loc - observations[i];
+        }
+        return 0;
+    }
+
+private:
+    Array_<MobilizedBodyIndex>  bodies;
+    Array_<Vec3>                stations;
+    Array_<Vec3>                observations;
+};
+
+// Solve the problem starting from the given state and return the solution.
+static Vector solve(const MultibodySystem& system, const State& start,
+                    const Array_<MobilizedBodyIndex>& links,
+                    const Array_<Vec3>& observations, bool asErrors,
+                    int numThreads, double& secs, int& numEvals) {
+    Assembler assembler(system);
+    assembler.setAccuracy(1e-6);
+    assembler.setNumberOfThreads(numThreads);
+
+    if (asErrors) {
+        StationErrors* errors = new StationErrors();
+        for (int i = 2; i < NumLinks; i += 3)
+            errors->addStation(links[i], Vec3(.05, 0, .05), observations[i]);
+        assembler.adoptAssemblyError(errors);
+        assembler.setForceNumericalJacobian(true);
+    } else {
+        Markers* markers = new Markers();
+        for (int i = 0; i < NumLinks; ++i)
+            markers->addMarker(links[i], Vec3(.05, 0, .05));
+        markers->defineObservationOrder(Array_<Markers::MarkerIx>());
+        assembler.adoptAssemblyGoal(markers);
+        assembler.setForceNumericalGradient(true);
+        markers->moveAllObservations(observations);
+    }
+
+    State state = start;
+    const double startTime = realTime();
+    try {
+        assembler.assemble(state);
+    } catch (const std::exception& e) {
+        std::printf("  assembly failed: %s\n", e.what());
+    }
+    secs = realTime() - startTime;
+    numEvals = assembler.getNumGoalEvals() + assembler.getNumErrorEvals();
+    return state.getQ();
+}
+
+int main() {
+    MultibodySystem system;
+    Array_<MobilizedBodyIndex> links;
+    createChain(system, links);
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+
+    // The target pose supplies the observed marker locations.
+    State target = system.getDefaultState();
+    for (int i = 0; i < target.getNQ(); ++i)
+        target.updQ()[i] = .3*std::sin(Real(i));
+    system.realize(target, Stage::Position);
+    Array_<Vec3> observations;
+    for (int i = 0; i < NumLinks; ++i)
+        observations.push_back(matter.getMobilizedBody(links[i])
+            .findStationLocationInGround(target, Vec3(.05, 0, .05)));
+
+    State start = system.getDefaultState();
+    for (int i = 0; i < start.getNQ(); ++i)
+        start.updQ()[i] = .3*std::sin(Real(i)) + .05*std::cos(Real(i));
+
+    std::printf("%-22s %8s %10s %8s %10s\n", "derivative", "threads",
+                "time", "evals", "max diff");
+    for (bool asErrors : {false, true}) {
+        Vector serialQ;
+        for (int numThreads : {1, 2, 4, 8}) {
+            double secs;
+            int numEvals;
+            const Vector q = solve(system, start, links, observations,
+                                   asErrors, numThreads, secs, numEvals);
+            if (numThreads == 1) serialQ = q;
+            std::printf("%-22s %8d %8.1fms %8d %10.2g\n",
+                        asErrors ? "numerical Jacobian" : "numerical gradient",
+                        numThreads, secs*1e3, numEvals,
+                        (q - serialQ).normInf());
+        }
+    }
+    return 0;
+}
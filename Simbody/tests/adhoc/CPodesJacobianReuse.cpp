@@ -0,0 +1,113 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+/**
+ * This program measures how much work CPodesIntegrator spends on Jacobians
+ * for a stiff problem: a chain of pin-jointed links whose joints are held
+ * near zero by stiff, damped springs. It compares CPODES' own difference
+ * quotients, which set and realize the whole state for every column, with
+ * stage-aware difference quotients, which realize only from Velocity stage
+ * for the u columns, each with the default limit of 50 steps between
+ * Jacobians and with a longer one. For each case we report the wall clock
+ * time, steps, realizations, Jacobian evaluations and reuses (each reuse is
+ * a Jacobian evaluation saved), and the largest difference in final q from
+ * the first case.
+ *
+ * Usage: CPodesJacobianReuse
+ */
+
+// Forces keep references to the subsystem handles they were given, so the
+// handles must live as long as the system does.
+class Chain {
+public:
+    explicit Chain(int numLinks) : matter(system), forces(system) {
+        Force::Gravity(forces, matter, -YAxis, 9.8);
+        Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia(.1)));
+        MobilizedBody parent = matter.Ground();
+        for (int i = 0; i < numLinks; ++i) {
+            parent = MobilizedBody::Pin(parent, Vec3(0, -.5, 0), body,
+                                        Vec3(0, .5, 0));
+            Force::MobilityLinearSpring(forces, parent, MobilizerQIndex(0), 
+                                        1e5, 0);
+            Force::MobilityLinearDamper(forces, parent, MobilizerUIndex(0), 
+                                        1e2);
+        }
+        system.realizeTopology();
+    }
+
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter;
+    GeneralForceSubsystem   forces;
+};
+
+int main() {
+    const Real tFinal = 1;
+    std::printf("%6s %-12s %5s | %10s %7s %9s %6s %7s | %9s\n", "links",
+                "jacobian", "msbj", "time", "steps", "realize", "jacs",
+                "reuses", "q diff");
+
+    const int lengths[] = {10, 25, 50};
+    for (int numLinks : lengths) {
+        const Chain chain(numLinks);
+        const MultibodySystem& system = chain.system;
+        State initState = system.getDefaultState();
+        for (int i = 0; i < initState.getNQ(); ++i)
+            initState.updQ()[i] = 0.1;
+
+        const CPodesIntegrator::JacobianMethod methods[] = 
+        {   CPodesIntegrator::FullDifferenceQuotient,
+            CPodesIntegrator::StageAwareDifferenceQuotient };
+        const char* names[] = {"full", "stage-aware"};
+        const int maxSteps[] = {50, 200};
+        Vector qRef;
+        for (int m = 0; m < 2; ++m) {
+            for (int msbj : maxSteps) {
+                CPodesIntegrator integ(system, CPodes::BDF, CPodes::Newton);
+                integ.setAccuracy(1e-4);
+                integ.setJacobianMethod(methods[m]);
+                integ.setMaxStepsBetweenJacobians(msbj);
+                integ.setInternalStepLimit(100000); // don't stop part way
+                integ.initialize(initState);
+                const double start = realTime();
+                while (integ.getTime() < tFinal) // first call just starts up
+                    integ.stepTo(tFinal);
+                const double secs = realTime() - start;
+                const Vector& q = integ.getState().getQ();
+                if (qRef.size() == 0)
+                    qRef = q;
+                std::printf("%6d %-12s %5d | %8.1fms %7d %9d %6d %7d | %9.2g\n",
+                    numLinks, names[m], msbj, secs*1e3,
+                    integ.getNumStepsTaken(), integ.getNumRealizations(),
+                    integ.getNumJacobianEvaluations(),
+                    integ.getNumJacobianReuses(), (q - qRef).normInf());
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Simbody.h"
+
+#include <cstdio>
+#include <memory>
+
+using namespace SimTK;
+
+/**
+ * This program measures how long it takes to solve the path of a CableSpan
+ * wrapping a single obstacle without an analytic geodesic form, with and
+ * without warm starting the geodesics from the previous ones. The cable's
+ * origin moves a little at every step, as it would during a time simulation.
+ *
+ * Usage: CableSpanGeodesicWarmStart
+ */
+
+static void runCable(const char* name, ContactGeometry* geometry,
+                     const Transform& X_GO, const Vec3& contactPointHint) {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    CableSubsystem cables(system);
+
+    Body::Rigid aBody(MassProperties(1., Vec3(0), Inertia(1)));
+    MobilizedBody::Translation origin(matter.Ground(), Vec3(-5., 0.1, 0.),
+                                      aBody, Transform());
+    CableSpan cable(cables, origin, Vec3(0.), matter.Ground(),
+                    Vec3(5., 0.5, -0.5));
+    cable.addObstacle(matter.Ground(), X_GO,
+                      std::shared_ptr<ContactGeometry>(geometry),
+                      contactPointHint);
+    system.realizeTopology();
+
+    const int numSteps = 1000;
+    for (bool warmStart : {false, true}) {
+        cable.setWarmStartGeodesics(warmStart);
+        State s = system.getDefaultState();
+        Real sum = 0;
+        const double start = realTime();
+        for (int step = 0; step < numSteps; ++step) {
+            const Real angle = 0.01 * step;
+            origin.setQ(s, Vec3(0.2 * sin(angle), 0.5 * sin(2. * angle),
+                                0.2 * cos(angle)));
+            system.realize(s, Stage::Position);
+            sum += cable.calcLength(s);
+            s.autoUpdateDiscreteVariables();
+        }
+        const double us = (realTime() - start) * 1e6 / numSteps;
+        std::printf("%10s %6s | %10.2fus | %.12g\n", name,
+                    warmStart ? "on" : "off", us, sum);
+    }
+}
+
+int main() {
+    std::printf("%10s %6s | %12s | %s\n", "obstacle", "warm", "per step",
+                "checksum");
+    runCable("ellipsoid", new ContactGeometry::Ellipsoid(Vec3(1.5, 2.6, 1.)),
+             Transform(), Vec3(0., 0., 1.1));
+    runCable("torus", new ContactGeometry::Torus(1., 0.2),
+             Transform(Rotation(0.5 * Pi, YAxis), Vec3(0.)),
+             Vec3(0.1, 0.2, 0.));
+    return 0;
+}
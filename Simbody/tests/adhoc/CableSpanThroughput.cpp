@@ -0,0 +1,95 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Simbody.h"
+
+#include <cstdio>
+#include <memory>
+
+using namespace SimTK;
+
+/**
+ * This program measures how long it takes to solve the paths of many
+ * CableSpans, each wrapping a sphere and a cylinder, as the cable count and
+ * the number of threads given to the CableSubsystem vary. Each cable has its
+ * own moving origin so that every path must be re-solved at every step.
+ *
+ * Usage: CableSpanThroughput
+ */
+
+static void runCables(int numCables) {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    CableSubsystem cables(system);
+
+    Body::Rigid aBody(MassProperties(1., Vec3(0), Inertia(1)));
+    std::shared_ptr<ContactGeometry> sphere(new ContactGeometry::Sphere(1.));
+    std::shared_ptr<ContactGeometry> cylinder(
+        new ContactGeometry::Cylinder(1.));
+
+    Array_<MobilizedBody::Translation> origins;
+    for (int i = 0; i < numCables; ++i) {
+        const Real offset = 0.5 * i / numCables;
+        origins.push_back(MobilizedBody::Translation(
+            matter.Ground(), Vec3(-5., 0.1 + offset, offset), aBody,
+            Transform()));
+        CableSpan cable(cables, origins.back(), Vec3(0.), matter.Ground(),
+                        Vec3(5., 1. - offset, -offset));
+        cable.addObstacle(matter.Ground(), Transform(Vec3(-1.5, 0., 0.)),
+                          sphere, Vec3(0., 1., 0.));
+        cable.addObstacle(matter.Ground(),
+                          Transform(Rotation(0.5 * Pi, XAxis),
+                                    Vec3(1.5, 0., 0.)),
+                          cylinder, Vec3(0., 1., 0.));
+    }
+    system.realizeTopology();
+
+    const int numSteps = 200;
+    for (int numThreads : {1, 2, 4}) {
+        cables.setNumberOfThreads(numThreads);
+        State s = system.getDefaultState();
+        Real sum = 0;
+        const double start = realTime();
+        for (int step = 0; step < numSteps; ++step) {
+            const Real angle = 0.01 * step;
+            for (int i = 0; i < numCables; ++i)
+                origins[i].setQ(s, Vec3(0.2 * sin(angle + i),
+                                        0.5 * sin(2. * angle),
+                                        0.2 * cos(angle - i)));
+            system.realize(s, Stage::Position);
+            sum += cables.getCable(CableSpanIndex(0)).calcLength(s);
+            s.autoUpdateDiscreteVariables();
+        }
+        const double ms = (realTime() - start) * 1e3 / numSteps;
+        std::printf("%8d %8d | %10.3fms %10.2fus | %g\n", numCables,
+                    numThreads, ms, ms * 1e3 / numCables, sum);
+    }
+}
+
+int main() {
+    std::printf("%8s %8s | %12s %12s | %s\n", "cables", "threads",
+                "per step", "per cable", "checksum");
+    for (int numCables : {10, 50, 100, 300})
+        runCables(numCables);
+    return 0;
+}
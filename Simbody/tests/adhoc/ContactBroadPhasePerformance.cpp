@@ -0,0 +1,95 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+#include <cmath>
+
+using namespace SimTK;
+
+/**
+ * This program compares the ContactTrackerSubsystem broad phase methods on
+ * "rubble piles" of 100 to 100,000 spheres on free bodies at constant
+ * density, so that each sphere touches about one other. At every step each
+ * body moves a small random amount, as it would between time steps of a
+ * simulation, and we time the calculation of the active contacts.
+ */
+
+static const Real Radius = 0.1;
+
+static double timeBroadPhase(int numBodies,
+                             ContactTrackerSubsystem::BroadPhaseMethod method) {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    ContactTrackerSubsystem tracker(system);
+    const ContactMaterial material(1e6, 0, 0, 0, 0);
+    Body::Rigid body(MassProperties(1, Vec3(0), Inertia(1)));
+    body.addContactSurface(Transform(),
+        ContactSurface(ContactGeometry::Sphere(Radius), material));
+    for (int i=0; i < numBodies; ++i)
+        MobilizedBody::Free(matter.Ground(), Transform(), body, Transform());
+    tracker.setBroadPhaseMethod(method);
+
+    State state = system.realizeTopology();
+    const Real side = 0.25*std::cbrt(Real(numBodies));
+    Random::Uniform random(0, side);
+    random.setSeed(1);
+    Array_<Vec3> positions(numBodies);
+    for (int i=0; i < numBodies; ++i)
+        positions[i] = Vec3(random.getValue(), random.getValue(),
+                            random.getValue());
+    
+    Random::Uniform jiggle(-0.01, 0.01);
+    const int numSteps = 20;
+    double total = 0;
+    for (int step=0; step <= numSteps; ++step) {
+        for (int i=0; i < numBodies; ++i) {
+            positions[i] += Vec3(jiggle.getValue(), jiggle.getValue(),
+                                 jiggle.getValue());
+            matter.getMobilizedBody(MobilizedBodyIndex(i+1))
+                .setQToFitTranslation(state, positions[i]);
+        }
+        system.realize(state, Stage::Position);
+        const double start = realTime();
+        tracker.getActiveContacts(state);
+        if (step > 0) // don't count building the initial structures
+            total += realTime() - start;
+    }
+    return total*1e3/numSteps;
+}
+
+int main() {
+    std::printf("%10s %16s %16s %8s\n", "surfaces", "single axis", 
+                "incremental SAP", "speedup");
+    const int sizes[] = {100, 1000, 10000, 100000};
+    for (int n : sizes) {
+        const double single = timeBroadPhase(n,
+            ContactTrackerSubsystem::SingleAxisSweep);
+        const double sap = timeBroadPhase(n,
+            ContactTrackerSubsystem::IncrementalSweepAndPrune);
+        std::printf("%10d %14.3fms %14.3fms %8.2f\n", n, single, sap, 
+                    single/sap);
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+/**
+ * This program measures how the cost of forming and using the constraint
+ * compliance matrix A=G M\ ~G grows with the number of contacts, comparing the
+ * dense matrix with the block-sparse DelassusOperator. The test system is a
+ * row of N free boxes lying on the ground, each touching the ground at its
+ * four bottom corners and touching its neighbor along one edge, so there are
+ * about 6N contact-like constraint equations. For each N we print the time to
+ * form A, the time for a fixed number of PGS sweeps working from it, and the
+ * number of stored entries.
+ *
+ * Usage: DelassusOperatorScaling
+ */
+
+static void createBoxRow(MultibodySystem& system, int numBoxes) {
+    SimbodyMatterSubsystem matter(system);
+    const Vec3 halfDims(.5, .25, .5);
+    Body::Rigid body(MassProperties(1, Vec3(0),
+                                    UnitInertia::brick(halfDims)));
+    MobilizedBody prev = matter.Ground();
+    for (int b = 0; b < numBoxes; ++b) {
+        MobilizedBody::Free box(matter.Ground(), Vec3(b, halfDims[1], 0),
+                                body, Vec3(0));
+        // Bottom corners on the ground plane.
+        for (int i = -1; i <= 1; i += 2)
+            for (int k = -1; k <= 1; k += 2)
+                Constraint::PointInPlane(matter.Ground(), UnitVec3(YAxis), 0,
+                    box, Vec3(i*halfDims[0], -halfDims[1], k*halfDims[2]));
+        // Face-to-face contact with the previous box at two points.
+        if (b > 0)
+            for (int k = -1; k <= 1; k += 2)
+                Constraint::PointInPlane(prev, UnitVec3(XAxis), halfDims[0],
+                    box, Vec3(-halfDims[0], 0, k*halfDims[2]));
+        prev = box;
+    }
+    system.realizeTopology();
+}
+
+// Run a fixed number of PGS iterations on A pi = rhs, with either form of A.
+template <class AMatrix>
+static void sweep(const AMatrix& A, int m, Vector& pi) {
+    PGSImpulseSolver pgs(0);
+    pgs.setConvergenceTol(0); // always do all the iterations
+    pgs.setMaxIterations(20);
+    Array_<MultiplierIndex> participating;
+    for (MultiplierIndex i(0); i < m; ++i) participating.push_back(i);
+    pgs.solveBilateral(participating, A, Vector(m, Real(1e-3)),
+                       Vector(m, Real(-1)), pi);
+}
+
+int main() {
+    std::printf("%8s %8s | %10s %10s %10s | %10s %10s %10s\n",
+                "boxes", "m", "dense A", "PGS", "entries",
+                "sparse A", "PGS", "entries");
+
+    const int boxCounts[] = {10, 40, 160, 640};
+    for (int numBoxes : boxCounts) {
+        MultibodySystem system;
+        createBoxRow(system, numBoxes);
+        const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+        State state = system.getDefaultState();
+        system.realize(state, Stage::Velocity);
+        const int m = state.getNMultipliers();
+
+        Matrix dense;
+        double start = realTime();
+        matter.calcProjectedMInv(state, dense);
+        const double denseFormMs = (realTime() - start)*1e3;
+
+        DelassusOperator sparse;
+        start = realTime();
+        matter.calcProjectedMInv(state, sparse);
+        const double sparseFormMs = (realTime() - start)*1e3;
+
+        Vector piDense, piSparse;
+        start = realTime();
+        sweep(dense, m, piDense);
+        const double densePGSMs = (realTime() - start)*1e3;
+        start = realTime();
+        sweep(sparse, m, piSparse);
+        const double sparsePGSMs = (realTime() - start)*1e3;
+
+        std::printf("%8d %8d | %8.2fms %8.2fms %10d | %8.2fms %8.2fms %10d"
+                    "   (max pi difference %g)\n",
+                    numBoxes, m, denseFormMs, densePGSMs, m*m,
+                    sparseFormMs, sparsePGSMs, sparse.getNumStoredEntries(),
+                    (piDense-piSparse).normInf());
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace SimTK;
+
+/**
+ * This program measures the cost of recording a trajectory at a high sample
+ * rate from an integrator that takes much larger steps. It compares asking
+ * the integrator to stop at every sample time, which produces a complete
+ * interpolated State each time (copied from the advanced State and then
+ * realized through Velocity stage), with returning after every internal step
+ * and sampling just the continuous variables y(t) with
+ * Integrator::calcInterpolatedY(). The test system is a chain of pendulums
+ * swinging under gravity, simulated for two seconds at several sample rates.
+ * We report the wall clock time for each approach, the number of integrator
+ * steps, and the largest difference between the two sets of samples.
+ *
+ * Usage: DenseOutputSampling
+ */
+
+// Forces keep references to the subsystem handles they were given, so the
+// handles must live as long as the system does.
+class Chain {
+public:
+    explicit Chain(int numLinks) : matter(system), forces(system) {
+        Force::Gravity(forces, matter, -YAxis, 9.8);
+        Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia(.1)));
+        MobilizedBody parent = matter.Ground();
+        for (int i = 0; i < numLinks; ++i)
+            parent = MobilizedBody::Pin(parent, Vec3(0, -.5, 0), body,
+                                        Vec3(0, .5, 0));
+        system.realizeTopology();
+    }
+
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter;
+    GeneralForceSubsystem   forces;
+};
+
+int main() {
+    const int numLinks = 30;
+    const Real tFinal = 2;
+    const Chain chain(numLinks);
+    const MultibodySystem& system = chain.system;
+    State initState = system.getDefaultState();
+    for (int i = 0; i < initState.getNQ(); ++i)
+        initState.updQ()[i] = Pi/4;
+
+    std::printf("%10s %8s | %12s %12s | %8s %10s\n", "rate (Hz)", "samples",
+                "stop at each", "dense y(t)", "steps", "max diff");
+
+    const Real rates[] = {100, 1000, 10000};
+    for (Real rate : rates) {
+        const int numSamples = (int)(tFinal*rate) + 1;
+        Matrix stopped(initState.getNY(), numSamples);
+        Matrix dense(initState.getNY(), numSamples);
+
+        // Stop at every sample time and copy y from the reported State.
+        RungeKuttaMersonIntegrator stopInteg(system);
+        stopInteg.setAccuracy(1e-5);
+        stopInteg.initialize(initState);
+        double start = realTime();
+        for (int j = 0; j < numSamples; ++j) {
+            stopInteg.stepTo(j/rate);
+            stopped(j) = stopInteg.getState().getY();
+        }
+        const double stopSecs = realTime() - start;
+
+        // Return after every step and sample y(t) for each sample time that
+        // the step covered.
+        RungeKuttaMersonIntegrator denseInteg(system);
+        denseInteg.setAccuracy(1e-5);
+        denseInteg.setReturnEveryInternalStep(true);
+        denseInteg.initialize(initState);
+        Vector y(initState.getNY());
+        int j = 0;
+        start = realTime();
+        while (j < numSamples) {
+            while (j < numSamples && j/rate <= denseInteg.getAdvancedTime()) {
+                denseInteg.calcInterpolatedY(j/rate, y);
+                dense(j++) = y;
+            }
+            if (j < numSamples)
+                denseInteg.stepTo(tFinal);
+        }
+        const double denseSecs = realTime() - start;
+
+        Real maxDiff = 0;
+        for (int k = 0; k < numSamples; ++k)
+            maxDiff = std::max(maxDiff, (stopped(k) - dense(k)).normInf());
+
+        std::printf("%10g %8d | %10.2fms %10.2fms | %8d %10.2g\n",
+                    rate, numSamples, stopSecs*1e3, denseSecs*1e3,
+                    denseInteg.getNumStepsTaken(), maxDiff);
+    }
+    return 0;
+}
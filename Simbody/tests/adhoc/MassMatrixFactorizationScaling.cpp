@@ -0,0 +1,111 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+/**
+ * This program compares the cost of forming, factoring and solving with the
+ * mass matrix M as a dense matrix (calcM() and FactorLLT) and in tree-sparse
+ * form (factorM() and MassMatrixFactorization). The test systems have a free
+ * base body with a number of limbs, each a chain of ten pin joints branching
+ * into two chains of five, roughly like a many-legged creature. For each
+ * model size we print the time per step to form and factor M and then solve
+ * once, and the number of entries stored for the lower triangle of M.
+ *
+ * Usage: MassMatrixFactorizationScaling
+ */
+
+static void createCreature(MultibodySystem& system, int numLimbs) {
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia::brick(.1,.2,.3)));
+    MobilizedBody::Free base(matter.Ground(), Vec3(0), body, Vec3(0));
+    for (int limb = 0; limb < numLimbs; ++limb) {
+        const Rotation R(2*Pi*limb/numLimbs, YAxis);
+        MobilizedBody parent = base;
+        for (int i = 0; i < 10; ++i)
+            parent = MobilizedBody::Pin(parent, Transform(R, Vec3(.1,0,0)),
+                                        body, Vec3(-.2,0,0));
+        for (int side = -1; side <= 1; side += 2) {
+            MobilizedBody child = parent;
+            for (int i = 0; i < 5; ++i)
+                child = MobilizedBody::Pin(child,
+                            Transform(Rotation(side*Pi/6, ZAxis),
+                                      Vec3(.2,0,0)),
+                            body, Vec3(-.2,0,0));
+        }
+    }
+    system.realizeTopology();
+}
+
+int main() {
+    std::printf("%8s | %10s %10s | %10s %10s | %s\n", "n", "dense", "entries",
+                "sparse", "entries", "max difference");
+
+    const int limbCounts[] = {5, 10, 25, 50};
+    for (int numLimbs : limbCounts) {
+        MultibodySystem system;
+        createCreature(system, numLimbs);
+        const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+        State state = system.getDefaultState();
+        const int nu = state.getNU();
+        Random::Uniform random(-1, 1);
+        random.setSeed(numLimbs);
+        for (int i = 0; i < state.getNQ(); ++i)
+            state.updQ()[i] = random.getValue();
+        const Vector q0 = state.getQ();
+        Vector b(nu);
+        for (int i = 0; i < nu; ++i) b[i] = random.getValue();
+
+        const int numSteps = nu < 500 ? 20 : 5;
+        Matrix M; FactorLLT llt; Vector xDense, xSparse;
+        MassMatrixFactorization MFac;
+
+        double start = realTime();
+        for (int step = 0; step < numSteps; ++step) {
+            state.updQ()[0] = q0[0] + 1e-3*step; // a new configuration
+            system.realize(state, Stage::Position);
+            matter.calcM(state, M);
+            llt.factor(M);
+            llt.solve(b, xDense);
+        }
+        const double denseMs = (realTime() - start)*1e3/numSteps;
+
+        start = realTime();
+        for (int step = 0; step < numSteps; ++step) {
+            state.updQ()[0] = q0[0] + 1e-3*step;
+            system.realize(state, Stage::Position);
+            matter.factorM(state, MFac);
+            MFac.solve(b, xSparse);
+        }
+        const double sparseMs = (realTime() - start)*1e3/numSteps;
+
+        std::printf("%8d | %8.2fms %10d | %8.3fms %10d | %g\n", nu,
+                    denseMs, nu*(nu+1)/2, sparseMs,
+                    MFac.getNumStoredEntries(), (xDense-xSparse).normInf());
+    }
+    return 0;
+}
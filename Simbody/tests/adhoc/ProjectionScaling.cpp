@@ -0,0 +1,140 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+/**
+ * This program measures how the cost of constraint projection grows with the
+ * number of constraints, comparing the default projection, which factors the
+ * constraint Jacobian, with iterative projection
+ * (SimbodyMatterSubsystem::setUseIterativeProjection()). The test system is a
+ * chain of N bodies connected by ball joints, with a rod constraint between
+ * each body and the one two links further along, so there are N-2 position
+ * constraints and 3N mobilities. For each N we perturb the assembled chain
+ * slightly many times and report the average time taken by projectQ() and
+ * projectU() in each mode, and how far apart the two answers are.
+ *
+ * Usage: ProjectionScaling
+ */
+
+static void createChain(MultibodySystem& system, int numBodies) {
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia(1)));
+    const Rotation R_PF(Pi/6, UnitVec3(1,1,1));
+    Array_<MobilizedBody> links;
+    MobilizedBody parent = matter.Ground();
+    for (int i = 0; i < numBodies; ++i) {
+        links.push_back(MobilizedBody::Ball(parent, Transform(R_PF, Vec3(.5,0,0)),
+                                            body, Vec3(-.5,0,0)));
+        parent = links.back();
+    }
+    system.realizeTopology();
+
+    // Make each rod the length it has in the default configuration, so that
+    // configuration is assembled.
+    State state = system.getDefaultState();
+    system.realize(state, Stage::Position);
+    for (int i = 2; i < numBodies; ++i) {
+        const Real length = (links[i].getBodyOriginLocation(state)
+                             - links[i-2].getBodyOriginLocation(state)).norm();
+        Constraint::Rod(links[i-2], Vec3(0), links[i], Vec3(0), length);
+    }
+    system.realizeTopology();
+}
+
+// Project a series of perturbed states and return the average time per
+// projection in milliseconds, including any one-time setup. The last
+// projected q's or u's are returned in result.
+static double timeProjection(const MultibodySystem& system, const State& start,
+                             int numTrials, Stage stage, Vector& result) {
+    Random::Uniform random(-1e-4, 1e-4);
+    random.setSeed(17); // same perturbations every time
+    const ProjectOptions options(1e-8);
+    ProjectResults results;
+    Vector noErrest;
+    double total = 0;
+    State state = start;
+    for (int trial = 0; trial < numTrials; ++trial) {
+        // Reset just q and u so that, as during a simulation, cached
+        // Instance-stage results such as the preconditioners survive.
+        state.updQ() = start.getQ();
+        state.updU() = start.getU();
+        Vector& y = (stage == Stage::Position ? state.updQ() : state.updU());
+        for (int i = 0; i < y.size(); ++i)
+            y[i] += random.getValue();
+        system.realize(state, stage);
+        const double begin = realTime();
+        if (stage == Stage::Position)
+            system.projectQ(state, noErrest, options, results);
+        else
+            system.projectU(state, noErrest, options, results);
+        total += realTime() - begin;
+        if (results.getExitStatus() != ProjectResults::Succeeded)
+            std::printf("  projection failed\n");
+    }
+    result = (stage == Stage::Position ? state.getQ() : state.getU());
+    return total/numTrials*1e3;
+}
+
+int main() {
+    std::printf("%8s %8s %8s | %10s %10s %10s | %10s %10s %10s\n",
+                "bodies", "m", "n", "Q factor", "Q iter", "Q diff",
+                "U factor", "U iter", "U diff");
+
+    const int bodyCounts[] = {25, 50, 100, 200, 400};
+    for (int numBodies : bodyCounts) {
+        MultibodySystem system;
+        createChain(system, numBodies);
+        SimbodyMatterSubsystem& matter = system.updMatterSubsystem();
+        State state = system.getDefaultState();
+        Random::Uniform random(-1, 1);
+        for (int i = 0; i < state.getNU(); ++i)
+            state.updU()[i] = random.getValue();
+        system.realize(state, Stage::Velocity);
+        system.project(state, 1e-10);
+
+        const int numTrials = 20;
+        Vector qFactored, qIterative, uFactored, uIterative;
+        matter.setUseIterativeProjection(false);
+        const double qFactorMs = timeProjection(system, state, numTrials,
+                                                Stage::Position, qFactored);
+        const double uFactorMs = timeProjection(system, state, numTrials,
+                                                Stage::Velocity, uFactored);
+        matter.setUseIterativeProjection(true);
+        const double qIterMs = timeProjection(system, state, numTrials,
+                                              Stage::Position, qIterative);
+        const double uIterMs = timeProjection(system, state, numTrials,
+                                              Stage::Velocity, uIterative);
+
+        std::printf("%8d %8d %8d | %8.3fms %8.3fms %10.2g | "
+                    "%8.3fms %8.3fms %10.2g\n",
+                    numBodies, numBodies-2, state.getNU(),
+                    qFactorMs, qIterMs, (qFactored-qIterative).normInf(),
+                    uFactorMs, uIterMs, (uFactored-uIterative).normInf());
+    }
+    return 0;
+}
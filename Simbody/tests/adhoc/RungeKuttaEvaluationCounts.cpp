@@ -0,0 +1,137 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+/**
+ * This program compares the explicit error-controlled Runge-Kutta 
+ * integrators by how many times they evaluate the system per simulated 
+ * second. The test system is a chain of pendulums swinging under gravity
+ * with a witness function on the first joint angle, so that the integrators
+ * also have to localize its zero crossings. For each integrator and accuracy
+ * setting we report realizations and steps per simulated second, the number
+ * of rejected steps, the number of events seen, the error in the final state
+ * compared with a tightly converged solution, and the wall clock time.
+ *
+ * Usage: RungeKuttaEvaluationCounts
+ */
+
+namespace {
+
+// Counts zero crossings of the first joint angle.
+class ZeroCrossingCounter : public TriggeredEventReporter {
+public:
+    explicit ZeroCrossingCounter(const MobilizedBody& body) 
+    :   TriggeredEventReporter(Stage::Position), body(body) {}
+    Real getValue(const State& state) const override {
+        return body.getOneQ(state, 0);
+    }
+    void handleEvent(const State&) const override {++count;}
+    mutable int count = 0;
+private:
+    const MobilizedBody body;
+};
+
+struct RunStats {
+    int realizations, steps, rejected, events;
+    double seconds;
+    Vector y;
+};
+
+RunStats simulate(Integrator& integ, MultibodySystem& system, 
+                  const ZeroCrossingCounter& counter, const State& initState,
+                  Real accuracy, Real tFinal) {
+    counter.count = 0;
+    integ.setAccuracy(accuracy);
+    TimeStepper ts(system, integ);
+    ts.initialize(initState);
+    const double start = realTime();
+    ts.stepTo(tFinal);
+    RunStats stats;
+    stats.seconds = realTime() - start;
+    stats.realizations = integ.getNumRealizations();
+    stats.steps = integ.getNumStepsTaken();
+    stats.rejected = integ.getNumErrorTestFailures();
+    stats.events = counter.count;
+    stats.y = integ.getState().getY();
+    return stats;
+}
+
+}
+
+int main() {
+    const int numLinks = 10;
+    const Real tFinal = 10;
+
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    GeneralForceSubsystem forces(system);
+    Force::Gravity(forces, matter, -YAxis, 9.8);
+    Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia(.1)));
+    MobilizedBody parent = matter.Ground();
+    MobilizedBody first;
+    for (int i = 0; i < numLinks; ++i) {
+        parent = MobilizedBody::Pin(parent, Vec3(0, -.5, 0), body,
+                                    Vec3(0, .5, 0));
+        if (i == 0) first = parent;
+    }
+    ZeroCrossingCounter* counter = new ZeroCrossingCounter(first);
+    system.addEventReporter(counter); // takes ownership
+    system.realizeTopology();
+
+    State initState = system.getDefaultState();
+    for (int i = 0; i < initState.getNQ(); ++i)
+        initState.updQ()[i] = Pi/4;
+
+    DormandPrinceIntegrator refInteg(system);
+    const Vector yRef = 
+        simulate(refInteg, system, *counter, initState, 1e-12, tFinal).y;
+
+    std::printf("per simulated second; error is max |y-yRef| at t=%g\n",
+                tFinal);
+    std::printf("%-20s %8s | %10s %8s %8s %6s | %10s %9s\n", "integrator", 
+                "accuracy", "realize/s", "steps/s", "rejected", "events",
+                "error", "time (ms)");
+    const Real accuracies[] = {1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8};
+    for (Real accuracy : accuracies) {
+        RungeKuttaMersonIntegrator   merson(system);
+        RungeKuttaFeldbergIntegrator feldberg(system);
+        DormandPrinceIntegrator      dopri(system);
+        Integrator* integs[] = {&merson, &feldberg, &dopri};
+        for (Integrator* integ : integs) {
+            const RunStats stats = simulate(*integ, system, *counter, 
+                                            initState, accuracy, tFinal);
+            std::printf("%-20s %8g | %10.0f %8.1f %8d %6d | %10.2e %9.1f\n",
+                        integ->getMethodName(), accuracy, 
+                        stats.realizations/tFinal, stats.steps/tFinal,
+                        stats.rejected, stats.events,
+                        (stats.y - yRef).normInf(), stats.seconds*1e3);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+/**
+ * This program measures how fast a fully realized State can be copied, for
+ * models of increasing size. Copying a State shares its discrete variable and
+ * cache entry values with the source until one of the copies writes on them,
+ * so a copy that is only read (like an integrator's snapshot) should be cheap;
+ * a copy that is then modified and re-realized pays for the values it
+ * rewrites. For each model size we report the time per plain copy and the
+ * time per copy-modify-realize cycle, with a plain realize for comparison.
+ *
+ * Usage: StateCopyThroughput
+ */
+
+// A binary tree of ball-jointed bodies with springs and gravity, so that
+// there is a fair amount of cache in every subsystem.
+static void createModel(SimbodyMatterSubsystem& matter,
+                        GeneralForceSubsystem& forces, int numBodies) {
+    Force::Gravity(forces, matter, -YAxis, 9.8);
+    const Body::Rigid body(MassProperties(1, Vec3(0), Inertia(1)));
+    Array_<MobilizedBody> bodies(1, matter.Ground());
+    for (int b = 0; b < numBodies; ++b) {
+        MobilizedBody& parent = bodies[b/2]; // binary tree
+        MobilizedBody::Ball child(parent, Vec3(0, -1, 0), body, Vec3(0));
+        Force::TwoPointLinearSpring(forces, parent, Vec3(0), child, Vec3(0),
+                                    10, 1);
+        bodies.push_back(child);
+    }
+}
+
+// Return the average time in microseconds for one call to f().
+template <class F>
+static double timeIt(int reps, F f) {
+    const double start = realTime();
+    for (int i = 0; i < reps; ++i)
+        f();
+    return (realTime() - start) * 1e6 / reps;
+}
+
+int main() {
+    std::printf("%8s %8s | %12s %12s %12s\n",
+                "bodies", "reps", "copy", "copy+realize", "realize");
+
+    const int bodyCounts[] = {10, 100, 1000, 5000};
+    for (int numBodies : bodyCounts) {
+        MultibodySystem system;
+        SimbodyMatterSubsystem matter(system);
+        GeneralForceSubsystem forces(system);
+        createModel(matter, forces, numBodies);
+        system.realizeTopology();
+        State state = system.getDefaultState();
+        state.updU().setTo(0.1);
+        system.realize(state, Stage::Acceleration);
+
+        const int reps = std::max(10, 200000 / numBodies);
+        const double copyUs = timeIt(reps, [&] {
+            State copy(state);
+            (void)copy.getTime();
+        });
+
+        // Copy, perturb a velocity, and realize again, as a what-if branch
+        // of a simulation would do.
+        const double branchUs = timeIt(reps, [&] {
+            State copy(state);
+            copy.updU()[0] += 1e-3;
+            system.realize(copy, Stage::Acceleration);
+        });
+
+        State work = state;
+        const double realizeUs = timeIt(reps, [&] {
+            work.updU()[0] += 1e-3;
+            system.realize(work, Stage::Acceleration);
+        });
+
+        std::printf("%8d %8d | %10.2fus %10.2fus %10.2fus\n", numBodies, reps,
+                    copyUs, branchUs, realizeUs);
+    }
+    return 0;
+}
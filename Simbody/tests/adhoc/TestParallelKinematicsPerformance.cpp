@@ -0,0 +1,140 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace SimTK;
+
+/**
+ * This program measures the speedup obtained from the level-parallel
+ * position and velocity kinematics sweeps and the subtree-parallel articulated
+ * body sweeps enabled by SimbodyMatterSubsystem::setNumberOfThreads(). Each
+ * test system is a "comb" of W identical branches hanging from Ground, each a
+ * chain of L Pin-jointed bodies, so every level of the tree is W bodies wide
+ * and there are W independent subtrees. We vary the total body count and the
+ * width, and print the wall-clock time per realization for one thread and for
+ * the requested number of threads (default: all processors).
+ *
+ * Usage: TestParallelKinematicsPerformance [numThreads]
+ */
+
+static void createComb(MultibodySystem& system, int width, int length) {
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body(MassProperties(1, Vec3(0), Inertia(1)));
+    for (int b = 0; b < width; ++b) {
+        MobilizedBodyIndex parentx = GroundIndex;
+        for (int i = 0; i < length; ++i) {
+            MobilizedBody::Pin next(matter.updMobilizedBody(parentx),
+                                    Vec3(0, -1, 0), body, Vec3(0));
+            parentx = next.getMobilizedBodyIndex();
+        }
+    }
+    system.realizeTopology();
+}
+
+// Return the wall-clock time in microseconds for one position kinematics plus
+// velocity kinematics realization, averaged over many iterations.
+static double timeKinematics(MultibodySystem& system, int numThreads) {
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+    system.updMatterSubsystem().setNumberOfThreads(numThreads);
+    system.realizeTopology(); // the thread count is a topology setting
+
+    State state = system.getDefaultState();
+    state.updU() = 0.1;
+    system.realize(state, Stage::Velocity);
+
+    const int iterations = std::max(20, 400000/matter.getNumBodies());
+    const double start = realTime();
+    for (int i = 0; i < iterations; ++i) {
+        matter.invalidatePositionKinematics(state);
+        matter.realizePositionKinematics(state);
+        matter.realizeVelocityKinematics(state);
+    }
+    return (realTime() - start)*1e6/iterations;
+}
+
+// Return the wall-clock time in microseconds for one articulated body
+// inertia plus tree forward dynamics calculation. This exercises the
+// subtree-parallel sweeps, which split this comb into its W branches.
+static double timeArticulatedBodyDynamics(MultibodySystem& system,
+                                          int numThreads) {
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+    system.updMatterSubsystem().setNumberOfThreads(numThreads);
+    system.realizeTopology(); // the thread count is a topology setting
+
+    State state = system.getDefaultState();
+    state.updU() = 0.1;
+    system.realize(state, Stage::Acceleration);
+
+    const int iterations = std::max(20, 200000/matter.getNumBodies());
+    const double start = realTime();
+    for (int i = 0; i < iterations; ++i) {
+        matter.invalidateArticulatedBodyInertias(state);
+        system.realize(state, Stage::Acceleration);
+    }
+    return (realTime() - start)*1e6/iterations;
+}
+
+int main(int argc, char** argv) {
+    const int numThreads = argc > 1 ? std::atoi(argv[1])
+                                    : ParallelExecutor::getNumProcessors();
+    std::printf("Level-parallel kinematics with %d threads\n", numThreads);
+    std::printf("%8s %8s %8s %12s %12s %8s\n",
+                "bodies", "width", "depth", "1 thread", "N threads", "speedup");
+
+    const int bodyCounts[] = {64, 256, 1024, 4096};
+    const int widths[]     = {1, 8, 32, 128, 512};
+    for (int nb : bodyCounts) {
+        for (int width : widths) {
+            if (width > nb) continue;
+            MultibodySystem system;
+            createComb(system, width, nb/width);
+            const double serialUs   = timeKinematics(system, 1);
+            const double parallelUs = timeKinematics(system, numThreads);
+            std::printf("%8d %8d %8d %10.2fus %10.2fus %8.2f\n",
+                        nb, width, nb/width, serialUs, parallelUs,
+                        serialUs/parallelUs);
+        }
+    }
+
+    std::printf("\nSubtree-parallel articulated body dynamics\n");
+    std::printf("%8s %8s %8s %12s %12s %8s\n",
+                "bodies", "width", "depth", "1 thread", "N threads", "speedup");
+    for (int nb : bodyCounts) {
+        for (int width : widths) {
+            if (width > nb) continue;
+            MultibodySystem system;
+            createComb(system, width, nb/width);
+            const double serialUs = timeArticulatedBodyDynamics(system, 1);
+            const double parallelUs = 
+                timeArticulatedBodyDynamics(system, numThreads);
+            std::printf("%8d %8d %8d %10.2fus %10.2fus %8.2f\n",
+                        nb, width, nb/width, serialUs, parallelUs,
+                        serialUs/parallelUs);
+        }
+    }
+    return 0;
+}